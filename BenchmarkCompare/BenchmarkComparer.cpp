@@ -0,0 +1,339 @@
+/***************************************************************************************
+ * Original Author:		Gabriele Giuseppini
+ * Created:				2020-01-11
+ * Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+ ***************************************************************************************/
+#include "BenchmarkComparer.h"
+
+#include <GameCore/GameException.h>
+#include <GameCore/Utils.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iomanip>
+
+namespace /* anonymous */ {
+
+    // Makes the median absolute deviation an estimate of the standard deviation
+    // of normally-distributed samples
+    static constexpr double MadToStandardDeviation = 1.4826;
+
+    double TimeUnitToNanoseconds(std::string const & timeUnit)
+    {
+        if (timeUnit == "ns")
+            return 1.0;
+        else if (timeUnit == "us")
+            return 1000.0;
+        else if (timeUnit == "ms")
+            return 1000000.0;
+        else if (timeUnit == "s")
+            return 1000000000.0;
+        else
+            throw GameException("Unrecognized time unit \"" + timeUnit + "\"");
+    }
+
+    double CalculateRelativeNoise(std::vector<double> const & samples)
+    {
+        double const median = BenchmarkComparer::CalculateMedian(samples);
+        if (median <= 0.0)
+            return 0.0;
+
+        return MadToStandardDeviation * BenchmarkComparer::CalculateMedianAbsoluteDeviation(samples) / median;
+    }
+
+    std::string VerdictToStr(BenchmarkComparer::Verdict verdict)
+    {
+        switch (verdict)
+        {
+            case BenchmarkComparer::Verdict::Regressed:
+                return "REGRESSED";
+            case BenchmarkComparer::Verdict::Improved:
+                return "improved";
+            case BenchmarkComparer::Verdict::Unchanged:
+                return "ok";
+            case BenchmarkComparer::Verdict::Missing:
+                return "missing";
+            case BenchmarkComparer::Verdict::New:
+                return "new";
+        }
+
+        assert(false);
+        return "";
+    }
+}
+
+BenchmarkComparer::BenchmarkSamples BenchmarkComparer::LoadGoogleBenchmarkJson(
+    std::filesystem::path const & filePath,
+    bool useCpuTime)
+{
+    picojson::value const root = Utils::ParseJSONFile(filePath);
+    if (!root.is<picojson::object>())
+    {
+        throw GameException("Benchmark file \"" + filePath.string() + "\" is not a JSON object");
+    }
+
+    picojson::object const & rootObject = root.get<picojson::object>();
+    auto const benchmarksIt = rootObject.find("benchmarks");
+    if (benchmarksIt == rootObject.end() || !benchmarksIt->second.is<picojson::array>())
+    {
+        throw GameException("Benchmark file \"" + filePath.string() + "\" has no benchmarks");
+    }
+
+    BenchmarkSamples samples;
+
+    for (auto const & benchmarkElem : benchmarksIt->second.get<picojson::array>())
+    {
+        if (!benchmarkElem.is<picojson::object>())
+        {
+            throw GameException("Benchmark file \"" + filePath.string() + "\" has a non-object benchmark");
+        }
+
+        picojson::object const & benchmarkObject = benchmarkElem.get<picojson::object>();
+
+        // Skip mean, median, stddev; we calculate our own statistics out of the repetitions
+        if (Utils::GetOptionalJsonMember<std::string>(benchmarkObject, "run_type", "iteration") != "iteration")
+            continue;
+
+        // The run name does not carry the repetition suffix
+        std::string const name = Utils::GetOptionalJsonMember<std::string>(
+            benchmarkObject,
+            "run_name",
+            Utils::GetMandatoryJsonMember<std::string>(benchmarkObject, "name"));
+
+        double const time = Utils::GetMandatoryJsonMember<double>(benchmarkObject, useCpuTime ? "cpu_time" : "real_time");
+        std::string const timeUnit = Utils::GetOptionalJsonMember<std::string>(benchmarkObject, "time_unit", "ns");
+
+        samples[name].push_back(time * TimeUnitToNanoseconds(timeUnit));
+    }
+
+    return samples;
+}
+
+std::vector<BenchmarkComparer::Comparison> BenchmarkComparer::Compare(
+    BenchmarkSamples const & baseline,
+    BenchmarkSamples const & current,
+    double minThreshold,
+    double noiseFactor)
+{
+    std::vector<Comparison> comparisons;
+
+    for (auto const & [name, baselineSamples] : baseline)
+    {
+        double const baselineMedian = CalculateMedian(baselineSamples);
+
+        auto const currentIt = current.find(name);
+        if (currentIt == current.end())
+        {
+            comparisons.emplace_back(
+                name,
+                Verdict::Missing,
+                baselineMedian,
+                0.0,
+                0.0,
+                0.0,
+                baselineSamples.size(),
+                0);
+
+            continue;
+        }
+
+        auto const & currentSamples = currentIt->second;
+        double const currentMedian = CalculateMedian(currentSamples);
+
+        double const relativeChange = baselineMedian > 0.0
+            ? (currentMedian - baselineMedian) / baselineMedian
+            : 0.0;
+
+        // A change is only significant when it stands out of the noise of both runs
+        double const threshold = std::max(
+            minThreshold,
+            noiseFactor * std::max(CalculateRelativeNoise(baselineSamples), CalculateRelativeNoise(currentSamples)));
+
+        Verdict verdict;
+        if (relativeChange > threshold)
+            verdict = Verdict::Regressed;
+        else if (relativeChange < -threshold)
+            verdict = Verdict::Improved;
+        else
+            verdict = Verdict::Unchanged;
+
+        comparisons.emplace_back(
+            name,
+            verdict,
+            baselineMedian,
+            currentMedian,
+            relativeChange,
+            threshold,
+            baselineSamples.size(),
+            currentSamples.size());
+    }
+
+    for (auto const & [name, currentSamples] : current)
+    {
+        if (baseline.count(name) == 0)
+        {
+            comparisons.emplace_back(
+                name,
+                Verdict::New,
+                0.0,
+                CalculateMedian(currentSamples),
+                0.0,
+                0.0,
+                0,
+                currentSamples.size());
+        }
+    }
+
+    // Regressions first, largest first; then all other changes, and missing
+    // and new benchmarks last
+    std::stable_sort(
+        comparisons.begin(),
+        comparisons.end(),
+        [](Comparison const & lhs, Comparison const & rhs)
+        {
+            bool const isLhsRegressed = (lhs.Result == Verdict::Regressed);
+            bool const isRhsRegressed = (rhs.Result == Verdict::Regressed);
+            if (isLhsRegressed != isRhsRegressed)
+                return isLhsRegressed;
+
+            bool const isLhsCompared = (lhs.Result != Verdict::Missing && lhs.Result != Verdict::New);
+            bool const isRhsCompared = (rhs.Result != Verdict::Missing && rhs.Result != Verdict::New);
+            if (isLhsCompared != isRhsCompared)
+                return isLhsCompared;
+
+            return lhs.RelativeChange > rhs.RelativeChange;
+        });
+
+    return comparisons;
+}
+
+bool BenchmarkComparer::IsPass(
+    std::vector<Comparison> const & comparisons,
+    bool doAllowMissing)
+{
+    return std::none_of(
+        comparisons.cbegin(),
+        comparisons.cend(),
+        [doAllowMissing](Comparison const & comparison)
+        {
+            return comparison.Result == Verdict::Regressed
+                || (comparison.Result == Verdict::Missing && !doAllowMissing);
+        });
+}
+
+void BenchmarkComparer::PrintReport(
+    std::vector<Comparison> const & comparisons,
+    bool doAllowMissing,
+    std::ostream & output)
+{
+    size_t nameWidth = 9;
+    for (auto const & comparison : comparisons)
+        nameWidth = std::max(nameWidth, comparison.Name.size());
+
+    output << std::left << std::setw(nameWidth) << "Benchmark"
+        << std::right
+        << std::setw(16) << "Baseline (ns)"
+        << std::setw(16) << "Current (ns)"
+        << std::setw(10) << "Change"
+        << std::setw(11) << "Threshold"
+        << std::setw(8) << "Reps"
+        << "  Verdict" << std::endl;
+
+    size_t regressedCount = 0;
+    size_t missingCount = 0;
+    size_t singleSampleCount = 0;
+
+    output << std::fixed;
+
+    for (auto const & comparison : comparisons)
+    {
+        output << std::left << std::setw(nameWidth) << comparison.Name << std::right;
+
+        if (comparison.Result == Verdict::Missing)
+        {
+            output << std::setw(16) << std::setprecision(1) << comparison.BaselineMedian
+                << std::setw(16) << "-"
+                << std::setw(10) << "-"
+                << std::setw(11) << "-";
+        }
+        else if (comparison.Result == Verdict::New)
+        {
+            output << std::setw(16) << "-"
+                << std::setw(16) << std::setprecision(1) << comparison.CurrentMedian
+                << std::setw(10) << "-"
+                << std::setw(11) << "-";
+        }
+        else
+        {
+            output << std::setw(16) << std::setprecision(1) << comparison.BaselineMedian
+                << std::setw(16) << std::setprecision(1) << comparison.CurrentMedian
+                << std::setw(9) << std::showpos << std::setprecision(1) << comparison.RelativeChange * 100.0 << "%" << std::noshowpos
+                << std::setw(10) << std::setprecision(1) << comparison.Threshold * 100.0 << "%";
+
+            if (comparison.BaselineSampleCount < 2 || comparison.CurrentSampleCount < 2)
+                ++singleSampleCount;
+        }
+
+        output << std::setw(8) << (std::to_string(comparison.BaselineSampleCount) + "/" + std::to_string(comparison.CurrentSampleCount))
+            << "  " << VerdictToStr(comparison.Result) << std::endl;
+
+        if (comparison.Result == Verdict::Regressed)
+            ++regressedCount;
+        else if (comparison.Result == Verdict::Missing)
+            ++missingCount;
+    }
+
+    output << std::endl;
+
+    if (singleSampleCount > 0)
+    {
+        output << "WARNING: " << singleSampleCount << " benchmark(s) have no repetitions, hence no noise estimate;"
+            << " run with --benchmark_repetitions" << std::endl;
+    }
+
+    if (missingCount > 0 && doAllowMissing)
+    {
+        output << "WARNING: " << missingCount << " benchmark(s) missing from the current run" << std::endl;
+    }
+
+    if (regressedCount > 0)
+        output << "FAIL: " << regressedCount << " benchmark(s) regressed" << std::endl;
+
+    if (missingCount > 0 && !doAllowMissing)
+    {
+        output << "FAIL: " << missingCount << " benchmark(s) missing from the current run;"
+            << " run with --allow_missing if they were left out on purpose" << std::endl;
+    }
+
+    if (IsPass(comparisons, doAllowMissing))
+        output << "PASS" << std::endl;
+}
+
+double BenchmarkComparer::CalculateMedian(std::vector<double> samples)
+{
+    if (samples.empty())
+        return 0.0;
+
+    size_t const mid = samples.size() / 2;
+    std::nth_element(samples.begin(), samples.begin() + mid, samples.end());
+    double const upperMedian = samples[mid];
+
+    if (samples.size() % 2 == 1)
+        return upperMedian;
+
+    double const lowerMedian = *std::max_element(samples.begin(), samples.begin() + mid);
+    return (lowerMedian + upperMedian) / 2.0;
+}
+
+double BenchmarkComparer::CalculateMedianAbsoluteDeviation(std::vector<double> const & samples)
+{
+    double const median = CalculateMedian(samples);
+
+    std::vector<double> deviations;
+    deviations.reserve(samples.size());
+    for (double const sample : samples)
+        deviations.push_back(std::abs(sample - median));
+
+    return CalculateMedian(std::move(deviations));
+}
@@ -0,0 +1,104 @@
+/***************************************************************************************
+ * Original Author:		Gabriele Giuseppini
+ * Created:				2020-01-11
+ * Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+ ***************************************************************************************/
+#pragma once
+
+#include <filesystem>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/*
+ * Compares two runs of the benchmarks, flagging the benchmarks whose median time has
+ * changed by more than their own noise.
+ *
+ * The noise of a benchmark is the median absolute deviation of its repetitions; a
+ * benchmark is regressed when its median has grown by more than a multiple of the
+ * noise of either run, and by more than a minimum threshold.
+ *
+ * A benchmark of the baseline that is missing from the current run fails the
+ * comparison too - unless explicitly allowed, e.g. for filtered runs - as it could
+ * otherwise hide a regression.
+ */
+class BenchmarkComparer
+{
+public:
+
+    // The times of the repetitions of each benchmark, in nanoseconds, by benchmark name
+    using BenchmarkSamples = std::map<std::string, std::vector<double>>;
+
+    enum class Verdict
+    {
+        Regressed,
+        Improved,
+        Unchanged,
+        Missing, // In the baseline only
+        New // In the current run only
+    };
+
+    struct Comparison
+    {
+        std::string Name;
+        Verdict Result;
+
+        double BaselineMedian; // ns
+        double CurrentMedian; // ns
+        double RelativeChange; // (current - baseline) / baseline
+        double Threshold; // Relative
+
+        size_t BaselineSampleCount;
+        size_t CurrentSampleCount;
+
+        Comparison(
+            std::string name,
+            Verdict result,
+            double baselineMedian,
+            double currentMedian,
+            double relativeChange,
+            double threshold,
+            size_t baselineSampleCount,
+            size_t currentSampleCount)
+            : Name(std::move(name))
+            , Result(result)
+            , BaselineMedian(baselineMedian)
+            , CurrentMedian(currentMedian)
+            , RelativeChange(relativeChange)
+            , Threshold(threshold)
+            , BaselineSampleCount(baselineSampleCount)
+            , CurrentSampleCount(currentSampleCount)
+        {}
+    };
+
+    /*
+     * Loads the iterations of a Google Benchmark JSON output, ignoring its aggregates.
+     */
+    static BenchmarkSamples LoadGoogleBenchmarkJson(
+        std::filesystem::path const & filePath,
+        bool useCpuTime);
+
+    /*
+     * Compares the benchmarks of the two runs, returning the comparisons sorted by
+     * relative change, largest regressions first.
+     */
+    static std::vector<Comparison> Compare(
+        BenchmarkSamples const & baseline,
+        BenchmarkSamples const & current,
+        double minThreshold,
+        double noiseFactor);
+
+    static bool IsPass(
+        std::vector<Comparison> const & comparisons,
+        bool doAllowMissing);
+
+    static void PrintReport(
+        std::vector<Comparison> const & comparisons,
+        bool doAllowMissing,
+        std::ostream & output);
+
+    static double CalculateMedian(std::vector<double> samples);
+
+    static double CalculateMedianAbsoluteDeviation(std::vector<double> const & samples);
+};
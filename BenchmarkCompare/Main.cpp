@@ -0,0 +1,115 @@
+/***************************************************************************************
+ * Original Author:		Gabriele Giuseppini
+ * Created:				2020-01-11
+ * Copyright:			Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+ ***************************************************************************************/
+
+#include "BenchmarkComparer.h"
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#define SEPARATOR "------------------------------------------------------"
+
+void PrintUsage();
+
+/*
+ * Exits with 0 when no benchmark has regressed or gone missing, with 1 when at least
+ * one has, and with -1 on errors.
+ */
+int main(int argc, char ** argv)
+{
+    if (argc < 3)
+    {
+        PrintUsage();
+        return -1;
+    }
+
+    std::string const baselineFile(argv[1]);
+    std::string const currentFile(argv[2]);
+
+    double minThreshold = 0.05;
+    double noiseFactor = 3.0;
+    bool doUseCpuTime = false;
+    bool doAllowMissing = false;
+
+    try
+    {
+        for (int i = 3; i < argc; ++i)
+        {
+            std::string option(argv[i]);
+            if (option == "-t" || option == "--min_threshold")
+            {
+                ++i;
+                if (i == argc)
+                {
+                    throw std::runtime_error(option + " option specified without a percentage");
+                }
+
+                minThreshold = std::stod(argv[i]) / 100.0;
+            }
+            else if (option == "-n" || option == "--noise_factor")
+            {
+                ++i;
+                if (i == argc)
+                {
+                    throw std::runtime_error(option + " option specified without a factor");
+                }
+
+                noiseFactor = std::stod(argv[i]);
+            }
+            else if (option == "-c" || option == "--cpu_time")
+            {
+                doUseCpuTime = true;
+            }
+            else if (option == "-m" || option == "--allow_missing")
+            {
+                doAllowMissing = true;
+            }
+            else
+            {
+                throw std::runtime_error("Unrecognized option '" + option + "'");
+            }
+        }
+
+        std::cout << SEPARATOR << std::endl;
+        std::cout << "Comparing benchmarks:" << std::endl;
+        std::cout << "  baseline      : " << baselineFile << std::endl;
+        std::cout << "  current       : " << currentFile << std::endl;
+        std::cout << "  min threshold : " << minThreshold * 100.0 << "%" << std::endl;
+        std::cout << "  noise factor  : " << noiseFactor << std::endl;
+        std::cout << "  time          : " << (doUseCpuTime ? "cpu" : "real") << std::endl;
+        std::cout << "  allow missing : " << (doAllowMissing ? "yes" : "no") << std::endl;
+        std::cout << SEPARATOR << std::endl;
+
+        auto const comparisons = BenchmarkComparer::Compare(
+            BenchmarkComparer::LoadGoogleBenchmarkJson(baselineFile, doUseCpuTime),
+            BenchmarkComparer::LoadGoogleBenchmarkJson(currentFile, doUseCpuTime),
+            minThreshold,
+            noiseFactor);
+
+        BenchmarkComparer::PrintReport(comparisons, doAllowMissing, std::cout);
+
+        return BenchmarkComparer::IsPass(comparisons, doAllowMissing) ? 0 : 1;
+    }
+    catch (std::exception & ex)
+    {
+        std::cout << "ERROR: " << ex.what() << std::endl;
+        return -1;
+    }
+}
+
+void PrintUsage()
+{
+    std::cout << std::endl;
+    std::cout << "Usage:" << std::endl;
+    std::cout << " BenchmarkCompare <baseline_json> <current_json> [-t, --min_threshold <percentage>]" << std::endl;
+    std::cout << "                  [-n, --noise_factor <factor>] [-c, --cpu_time] [-m, --allow_missing]" << std::endl;
+    std::cout << std::endl;
+    std::cout << " The json files are produced by Benchmarks --benchmark_repetitions=<n> --benchmark_out=<file>" << std::endl;
+    std::cout << " --benchmark_out_format=json; a benchmark regresses when its median time grows by more than" << std::endl;
+    std::cout << " the minimum threshold (default 5%) and by more than the noise factor (default 3) times the" << std::endl;
+    std::cout << " median absolute deviation of either run. A benchmark of the baseline that is missing from" << std::endl;
+    std::cout << " the current run fails the comparison, unless --allow_missing is specified." << std::endl;
+}
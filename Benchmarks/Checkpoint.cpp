@@ -0,0 +1,113 @@
+#include "ShipUpdatePhases.h"
+
+#include <Game/GameEventDispatcher.h>
+#include <Game/ShipDefinitionGenerator.h>
+#include <Game/World.h>
+
+#include <GameCore/Checkpoint.h>
+#include <GameCore/ThreadPool.h>
+
+#include <filesystem>
+#include <memory>
+
+//
+// Times saving and restoring a checkpoint of a world containing a synthetic ship,
+// from 10K to 1M points; the target is tens of milliseconds at 200K points.
+//
+// Save includes visiting the state and writing the file; Load includes mapping
+// the file and copying the state back into the (already built) world.
+//
+// Run from the folder containing the Data folder.
+//
+
+namespace /* anonymous */ {
+
+    static constexpr std::uint64_t Seed = 1;
+
+    std::filesystem::path GetCheckpointFilePath()
+    {
+        return std::filesystem::temp_directory_path() / "CheckpointBenchmark.fscp";
+    }
+
+    std::unique_ptr<Physics::World> MakeWorld(
+        size_t pointCount,
+        GameParameters const & gameParameters)
+    {
+        auto & resources = ShipBenchmarkResources::GetInstance();
+
+        auto world = std::make_unique<Physics::World>(
+            std::make_shared<GameEventDispatcher>(),
+            std::make_shared<ThreadPool>(ThreadPool::GetDefaultWorkerCount(), false),
+            gameParameters,
+            resources.GetResourceLoader());
+
+        world->AddShip(
+            ShipDefinitionGenerator::Generate(
+                ShipDefinitionGenerator::HullType::MixedMaterials,
+                pointCount,
+                Seed,
+                ShipDefinitionGenerator::Palette::FromMaterialDatabase(resources.GetMaterialDatabase())),
+            resources.GetMaterialDatabase(),
+            gameParameters);
+
+        return world;
+    }
+
+    void SetCheckpointCounters(benchmark::State & state)
+    {
+        auto const fileSize = std::filesystem::file_size(GetCheckpointFilePath());
+
+        state.counters["Bytes"] = benchmark::Counter(
+            static_cast<double>(fileSize),
+            benchmark::Counter::kIsIterationInvariantRate,
+            benchmark::Counter::kIs1024);
+
+        state.counters["FileSize"] = benchmark::Counter(
+            static_cast<double>(fileSize),
+            benchmark::Counter::kDefaults,
+            benchmark::Counter::kIs1024);
+    }
+}
+
+static void Checkpoint_Save(benchmark::State & state)
+{
+    GameParameters const gameParameters;
+
+    auto world = MakeWorld(static_cast<size_t>(state.range(0)), gameParameters);
+
+    for (auto _ : state)
+    {
+        CheckpointWriter checkpoint;
+        world->SaveState(checkpoint);
+        checkpoint.Save(GetCheckpointFilePath());
+    }
+
+    SetCheckpointCounters(state);
+
+    std::filesystem::remove(GetCheckpointFilePath());
+}
+BENCHMARK(Checkpoint_Save)->Arg(10000)->Arg(200000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+static void Checkpoint_Load(benchmark::State & state)
+{
+    GameParameters const gameParameters;
+
+    auto world = MakeWorld(static_cast<size_t>(state.range(0)), gameParameters);
+
+    {
+        CheckpointWriter checkpoint;
+        world->SaveState(checkpoint);
+        checkpoint.Save(GetCheckpointFilePath());
+    }
+
+    for (auto _ : state)
+    {
+        CheckpointReader checkpoint(GetCheckpointFilePath());
+        world->LoadState(checkpoint);
+    }
+
+    SetCheckpointCounters(state);
+
+    std::filesystem::remove(GetCheckpointFilePath());
+}
+BENCHMARK(Checkpoint_Load)->Arg(10000)->Arg(200000)->Arg(1000000)->Unit(benchmark::kMillisecond);
@@ -1,6 +1,8 @@
 #include "Utils.h"
 
+#include <GameCore/Buffer.h>
 #include <GameCore/GameMath.h>
+#include <GameCore/GameMathBatch.h>
 
 #include <benchmark/benchmark.h>
 
@@ -73,4 +75,107 @@ static void FastExp_FastExp(benchmark::State& state)
 
     benchmark::DoNotOptimize(results);
 }
-BENCHMARK(FastExp_FastExp);
\ No newline at end of file
+BENCHMARK(FastExp_FastExp);
+
+//
+// Batch versions, on aligned buffers
+//
+
+static Buffer<float> MakeAlignedFloats(size_t count)
+{
+    auto const floats = MakeFloats(count);
+
+    Buffer<float> buffer(make_aligned_element_count(count));
+    std::copy(floats.cbegin(), floats.cend(), buffer.data());
+
+    return buffer;
+}
+
+static void FastPow_FastPow_Scalar(benchmark::State& state)
+{
+    auto bases = MakeAlignedFloats(Size);
+    auto exponents = MakeAlignedFloats(Size);
+    Buffer<float> results(make_aligned_element_count(Size));
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < Size; ++i)
+        {
+            results[i] = FastPow(bases[i], exponents[i]);
+        }
+    }
+
+    benchmark::DoNotOptimize(results.data());
+}
+BENCHMARK(FastPow_FastPow_Scalar);
+
+static void FastPow_FastPowBatch(benchmark::State& state)
+{
+    auto bases = MakeAlignedFloats(Size);
+    auto exponents = MakeAlignedFloats(Size);
+    Buffer<float> results(make_aligned_element_count(Size));
+    for (auto _ : state)
+    {
+        FastPowBatch(bases.data(), exponents.data(), results.data(), Size);
+    }
+
+    benchmark::DoNotOptimize(results.data());
+}
+BENCHMARK(FastPow_FastPowBatch);
+
+static void FastExp_FastExp_Scalar(benchmark::State& state)
+{
+    auto exponents = MakeAlignedFloats(Size);
+    Buffer<float> results(make_aligned_element_count(Size));
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < Size; ++i)
+        {
+            results[i] = FastExp(exponents[i]);
+        }
+    }
+
+    benchmark::DoNotOptimize(results.data());
+}
+BENCHMARK(FastExp_FastExp_Scalar);
+
+static void FastExp_FastExpBatch(benchmark::State& state)
+{
+    auto exponents = MakeAlignedFloats(Size);
+    Buffer<float> results(make_aligned_element_count(Size));
+    for (auto _ : state)
+    {
+        FastExpBatch(exponents.data(), results.data(), Size);
+    }
+
+    benchmark::DoNotOptimize(results.data());
+}
+BENCHMARK(FastExp_FastExpBatch);
+
+static void FastLog2_FastLog2_Scalar(benchmark::State& state)
+{
+    auto values = MakeAlignedFloats(Size);
+    Buffer<float> results(make_aligned_element_count(Size));
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < Size; ++i)
+        {
+            results[i] = FastLog2(values[i]);
+        }
+    }
+
+    benchmark::DoNotOptimize(results.data());
+}
+BENCHMARK(FastLog2_FastLog2_Scalar);
+
+static void FastLog2_FastLog2Batch(benchmark::State& state)
+{
+    auto values = MakeAlignedFloats(Size);
+    Buffer<float> results(make_aligned_element_count(Size));
+    for (auto _ : state)
+    {
+        FastLog2Batch(values.data(), results.data(), Size);
+    }
+
+    benchmark::DoNotOptimize(results.data());
+}
+BENCHMARK(FastLog2_FastLog2Batch);
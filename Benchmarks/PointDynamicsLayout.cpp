@@ -0,0 +1,133 @@
+#include "Utils.h"
+
+#include <GameCore/SysSpecifics.h>
+#include <GameCore/Vec2fBuffers.h>
+
+#include <benchmark/benchmark.h>
+
+//
+// Compares the interleaved and the split layouts of the point dynamics buffers,
+// running the same kernels as the game does against each layout
+//
+
+static constexpr size_t SampleSize = 20000000;
+
+template<typename TDynamicsBuffer>
+static void PointDynamicsLayout_UpdateSpringForces(benchmark::State& state)
+{
+    auto const size = MakeSize(SampleSize);
+
+    std::vector<vec2f> pointsPosition;
+    std::vector<vec2f> pointsVelocity;
+    std::vector<vec2f> pointsForce;
+    std::vector<SpringEndpoints> springsEndpoints;
+    std::vector<float> springsStiffnessCoefficient;
+    std::vector<float> springsDamperCoefficient;
+    std::vector<float> springsRestLength;
+
+    MakeGraph2(size, pointsPosition, pointsVelocity, pointsForce,
+        springsEndpoints, springsStiffnessCoefficient, springsDamperCoefficient, springsRestLength);
+
+    TDynamicsBuffer positionBuffer(size, size, vec2f::zero());
+    TDynamicsBuffer velocityBuffer(size, size, vec2f::zero());
+    TDynamicsBuffer forceBuffer(size, size, vec2f::zero());
+    for (size_t p = 0; p < size; ++p)
+    {
+        positionBuffer.set(p, pointsPosition[p]);
+        velocityBuffer.set(p, pointsVelocity[p]);
+        forceBuffer.set(p, pointsForce[p]);
+    }
+
+    BenchmarkHardwareCounters hardwareCounters(state);
+
+    for (auto _ : state)
+    {
+        for (size_t springIndex = 0; springIndex < size; ++springIndex)
+        {
+            auto const pointAIndex = springsEndpoints[springIndex].PointAIndex;
+            auto const pointBIndex = springsEndpoints[springIndex].PointBIndex;
+
+            vec2f const displacement = positionBuffer.get(pointBIndex) - positionBuffer.get(pointAIndex);
+            float const displacementLength = displacement.length();
+            vec2f const springDir = displacement.normalise(displacementLength);
+
+            vec2f const fSpringA =
+                springDir
+                * (displacementLength - springsRestLength[springIndex])
+                * springsStiffnessCoefficient[springIndex];
+
+            vec2f const relVelocity = velocityBuffer.get(pointBIndex) - velocityBuffer.get(pointAIndex);
+            vec2f const fDampA =
+                springDir
+                * relVelocity.dot(springDir)
+                * springsDamperCoefficient[springIndex];
+
+            forceBuffer.add(pointAIndex, fSpringA + fDampA);
+            forceBuffer.add(pointBIndex, -(fSpringA + fDampA));
+        }
+    }
+
+    benchmark::DoNotOptimize(forceBuffer.get(0));
+}
+BENCHMARK_TEMPLATE(PointDynamicsLayout_UpdateSpringForces, InterleavedVec2fBuffer);
+BENCHMARK_TEMPLATE(PointDynamicsLayout_UpdateSpringForces, SplitVec2fBuffer);
+
+template<typename TDynamicsBuffer>
+static void PointDynamicsLayout_Integrate(benchmark::State& state)
+{
+    auto const size = MakeSize(SampleSize);
+
+    TDynamicsBuffer positionBuffer(size, 0, vec2f(1.0f, 2.0f));
+    TDynamicsBuffer velocityBuffer(size, 0, vec2f(0.1f, 0.2f));
+    TDynamicsBuffer forceBuffer(size, 0, vec2f(3.0f, 4.0f));
+    TDynamicsBuffer integrationFactorBuffer(size, 0, vec2f(0.01f, 0.01f));
+
+    float const dt = 0.02f;
+    float const globalDampCoefficient = 0.9996f;
+
+    BenchmarkHardwareCounters hardwareCounters(state);
+
+    for (auto _ : state)
+    {
+        for (size_t a = 0; a < TDynamicsBuffer::ComponentArrayCount; ++a)
+        {
+            float * restrict positionData = positionBuffer.GetComponentArray(a);
+            float * restrict velocityData = velocityBuffer.GetComponentArray(a);
+            float * restrict forceData = forceBuffer.GetComponentArray(a);
+            float * restrict integrationFactorData = integrationFactorBuffer.GetComponentArray(a);
+
+            size_t const count = positionBuffer.GetComponentArrayLength();
+            for (size_t i = 0; i < count; ++i)
+            {
+                float const deltaPos = velocityData[i] * dt + forceData[i] * integrationFactorData[i];
+                positionData[i] += deltaPos;
+                velocityData[i] = deltaPos * globalDampCoefficient / dt;
+                forceData[i] = 0.0f;
+            }
+        }
+    }
+
+    benchmark::DoNotOptimize(positionBuffer.get(0));
+}
+BENCHMARK_TEMPLATE(PointDynamicsLayout_Integrate, InterleavedVec2fBuffer);
+BENCHMARK_TEMPLATE(PointDynamicsLayout_Integrate, SplitVec2fBuffer);
+
+template<typename TDynamicsBuffer>
+static void PointDynamicsLayout_Upload(benchmark::State& state)
+{
+    auto const size = MakeSize(SampleSize);
+
+    TDynamicsBuffer positionBuffer(size, 0, vec2f(1.0f, 2.0f));
+    std::vector<vec2f> uploadBuffer(size);
+
+    BenchmarkHardwareCounters hardwareCounters(state);
+
+    for (auto _ : state)
+    {
+        positionBuffer.copy_to(uploadBuffer.data());
+    }
+
+    benchmark::DoNotOptimize(uploadBuffer);
+}
+BENCHMARK_TEMPLATE(PointDynamicsLayout_Upload, InterleavedVec2fBuffer);
+BENCHMARK_TEMPLATE(PointDynamicsLayout_Upload, SplitVec2fBuffer);
@@ -1,5 +1,6 @@
 #include "Utils.h"
 
+#include <GameCore/Buffer.h>
 #include <GameCore/PrecalculatedFunction.h>
 
 #include <benchmark/benchmark.h>
@@ -117,4 +118,26 @@ static void PrecalculatedFunction_LinearlyInterpolatedPeriodic_WithPhaseArgAdjus
 
     benchmark::DoNotOptimize(result);
 }
-BENCHMARK(PrecalculatedFunction_LinearlyInterpolatedPeriodic_WithPhaseArgAdjustment);
\ No newline at end of file
+BENCHMARK(PrecalculatedFunction_LinearlyInterpolatedPeriodic_WithPhaseArgAdjustment);
+
+static void PrecalculatedFunction_LinearlyInterpolatedPeriodicBatch_8k(benchmark::State& state)
+{
+    PrecalculatedFunction<8192> pf(
+        [](float x)
+        {
+            return sin(2.0f * Pi<float> * x);
+        });
+
+    auto const floats = MakeFloats(Size);
+    Buffer<float> args(make_aligned_element_count(Size));
+    std::copy(floats.cbegin(), floats.cend(), args.data());
+
+    Buffer<float> results(make_aligned_element_count(Size));
+    for (auto _ : state)
+    {
+        pf.GetLinearlyInterpolatedPeriodicBatch(args.data(), results.data(), Size);
+    }
+
+    benchmark::DoNotOptimize(results.data());
+}
+BENCHMARK(PrecalculatedFunction_LinearlyInterpolatedPeriodicBatch_8k);
@@ -0,0 +1,126 @@
+#include <GameCore/RandomEngine.h>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+static constexpr size_t Size = 10000000;
+
+static void RandomReal_Ranlux48Base(benchmark::State& state)
+{
+    std::seed_seq seedSeq({ 1, 242, 19730528 });
+    std::ranlux48_base engine(seedSeq);
+    std::vector<float> results(Size);
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < Size; ++i)
+        {
+            // As the game used to: a distribution per invocation
+            std::uniform_real_distribution<float> dis(0.0f, 1.0f);
+            results[i] = 1.0f + dis(engine) * 2.0f;
+        }
+    }
+
+    benchmark::DoNotOptimize(results);
+}
+BENCHMARK(RandomReal_Ranlux48Base);
+
+static void RandomReal_RandomEngine_Scalar(benchmark::State& state)
+{
+    RandomEngine engine(19730528);
+    std::vector<float> results(Size);
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < Size; ++i)
+        {
+            results[i] = engine.GenerateRandomReal(1.0f, 3.0f);
+        }
+    }
+
+    benchmark::DoNotOptimize(results);
+}
+BENCHMARK(RandomReal_RandomEngine_Scalar);
+
+static void RandomReal_RandomEngine_FillUniform(benchmark::State& state)
+{
+    RandomEngine engine(19730528);
+    std::vector<float> results(Size);
+
+    for (auto _ : state)
+    {
+        engine.FillUniform(results.data(), Size, 1.0f, 3.0f);
+    }
+
+    benchmark::DoNotOptimize(results);
+}
+BENCHMARK(RandomReal_RandomEngine_FillUniform);
+
+static void RandomInteger_Ranlux48Base(benchmark::State& state)
+{
+    std::seed_seq seedSeq({ 1, 242, 19730528 });
+    std::ranlux48_base engine(seedSeq);
+    std::vector<size_t> results(Size);
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < Size; ++i)
+        {
+            std::uniform_int_distribution<size_t> dis(4, 9);
+            results[i] = dis(engine);
+        }
+    }
+
+    benchmark::DoNotOptimize(results);
+}
+BENCHMARK(RandomInteger_Ranlux48Base);
+
+static void RandomInteger_RandomEngine(benchmark::State& state)
+{
+    RandomEngine engine(19730528);
+    std::vector<size_t> results(Size);
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < Size; ++i)
+        {
+            results[i] = engine.GenerateRandomInteger<size_t>(4, 9);
+        }
+    }
+
+    benchmark::DoNotOptimize(results);
+}
+BENCHMARK(RandomInteger_RandomEngine);
+
+static void RadialVectors_RandomEngine_Scalar(benchmark::State& state)
+{
+    RandomEngine engine(19730528);
+    std::vector<vec2f> results(Size);
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < Size; ++i)
+        {
+            results[i] = engine.GenerateRandomRadialVector(1.0f, 2.0f);
+        }
+    }
+
+    benchmark::DoNotOptimize(results);
+}
+BENCHMARK(RadialVectors_RandomEngine_Scalar);
+
+static void RadialVectors_RandomEngine_Fill(benchmark::State& state)
+{
+    RandomEngine engine(19730528);
+    std::vector<vec2f> results(Size);
+
+    for (auto _ : state)
+    {
+        engine.FillRadialVectors(results.data(), Size, 1.0f, 2.0f);
+    }
+
+    benchmark::DoNotOptimize(results);
+}
+BENCHMARK(RadialVectors_RandomEngine_Fill);
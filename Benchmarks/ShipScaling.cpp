@@ -0,0 +1,87 @@
+#include "ShipUpdatePhases.h"
+
+#include <Game/ShipDefinitionGenerator.h>
+
+#include <map>
+#include <string>
+#include <tuple>
+
+//
+// Reports how each phase of a ship's update scales with the size of the ship, from
+// 10K to 10M points, running the phases against synthetic ships of each hull type.
+//
+// The interesting counters are TimePerPoint - the time per point per step - and
+// BytesPerPoint.
+//
+// Run from the folder containing the Data folder.
+//
+
+namespace /* anonymous */ {
+
+    static constexpr std::uint64_t Seed = 1;
+
+    // Light diffusion visits each point once per lamp, and lamps grow with points
+    static constexpr size_t MaxLampGridDiffuseLightPointCount = 1000000;
+
+    ShipDefinition const & GetSyntheticShipDefinition(
+        ShipDefinitionGenerator::HullType hullType,
+        size_t pointCount)
+    {
+        static std::map<std::tuple<ShipDefinitionGenerator::HullType, size_t>, ShipDefinition> shipDefinitions;
+
+        auto const key = std::make_tuple(hullType, pointCount);
+
+        auto it = shipDefinitions.find(key);
+        if (it == shipDefinitions.end())
+        {
+            it = shipDefinitions.emplace(
+                key,
+                ShipDefinitionGenerator::Generate(
+                    hullType,
+                    pointCount,
+                    Seed,
+                    ShipDefinitionGenerator::Palette::FromMaterialDatabase(
+                        ShipBenchmarkResources::GetInstance().GetMaterialDatabase()))).first;
+        }
+
+        return it->second;
+    }
+
+    bool RegisterShipScalingBenchmarks()
+    {
+        for (auto hullType : {
+            ShipDefinitionGenerator::HullType::SolidRectangle,
+            ShipDefinitionGenerator::HullType::Lattice,
+            ShipDefinitionGenerator::HullType::RopeRig,
+            ShipDefinitionGenerator::HullType::LampGrid,
+            ShipDefinitionGenerator::HullType::MixedMaterials })
+        {
+            for (auto const & phase : Physics::ShipUpdatePhasesBenchmark::GetPhases())
+            {
+                auto * benchmark = benchmark::RegisterBenchmark(
+                    ("ShipScaling_" + std::string(phase.Name) + "/" + ShipDefinitionGenerator::HullTypeToStr(hullType)).c_str(),
+                    [hullType, phaseFunction = phase.Function](benchmark::State & state)
+                    {
+                        RunShipUpdatePhase(
+                            state,
+                            GetSyntheticShipDefinition(hullType, static_cast<size_t>(state.range(0))),
+                            phaseFunction);
+                    });
+
+                size_t const maxPointCount =
+                    (hullType == ShipDefinitionGenerator::HullType::LampGrid && std::string(phase.Name) == "DiffuseLight")
+                    ? MaxLampGridDiffuseLightPointCount
+                    : 10000000;
+
+                benchmark
+                    ->RangeMultiplier(10)
+                    ->Range(10000, static_cast<int64_t>(maxPointCount))
+                    ->Unit(benchmark::kMicrosecond);
+            }
+        }
+
+        return true;
+    }
+
+    bool const AreShipScalingBenchmarksRegistered = RegisterShipScalingBenchmarks();
+}
@@ -0,0 +1,140 @@
+#include "ShipUpdatePhases.h"
+#include "Utils.h"
+
+#include <Game/GameEventDispatcher.h>
+#include <Game/ShipBuilder.h>
+#include <Game/World.h>
+
+#include <GameCore/Log.h>
+#include <GameCore/ThreadPool.h>
+
+#include <memory>
+#include <string>
+
+//
+// Runs the individual phases of a ship's update against the real ships in the
+// Ships folder, one benchmark per ship and phase.
+//
+// Each ship file is loaded once; each run of a benchmark builds the ship afresh,
+// outside of the timed loop, so that phases that move the ship do not affect the
+// phases that follow them. Rates are reported in elements - points or springs,
+// depending on the phase - per second.
+//
+// Run from the folder containing the Data and Ships folders.
+//
+
+ShipBenchmarkResources & ShipBenchmarkResources::GetInstance()
+{
+    static ShipBenchmarkResources instance;
+    return instance;
+}
+
+ShipBenchmarkResources::ShipBenchmarkResources()
+    : mResourceLoader()
+    , mMaterialDatabase(MaterialDatabase::Load(mResourceLoader))
+    , mShipDefinitions()
+{
+}
+
+ShipDefinition const & ShipBenchmarkResources::GetShipDefinition(std::filesystem::path const & shipFilePath)
+{
+    auto it = mShipDefinitions.find(shipFilePath);
+    if (it == mShipDefinitions.end())
+    {
+        it = mShipDefinitions.emplace(shipFilePath, ShipDefinition::Load(shipFilePath)).first;
+    }
+
+    return it->second;
+}
+
+void RunShipUpdatePhase(
+    benchmark::State & state,
+    ShipDefinition const & shipDefinition,
+    Physics::ShipUpdatePhasesBenchmark::PhaseFunction const & phaseFunction)
+{
+    auto & resources = ShipBenchmarkResources::GetInstance();
+
+    GameParameters const gameParameters;
+
+    auto gameEventDispatcher = std::make_shared<GameEventDispatcher>();
+
+    Physics::World world(
+        gameEventDispatcher,
+        std::make_shared<ThreadPool>(ThreadPool::GetDefaultWorkerCount(), false),
+        gameParameters,
+        resources.GetResourceLoader());
+
+    auto ship = ShipBuilder::Create(
+        0,
+        world,
+        gameEventDispatcher,
+        shipDefinition,
+        resources.GetMaterialDatabase(),
+        gameParameters);
+
+    size_t elementCount = 0;
+
+    {
+        BenchmarkHardwareCounters hardwareCounters(state);
+
+        for (auto _ : state)
+        {
+            elementCount = phaseFunction(*ship, gameParameters);
+        }
+    }
+
+    double const pointCount = static_cast<double>(ship->GetPointCount());
+
+    state.counters["Elements"] = benchmark::Counter(
+        static_cast<double>(elementCount),
+        benchmark::Counter::kIsIterationInvariantRate);
+
+    // Seconds per point per step
+    state.counters["TimePerPoint"] = benchmark::Counter(
+        pointCount,
+        benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+
+    state.counters["BytesPerPoint"] = benchmark::Counter(
+        static_cast<double>(ship->GetMemoryFootprint()) / pointCount);
+}
+
+namespace /* anonymous */ {
+
+    bool RegisterShipUpdatePhaseBenchmarks()
+    {
+        std::filesystem::path const shipFolderPath("Ships");
+        if (!std::filesystem::is_directory(shipFolderPath))
+        {
+            LogMessage("ShipUpdatePhases: no Ships folder in the current directory, not registering any benchmarks");
+            return false;
+        }
+
+        for (auto const & entryIt : std::filesystem::directory_iterator(shipFolderPath))
+        {
+            if (!entryIt.is_regular_file()
+                || entryIt.path().extension() != ".shp")
+            {
+                continue;
+            }
+
+            std::filesystem::path const shipFilePath = entryIt.path();
+
+            for (auto const & phase : Physics::ShipUpdatePhasesBenchmark::GetPhases())
+            {
+                benchmark::RegisterBenchmark(
+                    ("ShipUpdatePhase_" + std::string(phase.Name) + "/" + shipFilePath.stem().string()).c_str(),
+                    [shipFilePath, phaseFunction = phase.Function](benchmark::State & state)
+                    {
+                        RunShipUpdatePhase(
+                            state,
+                            ShipBenchmarkResources::GetInstance().GetShipDefinition(shipFilePath),
+                            phaseFunction);
+                    });
+            }
+        }
+
+        return true;
+    }
+
+    bool const AreShipUpdatePhaseBenchmarksRegistered = RegisterShipUpdatePhaseBenchmarks();
+}
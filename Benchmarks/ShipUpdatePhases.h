@@ -0,0 +1,199 @@
+#pragma once
+
+#include <Game/GameParameters.h>
+#include <Game/MaterialDatabase.h>
+#include <Game/ResourceLoader.h>
+#include <Game/Ship.h>
+#include <Game/ShipDefinition.h>
+
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <vector>
+
+namespace Physics
+{
+
+/*
+ * The phases of a ship's update that are benchmarked individually; each phase
+ * returns the number of elements that it has processed.
+ */
+class ShipUpdatePhasesBenchmark
+{
+public:
+
+    using PhaseFunction = std::function<size_t(Ship &, GameParameters const &)>;
+
+    struct Phase
+    {
+        char const * Name;
+        PhaseFunction Function;
+    };
+
+    static std::vector<Phase> GetPhases()
+    {
+        return {
+            {
+                "UpdateSpringForces",
+                [](Ship & ship, GameParameters const & gameParameters)
+                {
+                    ship.UpdateSpringForces(gameParameters);
+                    return static_cast<size_t>(ship.mSprings.GetElementCount());
+                }
+            },
+            {
+                // The per-spring loop that Ship::UpdateSpringForces used before the
+                // solver spring blocks, as a reference for the phase above
+                "UpdateSpringForces_PerSpring",
+                [](Ship & ship, GameParameters const & /*gameParameters*/)
+                {
+                    for (auto springIndex : ship.mSprings)
+                    {
+                        auto const pointAIndex = ship.mSprings.GetEndpointAIndex(springIndex);
+                        auto const pointBIndex = ship.mSprings.GetEndpointBIndex(springIndex);
+
+                        vec2f const displacement = ship.mPoints.GetPosition(pointBIndex) - ship.mPoints.GetPosition(pointAIndex);
+                        float const displacementLength = displacement.length();
+                        vec2f const springDir = displacement.normalise(displacementLength);
+
+                        vec2f const fSpringA =
+                            springDir
+                            * (displacementLength - ship.mSprings.GetRestLength(springIndex))
+                            * ship.mSprings.GetStiffnessCoefficient(springIndex);
+
+                        vec2f const relVelocity = ship.mPoints.GetVelocity(pointBIndex) - ship.mPoints.GetVelocity(pointAIndex);
+                        vec2f const fDampA =
+                            springDir
+                            * relVelocity.dot(springDir)
+                            * ship.mSprings.GetDampingCoefficient(springIndex);
+
+                        ship.mPoints.AddForce(pointAIndex, fSpringA + fDampA);
+                        ship.mPoints.AddForce(pointBIndex, -(fSpringA + fDampA));
+                    }
+
+                    return static_cast<size_t>(ship.mSprings.GetElementCount());
+                }
+            },
+            {
+                "UpdatePointForces",
+                [](Ship & ship, GameParameters const & gameParameters)
+                {
+                    ship.UpdatePointForces(gameParameters);
+                    return static_cast<size_t>(ship.mPoints.GetElementCount());
+                }
+            },
+            {
+                "IntegrateAndResetPointForces",
+                [](Ship & ship, GameParameters const & gameParameters)
+                {
+                    ship.IntegrateAndResetPointForces(gameParameters);
+                    return static_cast<size_t>(ship.mPoints.GetElementCount());
+                }
+            },
+            {
+                "HandleCollisionsWithSeaFloor",
+                [](Ship & ship, GameParameters const & gameParameters)
+                {
+                    ship.HandleCollisionsWithSeaFloor(gameParameters);
+                    return static_cast<size_t>(ship.mPoints.GetElementCount());
+                }
+            },
+            {
+                "UpdateStrains",
+                [](Ship & ship, GameParameters const & gameParameters)
+                {
+                    ship.mSprings.UpdateStrains(
+                        gameParameters,
+                        ship.mPoints,
+                        ship.mStructuralCommands);
+
+                    // Springs are never broken here, hence each iteration sees the same structure
+                    ship.mStructuralCommands.Clear();
+
+                    return static_cast<size_t>(ship.mSprings.GetElementCount());
+                }
+            },
+            {
+                "UpdateWaterVelocities",
+                [](Ship & ship, GameParameters const & gameParameters)
+                {
+                    float waterSplashed = 0.0f;
+                    ship.UpdateWaterVelocities(gameParameters, waterSplashed);
+                    benchmark::DoNotOptimize(waterSplashed);
+                    return static_cast<size_t>(ship.mPoints.GetElementCount());
+                }
+            },
+            {
+                "DiffuseLight",
+                [](Ship & ship, GameParameters const & gameParameters)
+                {
+                    ship.DiffuseLight(gameParameters);
+                    return static_cast<size_t>(ship.mPoints.GetElementCount());
+                }
+            },
+            {
+                "PropagateHeat",
+                [](Ship & ship, GameParameters const & gameParameters)
+                {
+                    ship.PropagateHeat(
+                        0.0f,
+                        GameParameters::SimulationStepTimeDuration<float>,
+                        gameParameters);
+                    return ship.mPoints.GetShipPointCount();
+                }
+            },
+            {
+                "RunConnectivityVisit",
+                [](Ship & ship, GameParameters const & /*gameParameters*/)
+                {
+                    ship.RunConnectivityVisit();
+                    return ship.mPoints.GetShipPointCount();
+                }
+            }
+        };
+    }
+};
+
+}
+
+/*
+ * Everything that is loaded once and shared by all the ship benchmarks; expects the
+ * Data folder in the current directory.
+ */
+class ShipBenchmarkResources
+{
+public:
+
+    static ShipBenchmarkResources & GetInstance();
+
+    ResourceLoader & GetResourceLoader()
+    {
+        return mResourceLoader;
+    }
+
+    MaterialDatabase const & GetMaterialDatabase() const
+    {
+        return mMaterialDatabase;
+    }
+
+    ShipDefinition const & GetShipDefinition(std::filesystem::path const & shipFilePath);
+
+private:
+
+    ShipBenchmarkResources();
+
+    ResourceLoader mResourceLoader;
+    MaterialDatabase mMaterialDatabase;
+    std::map<std::filesystem::path, ShipDefinition> mShipDefinitions;
+};
+
+/*
+ * Builds a ship out of the definition and runs the phase on it, reporting the rate of
+ * processed elements, the time per point, and the memory footprint of the ship per point.
+ */
+void RunShipUpdatePhase(
+    benchmark::State & state,
+    ShipDefinition const & shipDefinition,
+    Physics::ShipUpdatePhasesBenchmark::PhaseFunction const & phaseFunction);
@@ -1,11 +1,8 @@
 #include "Utils.h"
 
+#include <GameCore/LibSimdPp.h>
 #include <GameCore/SysSpecifics.h>
 
-// TODO: move to GameLib's LibSimdPp.h
-#define SIMDPP_ARCH_X86_SSSE3
-#include "simdpp/simd.h"
-
 #include <benchmark/benchmark.h>
 
 #include <algorithm>
@@ -28,6 +25,8 @@ static void UpdateSpringForces_Naive(benchmark::State& state)
     MakeGraph2(size, pointsPosition, pointsVelocity, pointsForce,
         springsEndpoints, springsStiffnessCoefficient, springsDamperCoefficient, springsRestLength);
 
+    BenchmarkHardwareCounters hardwareCounters(state);
+
     for (auto _ : state)
     {
         for (size_t springIndex = 0; springIndex < size; ++springIndex)
@@ -104,6 +103,8 @@ static void UpdateSpringForces_LibSimdPpAndIntrinsics(benchmark::State& state)
 
     __m128 const Zero = _mm_set_ps(0.0f, 0.0f, 0.0f, 0.0f);
 
+    BenchmarkHardwareCounters hardwareCounters(state);
+
     for (auto _ : state)
     {
         for (size_t s = 0; s < springsEndpoints.size(); s += 4)
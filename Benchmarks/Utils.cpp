@@ -1,5 +1,26 @@
 #include "Utils.h"
 
+BenchmarkHardwareCounters::BenchmarkHardwareCounters(benchmark::State & state)
+    : mState(state)
+    , mHardwareCounters()
+    , mStartValues(mHardwareCounters.Read())
+{
+}
+
+BenchmarkHardwareCounters::~BenchmarkHardwareCounters()
+{
+    if (!mHardwareCounters.IsAvailable())
+        return;
+
+    HardwareCounterValues const values = mHardwareCounters.Read() - mStartValues;
+
+    mState.counters["Cycles"] = benchmark::Counter(static_cast<double>(values.Cycles), benchmark::Counter::kAvgIterations);
+    mState.counters["Instructions"] = benchmark::Counter(static_cast<double>(values.Instructions), benchmark::Counter::kAvgIterations);
+    mState.counters["IPC"] = values.GetInstructionsPerCycle();
+    mState.counters["LLCMisses"] = benchmark::Counter(static_cast<double>(values.LLCMisses), benchmark::Counter::kAvgIterations);
+    mState.counters["DTLBMisses"] = benchmark::Counter(static_cast<double>(values.DTLBMisses), benchmark::Counter::kAvgIterations);
+}
+
 size_t MakeSize(size_t count)
 {
     if (0 == (count % 16))
@@ -1,8 +1,31 @@
 #include <GameCore/GameTypes.h>
+#include <GameCore/HardwareCounters.h>
 #include <GameCore/Vectors.h>
 
+#include <benchmark/benchmark.h>
+
 #include <vector>
 
+/*
+ * Counts the hardware events from construction to destruction, and reports them as
+ * per-iteration counters of the benchmark; reports nothing when the counters are not
+ * available.
+ */
+class BenchmarkHardwareCounters
+{
+public:
+
+    explicit BenchmarkHardwareCounters(benchmark::State & state);
+
+    ~BenchmarkHardwareCounters();
+
+private:
+
+    benchmark::State & mState;
+    HardwareCounters mHardwareCounters;
+    HardwareCounterValues const mStartValues;
+};
+
 size_t MakeSize(size_t count);
 
 std::vector<float> MakeFloats(size_t count);
@@ -1,5 +1,6 @@
 #include "Utils.h"
 
+#include <GameCore/LibSimdPp.h>
 #include <GameCore/SysSpecifics.h>
 
 #include <benchmark/benchmark.h>
@@ -110,10 +111,6 @@ BENCHMARK(VectorNormalization_Naive_AndLength_RestrictPointers);
 
 ////////////////////////////////////////////////////////////////////////////////////////
 
-// TODO: move to GameLib's LibSimdPp.h
-#define SIMDPP_ARCH_X86_SSSE3
-#include "simdpp/simd.h"
-
 static void VectorNormalization_Vectorized_AndLength_VSizeGnostic_Load1(benchmark::State& state)
 {
     auto const size = MakeSize(SampleSize);
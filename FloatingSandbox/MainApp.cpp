@@ -11,11 +11,19 @@
 #include "MainFrame.h"
 #include "UnhandledExceptionHandler.h"
 
+#include <Game/FrameProfiler.h>
+
 #include <GameCore/FloatingPoint.h>
+#include <GameCore/GameWallClock.h>
+#include <GameCore/RewindBuffer.h>
+#include <GameCore/TraceRecorder.h>
 
 #include <wx/app.h>
 #include <wx/msgdlg.h>
 
+#include <filesystem>
+#include <optional>
+
 #ifdef _MSC_VER
 #else
 #include "Resources/Ship.xpm"
@@ -44,6 +52,19 @@ class MainApp : public wxApp
 {
 public:
     virtual bool OnInit() override;
+    virtual int OnExit() override;
+
+private:
+
+    // When set, the trace of the last frames is written here at exit
+    std::optional<std::filesystem::path> mTraceOutputFilePath;
+
+    // When set, the state hash of each simulation step is written here
+    std::optional<std::filesystem::path> mStateHashLogFilePath;
+
+    // When set, the last seconds of simulation are kept for rewinding
+    std::optional<float> mRewindDuration;
+    size_t mRewindMaxByteSize = 512 * 1024 * 1024;
 };
 
 IMPLEMENT_APP(MainApp);
@@ -89,6 +110,54 @@ bool MainApp::OnInit()
     EnableFloatingPointExceptions();
 #endif
 
+    //
+    // Parse command line
+    //
+    //  --trace <path>: write the trace of the last frames to <path> at exit
+    //  --hardware-counters: count hardware events in each profiled section (Linux only)
+    //  --deterministic: drive all timers with simulation time, for reproducible runs
+    //  --state-hashes <path>: write the hash of the state of the world after each step to <path>
+    //  --rewind <seconds>: keep the last <seconds> of simulation for rewinding
+    //  --rewind-memory <MB>: cap the memory used for rewinding (default: 512MB)
+    //
+
+    for (int a = 1; a < argc; ++a)
+    {
+        if (argv[a] == wxString("--trace") && a + 1 < argc)
+        {
+            mTraceOutputFilePath = std::filesystem::path(argv[++a].ToStdString());
+            TraceRecorder::GetInstance().SetEnabled(true);
+        }
+        else if (argv[a] == wxString("--hardware-counters"))
+        {
+#ifdef FRAME_PROFILER
+            FrameProfiler::GetInstance().SetHardwareCountersEnabled(true);
+#endif
+        }
+        else if (argv[a] == wxString("--deterministic"))
+        {
+            GameWallClock::GetInstance().SetDeterministic();
+        }
+        else if (argv[a] == wxString("--state-hashes") && a + 1 < argc)
+        {
+            mStateHashLogFilePath = std::filesystem::path(argv[++a].ToStdString());
+        }
+        else if (argv[a] == wxString("--rewind") && a + 1 < argc)
+        {
+            double rewindDuration;
+            if (argv[++a].ToDouble(&rewindDuration) && rewindDuration > 0.0)
+                mRewindDuration = static_cast<float>(rewindDuration);
+        }
+        else if (argv[a] == wxString("--rewind-memory") && a + 1 < argc)
+        {
+            unsigned long rewindMaxMegabytes;
+            if (argv[++a].ToULong(&rewindMaxMegabytes) && rewindMaxMegabytes > 0)
+                mRewindMaxByteSize = static_cast<size_t>(rewindMaxMegabytes) * 1024 * 1024;
+        }
+    }
+
+    TraceRecorder::GetInstance().SetCurrentThreadName("Main");
+
     //
     // Initialize wxWidgets
     //
@@ -103,7 +172,11 @@ bool MainApp::OnInit()
 
     try
     {
-        MainFrame* frame = new MainFrame(this);
+        std::optional<RewindBuffer::Settings> rewindSettings;
+        if (!!mRewindDuration)
+            rewindSettings.emplace(*mRewindDuration, mRewindMaxByteSize);
+
+        MainFrame* frame = new MainFrame(this, mStateHashLogFilePath, rewindSettings);
         frame->SetIcon(wxICON(AAA_SHIP_ICON));
         SetTopWindow(frame);
 
@@ -115,4 +188,21 @@ bool MainApp::OnInit()
 
         return false;
     }
+}
+
+int MainApp::OnExit()
+{
+    if (!!mTraceOutputFilePath)
+    {
+        try
+        {
+            TraceRecorder::GetInstance().WriteChromeTrace(*mTraceOutputFilePath);
+        }
+        catch (std::exception const & e)
+        {
+            wxMessageBox(std::string(e.what()), wxT("Error"), wxICON_ERROR);
+        }
+    }
+
+    return wxApp::OnExit();
 }
\ No newline at end of file
@@ -9,6 +9,7 @@
 #include "NewVersionDisplayDialog.h"
 #include "ShipDescriptionDialog.h"
 #include "SplashScreenDialog.h"
+#include "StandardSystemPaths.h"
 #include "StartupTipDialog.h"
 
 #include <Game/ImageFileTools.h>
@@ -17,9 +18,11 @@
 
 #include <GameCore/GameException.h>
 #include <GameCore/Log.h>
+#include <GameCore/TraceRecorder.h>
 #include <GameCore/Utils.h>
 #include <GameCore/Version.h>
 
+#include <wx/filedlg.h>
 #include <wx/intl.h>
 #include <wx/msgdlg.h>
 #include <wx/panel.h>
@@ -31,6 +34,7 @@
 #include <cassert>
 #include <chrono>
 #include <ctime>
+#include <future>
 #include <iomanip>
 #include <map>
 #include <sstream>
@@ -41,6 +45,9 @@ const long ID_MAIN_CANVAS = wxNewId();
 const long ID_LOAD_SHIP_MENUITEM = wxNewId();
 const long ID_RELOAD_LAST_SHIP_MENUITEM = wxNewId();
 const long ID_SAVE_SCREENSHOT_MENUITEM = wxNewId();
+const long ID_SAVE_TRACE_MENUITEM = wxNewId();
+const long ID_SAVE_CHECKPOINT_MENUITEM = wxNewId();
+const long ID_LOAD_CHECKPOINT_MENUITEM = wxNewId();
 const long ID_QUIT_MENUITEM = wxNewId();
 
 const long ID_ZOOM_IN_MENUITEM = wxNewId();
@@ -49,6 +56,7 @@ const long ID_AMBIENT_LIGHT_UP_MENUITEM = wxNewId();
 const long ID_AMBIENT_LIGHT_DOWN_MENUITEM = wxNewId();
 const long ID_PAUSE_MENUITEM = wxNewId();
 const long ID_STEP_MENUITEM = wxNewId();
+const long ID_REWIND_MENUITEM = wxNewId();
 const long ID_RESET_VIEW_MENUITEM = wxNewId();
 
 const long ID_MOVE_MENUITEM = wxNewId();
@@ -96,9 +104,12 @@ const long ID_GAME_TIMER = wxNewId();
 const long ID_LOW_FREQUENCY_TIMER = wxNewId();
 const long ID_CHECK_UPDATE_TIMER = wxNewId();
 
-MainFrame::MainFrame(wxApp * mainApp)
+MainFrame::MainFrame(
+    wxApp * mainApp,
+    std::optional<std::filesystem::path> const & stateHashLogFilePath,
+    std::optional<RewindBuffer::Settings> const & rewindSettings)
     : mMainApp(mainApp)
-    , mResourceLoader(new ResourceLoader())
+    , mResourceLoader(new ResourceLoader(StandardSystemPaths::GetInstance().GetUserSettingsGameFolderPath()))
     , mGameController()
     , mSoundController()
     , mToolController()
@@ -226,6 +237,20 @@ MainFrame::MainFrame(wxApp * mainApp)
     fileMenu->Append(saveScreenshotMenuItem);
     Connect(ID_SAVE_SCREENSHOT_MENUITEM, wxEVT_COMMAND_MENU_SELECTED, (wxObjectEventFunction)&MainFrame::OnSaveScreenshotMenuItemSelected);
 
+    wxMenuItem * saveTraceMenuItem = new wxMenuItem(fileMenu, ID_SAVE_TRACE_MENUITEM, _("Save Trace\tCtrl+T"), _("Save a timeline of the most recent frames"), wxITEM_NORMAL);
+    fileMenu->Append(saveTraceMenuItem);
+    Connect(ID_SAVE_TRACE_MENUITEM, wxEVT_COMMAND_MENU_SELECTED, (wxObjectEventFunction)&MainFrame::OnSaveTraceMenuItemSelected);
+
+    fileMenu->Append(new wxMenuItem(fileMenu, wxID_SEPARATOR));
+
+    wxMenuItem * saveCheckpointMenuItem = new wxMenuItem(fileMenu, ID_SAVE_CHECKPOINT_MENUITEM, _("Save Checkpoint\tCtrl+K"), _("Save the complete state of the simulation"), wxITEM_NORMAL);
+    fileMenu->Append(saveCheckpointMenuItem);
+    Connect(ID_SAVE_CHECKPOINT_MENUITEM, wxEVT_COMMAND_MENU_SELECTED, (wxObjectEventFunction)&MainFrame::OnSaveCheckpointMenuItemSelected);
+
+    wxMenuItem * loadCheckpointMenuItem = new wxMenuItem(fileMenu, ID_LOAD_CHECKPOINT_MENUITEM, _("Load Checkpoint"), _("Resume the simulation from a saved checkpoint"), wxITEM_NORMAL);
+    fileMenu->Append(loadCheckpointMenuItem);
+    Connect(ID_LOAD_CHECKPOINT_MENUITEM, wxEVT_COMMAND_MENU_SELECTED, (wxObjectEventFunction)&MainFrame::OnLoadCheckpointMenuItemSelected);
+
     fileMenu->Append(new wxMenuItem(fileMenu, wxID_SEPARATOR));
 
     wxMenuItem* quitMenuItem = new wxMenuItem(fileMenu, ID_QUIT_MENUITEM, _("Quit\tAlt-F4"), _("Quit the application"), wxITEM_NORMAL);
@@ -265,6 +290,11 @@ MainFrame::MainFrame(wxApp * mainApp)
     controlsMenu->Append(mStepMenuItem);
     Connect(ID_STEP_MENUITEM, wxEVT_COMMAND_MENU_SELECTED, (wxObjectEventFunction)&MainFrame::OnStepMenuItemSelected);
 
+    wxMenuItem * rewindMenuItem = new wxMenuItem(controlsMenu, ID_REWIND_MENUITEM, _("Rewind\tBack"), _("Go back one second of simulation"), wxITEM_NORMAL);
+    rewindMenuItem->Enable(!!rewindSettings); // Only when recording
+    controlsMenu->Append(rewindMenuItem);
+    Connect(ID_REWIND_MENUITEM, wxEVT_COMMAND_MENU_SELECTED, (wxObjectEventFunction)&MainFrame::OnRewindMenuItemSelected);
+
     controlsMenu->Append(new wxMenuItem(controlsMenu, wxID_SEPARATOR));
 
     wxMenuItem * resetViewMenuItem = new wxMenuItem(controlsMenu, ID_RESET_VIEW_MENUITEM, _("Reset View\tHOME"), wxEmptyString, wxITEM_NORMAL);
@@ -554,6 +584,24 @@ void MainFrame::OnPostInitializeTrigger(wxTimerEvent & /*event*/)
     mMainApp->Yield();
 
 
+    //
+    // Start creating Sound controller - on a worker thread, as it's all decoding of
+    // sound files, which may proceed while the game controller does its OpenGL work
+    // on this thread
+    //
+
+    auto const startTimestamp = std::chrono::steady_clock::now();
+
+    std::future<std::shared_ptr<SoundController>> soundControllerFuture = std::async(
+        std::launch::async,
+        [resourceLoader = mResourceLoader]()
+        {
+            return std::make_shared<SoundController>(
+                resourceLoader,
+                [](float, std::string const &) {});
+        });
+
+
     //
     // Create Game controller
     //
@@ -571,7 +619,7 @@ void MainFrame::OnPostInitializeTrigger(wxTimerEvent & /*event*/)
             mResourceLoader,
             [&splash, this](float progress, std::string const & message)
             {
-                splash->UpdateProgress(progress / 2.0f, message);
+                splash->UpdateProgress(0.95f * progress, message);
                 this->mMainApp->Yield();
                 this->mMainApp->Yield();
                 this->mMainApp->Yield();
@@ -584,24 +632,36 @@ void MainFrame::OnPostInitializeTrigger(wxTimerEvent & /*event*/)
         return;
     }
 
+    if (!!stateHashLogFilePath)
+    {
+        try
+        {
+            mGameController->StartStateHashLog(*stateHashLogFilePath);
+        }
+        catch (std::exception const & e)
+        {
+            OnError("Error starting the state hash log: " + std::string(e.what()), false);
+        }
+    }
+
+    if (!!rewindSettings)
+    {
+        mGameController->StartRewindRecording(*rewindSettings);
+    }
+
     this->mMainApp->Yield();
 
 
     //
-    // Create Sound controller
+    // Wait for Sound controller
     //
 
+    splash->UpdateProgress(0.95f, "Loading sounds...");
+    this->mMainApp->Yield();
+
     try
     {
-        mSoundController = std::make_shared<SoundController>(
-            mResourceLoader,
-            [&splash, this](float progress, std::string const & message)
-            {
-                splash->UpdateProgress(0.5f + progress / 2.0f, message);
-                this->mMainApp->Yield();
-                this->mMainApp->Yield();
-                this->mMainApp->Yield();
-            });
+        mSoundController = soundControllerFuture.get();
     }
     catch (std::exception const & e)
     {
@@ -610,6 +670,10 @@ void MainFrame::OnPostInitializeTrigger(wxTimerEvent & /*event*/)
         return;
     }
 
+    LogMessage("MainFrame: game and sound controllers created in ",
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTimestamp).count(), "ms");
+
+    splash->UpdateProgress(1.0f, "Loading sounds...");
     this->mMainApp->Yield();
 
 
@@ -1169,6 +1233,154 @@ void MainFrame::OnSaveScreenshotMenuItemSelected(wxCommandEvent & /*event*/)
     }
 }
 
+void MainFrame::OnSaveTraceMenuItemSelected(wxCommandEvent & /*event*/)
+{
+    //
+    // Ensure pictures folder exists
+    //
+
+    assert(!!mUIPreferencesManager);
+    auto const folderPath = mUIPreferencesManager->GetScreenshotsFolderPath();
+
+    if (!std::filesystem::exists(folderPath))
+    {
+        try
+        {
+            std::filesystem::create_directories(folderPath);
+        }
+        catch (std::filesystem::filesystem_error const & fex)
+        {
+            OnError(
+                std::string("Could not save trace to path \"") + folderPath.string() + "\": " + fex.what(),
+                false);
+
+            return;
+        }
+    }
+
+    //
+    // Choose filename
+    //
+
+    std::filesystem::path traceFilePath;
+
+    do
+    {
+        auto now = std::chrono::system_clock::now();
+        auto now_time_t = std::chrono::system_clock::to_time_t(now);
+        auto const tm = std::localtime(&now_time_t);
+
+        std::stringstream ssFilename;
+        ssFilename.fill('0');
+        ssFilename
+            << "Trace_"
+            << std::setw(4) << (1900 + tm->tm_year) << std::setw(2) << (1 + tm->tm_mon) << std::setw(2) << tm->tm_mday
+            << "_"
+            << std::setw(2) << tm->tm_hour << std::setw(2) << tm->tm_min << std::setw(2) << tm->tm_sec
+            << "_"
+            << std::setw(3) << std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch() % std::chrono::seconds(1)).count()
+            << ".json";
+
+        traceFilePath = folderPath / ssFilename.str();
+
+    } while (std::filesystem::exists(traceFilePath));
+
+
+    //
+    // Save trace
+    //
+
+    try
+    {
+        TraceRecorder::GetInstance().WriteChromeTrace(traceFilePath);
+
+        LogMessage("MainFrame: saved trace to \"", traceFilePath.string(), "\"");
+    }
+    catch (GameException const & gex)
+    {
+        OnError(
+            std::string("Could not save trace: ") + gex.what(),
+            false);
+    }
+}
+
+void MainFrame::OnSaveCheckpointMenuItemSelected(wxCommandEvent & /*event*/)
+{
+    //
+    // Choose filename
+    //
+
+    assert(!!mUIPreferencesManager);
+    auto const folderPath = mUIPreferencesManager->GetScreenshotsFolderPath();
+
+    std::filesystem::path checkpointFilePath;
+
+    do
+    {
+        auto now = std::chrono::system_clock::now();
+        auto now_time_t = std::chrono::system_clock::to_time_t(now);
+        auto const tm = std::localtime(&now_time_t);
+
+        std::stringstream ssFilename;
+        ssFilename.fill('0');
+        ssFilename
+            << "Checkpoint_"
+            << std::setw(4) << (1900 + tm->tm_year) << std::setw(2) << (1 + tm->tm_mon) << std::setw(2) << tm->tm_mday
+            << "_"
+            << std::setw(2) << tm->tm_hour << std::setw(2) << tm->tm_min << std::setw(2) << tm->tm_sec
+            << "_"
+            << std::setw(3) << std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch() % std::chrono::seconds(1)).count()
+            << ".fscp";
+
+        checkpointFilePath = folderPath / ssFilename.str();
+
+    } while (std::filesystem::exists(checkpointFilePath));
+
+    //
+    // Save checkpoint
+    //
+
+    assert(!!mGameController);
+    try
+    {
+        mGameController->SaveCheckpoint(checkpointFilePath);
+    }
+    catch (std::exception const & ex)
+    {
+        OnError(
+            std::string("Could not save checkpoint: ") + ex.what(),
+            false);
+    }
+}
+
+void MainFrame::OnLoadCheckpointMenuItemSelected(wxCommandEvent & /*event*/)
+{
+    assert(!!mUIPreferencesManager);
+
+    wxFileDialog openFileDialog(
+        this,
+        _("Load Checkpoint"),
+        mUIPreferencesManager->GetScreenshotsFolderPath().string(),
+        wxEmptyString,
+        _("Checkpoint files (*.fscp)|*.fscp"),
+        wxFD_OPEN | wxFD_FILE_MUST_EXIST);
+
+    if (openFileDialog.ShowModal() != wxID_OK)
+        return;
+
+    ResetState();
+
+    assert(!!mGameController);
+    try
+    {
+        mGameController->LoadCheckpoint(openFileDialog.GetPath().ToStdString());
+    }
+    catch (std::exception const & ex)
+    {
+        OnError(ex.what(), false);
+    }
+}
+
 void MainFrame::OnPauseMenuItemSelected(wxCommandEvent & /*event*/)
 {
     if (mPauseMenuItem->IsChecked())
@@ -1203,6 +1415,27 @@ void MainFrame::OnStepMenuItemSelected(wxCommandEvent & /*event*/)
     mGameController->Update();
 }
 
+void MainFrame::OnRewindMenuItemSelected(wxCommandEvent & /*event*/)
+{
+    assert(!!mGameController);
+    try
+    {
+        auto const result = mGameController->Rewind(1.0f);
+        if (result == RewindResultType::NotRecording)
+        {
+            OnError(
+                "Could not rewind: rewind is not being recorded; start the game with --rewind <seconds>",
+                false);
+        }
+    }
+    catch (std::exception const & ex)
+    {
+        OnError(
+            std::string("Could not rewind: ") + ex.what(),
+            false);
+    }
+}
+
 void MainFrame::OnResetViewMenuItemSelected(wxCommandEvent & /*event*/)
 {
     assert(!!mGameController);
@@ -31,6 +31,7 @@
 
 #include <chrono>
 #include <cstdint>
+#include <filesystem>
 #include <memory>
 #include <optional>
 #include <vector>
@@ -53,7 +54,10 @@ public:
 
 public:
 
-    MainFrame(wxApp * mainApp);
+    MainFrame(
+        wxApp * mainApp,
+        std::optional<std::filesystem::path> const & stateHashLogFilePath,
+        std::optional<RewindBuffer::Settings> const & rewindSettings);
 
     virtual ~MainFrame();
 
@@ -141,10 +145,14 @@ private:
     void OnAmbientLightDownMenuItemSelected(wxCommandEvent& event);
     void OnPauseMenuItemSelected(wxCommandEvent& event);
     void OnStepMenuItemSelected(wxCommandEvent& event);
+    void OnRewindMenuItemSelected(wxCommandEvent& event);
     void OnResetViewMenuItemSelected(wxCommandEvent& event);
     void OnLoadShipMenuItemSelected(wxCommandEvent& event);
     void OnReloadLastShipMenuItemSelected(wxCommandEvent& event);
     void OnSaveScreenshotMenuItemSelected(wxCommandEvent& event);
+    void OnSaveTraceMenuItemSelected(wxCommandEvent& event);
+    void OnSaveCheckpointMenuItemSelected(wxCommandEvent& event);
+    void OnLoadCheckpointMenuItemSelected(wxCommandEvent& event);
 
     void OnMoveMenuItemSelected(wxCommandEvent& event);
     void OnMoveAllMenuItemSelected(wxCommandEvent& event);
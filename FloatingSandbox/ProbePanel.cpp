@@ -33,6 +33,9 @@ ProbePanel::ProbePanel(wxWindow* parent)
 
     mFrameRateProbe = AddScalarTimeSeriesProbe("Frame Rate", 200);
     mURRatioProbe = AddScalarTimeSeriesProbe("U/R Ratio", 200);
+    mUpdateP99Probe = AddScalarTimeSeriesProbe("Update p99", 200);
+    mRenderP99Probe = AddScalarTimeSeriesProbe("Render p99", 200);
+    mHitchesProbe = AddScalarTimeSeriesProbe("Hitches", 200);
 
     mWaterTakenProbe = AddScalarTimeSeriesProbe("Water Inflow", 120);
     mWaterSplashProbe = AddScalarTimeSeriesProbe("Water Splash", 200);
@@ -60,10 +63,16 @@ void ProbePanel::Update()
     {
         mFrameRateProbe->Update();
         mURRatioProbe->Update();
+        mUpdateP99Probe->Update();
+        mRenderP99Probe->Update();
+        mHitchesProbe->Update();
         mWaterTakenProbe->Update();
         mWaterSplashProbe->Update();
         mWindSpeedProbe->Update();
 
+        if (!!mRewindMemoryProbe)
+            mRewindMemoryProbe->Update();
+
         for (auto const & p : mCustomProbes)
         {
             p.second->Update();
@@ -96,10 +105,16 @@ void ProbePanel::OnGameReset()
 {
     mFrameRateProbe->Reset();
     mURRatioProbe->Reset();
+    mUpdateP99Probe->Reset();
+    mRenderP99Probe->Reset();
+    mHitchesProbe->Reset();
     mWaterTakenProbe->Reset();
     mWaterSplashProbe->Reset();
     mWindSpeedProbe->Reset();
 
+    if (!!mRewindMemoryProbe)
+        mRewindMemoryProbe->Reset();
+
     for (auto const & p : mCustomProbes)
     {
         p.second->Reset();
@@ -151,4 +166,28 @@ void ProbePanel::OnUpdateToRenderRatioUpdated(
     float immediateURRatio)
 {
     mURRatioProbe->RegisterSample(immediateURRatio);
-}
\ No newline at end of file
+}
+
+void ProbePanel::OnFrameTimesUpdated(
+    DurationPercentiles const & updateDurations,
+    DurationPercentiles const & renderDurations,
+    size_t hitchCount)
+{
+    mUpdateP99Probe->RegisterSample(updateDurations.P99);
+    mRenderP99Probe->RegisterSample(renderDurations.P99);
+    mHitchesProbe->RegisterSample(static_cast<float>(hitchCount));
+}
+
+void ProbePanel::OnRewindBufferUpdated(
+    float /*duration*/,
+    size_t byteSize,
+    size_t /*maxByteSize*/)
+{
+    if (!mRewindMemoryProbe)
+    {
+        mRewindMemoryProbe = AddScalarTimeSeriesProbe("Rewind MB", 200);
+        mProbesSizer->Layout();
+    }
+
+    mRewindMemoryProbe->RegisterSample(static_cast<float>(byteSize) / (1024.0f * 1024.0f));
+}
@@ -68,6 +68,16 @@ public:
     virtual void OnUpdateToRenderRatioUpdated(
         float immediateURRatio) override;
 
+    virtual void OnFrameTimesUpdated(
+        DurationPercentiles const & updateDurations,
+        DurationPercentiles const & renderDurations,
+        size_t hitchCount) override;
+
+    virtual void OnRewindBufferUpdated(
+        float duration,
+        size_t byteSize,
+        size_t maxByteSize) override;
+
 private:
 
     bool IsActive() const
@@ -89,8 +99,12 @@ private:
 
     std::unique_ptr<ScalarTimeSeriesProbeControl> mFrameRateProbe;
     std::unique_ptr<ScalarTimeSeriesProbeControl> mURRatioProbe;
+    std::unique_ptr<ScalarTimeSeriesProbeControl> mUpdateP99Probe;
+    std::unique_ptr<ScalarTimeSeriesProbeControl> mRenderP99Probe;
+    std::unique_ptr<ScalarTimeSeriesProbeControl> mHitchesProbe;
     std::unique_ptr<ScalarTimeSeriesProbeControl> mWaterTakenProbe;
     std::unique_ptr<ScalarTimeSeriesProbeControl> mWaterSplashProbe;
     std::unique_ptr<ScalarTimeSeriesProbeControl> mWindSpeedProbe;
+    std::unique_ptr<ScalarTimeSeriesProbeControl> mRewindMemoryProbe; // Only when recording for rewind
     std::unordered_map<std::string, std::unique_ptr<ScalarTimeSeriesProbeControl>> mCustomProbes;
 };
@@ -5,12 +5,18 @@
 ***************************************************************************************/
 #include "ShipPreviewPanel.h"
 
+#include "StandardSystemPaths.h"
+
 #include <Game/ImageFileTools.h>
 #include <Game/ShipDefinitionFile.h>
+#include <Game/ShipPreviewCache.h>
 
 #include <GameCore/GameException.h>
 #include <GameCore/Log.h>
 
+#include <algorithm>
+#include <atomic>
+
 wxDEFINE_EVENT(fsEVT_DIR_SCANNED, fsDirScannedEvent);
 wxDEFINE_EVENT(fsEVT_DIR_SCAN_ERROR, fsDirScanErrorEvent);
 wxDEFINE_EVENT(fsEVT_PREVIEW_READY, fsPreviewReadyEvent);
@@ -37,6 +43,7 @@ ShipPreviewPanel::ShipPreviewPanel(
     , mCurrentlyCompletedDirectory()
     // Preview Thread
     , mPreviewThread()
+    , mPreviewCacheFolderPath(StandardSystemPaths::GetInstance().GetUserSettingsGameFolderPath() / "ShipPreviewCache")
     , mPanelToThreadMessage()
     , mPanelToThreadMessageMutex()
     , mPanelToThreadMessageLock(mPanelToThreadMessageMutex, std::defer_lock)
@@ -457,46 +464,132 @@ void ShipPreviewPanel::ScanDirectory(std::filesystem::path const & directoryPath
 
 
     //
-    // Process all files and create previews
+    // Serve all previews we have in the cache
     //
 
+    ShipPreviewCache previewCache(mPreviewCacheFolderPath, directoryPath);
+
+    std::vector<size_t> uncachedShipIndices;
+
     for (size_t iShip = 0; iShip < shipFilepaths.size(); ++iShip)
     {
         // Check whether we have been interrupted
         if (!!mPanelToThreadMessage)
             return;
 
-        try
+        auto shipPreview = previewCache.TryGet(shipFilepaths[iShip]);
+        if (!!shipPreview)
         {
-            // Load preview
-            auto shipPreview = ShipPreview::Load(
-                shipFilepaths[iShip],
-                ImageSize(ShipPreviewControl::ImageWidth, ShipPreviewControl::ImageHeight));
-
             // Fire event
             QueueEvent(
                 new fsPreviewReadyEvent(
                     fsEVT_PREVIEW_READY,
                     this->GetId(),
                     iShip,
-                    std::make_shared<ShipPreview>(std::move(shipPreview))));
+                    std::make_shared<ShipPreview>(std::move(*shipPreview))));
+        }
+        else
+        {
+            uncachedShipIndices.push_back(iShip);
+        }
+    }
+
+    LogMessage("PreviewThread::ScanDirectory(): ", shipFilepaths.size() - uncachedShipIndices.size(), " cached previews, ",
+        uncachedShipIndices.size(), " to be created");
+
 
-            if (isSingleCore && (3 == (iShip % 4)))
+    //
+    // Create all other previews with a pool of workers
+    //
+
+    if (!uncachedShipIndices.empty())
+    {
+        std::atomic<size_t> nextUncachedShipIndex(0);
+
+        auto const worker = [&]()
+        {
+            for (size_t i = nextUncachedShipIndex++; i < uncachedShipIndices.size(); i = nextUncachedShipIndex++)
             {
-                // Give the main thread time to process this
-                std::this_thread::yield();
+                // Check whether we have been interrupted
+                if (!!mPanelToThreadMessage)
+                    return;
+
+                size_t const iShip = uncachedShipIndices[i];
+
+                try
+                {
+                    // Load preview
+                    auto shipPreview = ShipPreview::Load(
+                        shipFilepaths[iShip],
+                        ImageSize(ShipPreviewControl::ImageWidth, ShipPreviewControl::ImageHeight));
+
+                    previewCache.Put(shipFilepaths[iShip], shipPreview);
+
+                    // Fire event
+                    QueueEvent(
+                        new fsPreviewReadyEvent(
+                            fsEVT_PREVIEW_READY,
+                            this->GetId(),
+                            iShip,
+                            std::make_shared<ShipPreview>(std::move(shipPreview))));
+
+                    if (isSingleCore && (3 == (i % 4)))
+                    {
+                        // Give the main thread time to process this
+                        std::this_thread::yield();
+                    }
+                }
+                catch (std::exception const & ex)
+                {
+                    // Fire error event
+                    QueueEvent(
+                        new fsPreviewErrorEvent(
+                            fsEVT_PREVIEW_ERROR,
+                            this->GetId(),
+                            iShip,
+                            ex.what()));
+                }
             }
+        };
+
+        // Leave one core to the main thread
+        size_t const workerThreadCount = std::min(
+            std::min(
+                static_cast<size_t>(std::max(std::thread::hardware_concurrency(), 2u) - 1u),
+                static_cast<size_t>(MaxPreviewWorkerThreads)),
+            uncachedShipIndices.size());
+
+        std::vector<std::thread> workerThreads;
+        for (size_t t = 1; t < workerThreadCount; ++t)
+        {
+            workerThreads.emplace_back(worker);
         }
-        catch (std::exception const & ex)
+
+        // This thread is a worker as well
+        worker();
+
+        for (auto & workerThread : workerThreads)
         {
-            // Fire error event
-            QueueEvent(
-                new fsPreviewErrorEvent(
-                    fsEVT_PREVIEW_ERROR,
-                    this->GetId(),
-                    iShip,
-                    ex.what()));
+            workerThread.join();
         }
+
+        // Check whether we have been interrupted
+        if (!!mPanelToThreadMessage)
+            return;
+    }
+
+
+    //
+    // Persist cache
+    //
+
+    try
+    {
+        previewCache.Save();
+    }
+    catch (std::exception const & ex)
+    {
+        LogMessage("PreviewThread::ScanDirectory(): error saving preview cache: ", ex.what());
     }
 
 
@@ -229,7 +229,8 @@ wxDECLARE_EVENT(fsEVT_DIR_PREVIEW_COMPLETE, fsDirPreviewCompleteEvent);
 /*
  * This panel populates itself with previews of all ships found in a directory.
  * The search for ships and extraction of previews is done by a separate thread,
- * so to not interfere with the UI message pump.
+ * so to not interfere with the UI message pump; previews missing from the
+ * persistent preview cache are extracted by a pool of worker threads.
  */
 class ShipPreviewPanel : public wxScrolled<wxPanel>
 {
@@ -239,6 +240,8 @@ public:
     static constexpr int MinPreviewWidth = ShipPreviewControl::Width + 2 * MinPreviewHGap;
     static constexpr int PreviewVGap = 8;
 
+    static constexpr unsigned int MaxPreviewWorkerThreads = 8;
+
 public:
 
     ShipPreviewPanel(
@@ -300,6 +303,9 @@ private:
     void RunPreviewThread();
     void ScanDirectory(std::filesystem::path const & directoryPath);
 
+    // The folder where we keep the preview cache indices
+    std::filesystem::path const mPreviewCacheFolderPath;
+
 
     //
     // Panel-to-Thread communication
@@ -11,9 +11,12 @@
 #include <GameCore/Log.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <future>
 #include <limits>
 #include <regex>
+#include <thread>
 
 float constexpr SinkingMusicVolume = 80.0f;
 float constexpr RepairVolume = 40.0f;
@@ -22,6 +25,7 @@ float constexpr SawedVolume = 80.0f;
 float constexpr StressSoundVolume = 20.0f;
 std::chrono::milliseconds constexpr SawedInertiaDuration = std::chrono::milliseconds(200);
 float constexpr WaveSplashTriggerSize = 0.5f;
+unsigned int constexpr MaxSoundLoaderThreads = 8;
 
 SoundController::SoundController(
     std::shared_ptr<ResourceLoader> resourceLoader,
@@ -107,24 +111,71 @@ SoundController::SoundController(
 
     auto soundNames = mResourceLoader->GetSoundNames();
 
-    for (size_t i = 0; i < soundNames.size(); ++i)
-    {
-        std::string const & soundName = soundNames[i];
-
-        // Notify progress
-        progressCallback(static_cast<float>(i + 1) / static_cast<float>(soundNames.size()), "Loading sounds...");
+    //
+    // Decode all sound buffers first, on a number of worker threads including
+    // this one; only this thread reports progress
+    //
 
+    auto const startTimestamp = std::chrono::steady_clock::now();
 
-        //
-        // Load sound buffer
-        //
+    std::vector<std::unique_ptr<sf::SoundBuffer>> soundBuffers(soundNames.size());
+    std::atomic<size_t> nextSound(0);
+    std::atomic<size_t> loadedSoundCount(0);
 
-        std::unique_ptr<sf::SoundBuffer> soundBuffer = std::make_unique<sf::SoundBuffer>();
-        if (!soundBuffer->loadFromFile(mResourceLoader->GetSoundFilepath(soundName).string()))
+    auto const soundLoader = [&](bool doReportProgress)
+    {
+        for (size_t i = nextSound.fetch_add(1); i < soundNames.size(); i = nextSound.fetch_add(1))
         {
-            throw GameException("Cannot load sound \"" + soundName + "\"");
+            std::unique_ptr<sf::SoundBuffer> soundBuffer = std::make_unique<sf::SoundBuffer>();
+            if (!soundBuffer->loadFromFile(mResourceLoader->GetSoundFilepath(soundNames[i]).string()))
+            {
+                throw GameException("Cannot load sound \"" + soundNames[i] + "\"");
+            }
+
+            soundBuffers[i] = std::move(soundBuffer);
+
+            size_t const loadedSounds = loadedSoundCount.fetch_add(1) + 1;
+            if (doReportProgress)
+            {
+                progressCallback(static_cast<float>(loadedSounds) / static_cast<float>(soundNames.size()), "Loading sounds...");
+            }
         }
+    };
+
+    size_t const threadCount = static_cast<size_t>(std::clamp(std::thread::hardware_concurrency(), 1u, MaxSoundLoaderThreads));
+    size_t const workerThreadCount = soundNames.size() > 1 ? std::min(soundNames.size(), threadCount) - 1 : 0;
+
+    std::vector<std::future<void>> soundLoaderFutures;
+    for (size_t t = 0; t < workerThreadCount; ++t)
+    {
+        soundLoaderFutures.emplace_back(
+            std::async(
+                std::launch::async,
+                soundLoader,
+                false));
+    }
+
+    soundLoader(true);
+
+    for (auto & soundLoaderFuture : soundLoaderFutures)
+    {
+        // Propagates exceptions
+        soundLoaderFuture.get();
+    }
+
+    LogMessage("SoundController: loaded ", soundNames.size(), " sounds in ",
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTimestamp).count(), "ms");
+
+    //
+    // Classify sounds
+    //
+
+    for (size_t i = 0; i < soundNames.size(); ++i)
+    {
+        std::string const & soundName = soundNames[i];
 
+        std::unique_ptr<sf::SoundBuffer> soundBuffer = std::move(soundBuffers[i]);
+        assert(!!soundBuffer);
 
 
         //
@@ -56,6 +56,11 @@ public:
 
     void OnSpringDestroyed(ElementIndex springElementIndex);
 
+    bool IsEmpty() const
+    {
+        return mCurrentBombs.empty();
+    }
+
     bool ToggleAntiMatterBombAt(
         vec2f const & targetPos,
         GameParameters const & gameParameters)
@@ -5,8 +5,6 @@
 ***************************************************************************************/
 #include "Physics.h"
 
-#include <GameCore/GameRandomEngine.h>
-
 namespace Physics {
 
 constexpr float LampWetFailureWaterThreshold = 0.1f;
@@ -76,6 +74,31 @@ void ElectricalElements::Destroy(ElementIndex electricalElementIndex)
     mIsDeletedBuffer[electricalElementIndex] = true;
 }
 
+size_t ElectricalElements::GetMemoryFootprint() const
+{
+    return
+        mIsDeletedBuffer.GetByteSize()
+        + mPointIndexBuffer.GetByteSize()
+        + mTypeBuffer.GetByteSize()
+        + mLuminiscenceBuffer.GetByteSize()
+        + mLightColorBuffer.GetByteSize()
+        + mLightSpreadBuffer.GetByteSize()
+        + mConnectedElectricalElementsBuffer.GetByteSize()
+        + mElementStateBuffer.GetByteSize()
+        + mAvailableCurrentBuffer.GetByteSize()
+        + mCurrentConnectivityVisitSequenceNumberBuffer.GetByteSize();
+}
+
+void ElectricalElements::SaveState(CheckpointWriter & checkpoint) const
+{
+    VisitState(*this, checkpoint);
+}
+
+void ElectricalElements::LoadState(CheckpointReader & checkpoint)
+{
+    VisitState(*this, checkpoint);
+}
+
 void ElectricalElements::Update(
     GameWallClock::time_point currentWallclockTime,
     SequenceNumber currentConnectivityVisitSequenceNumber,
@@ -160,7 +183,7 @@ void ElectricalElements::RunLampStateMachine(
                 // Transition state, choose whether to A or B
                 lamp.FlickerCounter = 0u;
                 lamp.NextStateTransitionTimePoint = currentWallclockTime + ElementState::LampState::FlickerStartInterval;
-                if (GameRandomEngine::GetInstance().Choose(2) == 0)
+                if (mParentWorld.GetRandomEngine().Choose(2) == 0)
                     lamp.State = ElementState::LampState::StateType::FlickerA;
                 else
                     lamp.State = ElementState::LampState::StateType::FlickerB;
@@ -324,7 +347,7 @@ bool ElectricalElements::CheckWetFailureTime(
     {
         // Sample the CDF
        isFailure =
-            GameRandomEngine::GetInstance().GenerateRandomNormalizedReal()
+            mParentWorld.GetRandomEngine().GenerateRandomNormalizedReal()
             < lamp.WetFailureRateCdf;
 
         // Schedule next check
@@ -334,4 +357,25 @@ bool ElectricalElements::CheckWetFailureTime(
     return isFailure;
 }
 
+template<typename TSelf, typename TArchive>
+void ElectricalElements::VisitState(
+    TSelf & self,
+    TArchive & archive)
+{
+    archive.Visit("IsDeleted", self.mIsDeletedBuffer);
+    archive.Visit("PointIndex", self.mPointIndexBuffer);
+    archive.Visit("Type", self.mTypeBuffer);
+    archive.Visit("Luminiscence", self.mLuminiscenceBuffer);
+    archive.Visit("LightColor", self.mLightColorBuffer);
+    archive.Visit("LightSpread", self.mLightSpreadBuffer);
+    archive.Visit("ConnectedElectricalElements", self.mConnectedElectricalElementsBuffer);
+
+    // Lamp state machines run on the wall clock, hence their time points only
+    // resume exactly in deterministic mode
+    archive.Visit("ElementState", self.mElementStateBuffer);
+
+    archive.Visit("AvailableCurrent", self.mAvailableCurrentBuffer);
+    archive.Visit("CurrentConnectivityVisitSequenceNumber", self.mCurrentConnectivityVisitSequenceNumberBuffer);
+}
+
 }
\ No newline at end of file
@@ -8,6 +8,7 @@
 #include "Materials.h"
 
 #include <GameCore/Buffer.h>
+#include <GameCore/Checkpoint.h>
 #include <GameCore/ElementContainer.h>
 #include <GameCore/GameWallClock.h>
 
@@ -61,6 +62,18 @@ public:
 
     ElectricalElements(ElectricalElements && other) = default;
 
+    /*
+     * Returns the number of bytes currently occupied by all of the buffers of this container.
+     */
+    size_t GetMemoryFootprint() const;
+
+    /*
+     * Saves and restores the state of all electrical elements; the state may only be restored onto
+     * electrical elements built from the same ship definition.
+     */
+    void SaveState(CheckpointWriter & checkpoint) const;
+    void LoadState(CheckpointReader & checkpoint);
+
     /*
      * Returns an iterator for the generator elements only.
      */
@@ -287,6 +300,12 @@ private:
         ElementState::LampState & lamp,
         GameWallClock::time_point currentWallclockTime);
 
+    // Visits the members making up the state, both for saving and for restoring
+    template<typename TSelf, typename TArchive>
+    static void VisitState(
+        TSelf & self,
+        TArchive & archive);
+
 private:
 
     //////////////////////////////////////////////////////////
@@ -11,6 +11,8 @@ namespace Physics {
 
 void DrawForceField::Apply(
     Points & points,
+    StructuralCommandBuffer & /*structuralCommands*/,
+    RandomEngine & /*randomEngine*/,
     float /*currentSimulationTime*/,
     GameParameters const & /*gameParameters*/) const
 {
@@ -23,12 +25,14 @@ void DrawForceField::Apply(
         vec2f displacement = (mCenterPosition - points.GetPosition(pointIndex));
         float forceMagnitude = mStrength / sqrtf(0.1f + displacement.length());
 
-        points.GetForce(pointIndex) += displacement.normalise() * forceMagnitude;
+        points.AddForce(pointIndex, displacement.normalise() * forceMagnitude);
     }
 }
 
 void SwirlForceField::Apply(
     Points & points,
+    StructuralCommandBuffer & /*structuralCommands*/,
+    RandomEngine & /*randomEngine*/,
     float /*currentSimulationTime*/,
     GameParameters const & /*gameParameters*/) const
 {
@@ -42,18 +46,20 @@ void SwirlForceField::Apply(
         float const displacementLength = displacement.length();
         float forceMagnitude = mStrength / sqrtf(0.1f + displacementLength);
 
-        points.GetForce(pointIndex) += vec2f(-displacement.y, displacement.x) * forceMagnitude;
+        points.AddForce(pointIndex, vec2f(-displacement.y, displacement.x) * forceMagnitude);
     }
 }
 
 void BlastForceField::Apply(
     Points & points,
-    float currentSimulationTime,
-    GameParameters const & gameParameters) const
+    StructuralCommandBuffer & structuralCommands,
+    RandomEngine & randomEngine,
+    float /*currentSimulationTime*/,
+    GameParameters const & /*gameParameters*/) const
 {
     //
     // Go through all points and, for each point in radius:
-    // - Keep non-ephemeral point that is closest to blast position; we'll Detach() it later
+    // - Keep non-ephemeral point that is closest to blast position; we'll detach it later
     //   (if this is the fist frame of the blast sequence)
     // - Flip over the point outside of the radius
     //
@@ -81,11 +87,12 @@ void BlastForceField::Apply(
             // Create acceleration to flip the point
             vec2f flippedRadius = pointRadius.normalise() * (mBlastRadius + (mBlastRadius - pointRadius.length()));
             vec2f newPosition = mCenterPosition + flippedRadius;
-            points.GetForce(pointIndex) +=
+            points.AddForce(
+                pointIndex,
                 (newPosition - points.GetPosition(pointIndex))
                 / DtSquared
                 * mStrength
-                * points.GetMass(pointIndex);
+                * points.GetMass(pointIndex));
         }
     }
 
@@ -98,22 +105,22 @@ void BlastForceField::Apply(
         && NoneElementIndex != closestPointIndex)
     {
         // Choose a detach velocity - using the same distribution as Debris
-        vec2f detachVelocity = GameRandomEngine::GetInstance().GenerateRandomRadialVector(
+        vec2f detachVelocity = randomEngine.GenerateRandomRadialVector(
             GameParameters::MinDebrisParticlesVelocity,
             GameParameters::MaxDebrisParticlesVelocity);
 
-        // Detach point
-        points.Detach(
+        // Detach point - once all force fields have been applied
+        structuralCommands.RecordPointDetach(
             closestPointIndex,
             detachVelocity,
-            Points::DetachOptions::GenerateDebris,
-            currentSimulationTime,
-            gameParameters);
+            true); // Generate debris
     }
 }
 
 void RadialSpaceWarpForceField::Apply(
     Points & points,
+    StructuralCommandBuffer & /*structuralCommands*/,
+    RandomEngine & /*randomEngine*/,
     float /*currentSimulationTime*/,
     GameParameters const & /*gameParameters*/) const
 {
@@ -128,16 +135,19 @@ void RadialSpaceWarpForceField::Apply(
 
             float const strength = mStrength * (1.0f - absolutePointDistanceFromRadius / mRadiusThickness);
 
-            points.GetForce(pointIndex) +=
+            points.AddForce(
+                pointIndex,
                 pointRadius.normalise()
                 * strength
-                * direction;
+                * direction);
         }
     }
 }
 
 void ImplosionForceField::Apply(
     Points & points,
+    StructuralCommandBuffer & /*structuralCommands*/,
+    RandomEngine & /*randomEngine*/,
     float /*currentSimulationTime*/,
     GameParameters const & /*gameParameters*/) const
 {
@@ -151,24 +161,28 @@ void ImplosionForceField::Apply(
         float const massNormalization = points.GetMass(pointIndex) / 50.0f;
 
         // Angular (constant)
-        points.GetForce(pointIndex) +=
+        points.AddForce(
+            pointIndex,
             vec2f(-normalizedDisplacement.y, normalizedDisplacement.x)
             * mStrength
             * massNormalization
-            / 10.0f; // Magic number
+            / 10.0f); // Magic number
 
         // Radial (stronger when closer)
-        points.GetForce(pointIndex) +=
+        points.AddForce(
+            pointIndex,
             normalizedDisplacement
             * mStrength
             / (0.2f + sqrt(displacementLength))
             * massNormalization
-            * 10.0f; // Magic number
+            * 10.0f); // Magic number
     }
 }
 
 void RadialExplosionForceField::Apply(
     Points & points,
+    StructuralCommandBuffer & /*structuralCommands*/,
+    RandomEngine & /*randomEngine*/,
     float /*currentSimulationTime*/,
     GameParameters const & /*gameParameters*/) const
 {
@@ -181,7 +195,7 @@ void RadialExplosionForceField::Apply(
         vec2f displacement = (points.GetPosition(pointIndex) - mCenterPosition);
         float forceMagnitude = mStrength / sqrtf(0.1f + displacement.length());
 
-        points.GetForce(pointIndex) += displacement.normalise() * forceMagnitude;
+        points.AddForce(pointIndex, displacement.normalise() * forceMagnitude);
     }
 }
 
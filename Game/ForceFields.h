@@ -7,7 +7,9 @@
 
 #include "GameParameters.h"
 #include "Physics.h"
+#include "StructuralCommandBuffer.h"
 
+#include <GameCore/RandomEngine.h>
 #include <GameCore/Vectors.h>
 
 namespace Physics
@@ -40,6 +42,8 @@ public:
 
     virtual void Apply(
         Points & points,
+        StructuralCommandBuffer & structuralCommands,
+        RandomEngine & randomEngine,
         float currentSimulationTime,
         GameParameters const & gameParameters) const = 0;
 
@@ -81,6 +85,8 @@ public:
 
     virtual void Apply(
         Points & points,
+        StructuralCommandBuffer & structuralCommands,
+        RandomEngine & randomEngine,
         float currentSimulationTime,
         GameParameters const & gameParameters) const override;
 
@@ -117,6 +123,8 @@ public:
 
     virtual void Apply(
         Points & points,
+        StructuralCommandBuffer & structuralCommands,
+        RandomEngine & randomEngine,
         float currentSimulationTime,
         GameParameters const & gameParameters) const override;
 
@@ -147,6 +155,8 @@ public:
 
     virtual void Apply(
         Points & points,
+        StructuralCommandBuffer & structuralCommands,
+        RandomEngine & randomEngine,
         float currentSimulationTime,
         GameParameters const & gameParameters) const override;
 
@@ -179,6 +189,8 @@ public:
 
     virtual void Apply(
         Points & points,
+        StructuralCommandBuffer & structuralCommands,
+        RandomEngine & randomEngine,
         float currentSimulationTime,
         GameParameters const & gameParameters) const override;
 
@@ -208,6 +220,8 @@ public:
 
     virtual void Apply(
         Points & points,
+        StructuralCommandBuffer & structuralCommands,
+        RandomEngine & randomEngine,
         float currentSimulationTime,
         GameParameters const & gameParameters) const override;
 
@@ -234,6 +248,8 @@ public:
 
     virtual void Apply(
         Points & points,
+        StructuralCommandBuffer & structuralCommands,
+        RandomEngine & randomEngine,
         float currentSimulationTime,
         GameParameters const & gameParameters) const override;
 
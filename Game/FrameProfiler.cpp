@@ -0,0 +1,158 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2020-01-06
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "FrameProfiler.h"
+
+#ifdef FRAME_PROFILER
+
+#include <GameCore/Log.h>
+
+#include <cassert>
+#include <iomanip>
+#include <sstream>
+
+namespace /* anonymous */ {
+
+    struct SectionInfo
+    {
+        char const * Name;
+        ProfiledSection Parent; // Same as self for top-level sections
+        bool IsProbed;
+    };
+
+    // In the same order as the enum
+    SectionInfo const SectionInfos[] = {
+        { "Update", ProfiledSection::Update, true },
+        { "Environment", ProfiledSection::Update, false },
+        { "Ships", ProfiledSection::Update, false },
+        { "RotDecay", ProfiledSection::UpdateShip, false },
+        { "Mechanics", ProfiledSection::UpdateShip, true },
+        { "WorldBounds", ProfiledSection::UpdateShip, false },
+        { "Bombs", ProfiledSection::UpdateShip, false },
+        { "Strains", ProfiledSection::UpdateShip, false },
+        { "StructCmds", ProfiledSection::UpdateShip, false },
+        { "Water", ProfiledSection::UpdateShip, true },
+        { "WaterVelocities", ProfiledSection::ShipWaterDynamics, false },
+        { "Electrical", ProfiledSection::UpdateShip, false },
+        { "DiffuseLight", ProfiledSection::ShipElectricalDynamics, false },
+        { "Heat", ProfiledSection::UpdateShip, false },
+        { "Particles", ProfiledSection::UpdateShip, false },
+        { "Rewind", ProfiledSection::Update, false },
+        { "Events", ProfiledSection::Update, false },
+        { "Render", ProfiledSection::Render, true },
+        { "World", ProfiledSection::Render, false },
+        { "Ships", ProfiledSection::RenderWorld, false },
+        { "End", ProfiledSection::Render, false }
+    };
+
+    static_assert(sizeof(SectionInfos) / sizeof(SectionInfo) == static_cast<size_t>(ProfiledSection::_Last) + 1);
+
+    size_t GetSectionDepth(size_t section)
+    {
+        size_t depth = 0;
+        for (size_t p = section; static_cast<size_t>(SectionInfos[p].Parent) != p; p = static_cast<size_t>(SectionInfos[p].Parent))
+        {
+            ++depth;
+        }
+
+        return depth;
+    }
+}
+
+char const * FrameProfiler::GetSectionName(ProfiledSection section)
+{
+    return SectionInfos[static_cast<size_t>(section)].Name;
+}
+
+FrameProfiler::FrameProfiler()
+    : mAccumulatedDurations()
+    , mAccumulatedHardwareCounters()
+    , mLastSampleTimestamp(std::chrono::steady_clock::now())
+    , mHardwareCounters()
+    , mFrameDurations()
+{
+    mAccumulatedDurations.fill(std::chrono::steady_clock::duration::zero());
+    mFrameDurations.fill(std::chrono::steady_clock::duration::zero());
+}
+
+void FrameProfiler::SetHardwareCountersEnabled(bool isEnabled)
+{
+    if (isEnabled && !mHardwareCounters)
+    {
+        auto hardwareCounters = std::make_unique<HardwareCounters>();
+        if (hardwareCounters->IsAvailable())
+        {
+            mHardwareCounters = std::move(hardwareCounters);
+        }
+        else
+        {
+            LogMessage("FrameProfiler: hardware counters are not available, profiling time only");
+        }
+    }
+    else if (!isEnabled)
+    {
+        mHardwareCounters.reset();
+    }
+}
+
+std::vector<std::string> FrameProfiler::GetFrameBreakdown() const
+{
+    std::vector<std::string> lines;
+
+    for (size_t s = 0; s < SectionCount; ++s)
+    {
+        if (mFrameDurations[s] == std::chrono::steady_clock::duration::zero())
+            continue;
+
+        std::ostringstream ss;
+        ss << std::fixed << std::setprecision(2)
+            << std::string(2 * GetSectionDepth(s), ' ')
+            << SectionInfos[s].Name << ": "
+            << std::chrono::duration<float, std::milli>(mFrameDurations[s]).count() << "ms";
+
+        lines.emplace_back(ss.str());
+    }
+
+    return lines;
+}
+
+std::vector<ProfiledSectionStatistics> FrameProfiler::Sample()
+{
+    auto const now = std::chrono::steady_clock::now();
+    float const elapsedMilliseconds = std::chrono::duration<float, std::milli>(now - mLastSampleTimestamp).count();
+    mLastSampleTimestamp = now;
+
+    std::vector<ProfiledSectionStatistics> statistics;
+
+    if (elapsedMilliseconds > 0.0f)
+    {
+        for (size_t s = 0; s < SectionCount; ++s)
+        {
+            float const milliseconds = std::chrono::duration<float, std::milli>(mAccumulatedDurations[s]).count();
+
+            // Parent time
+            size_t const parent = static_cast<size_t>(SectionInfos[s].Parent);
+            float const parentMilliseconds = (parent != s)
+                ? std::chrono::duration<float, std::milli>(mAccumulatedDurations[parent]).count()
+                : elapsedMilliseconds;
+
+            statistics.emplace_back(
+                static_cast<ProfiledSection>(s),
+                SectionInfos[s].Name,
+                GetSectionDepth(s),
+                milliseconds * 1000.0f / elapsedMilliseconds,
+                parentMilliseconds > 0.0f ? milliseconds / parentMilliseconds : 0.0f,
+                mAccumulatedHardwareCounters[s],
+                SectionInfos[s].IsProbed);
+        }
+    }
+
+    mAccumulatedDurations.fill(std::chrono::steady_clock::duration::zero());
+    mAccumulatedHardwareCounters.fill(HardwareCounterValues());
+
+    return statistics;
+}
+
+#endif
@@ -0,0 +1,231 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2020-01-06
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <GameCore/HardwareCounters.h>
+#include <GameCore/TraceRecorder.h>
+
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*
+ * The sections of a frame that are timed, in depth-first order.
+ */
+enum class ProfiledSection : std::uint8_t
+{
+    Update = 0,
+        UpdateWorldEnvironment,
+        UpdateShip,
+            ShipRotAndDecay,
+            ShipMechanicalDynamics,
+            ShipTrimForWorldBounds,
+            ShipBombs,
+            ShipStrains,
+            ShipStructuralCommands,
+            ShipWaterDynamics,
+                ShipWaterVelocities,
+            ShipElectricalDynamics,
+                ShipDiffuseLight,
+            ShipHeatDynamics,
+            ShipEphemeralParticles,
+        UpdateRewindCapture,
+        UpdateEventFlush,
+
+    Render,
+        RenderWorld,
+            RenderShips,
+        RenderEnd,
+
+    _Last = RenderEnd
+};
+
+/*
+ * The time spent in a section since the previous sample.
+ */
+struct ProfiledSectionStatistics
+{
+    ProfiledSection Section;
+    std::string Name;
+    size_t Depth; // Zero for top-level sections
+    float MillisecondsPerSecond; // Of wall-clock time
+    float FractionOfParent; // For top-level sections, fraction of wall-clock time
+    HardwareCounterValues HardwareCounters; // All zero when not counted
+    bool IsProbed; // Whether the section is interesting enough for a probe
+
+    ProfiledSectionStatistics(
+        ProfiledSection section,
+        std::string const & name,
+        size_t depth,
+        float millisecondsPerSecond,
+        float fractionOfParent,
+        HardwareCounterValues const & hardwareCounters,
+        bool isProbed)
+        : Section(section)
+        , Name(name)
+        , Depth(depth)
+        , MillisecondsPerSecond(millisecondsPerSecond)
+        , FractionOfParent(fractionOfParent)
+        , HardwareCounters(hardwareCounters)
+        , IsProbed(isProbed)
+    {}
+};
+
+#ifdef FRAME_PROFILER
+
+/*
+ * Accumulates the time spent in each section of the frames, and optionally the hardware
+ * counters of the main thread.
+ *
+ * Sections are only timed on the main thread; a section running parallel loops is
+ * timed as a whole, from the main thread, and its counters only include the chunks
+ * run by the main thread.
+ *
+ * Singleton.
+ */
+class FrameProfiler
+{
+public:
+
+    static FrameProfiler & GetInstance()
+    {
+        static FrameProfiler * instance = new FrameProfiler();
+
+        return *instance;
+    }
+
+    static char const * GetSectionName(ProfiledSection section);
+
+    /*
+     * Starts or stops counting hardware events in each section; must be invoked on the
+     * main thread. Counting requires two system calls per section.
+     */
+    void SetHardwareCountersEnabled(bool isEnabled);
+
+    inline bool IsHardwareCountersEnabled() const
+    {
+        return !!mHardwareCounters;
+    }
+
+    inline HardwareCounterValues ReadHardwareCounters() const
+    {
+        assert(!!mHardwareCounters);
+        return mHardwareCounters->Read();
+    }
+
+    inline void Accumulate(
+        ProfiledSection section,
+        std::chrono::steady_clock::duration duration,
+        HardwareCounterValues const & hardwareCounters)
+    {
+        mAccumulatedDurations[static_cast<size_t>(section)] += duration;
+        mAccumulatedHardwareCounters[static_cast<size_t>(section)] += hardwareCounters;
+        mFrameDurations[static_cast<size_t>(section)] += duration;
+    }
+
+    /*
+     * Starts timing a new frame, forgetting the breakdown of the previous one.
+     */
+    void StartFrame()
+    {
+        mFrameDurations.fill(std::chrono::steady_clock::duration::zero());
+    }
+
+    /*
+     * Returns one line for each section timed in the current frame, indented by depth.
+     */
+    std::vector<std::string> GetFrameBreakdown() const;
+
+    /*
+     * Returns the statistics of all sections since the previous invocation of this method,
+     * and starts over.
+     */
+    std::vector<ProfiledSectionStatistics> Sample();
+
+private:
+
+    FrameProfiler();
+
+    static size_t constexpr SectionCount = static_cast<size_t>(ProfiledSection::_Last) + 1;
+
+    std::array<std::chrono::steady_clock::duration, SectionCount> mAccumulatedDurations;
+    std::array<HardwareCounterValues, SectionCount> mAccumulatedHardwareCounters;
+    std::chrono::steady_clock::time_point mLastSampleTimestamp;
+
+    std::unique_ptr<HardwareCounters> mHardwareCounters; // Only when enabled and available
+
+    std::array<std::chrono::steady_clock::duration, SectionCount> mFrameDurations;
+};
+
+/*
+ * Times its own lifetime, accumulating it to a section; also counts hardware events
+ * and records a trace event, but only when the profiler's hardware counters and the
+ * trace recorder - respectively - are enabled at the start of the scope.
+ */
+class ScopedProfileTimer
+{
+public:
+
+    explicit ScopedProfileTimer(ProfiledSection section)
+        : mSection(section)
+        , mIsCountingHardware(FrameProfiler::GetInstance().IsHardwareCountersEnabled())
+        , mIsTracing(TraceRecorder::GetInstance().IsEnabled())
+        , mStartHardwareCounters(mIsCountingHardware ? FrameProfiler::GetInstance().ReadHardwareCounters() : HardwareCounterValues())
+        , mStartTimestamp(std::chrono::steady_clock::now())
+    {}
+
+    ~ScopedProfileTimer()
+    {
+        auto const endTimestamp = std::chrono::steady_clock::now();
+
+        auto & profiler = FrameProfiler::GetInstance();
+
+        profiler.Accumulate(
+            mSection,
+            endTimestamp - mStartTimestamp,
+            (mIsCountingHardware && profiler.IsHardwareCountersEnabled())
+                ? profiler.ReadHardwareCounters() - mStartHardwareCounters
+                : HardwareCounterValues());
+
+        if (mIsTracing)
+        {
+            TraceRecorder::GetInstance().RecordEvent(
+                FrameProfiler::GetSectionName(mSection),
+                mStartTimestamp,
+                endTimestamp);
+        }
+    }
+
+    ScopedProfileTimer(ScopedProfileTimer const &) = delete;
+    ScopedProfileTimer & operator=(ScopedProfileTimer const &) = delete;
+
+private:
+
+    ProfiledSection const mSection;
+    bool const mIsCountingHardware;
+    bool const mIsTracing;
+    HardwareCounterValues const mStartHardwareCounters;
+    std::chrono::steady_clock::time_point const mStartTimestamp;
+};
+
+#define PROFILE_SCOPE_CONCAT_INNER(a, b) a##b
+#define PROFILE_SCOPE_CONCAT(a, b) PROFILE_SCOPE_CONCAT_INNER(a, b)
+
+/*
+ * Times the rest of the enclosing scope.
+ */
+#define PROFILE_SCOPE(section) \
+    ScopedProfileTimer const PROFILE_SCOPE_CONCAT(_profileScopeTimer, __LINE__)(ProfiledSection::section)
+
+#else
+
+#define PROFILE_SCOPE(section)
+
+#endif
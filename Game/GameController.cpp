@@ -5,8 +5,15 @@
 ***************************************************************************************/
 #include "GameController.h"
 
+#include "FrameProfiler.h"
+
 #include <GameCore/GameMath.h>
 #include <GameCore/Log.h>
+#include <GameCore/TraceRecorder.h>
+
+#include <chrono>
+#include <future>
+#include <iomanip>
 
 std::unique_ptr<GameController> GameController::Create(
     bool isStatusTextEnabled,
@@ -15,20 +22,52 @@ std::unique_ptr<GameController> GameController::Create(
     std::shared_ptr<ResourceLoader> resourceLoader,
     ProgressCallback const & progressCallback)
 {
-    // Load materials
-    MaterialDatabase materialDatabase = MaterialDatabase::Load(*resourceLoader);
+    TRACE_SCOPE("GameController::Create");
 
-    // Create game dispatcher
-    std::unique_ptr<GameEventDispatcher> gameEventDispatcher = std::make_unique<GameEventDispatcher>();
+    auto const startTimestamp = std::chrono::steady_clock::now();
 
-    // Create render context
-    std::unique_ptr<Render::RenderContext> renderContext = std::make_unique<Render::RenderContext>(
-        *resourceLoader,
-        [&progressCallback](float progress, std::string const & message)
+    // Load materials - on a worker thread, as it's all JSON parsing
+    std::future<MaterialDatabase> materialDatabaseFuture = std::async(
+        std::launch::async,
+        [resourceLoader]()
         {
-            progressCallback(0.9f * progress, message);
+            TRACE_SCOPE("MaterialDatabase::Load");
+
+            auto const taskStartTimestamp = std::chrono::steady_clock::now();
+
+            MaterialDatabase materialDatabase = MaterialDatabase::Load(*resourceLoader);
+
+            LogMessage("GameController: loaded materials in ",
+                std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - taskStartTimestamp).count(), "ms");
+
+            return materialDatabase;
         });
 
+    // Create game dispatcher
+    std::unique_ptr<GameEventDispatcher> gameEventDispatcher = std::make_unique<GameEventDispatcher>();
+
+    // Create render context - on this thread, as it owns the OpenGL context
+    auto const renderContextStartTimestamp = std::chrono::steady_clock::now();
+
+    std::unique_ptr<Render::RenderContext> renderContext;
+
+    {
+        TRACE_SCOPE("RenderContext::RenderContext");
+
+        renderContext = std::make_unique<Render::RenderContext>(
+            *resourceLoader,
+            [&progressCallback](float progress, std::string const & message)
+            {
+                progressCallback(0.9f * progress, message);
+            });
+    }
+
+    LogMessage("GameController: created render context in ",
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - renderContextStartTimestamp).count(), "ms");
+
+    // Wait for materials
+    MaterialDatabase materialDatabase = materialDatabaseFuture.get();
+
     // Create status text
     std::unique_ptr<StatusText> statusText = std::make_unique<StatusText>(
         isStatusTextEnabled,
@@ -38,7 +77,7 @@ std::unique_ptr<GameController> GameController::Create(
     // Create controller
     //
 
-    return std::unique_ptr<GameController>(
+    auto gameController = std::unique_ptr<GameController>(
         new GameController(
             std::move(renderContext),
             std::move(swapRenderBuffersFunction),
@@ -46,6 +85,11 @@ std::unique_ptr<GameController> GameController::Create(
             std::move(statusText),
             std::move(materialDatabase),
             resourceLoader));
+
+    LogMessage("GameController: created in ",
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTimestamp).count(), "ms");
+
+    return gameController;
 }
 
 GameController::GameController(
@@ -58,20 +102,24 @@ GameController::GameController(
     // State
     : mGameParameters()
     , mLastShipLoadedFilepath()
+    , mWorldShipDefinitionFilepaths()
     , mIsPaused(false)
     , mIsMoveToolEngaged(false)
     , mFlameThrowerToRender()
     , mTsunamiNotificationStateMachine()
     // Parameters that we own
     , mShowTsunamiNotifications(true)
+    , mFrameTimeBudget(50.0f)
     // Doers
     , mRenderContext(std::move(renderContext))
     , mSwapRenderBuffersFunction(std::move(swapRenderBuffersFunction))
     , mGameEventDispatcher(std::move(gameEventDispatcher))
     , mResourceLoader(std::move(resourceLoader))
     , mStatusText(std::move(statusText))
+    , mThreadPool(std::make_shared<ThreadPool>(ThreadPool::GetDefaultWorkerCount(), false))
     , mWorld(new Physics::World(
         mGameEventDispatcher,
+        mThreadPool,
         mGameParameters,
         *mResourceLoader))
     , mMaterialDatabase(std::move(materialDatabase))
@@ -96,6 +144,14 @@ GameController::GameController(
     , mLastTotalRenderDuration(std::chrono::steady_clock::duration::zero())
     , mOriginTimestampGame(GameWallClock::time_point::min())
     , mSkippedFirstStatPublishes(0)
+    , mUpdateDurationHistogram()
+    , mRenderDurationHistogram()
+    , mHitchCount(0)
+    , mLastUpdateStructuralChangeCounts()
+    , mLastUpdateEventCount(0)
+    , mWorldStepCount(0)
+    , mStateHashLog()
+    , mRewindBuffer()
 {
     // Register ourselves as event handler for the events we care about
     mGameEventDispatcher->RegisterWavePhenomenaEventHandler(this);
@@ -172,6 +228,7 @@ ShipMetadata GameController::ResetAndLoadShip(std::filesystem::path const & ship
     // Create a new world
     auto newWorld = std::make_unique<Physics::World>(
         mGameEventDispatcher,
+        mThreadPool,
         mGameParameters,
         *mResourceLoader);
 
@@ -206,6 +263,8 @@ ShipMetadata GameController::ResetAndLoadShip(std::filesystem::path const & ship
 
 ShipMetadata GameController::AddShip(std::filesystem::path const & shipDefinitionFilepath)
 {
+    TRACE_SCOPE("GameController::AddShip");
+
     // Load ship definition
     auto shipDefinition = ShipDefinition::Load(shipDefinitionFilepath);
 
@@ -235,9 +294,12 @@ ShipMetadata GameController::AddShip(std::filesystem::path const & shipDefinitio
 
 void GameController::ReloadLastShip()
 {
+    TRACE_SCOPE("GameController::ReloadLastShip");
+
     // Create a new world
     auto newWorld = std::make_unique<Physics::World>(
         mGameEventDispatcher,
+        mThreadPool,
         mGameParameters,
         *mResourceLoader);
 
@@ -268,17 +330,206 @@ void GameController::ReloadLastShip()
         shipId);
 }
 
+void GameController::SaveCheckpoint(std::filesystem::path const & checkpointFilepath)
+{
+    TRACE_SCOPE("GameController::SaveCheckpoint");
+
+    auto const startTimestamp = std::chrono::steady_clock::now();
+
+    assert(!!mWorld);
+    assert(mWorldShipDefinitionFilepaths.size() == mWorld->GetShipCount());
+
+    CheckpointWriter checkpoint;
+
+    // Ships are rebuilt from their definitions at restore time, hence
+    // we only store where to find them
+    checkpoint.SetScope("Game.");
+    checkpoint.Visit("ShipCount", static_cast<std::uint32_t>(mWorldShipDefinitionFilepaths.size()));
+    for (size_t s = 0; s < mWorldShipDefinitionFilepaths.size(); ++s)
+    {
+        checkpoint.Visit("ShipDefinitionFilepath" + std::to_string(s), mWorldShipDefinitionFilepaths[s].string());
+    }
+
+    checkpoint.Visit("WorldStepCount", mWorldStepCount);
+    checkpoint.Visit("WallClockNow", GameWallClock::GetInstance().Now());
+
+    mWorld->SaveState(checkpoint);
+
+    checkpoint.Save(checkpointFilepath);
+
+    LogMessage("GameController: saved checkpoint \"", checkpointFilepath.string(), "\" (",
+        checkpoint.GetByteSize() / 1024, "KB) in ",
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTimestamp).count(), "ms");
+}
+
+RewindResultType GameController::Rewind(float seconds)
+{
+    TRACE_SCOPE("GameController::Rewind");
+
+    if (!mRewindBuffer)
+    {
+        return RewindResultType::NotRecording;
+    }
+
+    assert(!!mWorld);
+
+    std::vector<std::uint8_t> image;
+    auto const frameTime = mRewindBuffer->Restore(
+        mWorld->GetCurrentSimulationTime() - seconds,
+        image);
+
+    if (!frameTime)
+    {
+        // Nothing recorded yet
+        return RewindResultType::NothingRecorded;
+    }
+
+    CheckpointReader checkpoint(image.data(), image.size());
+
+    checkpoint.SetScope("Game.");
+
+    checkpoint.Visit("WorldStepCount", mWorldStepCount);
+
+    GameWallClock::time_point wallClockNow;
+    checkpoint.Visit("WallClockNow", wallClockNow);
+
+    mWorld->LoadState(checkpoint);
+
+    if (GameWallClock::GetInstance().IsDeterministic())
+    {
+        GameWallClock::GetInstance().SetDeterministicNow(wallClockNow);
+    }
+
+    LogMessage("GameController: rewound to ", *frameTime, "s (step ", mWorldStepCount, ")");
+
+    return RewindResultType::Rewound;
+}
+
+ShipMetadata GameController::LoadCheckpoint(std::filesystem::path const & checkpointFilepath)
+{
+    TRACE_SCOPE("GameController::LoadCheckpoint");
+
+    auto const startTimestamp = std::chrono::steady_clock::now();
+
+    CheckpointReader checkpoint(checkpointFilepath);
+
+    checkpoint.SetScope("Game.");
+
+    std::uint32_t shipCount;
+    checkpoint.Visit("ShipCount", shipCount);
+    if (shipCount == 0)
+    {
+        throw std::runtime_error("The checkpoint has no ships");
+    }
+
+    std::uint64_t worldStepCount;
+    checkpoint.Visit("WorldStepCount", worldStepCount);
+
+    GameWallClock::time_point wallClockNow;
+    checkpoint.Visit("WallClockNow", wallClockNow);
+
+    // Create a new world
+    auto newWorld = std::make_unique<Physics::World>(
+        mGameEventDispatcher,
+        mThreadPool,
+        mGameParameters,
+        *mResourceLoader);
+
+    // Rebuild the ships
+    std::vector<std::filesystem::path> shipDefinitionFilepaths;
+    std::vector<ShipDefinition> shipDefinitions;
+    std::vector<ShipId> shipIds;
+    for (std::uint32_t s = 0; s < shipCount; ++s)
+    {
+        std::string shipDefinitionFilepath;
+        checkpoint.Visit("ShipDefinitionFilepath" + std::to_string(s), shipDefinitionFilepath);
+
+        auto shipDefinition = ShipDefinition::Load(shipDefinitionFilepath);
+
+        mRenderContext->ValidateShip(shipDefinition);
+
+        shipIds.push_back(newWorld->AddShip(
+            shipDefinition,
+            mMaterialDatabase,
+            mGameParameters));
+
+        shipDefinitionFilepaths.emplace_back(shipDefinitionFilepath);
+        shipDefinitions.emplace_back(std::move(shipDefinition));
+    }
+
+    // Restore the state
+    newWorld->LoadState(checkpoint);
+
+    //
+    // No errors, so we may continue
+    //
+
+    ShipMetadata shipMetadata(shipDefinitions.front().Metadata);
+
+    // Time points in the checkpoint only make sense on the deterministic clock
+    if (GameWallClock::GetInstance().IsDeterministic())
+    {
+        GameWallClock::GetInstance().SetDeterministicNow(wallClockNow);
+    }
+
+    Reset(std::move(newWorld));
+
+    mWorldStepCount = worldStepCount;
+
+    for (size_t s = 0; s < shipDefinitions.size(); ++s)
+    {
+        OnShipAdded(
+            std::move(shipDefinitions[s]),
+            shipDefinitionFilepaths[s],
+            shipIds[s]);
+    }
+
+    LogMessage("GameController: loaded checkpoint \"", checkpointFilepath.string(), "\" in ",
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTimestamp).count(), "ms",
+        GameWallClock::GetInstance().IsDeterministic() ? "" : " (not in deterministic mode: timers restart from now)");
+
+    return shipMetadata;
+}
+
 RgbImageData GameController::TakeScreenshot()
 {
     return mRenderContext->TakeScreenshot();
 }
 
+void GameController::StartStateHashLog(std::filesystem::path const & filePath)
+{
+    mStateHashLog.open(filePath, std::ios::out | std::ios::trunc);
+    if (!mStateHashLog.is_open())
+    {
+        throw std::runtime_error("Cannot open state hash log file \"" + filePath.string() + "\"");
+    }
+
+    LogMessage("GameController: logging state hashes to \"", filePath.string(), "\"",
+        GameWallClock::GetInstance().IsDeterministic() ? "" : " (not in deterministic mode: hashes are not reproducible)");
+}
+
+void GameController::StartRewindRecording(RewindBuffer::Settings const & settings)
+{
+    mRewindBuffer = std::make_unique<RewindBuffer>(settings);
+
+    LogMessage("GameController: recording ", settings.Duration, "s for rewind, within ",
+        settings.MaxByteSize / (1024 * 1024), "MB");
+}
+
 void GameController::RunGameIteration()
 {
+#ifdef FRAME_PROFILER
+    FrameProfiler::GetInstance().StartFrame();
+#endif
+
     ///////////////////////////////////////////////////////////
     // Update simulation
     ///////////////////////////////////////////////////////////
 
+    auto updateDuration = std::chrono::steady_clock::duration::zero();
+    mLastUpdateStructuralChangeCounts = Physics::StructuralChangeCounts();
+    mLastUpdateEventCount = 0;
+
     // Make sure we're not paused
     if (!mIsPaused && !mIsMoveToolEngaged)
     {
@@ -287,7 +538,16 @@ void GameController::RunGameIteration()
         InternalUpdate();
 
         auto const endTime = std::chrono::steady_clock::now();
-        mTotalUpdateDuration += endTime - startTime;
+        updateDuration = endTime - startTime;
+        mTotalUpdateDuration += updateDuration;
+
+        mUpdateDurationHistogram.Record(updateDuration);
+    }
+    else
+    {
+        // Publish the events fired by tools - e.g. destroys - while we're not updating,
+        // as they would otherwise only reach the sinks all at once when we resume
+        mLastUpdateEventCount = mGameEventDispatcher->Flush();
     }
 
 
@@ -331,7 +591,8 @@ void GameController::RunGameIteration()
     InternalRender();
 
     auto const endTime = std::chrono::steady_clock::now();
-    mTotalRenderDuration += endTime - startTime;
+    auto const renderDuration = endTime - startTime;
+    mTotalRenderDuration += renderDuration;
 
 
     //
@@ -340,6 +601,15 @@ void GameController::RunGameIteration()
 
     ++mTotalFrameCount;
     ++mLastFrameCount;
+
+    mRenderDurationHistogram.Record(renderDuration);
+
+    if (std::chrono::duration<float, std::milli>(updateDuration + renderDuration).count() > mFrameTimeBudget)
+    {
+        ++mHitchCount;
+
+        ReportHitch(updateDuration, renderDuration);
+    }
 }
 
 void GameController::LowFrequencyUpdate()
@@ -889,6 +1159,16 @@ void GameController::OnTsunami(float x)
 
 void GameController::InternalUpdate()
 {
+    PROFILE_SCOPE(Update);
+
+    // In deterministic mode time only moves with the simulation
+    if (GameWallClock::GetInstance().IsDeterministic())
+    {
+        GameWallClock::GetInstance().Advance(
+            std::chrono::duration_cast<GameWallClock::duration>(
+                std::chrono::duration<float>(GameParameters::SimulationStepTimeDuration<float>)));
+    }
+
     auto now = GameWallClock::GetInstance().Now();
 
     // Update parameter smoothers
@@ -906,8 +1186,29 @@ void GameController::InternalUpdate()
         mGameParameters,
         *mRenderContext);
 
+    // Remember the structural changes, for hitch reports
+    mLastUpdateStructuralChangeCounts = mWorld->ConsumeStructuralChangeCounts();
+
+    ++mWorldStepCount;
+
+    if (mStateHashLog.is_open())
+    {
+        mStateHashLog << mWorldStepCount << ' '
+            << std::hex << std::setw(16) << std::setfill('0') << mWorld->CalculateStateHash()
+            << std::dec << std::setfill(' ') << '\n';
+    }
+
+    if (!!mRewindBuffer)
+    {
+        CaptureRewindFrame();
+    }
+
     // Flush events
-    mGameEventDispatcher->Flush();
+    {
+        PROFILE_SCOPE(UpdateEventFlush);
+
+        mLastUpdateEventCount = mGameEventDispatcher->Flush();
+    }
 
     // Update own state
     if (!!mTsunamiNotificationStateMachine)
@@ -919,6 +1220,8 @@ void GameController::InternalUpdate()
 
 void GameController::InternalRender()
 {
+    PROFILE_SCOPE(Render);
+
     //
     // Do zoom smoothing
     //
@@ -968,8 +1271,12 @@ void GameController::InternalRender()
     // Render world
     //
 
-    assert(!!mWorld);
-    mWorld->Render(mGameParameters, *mRenderContext);
+    {
+        PROFILE_SCOPE(RenderWorld);
+
+        assert(!!mWorld);
+        mWorld->Render(mGameParameters, *mRenderContext);
+    }
 
 
     //
@@ -997,7 +1304,11 @@ void GameController::InternalRender()
     // Finish rendering
     //
 
-    mRenderContext->RenderEnd();
+    {
+        PROFILE_SCOPE(RenderEnd);
+
+        mRenderContext->RenderEnd();
+    }
 }
 
 void GameController::SmoothToTarget(
@@ -1035,6 +1346,11 @@ void GameController::Reset(std::unique_ptr<Physics::World> newWorld)
 
     // Reset state
     mTsunamiNotificationStateMachine.reset();
+    mWorldStepCount = 0;
+    mWorldShipDefinitionFilepaths.clear();
+
+    if (!!mRewindBuffer)
+        mRewindBuffer->Clear();
 
     // Reset rendering engine
     assert(!!mRenderContext);
@@ -1064,6 +1380,44 @@ void GameController::OnShipAdded(
 
     // Remember last loaded ship
     mLastShipLoadedFilepath = shipDefinitionFilepath;
+    mWorldShipDefinitionFilepaths.push_back(shipDefinitionFilepath);
+
+    // Earlier states do not have this ship
+    if (!!mRewindBuffer)
+        mRewindBuffer->Clear();
+}
+
+void GameController::CaptureRewindFrame()
+{
+    PROFILE_SCOPE(UpdateRewindCapture);
+
+    assert(!!mRewindBuffer);
+
+    if (!mWorld->CanSaveState())
+    {
+        // The state cannot be captured at the moment, e.g. there are bombs
+        return;
+    }
+
+    std::vector<std::uint8_t> image;
+    if (!mRewindBuffer->TryAcquireImage(image))
+    {
+        // The encoder is behind, skip this step
+        return;
+    }
+
+    // Serialize straight into the image
+    CheckpointWriter checkpoint(image);
+
+    checkpoint.SetScope("Game.");
+    checkpoint.Visit("WorldStepCount", mWorldStepCount);
+    checkpoint.Visit("WallClockNow", GameWallClock::GetInstance().Now());
+
+    mWorld->SaveState(checkpoint);
+
+    checkpoint.Finish();
+
+    mRewindBuffer->Push(mWorld->GetCurrentSimulationTime(), std::move(image));
 }
 
 void GameController::PublishStats(std::chrono::steady_clock::time_point nowReal)
@@ -1107,6 +1461,45 @@ void GameController::PublishStats(std::chrono::steady_clock::time_point nowReal)
     assert(!!mGameEventDispatcher);
     mGameEventDispatcher->OnUpdateToRenderRatioUpdated(lastURRatio);
 
+    // Publish frame time percentiles, and start over
+    assert(!!mGameEventDispatcher);
+    mGameEventDispatcher->OnFrameTimesUpdated(
+        mUpdateDurationHistogram.GetPercentiles(),
+        mRenderDurationHistogram.GetPercentiles(),
+        mHitchCount);
+
+    mUpdateDurationHistogram.Reset();
+    mRenderDurationHistogram.Reset();
+    mHitchCount = 0;
+
+    // Publish rewind buffer
+    if (!!mRewindBuffer)
+    {
+        auto const rewindStatistics = mRewindBuffer->GetStatistics();
+
+        assert(!!mGameEventDispatcher);
+        mGameEventDispatcher->OnRewindBufferUpdated(
+            rewindStatistics.Duration,
+            rewindStatistics.ByteSize,
+            mRewindBuffer->GetSettings().MaxByteSize);
+    }
+
+    // Sample frame profile
+#ifdef FRAME_PROFILER
+    std::vector<ProfiledSectionStatistics> const frameProfile = FrameProfiler::GetInstance().Sample();
+
+    // Publish the most significant sections as probes
+    for (auto const & section : frameProfile)
+    {
+        if (section.IsProbed)
+        {
+            mGameEventDispatcher->OnCustomProbe("Prf " + section.Name, section.MillisecondsPerSecond);
+        }
+    }
+#else
+    std::vector<ProfiledSectionStatistics> const frameProfile;
+#endif
+
     // Update status text
     assert(!!mStatusText);
     mStatusText->SetText(
@@ -1118,7 +1511,29 @@ void GameController::PublishStats(std::chrono::steady_clock::time_point nowReal)
         mRenderContext->GetCameraWorldPosition(),
         totalURRatio,
         lastURRatio,
-        mRenderContext->GetStatistics());
+        mRenderContext->GetStatistics(),
+        mThreadPool->GetUtilizationStatistics(),
+        frameProfile);
+}
+
+void GameController::ReportHitch(
+    std::chrono::steady_clock::duration updateDuration,
+    std::chrono::steady_clock::duration renderDuration) const
+{
+    LogMessage("GameController: hitch: iteration took ",
+        std::chrono::duration<float, std::milli>(updateDuration + renderDuration).count(), "ms (update ",
+        std::chrono::duration<float, std::milli>(updateDuration).count(), "ms, render ",
+        std::chrono::duration<float, std::milli>(renderDuration).count(), "ms) against a budget of ",
+        mFrameTimeBudget, "ms; springs broken: ", mLastUpdateStructuralChangeCounts.BrokenSprings,
+        ", points detached: ", mLastUpdateStructuralChangeCounts.DetachedPoints,
+        ", events dispatched: ", mLastUpdateEventCount);
+
+#ifdef FRAME_PROFILER
+    for (auto const & line : FrameProfiler::GetInstance().GetFrameBreakdown())
+    {
+        LogMessage("GameController: hitch:   ", line);
+    }
+#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////
@@ -17,16 +17,20 @@
 #include "StatusText.h"
 
 #include <GameCore/Colors.h>
+#include <GameCore/DurationHistogram.h>
 #include <GameCore/GameTypes.h>
 #include <GameCore/GameWallClock.h>
 #include <GameCore/ImageData.h>
 #include <GameCore/ProgressCallback.h>
+#include <GameCore/RewindBuffer.h>
+#include <GameCore/ThreadPool.h>
 #include <GameCore/Vectors.h>
 
 #include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <filesystem>
+#include <fstream>
 #include <functional>
 #include <memory>
 #include <string>
@@ -94,6 +98,10 @@ public:
     ShipMetadata AddShip(std::filesystem::path const & shipDefinitionFilepath) override;
     void ReloadLastShip() override;
 
+    void SaveCheckpoint(std::filesystem::path const & checkpointFilepath) override;
+    ShipMetadata LoadCheckpoint(std::filesystem::path const & checkpointFilepath) override;
+    RewindResultType Rewind(float seconds) override;
+
     RgbImageData TakeScreenshot() override;
 
     void RunGameIteration() override;
@@ -440,6 +448,28 @@ public:
     bool GetShowTsunamiNotifications() const override { return mShowTsunamiNotifications; }
     void SetShowTsunamiNotifications(bool value) override { mShowTsunamiNotifications = value; }
 
+    //
+    // Diagnostics parameters
+    //
+
+    float GetFrameTimeBudget() const override { return mFrameTimeBudget; }
+    void SetFrameTimeBudget(float value) override { mFrameTimeBudget = value; }
+
+public:
+
+    /*
+     * Starts writing the hash of the state of the world after each simulation step
+     * to the specified file, as "<step> <hash>" lines, for comparing two runs in
+     * deterministic mode; steps are counted from the creation of the current world.
+     */
+    void StartStateHashLog(std::filesystem::path const & filePath);
+
+    /*
+     * Starts keeping the state of the world after each simulation step in a rewind
+     * buffer, so that Rewind() may resume the simulation from an earlier step.
+     */
+    void StartRewindRecording(RewindBuffer::Settings const & settings);
+
 private:
 
     GameController(
@@ -469,8 +499,14 @@ private:
         std::filesystem::path const & shipDefinitionFilepath,
         ShipId shipId);
 
+    void CaptureRewindFrame();
+
     void PublishStats(std::chrono::steady_clock::time_point nowReal);
 
+    void ReportHitch(
+        std::chrono::steady_clock::duration updateDuration,
+        std::chrono::steady_clock::duration renderDuration) const;
+
 private:
 
     //
@@ -479,6 +515,7 @@ private:
 
     GameParameters mGameParameters;
     std::filesystem::path mLastShipLoadedFilepath;
+    std::vector<std::filesystem::path> mWorldShipDefinitionFilepaths; // For checkpoints, in ship ID order
     bool mIsPaused;
     bool mIsMoveToolEngaged;
 
@@ -525,6 +562,7 @@ private:
     //
 
     bool mShowTsunamiNotifications;
+    float mFrameTimeBudget;
 
 
     //
@@ -536,6 +574,7 @@ private:
     std::shared_ptr<GameEventDispatcher> mGameEventDispatcher;
     std::shared_ptr<ResourceLoader> mResourceLoader;
     std::shared_ptr<StatusText> mStatusText;
+    std::shared_ptr<ThreadPool> mThreadPool;
 
 
     //
@@ -676,4 +715,30 @@ private:
     std::chrono::steady_clock::duration mLastTotalRenderDuration;
     GameWallClock::time_point mOriginTimestampGame;
     int mSkippedFirstStatPublishes;
+
+    // Durations of the individual iterations since the last publish
+    DurationHistogram mUpdateDurationHistogram;
+    DurationHistogram mRenderDurationHistogram;
+    size_t mHitchCount;
+
+    // What happened during the last update, for hitch reports
+    Physics::StructuralChangeCounts mLastUpdateStructuralChangeCounts;
+    size_t mLastUpdateEventCount;
+
+    //
+    // State hashes
+    //
+
+    // The number of steps simulated in the current world
+    std::uint64_t mWorldStepCount;
+
+    // Open when the state hashes are being logged
+    std::ofstream mStateHashLog;
+
+    //
+    // Rewind
+    //
+
+    // Set when recording for rewind
+    std::unique_ptr<RewindBuffer> mRewindBuffer;
 };
@@ -6,13 +6,30 @@
 #pragma once
 
 #include "GameEventHandlers.h"
+#include "GameEventRecordBuffer.h"
 
 #include <GameCore/TupleKeys.h>
 
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <thread>
 #include <vector>
 
+/*
+ * Dispatches game events to the registered sinks.
+ *
+ * High-frequency events - stress, breaks, destroys, repairs, and light flickers - may be
+ * fired by any thread, also from within parallel loops: each thread records them into its
+ * own buffer, without locking, and the buffers are only aggregated and dispatched at Flush(),
+ * which the game controller invokes once per frame - also while the simulation is paused.
+ *
+ * All other events are dispatched - or aggregated - on the calling thread, and may only be
+ * fired by the main thread.
+ */
 class GameEventDispatcher
     : public ILifecycleGameEventHandler
     , public IStructuralGameEventHandler
@@ -23,11 +40,10 @@ class GameEventDispatcher
 public:
 
     GameEventDispatcher()
-        : mSpringRepairedEvents()
-        , mTriangleRepairedEvents()
-        , mStressEvents()
-        , mBreakEvents()
-        , mLightFlickerEvents()
+        : mId(NextId.fetch_add(1, std::memory_order_relaxed))
+        , mRecordBuffers()
+        , mRecordBuffersMutex()
+        , mRecordedEvents()
         , mBombExplosionEvents()
         , mRCBombPingEvents()
         , mTimerBombDefusedEvents()
@@ -88,17 +104,17 @@ public:
     virtual void OnStress(
         StructuralMaterial const & structuralMaterial,
         bool isUnderwater,
-        unsigned int size) override
+        unsigned int size) override final
     {
-        mStressEvents[std::make_tuple(&structuralMaterial, isUnderwater)] += size;
+        RecordEvent(GameEventKey::EventType::Stress, &structuralMaterial, isUnderwater, size);
     }
 
     virtual void OnBreak(
         StructuralMaterial const & structuralMaterial,
         bool isUnderwater,
-        unsigned int size) override
+        unsigned int size) override final
     {
-        mBreakEvents[std::make_tuple(&structuralMaterial, isUnderwater)] += size;
+        RecordEvent(GameEventKey::EventType::Break, &structuralMaterial, isUnderwater, size);
     }
 
     //
@@ -147,6 +163,34 @@ public:
         }
     }
 
+    virtual void OnFrameTimesUpdated(
+        DurationPercentiles const & updateDurations,
+        DurationPercentiles const & renderDurations,
+        size_t hitchCount) override
+    {
+        for (auto sink : mStatisticsSinks)
+        {
+            sink->OnFrameTimesUpdated(
+                updateDurations,
+                renderDurations,
+                hitchCount);
+        }
+    }
+
+    virtual void OnRewindBufferUpdated(
+        float duration,
+        size_t byteSize,
+        size_t maxByteSize) override
+    {
+        for (auto sink : mStatisticsSinks)
+        {
+            sink->OnRewindBufferUpdated(
+                duration,
+                byteSize,
+                maxByteSize);
+        }
+    }
+
     //
     // Generic
     //
@@ -154,29 +198,25 @@ public:
     virtual void OnDestroy(
         StructuralMaterial const & structuralMaterial,
         bool isUnderwater,
-        unsigned int size) override
+        unsigned int size) override final
     {
-        // No need to aggregate this one
-        for (auto sink : mGenericSinks)
-        {
-            sink->OnDestroy(structuralMaterial, isUnderwater, size);
-        }
+        RecordEvent(GameEventKey::EventType::Destroy, &structuralMaterial, isUnderwater, size);
     }
 
     virtual void OnSpringRepaired(
         StructuralMaterial const & structuralMaterial,
         bool isUnderwater,
-        unsigned int size) override
+        unsigned int size) override final
     {
-        mSpringRepairedEvents[std::make_tuple(&structuralMaterial, isUnderwater)] += size;
+        RecordEvent(GameEventKey::EventType::SpringRepaired, &structuralMaterial, isUnderwater, size);
     }
 
     virtual void OnTriangleRepaired(
         StructuralMaterial const & structuralMaterial,
         bool isUnderwater,
-        unsigned int size) override
+        unsigned int size) override final
     {
-        mTriangleRepairedEvents[std::make_tuple(&structuralMaterial, isUnderwater)] += size;
+        RecordEvent(GameEventKey::EventType::TriangleRepaired, &structuralMaterial, isUnderwater, size);
     }
 
     virtual void OnSawed(
@@ -204,9 +244,13 @@ public:
     virtual void OnLightFlicker(
         DurationShortLongType duration,
         bool isUnderwater,
-        unsigned int size) override
+        unsigned int size) override final
     {
-        mLightFlickerEvents[std::make_tuple(duration, isUnderwater)] += size;
+        RecordEvent(
+            GameEventKey::EventType::LightFlicker,
+            static_cast<std::uintptr_t>(duration),
+            isUnderwater,
+            size);
     }
 
     virtual void OnWaterTaken(float waterTaken) override
@@ -362,47 +406,38 @@ public:
 public:
 
     /*
-     * Flushes all events aggregated so far and clears the state.
+     * Publishes all the events aggregated so far, returning the number of events that
+     * had been fired.
      */
-    void Flush()
+    size_t Flush()
     {
+        size_t eventCount = 0;
+
         //
-        // Publish aggregations
+        // Aggregate recorded events
         //
 
-        for (auto * sink : mStructuralSinks)
         {
-            for (auto const & entry : mStressEvents)
-            {
-                sink->OnStress(*(std::get<0>(entry.first)), std::get<1>(entry.first), entry.second);
-            }
+            std::lock_guard<std::mutex> lock(mRecordBuffersMutex);
 
-            for (auto const & entry : mBreakEvents)
+            for (auto & recordBuffer : mRecordBuffers)
             {
-                sink->OnBreak(*(std::get<0>(entry.first)), std::get<1>(entry.first), entry.second);
+                eventCount += recordBuffer.Buffer->DrainInto(mRecordedEvents);
             }
         }
 
-        mStressEvents.clear();
-        mBreakEvents.clear();
-
-        for (auto * sink : mGenericSinks)
-        {
-            for (auto const & entry : mSpringRepairedEvents)
-            {
-                sink->OnSpringRepaired(*(std::get<0>(entry.first)), std::get<1>(entry.first), entry.second);
-            }
-
-            for (auto const & entry : mTriangleRepairedEvents)
-            {
-                sink->OnTriangleRepaired(*(std::get<0>(entry.first)), std::get<1>(entry.first), entry.second);
-            }
+        //
+        // Publish aggregations
+        //
 
-            for (auto const & entry : mLightFlickerEvents)
+        mRecordedEvents.ForEachAndClear(
+            [this](GameEventKey const & key, unsigned int size)
             {
-                sink->OnLightFlicker(std::get<0>(entry.first), std::get<1>(entry.first), entry.second);
-            }
+                PublishRecordedEvent(key, size);
+            });
 
+        for (auto * sink : mGenericSinks)
+        {
             for (auto const & entry : mBombExplosionEvents)
             {
                 sink->OnBombExplosion(std::get<0>(entry.first), std::get<1>(entry.first), entry.second);
@@ -419,13 +454,13 @@ public:
             }
         }
 
-        mSpringRepairedEvents.clear();
-        mTriangleRepairedEvents.clear();
-        mLightFlickerEvents.clear();
+        eventCount += mBombExplosionEvents.size() + mRCBombPingEvents.size() + mTimerBombDefusedEvents.size();
+
         mBombExplosionEvents.clear();
         mRCBombPingEvents.clear();
         mTimerBombDefusedEvents.clear();
-        mTimerBombDefusedEvents.clear();
+
+        return eventCount;
     }
 
     void RegisterLifecycleEventHandler(ILifecycleGameEventHandler * sink)
@@ -455,12 +490,150 @@ public:
 
 private:
 
+    void RecordEvent(
+        GameEventKey::EventType type,
+        StructuralMaterial const * structuralMaterial,
+        bool isUnderwater,
+        unsigned int size)
+    {
+        RecordEvent(
+            type,
+            reinterpret_cast<std::uintptr_t>(structuralMaterial),
+            isUnderwater,
+            size);
+    }
+
+    void RecordEvent(
+        GameEventKey::EventType type,
+        std::uintptr_t subject,
+        bool isUnderwater,
+        unsigned int size)
+    {
+        GetThreadRecordBuffer().Record(
+            GameEventKey(subject, type, isUnderwater),
+            size);
+    }
+
+    GameEventRecordBuffer & GetThreadRecordBuffer()
+    {
+        // Remembers the buffer of the last dispatcher used by this thread
+        thread_local std::uint64_t cachedDispatcherId = 0;
+        thread_local GameEventRecordBuffer * cachedBuffer = nullptr;
+
+        if (cachedDispatcherId != mId)
+        {
+            std::lock_guard<std::mutex> lock(mRecordBuffersMutex);
+
+            auto const threadId = std::this_thread::get_id();
+
+            auto it = std::find_if(
+                mRecordBuffers.begin(),
+                mRecordBuffers.end(),
+                [&threadId](ThreadRecordBuffer const & recordBuffer)
+                {
+                    return recordBuffer.ThreadId == threadId;
+                });
+
+            if (it == mRecordBuffers.end())
+            {
+                mRecordBuffers.push_back({ threadId, std::make_unique<GameEventRecordBuffer>() });
+                it = std::prev(mRecordBuffers.end());
+            }
+
+            cachedDispatcherId = mId;
+            cachedBuffer = it->Buffer.get();
+        }
+
+        return *cachedBuffer;
+    }
+
+    void PublishRecordedEvent(
+        GameEventKey const & key,
+        unsigned int size)
+    {
+        switch (key.Type)
+        {
+            case GameEventKey::EventType::Stress:
+            {
+                for (auto * sink : mStructuralSinks)
+                {
+                    sink->OnStress(*reinterpret_cast<StructuralMaterial const *>(key.Subject), key.IsUnderwater, size);
+                }
+
+                break;
+            }
+
+            case GameEventKey::EventType::Break:
+            {
+                for (auto * sink : mStructuralSinks)
+                {
+                    sink->OnBreak(*reinterpret_cast<StructuralMaterial const *>(key.Subject), key.IsUnderwater, size);
+                }
+
+                break;
+            }
+
+            case GameEventKey::EventType::Destroy:
+            {
+                for (auto * sink : mGenericSinks)
+                {
+                    sink->OnDestroy(*reinterpret_cast<StructuralMaterial const *>(key.Subject), key.IsUnderwater, size);
+                }
+
+                break;
+            }
+
+            case GameEventKey::EventType::SpringRepaired:
+            {
+                for (auto * sink : mGenericSinks)
+                {
+                    sink->OnSpringRepaired(*reinterpret_cast<StructuralMaterial const *>(key.Subject), key.IsUnderwater, size);
+                }
+
+                break;
+            }
+
+            case GameEventKey::EventType::TriangleRepaired:
+            {
+                for (auto * sink : mGenericSinks)
+                {
+                    sink->OnTriangleRepaired(*reinterpret_cast<StructuralMaterial const *>(key.Subject), key.IsUnderwater, size);
+                }
+
+                break;
+            }
+
+            case GameEventKey::EventType::LightFlicker:
+            {
+                for (auto * sink : mGenericSinks)
+                {
+                    sink->OnLightFlicker(static_cast<DurationShortLongType>(key.Subject), key.IsUnderwater, size);
+                }
+
+                break;
+            }
+        }
+    }
+
+private:
+
+    // Dispatcher IDs start at 1, so that 0 never matches a thread's cached dispatcher
+    static inline std::atomic<std::uint64_t> NextId{ 1 };
+
+    std::uint64_t const mId;
+
+    // The buffers of all threads that have recorded events with this dispatcher
+    struct ThreadRecordBuffer
+    {
+        std::thread::id ThreadId;
+        std::unique_ptr<GameEventRecordBuffer> Buffer;
+    };
+
+    std::vector<ThreadRecordBuffer> mRecordBuffers;
+    std::mutex mRecordBuffersMutex;
+
     // The current events being aggregated
-    unordered_tuple_map<std::tuple<StructuralMaterial const *, bool>, unsigned int> mSpringRepairedEvents;
-    unordered_tuple_map<std::tuple<StructuralMaterial const *, bool>, unsigned int> mTriangleRepairedEvents;
-    unordered_tuple_map<std::tuple<StructuralMaterial const *, bool>, unsigned int> mStressEvents;
-    unordered_tuple_map<std::tuple<StructuralMaterial const *, bool>, unsigned int> mBreakEvents;
-    unordered_tuple_map<std::tuple<DurationShortLongType, bool>, unsigned int> mLightFlickerEvents;
+    GameEventAggregationTable mRecordedEvents;
     unordered_tuple_map<std::tuple<BombType, bool>, unsigned int> mBombExplosionEvents;
     unordered_tuple_map<std::tuple<bool>, unsigned int> mRCBombPingEvents;
     unordered_tuple_map<std::tuple<bool>, unsigned int> mTimerBombDefusedEvents;
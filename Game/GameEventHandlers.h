@@ -7,6 +7,7 @@
 
 #include "Materials.h"
 
+#include <GameCore/DurationHistogram.h>
 #include <GameCore/GameTypes.h>
 
 #include <optional>
@@ -106,6 +107,30 @@ struct IStatisticsGameEventHandler
     {
         // Default-implemented
     }
+
+    /*
+     * Percentiles of the durations of the updates and renders of the iterations since
+     * the previous notification, together with the number of those iterations that have
+     * exceeded the frame budget.
+     */
+    virtual void OnFrameTimesUpdated(
+        DurationPercentiles const & /*updateDurations*/,
+        DurationPercentiles const & /*renderDurations*/,
+        size_t /*hitchCount*/)
+    {
+        // Default-implemented
+    }
+
+    /*
+     * The span of simulation time that may be rewound, and the memory it takes.
+     */
+    virtual void OnRewindBufferUpdated(
+        float /*duration*/,
+        size_t /*byteSize*/,
+        size_t /*maxByteSize*/)
+    {
+        // Default-implemented
+    }
 };
 
 struct IGenericGameEventHandler
@@ -0,0 +1,264 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2020-01-03
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/*
+ * The key of a high-frequency game event: events with the same key are aggregated
+ * by summing their sizes.
+ */
+struct GameEventKey
+{
+    enum class EventType : std::uint8_t
+    {
+        Stress,
+        Break,
+        Destroy,
+        SpringRepaired,
+        TriangleRepaired,
+        LightFlicker
+    };
+
+    // The structural material of the event, or the duration of a light flicker
+    std::uintptr_t Subject;
+    EventType Type;
+    bool IsUnderwater;
+
+    GameEventKey(
+        std::uintptr_t subject,
+        EventType type,
+        bool isUnderwater)
+        : Subject(subject)
+        , Type(type)
+        , IsUnderwater(isUnderwater)
+    {}
+
+    bool operator==(GameEventKey const & other) const
+    {
+        return Subject == other.Subject
+            && Type == other.Type
+            && IsUnderwater == other.IsUnderwater;
+    }
+
+    size_t Hash() const
+    {
+        // Fibonacci hashing of the subject, mixed with the other fields
+        std::uint64_t const h =
+            (static_cast<std::uint64_t>(Subject) ^ (static_cast<std::uint64_t>(Type) << 1) ^ (IsUnderwater ? 1 : 0))
+            * 0x9e3779b97f4a7c15ull;
+
+        return static_cast<size_t>(h >> 32);
+    }
+};
+
+/*
+ * An open-addressing hash table aggregating event sizes by key.
+ *
+ * The set of distinct keys in a step is small - one per material and event type - hence
+ * the table stays tiny and is probed linearly, without any node allocations.
+ */
+class GameEventAggregationTable
+{
+public:
+
+    GameEventAggregationTable()
+        : mSlots(InitialCapacity)
+        , mOccupiedCount(0)
+    {}
+
+    bool IsEmpty() const
+    {
+        return mOccupiedCount == 0;
+    }
+
+    void Add(
+        GameEventKey const & key,
+        unsigned int size)
+    {
+        // Keep the load factor below 3/4
+        if ((mOccupiedCount + 1) * 4 > mSlots.size() * 3)
+        {
+            Grow();
+        }
+
+        size_t const mask = mSlots.size() - 1;
+        for (size_t s = key.Hash() & mask; ; s = (s + 1) & mask)
+        {
+            Slot & slot = mSlots[s];
+
+            if (!slot.IsOccupied)
+            {
+                slot.Key = key;
+                slot.Size = size;
+                slot.IsOccupied = true;
+                ++mOccupiedCount;
+                return;
+            }
+
+            if (slot.Key == key)
+            {
+                slot.Size += size;
+                return;
+            }
+        }
+    }
+
+    template<typename TVisitor>
+    void ForEach(TVisitor && visitor) const
+    {
+        for (auto const & slot : mSlots)
+        {
+            if (slot.IsOccupied)
+            {
+                visitor(slot.Key, slot.Size);
+            }
+        }
+    }
+
+    template<typename TVisitor>
+    void ForEachAndClear(TVisitor && visitor)
+    {
+        if (mOccupiedCount == 0)
+            return;
+
+        for (auto & slot : mSlots)
+        {
+            if (slot.IsOccupied)
+            {
+                visitor(slot.Key, slot.Size);
+                slot.IsOccupied = false;
+            }
+        }
+
+        mOccupiedCount = 0;
+    }
+
+private:
+
+    static size_t constexpr InitialCapacity = 64; // Power of two
+
+    struct Slot
+    {
+        GameEventKey Key;
+        unsigned int Size;
+        bool IsOccupied;
+
+        Slot()
+            : Key(0, GameEventKey::EventType::Stress, false)
+            , Size(0)
+            , IsOccupied(false)
+        {}
+    };
+
+    void Grow()
+    {
+        std::vector<Slot> oldSlots(mSlots.size() * 2);
+        oldSlots.swap(mSlots);
+        mOccupiedCount = 0;
+
+        for (auto const & slot : oldSlots)
+        {
+            if (slot.IsOccupied)
+            {
+                Add(slot.Key, slot.Size);
+            }
+        }
+    }
+
+    std::vector<Slot> mSlots;
+    size_t mOccupiedCount;
+};
+
+/*
+ * The buffer into which a single thread records its events, without any synchronization.
+ *
+ * Records are appended to a fixed-capacity array; when the array is full, its records are
+ * folded into a thread-private aggregation table, and the array starts over.
+ */
+class GameEventRecordBuffer
+{
+public:
+
+    static size_t constexpr Capacity = 4096;
+
+    GameEventRecordBuffer()
+        : mRecords(new EventRecord[Capacity])
+        , mRecordCount(0)
+        , mSpilledRecordCount(0)
+        , mSpilledEvents()
+    {}
+
+    void Record(
+        GameEventKey const & key,
+        unsigned int size)
+    {
+        if (mRecordCount == Capacity)
+        {
+            Spill();
+        }
+
+        assert(mRecordCount < Capacity);
+
+        mRecords[mRecordCount].Key = key;
+        mRecords[mRecordCount].Size = size;
+        ++mRecordCount;
+    }
+
+    /*
+     * Moves all events recorded so far into the specified table, returning the number
+     * of events that had been recorded.
+     *
+     * Not thread-safe: the owning thread may not record while its buffer is being drained.
+     */
+    size_t DrainInto(GameEventAggregationTable & table)
+    {
+        Spill();
+
+        mSpilledEvents.ForEachAndClear(
+            [&table](GameEventKey const & key, unsigned int size)
+            {
+                table.Add(key, size);
+            });
+
+        size_t const recordCount = mSpilledRecordCount;
+        mSpilledRecordCount = 0;
+
+        return recordCount;
+    }
+
+private:
+
+    struct EventRecord
+    {
+        GameEventKey Key;
+        unsigned int Size;
+
+        EventRecord()
+            : Key(0, GameEventKey::EventType::Stress, false)
+            , Size(0)
+        {}
+    };
+
+    void Spill()
+    {
+        for (size_t r = 0; r < mRecordCount; ++r)
+        {
+            mSpilledEvents.Add(mRecords[r].Key, mRecords[r].Size);
+        }
+
+        mSpilledRecordCount += mRecordCount;
+        mRecordCount = 0;
+    }
+
+    std::unique_ptr<EventRecord[]> mRecords;
+    size_t mRecordCount;
+    size_t mSpilledRecordCount;
+    GameEventAggregationTable mSpilledEvents;
+};
@@ -33,6 +33,10 @@ struct IGameController
     virtual ShipMetadata AddShip(std::filesystem::path const & shipDefinitionFilepath) = 0;
     virtual void ReloadLastShip() = 0;
 
+    virtual void SaveCheckpoint(std::filesystem::path const & checkpointFilepath) = 0;
+    virtual ShipMetadata LoadCheckpoint(std::filesystem::path const & checkpointFilepath) = 0;
+    virtual RewindResultType Rewind(float seconds) = 0;
+
     virtual RgbImageData TakeScreenshot() = 0;
 
     virtual void RunGameIteration() = 0;
@@ -379,4 +383,12 @@ struct IGameController
 
     virtual bool GetShowTsunamiNotifications() const = 0;
     virtual void SetShowTsunamiNotifications(bool value) = 0;
+
+    //
+    // Diagnostics parameters
+    //
+
+    // The duration, in milliseconds, above which an iteration is reported as a hitch
+    virtual float GetFrameTimeBudget() const = 0;
+    virtual void SetFrameTimeBudget(float value) = 0;
 };
@@ -6,6 +6,7 @@
 #include "ImageFileTools.h"
 
 #include <GameCore/GameException.h>
+#include <GameCore/ImageTools.h>
 
 #include <IL/il.h>
 #include <IL/ilu.h>
@@ -13,12 +14,26 @@
 #include <algorithm>
 #include <cassert>
 #include <cstring>
+#include <fstream>
 #include <regex>
+#include <type_traits>
 
 bool ImageFileTools::mIsInitialized = false;
 
+std::mutex ImageFileTools::mDevILMutex;
+
 ImageSize ImageFileTools::GetImageSize(std::filesystem::path const & filepath)
 {
+    std::string const filepathStr = filepath.string();
+
+    //
+    // Read file
+    //
+
+    auto const fileData = ReadImageFile(filepath);
+
+    std::lock_guard<std::mutex> lock(mDevILMutex);
+
     CheckInitialized();
 
     ILuint imghandle;
@@ -29,11 +44,10 @@ ImageSize ImageFileTools::GetImageSize(std::filesystem::path const & filepath)
     // Load image
     //
 
-    std::string filepathStr = filepath.string();
-    ILconst_string ilFilename(filepathStr.c_str());
-    if (!ilLoadImage(ilFilename))
+    if (!ilLoadL(IL_TYPE_UNKNOWN, fileData.data(), static_cast<ILuint>(fileData.size())))
     {
         ILint devilError = ilGetError();
+        ilDeleteImage(imghandle);
         std::string devilErrorMessage(iluErrorString(devilError));
         throw GameException("Could not load image \"" + filepathStr + "\": " + devilErrorMessage);
     }
@@ -78,8 +92,6 @@ RgbaImageData ImageFileTools::LoadImageRgbaLowerLeftAndMagnify(
     std::filesystem::path const & filepath,
     int magnificationFactor)
 {
-    auto imageSize = GetImageSize(filepath);
-
     return InternalLoadImage<rgbaColor>(
         filepath,
         IL_RGBA,
@@ -134,10 +146,10 @@ RgbaImageData ImageFileTools::LoadImageRgbaLowerLeftAndResize(
                     1.0f);
 
                 return ImageSize(
-                    static_cast<int>(round(static_cast<float>(originalImageSize.Width) * shrinkFactor)),
-                    static_cast<int>(round(static_cast<float>(originalImageSize.Height) * shrinkFactor)));
+                    std::max(static_cast<int>(round(static_cast<float>(originalImageSize.Width) * shrinkFactor)), 1),
+                    std::max(static_cast<int>(round(static_cast<float>(originalImageSize.Height) * shrinkFactor)), 1));
             },
-            ILU_BILINEAR));
+            BoxFilter));
 }
 
 RgbImageData ImageFileTools::LoadImageRgbUpperLeft(std::filesystem::path const & filepath)
@@ -189,6 +201,26 @@ void ImageFileTools::CheckInitialized()
     }
 }
 
+std::vector<unsigned char> ImageFileTools::ReadImageFile(std::filesystem::path const & filepath)
+{
+    std::ifstream file(filepath, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+    {
+        throw GameException("Could not load image \"" + filepath.string() + "\": the file could not be opened");
+    }
+
+    auto const fileSize = static_cast<size_t>(file.tellg());
+    std::vector<unsigned char> fileData(fileSize);
+
+    file.seekg(0, std::ios::beg);
+    if (!file.read(reinterpret_cast<char *>(fileData.data()), fileSize))
+    {
+        throw GameException("Could not load image \"" + filepath.string() + "\": the file could not be read");
+    }
+
+    return fileData;
+}
+
 template <typename TColor>
 ImageData<TColor> ImageFileTools::InternalLoadImage(
     std::filesystem::path const & filepath,
@@ -196,98 +228,157 @@ ImageData<TColor> ImageFileTools::InternalLoadImage(
     int targetOrigin,
     std::optional<ResizeInfo> resizeInfo)
 {
-    CheckInitialized();
+    std::string const filepathStr = filepath.string();
 
     //
-    // Load image
+    // Read file - done outside of the lock, so that concurrent loads only
+    // contend on the decoding
     //
 
-    ILuint imghandle;
-    ilGenImages(1, &imghandle);
-    ilBindImage(imghandle);
-
-    std::string filepathStr = filepath.string();
-    ILconst_string ilFilename(filepathStr.c_str());
-    if (!ilLoadImage(ilFilename))
-    {
-        ILint devilError = ilGetError();
-        std::string devilErrorMessage(iluErrorString(devilError));
-        throw GameException("Could not load image \"" + filepathStr + "\": " + devilErrorMessage);
-    }
+    auto const fileData = ReadImageFile(filepath);
 
     //
-    // Check if we need to convert it
+    // Decode image and extract its data - under the lock, as the data belongs
+    // to DevIL until the image is deleted
     //
 
-    int imageFormat = ilGetInteger(IL_IMAGE_FORMAT);
-    int imageType = ilGetInteger(IL_IMAGE_TYPE);
-    if (targetFormat != imageFormat || IL_UNSIGNED_BYTE != imageType)
+    ImageSize imageSize(0, 0);
+    int imageOrigin;
+    std::unique_ptr<TColor[]> data;
+
     {
-        if (!ilConvertImage(targetFormat, IL_UNSIGNED_BYTE))
+        std::lock_guard<std::mutex> lock(mDevILMutex);
+
+        CheckInitialized();
+
+        ILuint imghandle;
+        ilGenImages(1, &imghandle);
+        ilBindImage(imghandle);
+
+        if (!ilLoadL(IL_TYPE_UNKNOWN, fileData.data(), static_cast<ILuint>(fileData.size())))
         {
             ILint devilError = ilGetError();
+            ilDeleteImage(imghandle);
             std::string devilErrorMessage(iluErrorString(devilError));
-            throw GameException("Could not convert image \"" + filepathStr + "\": " + devilErrorMessage);
+            throw GameException("Could not load image \"" + filepathStr + "\": " + devilErrorMessage);
         }
-    }
 
-    int imageOrigin = ilGetInteger(IL_IMAGE_ORIGIN);
-    if (targetOrigin != imageOrigin)
-    {
-        iluFlipImage();
-    }
+        //
+        // Check if we need to convert it
+        //
 
+        int imageFormat = ilGetInteger(IL_IMAGE_FORMAT);
+        int imageType = ilGetInteger(IL_IMAGE_TYPE);
+        if (targetFormat != imageFormat || IL_UNSIGNED_BYTE != imageType)
+        {
+            if (!ilConvertImage(targetFormat, IL_UNSIGNED_BYTE))
+            {
+                ILint devilError = ilGetError();
+                ilDeleteImage(imghandle);
+                std::string devilErrorMessage(iluErrorString(devilError));
+                throw GameException("Could not convert image \"" + filepathStr + "\": " + devilErrorMessage);
+            }
+        }
 
-    //
-    // Get metadata
-    //
+        // Note: we don't flip the image here; we rather copy its rows
+        // in the target order while extracting its data
+        imageOrigin = ilGetInteger(IL_IMAGE_ORIGIN);
 
-    ImageSize imageSize(
-        ilGetInteger(IL_IMAGE_WIDTH),
-        ilGetInteger(IL_IMAGE_HEIGHT));
-    int const depth = ilGetInteger(IL_IMAGE_DEPTH);
-    int const bpp = ilGetInteger(IL_IMAGE_BYTES_PER_PIXEL);
 
-    assert(bpp == sizeof(TColor));
+        //
+        // Get metadata
+        //
 
+        imageSize = ImageSize(
+            ilGetInteger(IL_IMAGE_WIDTH),
+            ilGetInteger(IL_IMAGE_HEIGHT));
+        int const depth = ilGetInteger(IL_IMAGE_DEPTH);
+        int const bpp = ilGetInteger(IL_IMAGE_BYTES_PER_PIXEL);
 
-    //
-    // Resize it
-    //
+        assert(bpp == sizeof(TColor));
+        (void)bpp;
 
-    if (!!resizeInfo)
-    {
-        iluImageParameter(ILU_FILTER, resizeInfo->FilterType);
 
-        auto newImageSize = resizeInfo->ResizeHandler(imageSize);
+        //
+        // Resize it, unless we do it ourselves
+        //
 
-        if (!iluScale(newImageSize.Width, newImageSize.Height, depth))
+        if (!!resizeInfo && resizeInfo->FilterType != BoxFilter)
         {
-            ILint devilError = ilGetError();
-            std::string devilErrorMessage(iluErrorString(devilError));
-            throw GameException("Could not resize image: " + devilErrorMessage);
-        }
+            iluImageParameter(ILU_FILTER, resizeInfo->FilterType);
 
-        imageSize = newImageSize;
-    }
+            auto newImageSize = resizeInfo->ResizeHandler(imageSize);
 
+            if (!iluScale(newImageSize.Width, newImageSize.Height, depth))
+            {
+                ILint devilError = ilGetError();
+                ilDeleteImage(imghandle);
+                std::string devilErrorMessage(iluErrorString(devilError));
+                throw GameException("Could not resize image: " + devilErrorMessage);
+            }
 
-    //
-    // Create data
-    //
+            imageSize = newImageSize;
+        }
 
-    ILubyte const * imageData = ilGetData();
-    auto data = std::make_unique<TColor[]>(imageSize.Width * imageSize.Height);
-    std::memcpy(static_cast<void*>(data.get()), imageData, imageSize.Width * imageSize.Height * bpp);
 
+        //
+        // Extract data, straight into the target orientation - and, when we resize
+        // it ourselves, straight into the resized image, so that we never make a
+        // full-size copy
+        //
 
-    //
-    // Delete image
-    //
+        ILubyte const * const imageData = ilGetData();
+
+        if (!!resizeInfo && resizeInfo->FilterType == BoxFilter)
+        {
+            if constexpr (std::is_same_v<TColor, rgbaColor>)
+            {
+                auto resizedImage = ImageTools::BoxFilterResize(
+                    reinterpret_cast<rgbaColor const *>(imageData),
+                    imageSize,
+                    resizeInfo->ResizeHandler(imageSize),
+                    targetOrigin != imageOrigin);
+
+                imageSize = resizedImage.Size;
+                data = std::move(resizedImage.Data);
+            }
+            else
+            {
+                assert(false); // Only supported for RGBA images
+                ilDeleteImage(imghandle);
+                throw GameException("Could not resize image \"" + filepathStr + "\": unsupported format");
+            }
+        }
+        else
+        {
+            data = std::make_unique<TColor[]>(imageSize.Width * imageSize.Height);
+
+            if (targetOrigin == imageOrigin)
+            {
+                std::memcpy(static_cast<void*>(data.get()), imageData, imageSize.Width * imageSize.Height * sizeof(TColor));
+            }
+            else
+            {
+                size_t const rowByteSize = static_cast<size_t>(imageSize.Width) * sizeof(TColor);
+                for (int srcRow = 0; srcRow < imageSize.Height; ++srcRow)
+                {
+                    int const tgtRow = imageSize.Height - 1 - srcRow;
+
+                    std::memcpy(
+                        static_cast<void*>(data.get() + tgtRow * imageSize.Width),
+                        imageData + srcRow * rowByteSize,
+                        rowByteSize);
+                }
+            }
+        }
 
-    ilDeleteImage(imghandle);
 
+        //
+        // Delete image
+        //
 
+        ilDeleteImage(imghandle);
+    }
 
     return ImageData<TColor>(
         imageSize,
@@ -301,6 +392,8 @@ void ImageFileTools::InternalSaveImage(
     int format,
     std::filesystem::path filepath)
 {
+    std::lock_guard<std::mutex> lock(mDevILMutex);
+
     CheckInitialized();
 
     ILuint imghandle;
@@ -9,8 +9,17 @@
 
 #include <filesystem>
 #include <functional>
+#include <mutex>
 #include <optional>
-
+#include <vector>
+
+/*
+ * Image loading and saving via DevIL.
+ *
+ * All methods are thread-safe: DevIL keeps all of its state (including the
+ * currently-bound image) in globals, hence calls into it - and reads of the data
+ * it owns - are serialized, while file I/O happens outside of the lock.
+ */
 class ImageFileTools
 {
 public:
@@ -36,6 +45,12 @@ private:
 
     static void CheckInitialized();
 
+    static std::vector<unsigned char> ReadImageFile(std::filesystem::path const & filepath);
+
+    // Special filter type: resize with our box filter while extracting
+    // the image data, rather than with DevIL
+    static constexpr int BoxFilter = -1;
+
     struct ResizeInfo
     {
         std::function<ImageSize(ImageSize const &)> ResizeHandler;
@@ -66,4 +81,7 @@ private:
 private:
 
     static bool mIsInitialized;
+
+    // Guards all calls into DevIL
+    static std::mutex mDevILMutex;
 };
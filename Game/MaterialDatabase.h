@@ -202,6 +202,11 @@ public:
         return nullptr;
     }
 
+    auto const & GetElectricalMaterials() const
+    {
+        return mElectricalMaterialMap;
+    }
+
     StructuralMaterial const & GetUniqueStructuralMaterial(StructuralMaterial::MaterialUniqueType uniqueType) const
     {
         assert(static_cast<size_t>(uniqueType) < mUniqueStructuralMaterials.size());
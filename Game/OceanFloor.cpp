@@ -146,6 +146,27 @@ void OceanFloor::Update(GameParameters const & gameParameters)
     }
 }
 
+void OceanFloor::SaveState(CheckpointWriter & checkpoint) const
+{
+    VisitState(*this, checkpoint);
+}
+
+void OceanFloor::LoadState(CheckpointReader & checkpoint)
+{
+    VisitState(*this, checkpoint);
+}
+
+template<typename TSelf, typename TArchive>
+void OceanFloor::VisitState(
+    TSelf & self,
+    TArchive & archive)
+{
+    archive.Visit("Samples", self.mSamples.get(), SamplesCount + 1);
+    archive.Visit("CurrentSeaDepth", self.mCurrentSeaDepth);
+    archive.Visit("CurrentOceanFloorBumpiness", self.mCurrentOceanFloorBumpiness);
+    archive.Visit("CurrentOceanFloorDetailAmplification", self.mCurrentOceanFloorDetailAmplification);
+}
+
 void OceanFloor::Upload(
     GameParameters const & /*gameParameters*/,
     Render::RenderContext & renderContext) const
@@ -11,6 +11,7 @@
 #include "ImageFileTools.h"
 #include "ResourceLoader.h"
 
+#include <GameCore/Checkpoint.h>
 #include <GameCore/GameMath.h>
 
 #include <memory>
@@ -30,6 +31,12 @@ public:
         GameParameters const & gameParameters,
         Render::RenderContext & renderContext) const;
 
+    /*
+     * Saves and restores the state of the ocean floor.
+     */
+    void SaveState(CheckpointWriter & checkpoint) const;
+    void LoadState(CheckpointReader & checkpoint);
+
 public:
 
     bool AdjustTo(
@@ -71,6 +78,14 @@ public:
         }
     }
 
+private:
+
+    // Visits the members making up the state, both for saving and for restoring
+    template<typename TSelf, typename TArchive>
+    static void VisitState(
+        TSelf & self,
+        TArchive & archive);
+
 private:
 
     // The number of samples for the entire world width;
@@ -5,7 +5,6 @@
 ***************************************************************************************/
 #include "Physics.h"
 
-#include <GameCore/GameRandomEngine.h>
 #include <GameCore/GameWallClock.h>
 
 #include <algorithm>
@@ -51,9 +50,17 @@ int32_t constexpr SWETotalSamples =
     + OceanSurface::SamplesCount
     + SWEOuterLayerSamples;
 
-OceanSurface::OceanSurface(std::shared_ptr<GameEventDispatcher> gameEventDispatcher)
+OceanSurface::OceanSurface(
+    std::shared_ptr<GameEventDispatcher> gameEventDispatcher,
+    RandomEngine & randomEngine)
     : mGameEventHandler(std::move(gameEventDispatcher))
+    , mRandomEngine(randomEngine)
     , mSamples(new Sample[SamplesCount + 1])
+    , mWindIncisivenessRunningAverage()
+    , mSinArgBuffer(make_aligned_element_count(SamplesCount))
+    , mBasalWave1Buffer(make_aligned_element_count(SamplesCount))
+    , mBasalWave2Buffer(make_aligned_element_count(SamplesCount))
+    , mRippleWaveBuffer(make_aligned_element_count(SamplesCount))
     ////////
     , mBasalWaveAmplitude1(0.0f)
     , mBasalWaveAmplitude2(0.0f)
@@ -362,13 +369,13 @@ void OceanSurface::AdjustTo(
 void OceanSurface::TriggerTsunami(float currentSimulationTime)
 {
     // Choose X
-    float const tsunamiWorldX = GameRandomEngine::GetInstance().GenerateRandomReal(
+    float const tsunamiWorldX = mRandomEngine.GenerateRandomReal(
         -GameParameters::HalfMaxWorldWidth,
         GameParameters::HalfMaxWorldWidth);
 
     // Choose height (good: 5 at 50-50)
     float constexpr AverageTsunamiHeight = 250.0f / SWEHeightFieldAmplification;
-    float const tsunamiHeight = GameRandomEngine::GetInstance().GenerateRandomReal(
+    float const tsunamiHeight = mRandomEngine.GenerateRandomReal(
         AverageTsunamiHeight * 0.96f,
         AverageTsunamiHeight * 1.04f)
         + SWEHeightFieldOffset;
@@ -409,13 +416,13 @@ void OceanSurface::TriggerRogueWave(
 
     // Choose height
     float constexpr MaxRogueWaveHeight = 50.0f / SWEHeightFieldAmplification;
-    float const rogueWaveHeight = GameRandomEngine::GetInstance().GenerateRandomReal(
+    float const rogueWaveHeight = mRandomEngine.GenerateRandomReal(
         MaxRogueWaveHeight * 0.35f,
         MaxRogueWaveHeight)
         + SWEHeightFieldOffset;
 
     // Choose rate
-    float const rogueWaveDelay = GameRandomEngine::GetInstance().GenerateRandomReal(
+    float const rogueWaveDelay = mRandomEngine.GenerateRandomReal(
         0.7f,
         2.0f);
 
@@ -431,6 +438,53 @@ void OceanSurface::TriggerRogueWave(
 
 ///////////////////////////////////////////////////////////////////////////////////////////////
 
+void OceanSurface::SaveState(CheckpointWriter & checkpoint) const
+{
+    VisitState(*this, checkpoint);
+}
+
+void OceanSurface::LoadState(CheckpointReader & checkpoint)
+{
+    VisitState(*this, checkpoint);
+}
+
+template<typename TSelf, typename TArchive>
+void OceanSurface::VisitState(
+    TSelf & self,
+    TArchive & archive)
+{
+    archive.Visit("Samples", self.mSamples.get(), SamplesCount + 1);
+    archive.Visit("WindIncisivenessRunningAverage", self.mWindIncisivenessRunningAverage);
+
+    // Calculated coefficients, and the parameters they are current with
+    archive.Visit("BasalWaveAmplitude1", self.mBasalWaveAmplitude1);
+    archive.Visit("BasalWaveAmplitude2", self.mBasalWaveAmplitude2);
+    archive.Visit("BasalWaveNumber1", self.mBasalWaveNumber1);
+    archive.Visit("BasalWaveNumber2", self.mBasalWaveNumber2);
+    archive.Visit("BasalWaveAngularVelocity1", self.mBasalWaveAngularVelocity1);
+    archive.Visit("BasalWaveAngularVelocity2", self.mBasalWaveAngularVelocity2);
+    archive.Visit("BasalWaveSin1", self.mBasalWaveSin1);
+    archive.Visit("NextTsunamiTimestamp", self.mNextTsunamiTimestamp);
+    archive.Visit("NextRogueWaveTimestamp", self.mNextRogueWaveTimestamp);
+    archive.Visit("WindBaseSpeedMagnitude", self.mWindBaseSpeedMagnitude);
+    archive.Visit("BasalWaveHeightAdjustment", self.mBasalWaveHeightAdjustment);
+    archive.Visit("BasalWaveLengthAdjustment", self.mBasalWaveLengthAdjustment);
+    archive.Visit("BasalWaveSpeedAdjustment", self.mBasalWaveSpeedAdjustment);
+    archive.Visit("TsunamiRate", self.mTsunamiRate);
+    archive.Visit("RogueWaveRate", self.mRogueWaveRate);
+
+    // Shallow water equations
+    archive.Visit("HeightField", self.mHeightField.get(), SWETotalSamples + 1);
+    archive.Visit("VelocityField", self.mVelocityField.get(), SWETotalSamples + 1);
+
+    // Waves
+    archive.Visit("SWEInteractiveWaveStateMachine", self.mSWEInteractiveWaveStateMachine);
+    archive.Visit("SWETsunamiWaveStateMachine", self.mSWETsunamiWaveStateMachine);
+    archive.Visit("SWERogueWaveWaveStateMachine", self.mSWERogueWaveWaveStateMachine);
+    archive.Visit("LastTsunamiTimestamp", self.mLastTsunamiTimestamp);
+    archive.Visit("LastRogueWaveTimestamp", self.mLastRogueWaveTimestamp);
+}
+
 void OceanSurface::SetSWEWaveHeight(
     int32_t centerIndex,
     float height)
@@ -568,7 +622,7 @@ GameWallClock::time_point OceanSurface::CalculateNextAbnormalWaveTimestamp(
         + std::chrono::duration_cast<GameWallClock::duration>(
             std::chrono::duration<float>(
                 60.0f // Grace period between tsunami waves
-                + GameRandomEngine::GetInstance().GenerateExponentialReal(1.0f / rateSeconds)));
+                + mRandomEngine.GenerateExponentialReal(1.0f / rateSeconds)));
 }
 
 /* Note: in this implementation we let go of the field advections,
@@ -753,61 +807,64 @@ void OceanSurface::GenerateSamples(
         ? windRipplesWaveHeight / mBasalWaveAmplitude1
         : 0.0f;
 
-    float sinArg1 = (mBasalWaveNumber1 * x - mBasalWaveAngularVelocity1 * currentSimulationTime) / (2 * Pi<float>);
-    float sinArg2 = (mBasalWaveNumber2 * x - mBasalWaveAngularVelocity2 * currentSimulationTime + secondaryBasalComponentPhase) / (2 * Pi<float>);
-    float sinArgRipple = (WindRippleWaveNumber * x - windRipplesAngularVelocity * currentSimulationTime) / (2 * Pi<float>);
+    float const sinArg1 = (mBasalWaveNumber1 * x - mBasalWaveAngularVelocity1 * currentSimulationTime) / (2 * Pi<float>);
+    float const sinArg2 = (mBasalWaveNumber2 * x - mBasalWaveAngularVelocity2 * currentSimulationTime + secondaryBasalComponentPhase) / (2 * Pi<float>);
+    float const sinArgRipple = (WindRippleWaveNumber * x - windRipplesAngularVelocity * currentSimulationTime) / (2 * Pi<float>);
 
-    // sample index = 0
-    float previousSampleValue;
-    {
-        float const sweValue =
-            (mHeightField[SWEOuterLayerSamples + 0] - SWEHeightFieldOffset)
-            * SWEHeightFieldAmplification;
+    float const sinArg1Dx = mBasalWaveNumber1 * Dx / (2 * Pi<float>);
+    float const sinArg2Dx = mBasalWaveNumber2 * Dx / (2 * Pi<float>);
+    float const sinArgRippleDx = WindRippleWaveNumber * Dx / (2 * Pi<float>);
 
-        float const basalValue1 =
-            mBasalWaveSin1.GetLinearlyInterpolatedPeriodic(sinArg1);
+    //
+    // Calculate basal waves and ripples for all samples at once
+    //
 
-        float const basalValue2 =
-            basalWave2AmplitudeCoeff
-            * mBasalWaveSin1.GetLinearlyInterpolatedPeriodic(sinArg2);
+    float * restrict const sinArgBuffer = mSinArgBuffer.data();
 
-        float const rippleValue =
-            rippleWaveAmplitudeCoeff
-            * mBasalWaveSin1.GetLinearlyInterpolatedPeriodic(sinArgRipple);
+    auto const calculateWave = [&](float startSinArg, float sinArgDx, float * restrict waveBuffer)
+    {
+        float sinArg = startSinArg;
+        sinArgBuffer[0] = sinArg;
+        for (int64_t i = 1; i < SamplesCount; ++i)
+        {
+            sinArg += sinArgDx;
+            sinArgBuffer[i] = sinArg;
+        }
 
-        previousSampleValue =
-            sweValue
-            + basalValue1
-            + basalValue2
-            + rippleValue;
+        mBasalWaveSin1.GetLinearlyInterpolatedPeriodicBatch(
+            sinArgBuffer,
+            waveBuffer,
+            SamplesCount);
+    };
 
-        mSamples[0].SampleValue = previousSampleValue;
-    }
+    float * restrict const basalWave1Buffer = mBasalWave1Buffer.data();
+    float * restrict const basalWave2Buffer = mBasalWave2Buffer.data();
+    float * restrict const rippleWaveBuffer = mRippleWaveBuffer.data();
 
-    float const sinArg1Dx = mBasalWaveNumber1 * Dx / (2 * Pi<float>);
-    float const sinArg2Dx = mBasalWaveNumber2 * Dx / (2 * Pi<float>);
-    float const sinArgRippleDx = WindRippleWaveNumber * Dx / (2 * Pi<float>);
+    calculateWave(sinArg1, sinArg1Dx, basalWave1Buffer);
+    calculateWave(sinArg2, sinArg2Dx, basalWave2Buffer);
+    calculateWave(sinArgRipple, sinArgRippleDx, rippleWaveBuffer);
 
-    // sample index = 1...SamplesCount - 1
-    for (int64_t i = 1; i < SamplesCount; ++i)
+    //
+    // Combine all components
+    //
+
+    float previousSampleValue = 0.0f; // Won't be used
+    for (int64_t i = 0; i < SamplesCount; ++i)
     {
         float const sweValue =
             (mHeightField[SWEOuterLayerSamples + i] - SWEHeightFieldOffset)
             * SWEHeightFieldAmplification;
 
-        sinArg1 += sinArg1Dx;
-        float const basalValue1 =
-            mBasalWaveSin1.GetLinearlyInterpolatedPeriodic(sinArg1);
+        float const basalValue1 = basalWave1Buffer[i];
 
-        sinArg2 += sinArg2Dx;
         float const basalValue2 =
             basalWave2AmplitudeCoeff
-            * mBasalWaveSin1.GetLinearlyInterpolatedPeriodic(sinArg2);
+            * basalWave2Buffer[i];
 
-        sinArgRipple += sinArgRippleDx;
         float const rippleValue =
             rippleWaveAmplitudeCoeff
-            * mBasalWaveSin1.GetLinearlyInterpolatedPeriodic(sinArgRipple);
+            * rippleWaveBuffer[i];
 
         float const sampleValue =
             sweValue
@@ -816,7 +873,11 @@ void OceanSurface::GenerateSamples(
             + rippleValue;
 
         mSamples[i].SampleValue = sampleValue;
-        mSamples[i - 1].SampleValuePlusOneMinusSampleValue = sampleValue - previousSampleValue;
+
+        if (i > 0)
+        {
+            mSamples[i - 1].SampleValuePlusOneMinusSampleValue = sampleValue - previousSampleValue;
+        }
 
         previousSampleValue = sampleValue;
     }
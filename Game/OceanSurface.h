@@ -8,8 +8,11 @@
 #include "GameEventDispatcher.h"
 #include "GameParameters.h"
 
+#include <GameCore/Buffer.h>
+#include <GameCore/Checkpoint.h>
 #include <GameCore/GameMath.h>
 #include <GameCore/PrecalculatedFunction.h>
+#include <GameCore/RandomEngine.h>
 #include <GameCore/RunningAverage.h>
 
 #include <memory>
@@ -22,7 +25,9 @@ class OceanSurface
 {
 public:
 
-    OceanSurface(std::shared_ptr<GameEventDispatcher> gameEventDispatcher);
+    OceanSurface(
+        std::shared_ptr<GameEventDispatcher> gameEventDispatcher,
+        RandomEngine & randomEngine);
 
     void Update(
         float currentSimulationTime,
@@ -33,6 +38,13 @@ public:
         GameParameters const & gameParameters,
         Render::RenderContext & renderContext) const;
 
+    /*
+     * Saves and restores the state of the ocean surface. Abnormal waves are timed on the
+     * wall clock, hence they only resume exactly in deterministic mode.
+     */
+    void SaveState(CheckpointWriter & checkpoint) const;
+    void LoadState(CheckpointReader & checkpoint);
+
 public:
 
     float GetHeightAt(float x) const
@@ -107,7 +119,7 @@ private:
         Wind const & wind,
         GameParameters const & gameParameters);
 
-    static GameWallClock::time_point CalculateNextAbnormalWaveTimestamp(
+    GameWallClock::time_point CalculateNextAbnormalWaveTimestamp(
         GameWallClock::time_point lastTimestamp,
         float rateSeconds);
 
@@ -119,10 +131,19 @@ private:
         Wind const & wind,
         GameParameters const & gameParameters);
 
+    // Visits the members making up the state, both for saving and for restoring
+    template<typename TSelf, typename TArchive>
+    static void VisitState(
+        TSelf & self,
+        TArchive & archive);
+
 private:
 
     std::shared_ptr<GameEventDispatcher> mGameEventHandler;
 
+    // The random engine of the world
+    RandomEngine & mRandomEngine;
+
     // What we store for each sample
     struct Sample
     {
@@ -136,6 +157,12 @@ private:
     // Smoothing of wind incisiveness
     RunningAverage<15> mWindIncisivenessRunningAverage;
 
+    // Scratch buffers for calculating the basal waves and wind ripples of all samples in batches
+    Buffer<float> mSinArgBuffer;
+    Buffer<float> mBasalWave1Buffer;
+    Buffer<float> mBasalWave2Buffer;
+    Buffer<float> mRippleWaveBuffer;
+
     //
     // Calculated coefficients
     //
@@ -25,6 +25,35 @@ void PinnedPoints::OnEphemeralParticleDestroyed(ElementIndex pointElementIndex)
     }
 }
 
+void PinnedPoints::SaveState(CheckpointWriter & checkpoint) const
+{
+    // Most recent first
+    std::vector<ElementIndex> pinnedPoints(mCurrentPinnedPoints.begin(), mCurrentPinnedPoints.end());
+
+    checkpoint.Visit("PinnedPoints", pinnedPoints);
+}
+
+void PinnedPoints::LoadState(CheckpointReader & checkpoint)
+{
+    std::vector<ElementIndex> pinnedPoints;
+    checkpoint.Visit("PinnedPoints", pinnedPoints);
+
+    mCurrentPinnedPoints.clear();
+
+    for (auto it = pinnedPoints.crbegin(); it != pinnedPoints.crend(); ++it)
+    {
+        assert(mShipPoints.IsPinned(*it));
+
+        mCurrentPinnedPoints.emplace(
+            [](auto)
+            {
+                // Cannot purge, as we're restoring at most as many as we may hold
+                assert(false);
+            },
+            *it);
+    }
+}
+
 void PinnedPoints::Upload(
     ShipId shipId,
     Render::RenderContext & renderContext) const
@@ -10,10 +10,12 @@
 #include "Physics.h"
 #include "RenderContext.h"
 
+#include <GameCore/Checkpoint.h>
 #include <GameCore/CircularList.h>
 #include <GameCore/Vectors.h>
 
 #include <memory>
+#include <vector>
 
 namespace Physics
 {
@@ -44,6 +46,13 @@ public:
 
     void OnEphemeralParticleDestroyed(ElementIndex pointElementIndex);
 
+    /*
+     * Saves and restores the set of pinned points; the pinned state of the points
+     * themselves is part of the state of the points.
+     */
+    void SaveState(CheckpointWriter & checkpoint) const;
+    void LoadState(CheckpointReader & checkpoint);
+
     bool ToggleAt(
         vec2f const & targetPos,
         GameParameters const & gameParameters)
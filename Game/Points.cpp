@@ -5,15 +5,22 @@
 ***************************************************************************************/
 #include "Physics.h"
 
-#include <GameCore/GameRandomEngine.h>
 #include <GameCore/Log.h>
 #include <GameCore/PrecalculatedFunction.h>
+#include <GameCore/TraceRecorder.h>
 
 #include <cmath>
 #include <limits>
+#include <unordered_map>
 
 namespace Physics {
 
+namespace /* anonymous */ {
+
+    // The ordinal of no material, in checkpoints
+    static constexpr std::uint32_t NoneMaterialOrdinal = std::numeric_limits<std::uint32_t>::max();
+}
+
 void Points::Add(
     vec2f const & position,
     StructuralMaterial const & structuralMaterial,
@@ -77,11 +84,8 @@ void Points::Add(
     mEphemeralMaxLifetimeBuffer.emplace_back(0.0f);
     mEphemeralStateBuffer.emplace_back(EphemeralState::DebrisState());
 
-    // Structure
-    mConnectedSpringsBuffer.emplace_back();
-    mFactoryConnectedSpringsBuffer.emplace_back();
-    mConnectedTrianglesBuffer.emplace_back();
-    mFactoryConnectedTrianglesBuffer.emplace_back();
+    // Structure: connected springs and triangles are set all at once, after
+    // all springs and triangles have been created
 
     mConnectedComponentIdBuffer.emplace_back(NoneConnectedComponentId);
     mPlaneIdBuffer.emplace_back(NonePlaneId);
@@ -114,9 +118,9 @@ void Points::CreateEphemeralParticleAirBubble(
     // Store attributes
     //
 
-    mPositionBuffer[pointIndex] = position;
-    mVelocityBuffer[pointIndex] = vec2f::zero();
-    mForceBuffer[pointIndex] = vec2f::zero();
+    mPositionBuffer.set(pointIndex, position);
+    mVelocityBuffer.set(pointIndex, vec2f::zero());
+    mForceBuffer.set(pointIndex, vec2f::zero());
     mAugmentedMaterialMassBuffer[pointIndex] = structuralMaterial.GetMass();
     mMassBuffer[pointIndex] = structuralMaterial.GetMass();
     mDecayBuffer[pointIndex] = 1.0f;
@@ -145,7 +149,7 @@ void Points::CreateEphemeralParticleAirBubble(
     mEphemeralStartTimeBuffer[pointIndex] = currentSimulationTime;
     mEphemeralMaxLifetimeBuffer[pointIndex] = std::numeric_limits<float>::max();
     mEphemeralStateBuffer[pointIndex] = EphemeralState::AirBubbleState(
-        GameRandomEngine::GetInstance().Choose<TextureFrameIndex>(2),
+        mParentWorld.GetRandomEngine().Choose<TextureFrameIndex>(2),
         initialSize,
         vortexAmplitude,
         vortexPeriod);
@@ -176,9 +180,9 @@ void Points::CreateEphemeralParticleDebris(
     // Store attributes
     //
 
-    mPositionBuffer[pointIndex] = position;
-    mVelocityBuffer[pointIndex] = velocity;
-    mForceBuffer[pointIndex] = vec2f::zero();
+    mPositionBuffer.set(pointIndex, position);
+    mVelocityBuffer.set(pointIndex, velocity);
+    mForceBuffer.set(pointIndex, vec2f::zero());
     mAugmentedMaterialMassBuffer[pointIndex] = structuralMaterial.GetMass();
     mMassBuffer[pointIndex] = structuralMaterial.GetMass();
     mDecayBuffer[pointIndex] = 1.0f;
@@ -237,9 +241,9 @@ void Points::CreateEphemeralParticleSparkle(
     // Store attributes
     //
 
-    mPositionBuffer[pointIndex] = position;
-    mVelocityBuffer[pointIndex] = velocity;
-    mForceBuffer[pointIndex] = vec2f::zero();
+    mPositionBuffer.set(pointIndex, position);
+    mVelocityBuffer.set(pointIndex, velocity);
+    mForceBuffer.set(pointIndex, vec2f::zero());
     mAugmentedMaterialMassBuffer[pointIndex] = structuralMaterial.GetMass();
     mMassBuffer[pointIndex] = structuralMaterial.GetMass();
     mDecayBuffer[pointIndex] = 1.0f;
@@ -268,7 +272,7 @@ void Points::CreateEphemeralParticleSparkle(
     mEphemeralStartTimeBuffer[pointIndex] = currentSimulationTime;
     mEphemeralMaxLifetimeBuffer[pointIndex] = std::chrono::duration_cast<std::chrono::duration<float>>(maxLifetime).count();
     mEphemeralStateBuffer[pointIndex] = EphemeralState::SparkleState(
-        GameRandomEngine::GetInstance().Choose<TextureFrameIndex>(2));
+        mParentWorld.GetRandomEngine().Choose<TextureFrameIndex>(2));
 
     mConnectedComponentIdBuffer[pointIndex] = NoneConnectedComponentId;
     mPlaneIdBuffer[pointIndex] = planeId;
@@ -285,6 +289,8 @@ void Points::Detach(
     float currentSimulationTime,
     GameParameters const & gameParameters)
 {
+    TRACE_SCOPE("Points::Detach");
+
     // Invoke detach handler
     if (!!mDetachHandler)
     {
@@ -298,7 +304,7 @@ void Points::Detach(
     // Imprint velocity, unless the point is pinned
     if (!mIsPinnedBuffer[pointElementIndex])
     {
-        mVelocityBuffer[pointElementIndex] = velocity;
+        mVelocityBuffer.set(pointElementIndex, velocity);
     }
 }
 
@@ -412,7 +418,7 @@ void Points::UpdateEphemeralParticles(
                                 * PrecalcLoFreqSin.GetNearestPeriodic(mEphemeralStateBuffer[pointIndex].AirBubble.NormalizedVortexAngularVelocity * lifetime);
 
                             // Update position
-                            mPositionBuffer[pointIndex].x +=
+                            mPositionBuffer.x(pointIndex) +=
                                 vortexValue - mEphemeralStateBuffer[pointIndex].AirBubble.LastVortexValue;
 
                             mEphemeralStateBuffer[pointIndex].AirBubble.LastVortexValue = vortexValue;
@@ -478,13 +484,154 @@ void Points::UpdateEphemeralParticles(
 void Points::Query(ElementIndex pointElementIndex) const
 {
     LogMessage("PointIndex: ", pointElementIndex);
-    LogMessage("P=", mPositionBuffer[pointElementIndex].toString(), " V=", mVelocityBuffer[pointElementIndex].toString());
+    LogMessage("P=", mPositionBuffer.get(pointElementIndex).toString(), " V=", mVelocityBuffer.get(pointElementIndex).toString());
     LogMessage("W=", mWaterBuffer[pointElementIndex], " T=", mTemperatureBuffer[pointElementIndex], " Decay=", mDecayBuffer[pointElementIndex]);
-    LogMessage("Springs: ", mConnectedSpringsBuffer[pointElementIndex].ConnectedSprings.size(), " (factory: ", mFactoryConnectedSpringsBuffer[pointElementIndex].ConnectedSprings.size(), ")");
+    LogMessage("Springs: ", mConnectedSprings.GetRow(pointElementIndex).size(), " (factory: ", mFactoryConnectedSprings.GetRow(pointElementIndex).size(), ")");
     LogMessage("PlaneID: ", mPlaneIdBuffer[pointElementIndex]);
     LogMessage("ConnectedComponentID: ", mConnectedComponentIdBuffer[pointElementIndex]);
 }
 
+size_t Points::GetMemoryFootprint() const
+{
+    size_t footprint =
+        // Materials
+        mMaterialsBuffer.GetByteSize()
+        + mIsRopeBuffer.GetByteSize()
+        // Dynamics
+        + mPositionBuffer.GetByteSize()
+        + mVelocityBuffer.GetByteSize()
+        + mForceBuffer.GetByteSize()
+        + mAugmentedMaterialMassBuffer.GetByteSize()
+        + mMassBuffer.GetByteSize()
+        + mDecayBuffer.GetByteSize()
+        + mIntegrationFactorTimeCoefficientBuffer.GetByteSize()
+        + mIntegrationFactorBuffer.GetByteSize()
+        + mForceRenderBuffer.GetByteSize()
+        // Water dynamics
+        + mMaterialIsHullBuffer.GetByteSize()
+        + mMaterialWaterVolumeFillBuffer.GetByteSize()
+        + mMaterialWaterIntakeBuffer.GetByteSize()
+        + mMaterialWaterRestitutionBuffer.GetByteSize()
+        + mMaterialWaterDiffusionSpeedBuffer.GetByteSize()
+        + mWaterBuffer.GetByteSize()
+        + mWaterBackBuffer.GetByteSize()
+        + mWaterVelocityBuffer.GetByteSize()
+        + mWaterMomentumBuffer.GetByteSize()
+        + mCumulatedIntakenWater.GetByteSize()
+        + mIsLeakingBuffer.GetByteSize()
+        + mFactoryIsLeakingBuffer.GetByteSize()
+        // Heat dynamics
+        + mTemperatureBuffer.GetByteSize()
+        + mTemperatureBackBuffer.GetByteSize()
+        + mMaterialHeatCapacityBuffer.GetByteSize()
+        + mMaterialIgnitionTemperatureBuffer.GetByteSize()
+        + mCombustionStateBuffer.GetByteSize()
+        // Electrical, wind, and rust dynamics
+        + mElectricalElementBuffer.GetByteSize()
+        + mLightBuffer.GetByteSize()
+        + mMaterialWindReceptivityBuffer.GetByteSize()
+        + mMaterialRustReceptivityBuffer.GetByteSize()
+        // Ephemeral particles
+        + mEphemeralTypeBuffer.GetByteSize()
+        + mEphemeralStartTimeBuffer.GetByteSize()
+        + mEphemeralMaxLifetimeBuffer.GetByteSize()
+        + mEphemeralStateBuffer.GetByteSize()
+        // Structure and connectivity
+        + mConnectedSprings.GetByteSize()
+        + mFactoryConnectedSprings.GetByteSize()
+        + mConnectedTriangles.GetByteSize()
+        + mFactoryConnectedTriangles.GetByteSize()
+        + mConnectedComponentIdBuffer.GetByteSize()
+        + mPlaneIdBuffer.GetByteSize()
+        + mPlaneIdFloatBuffer.GetByteSize()
+        + mCurrentConnectivityVisitSequenceNumberBuffer.GetByteSize()
+        // Pinning and repair
+        + mIsPinnedBuffer.GetByteSize()
+        + mRepairStateBuffer.GetByteSize()
+        // Immutable render attributes
+        + mColorBuffer.GetByteSize()
+        + mTextureCoordinatesBuffer.GetByteSize()
+        // Work buffers
+        + mFloatBufferAllocator.GetByteSize()
+        + mVec2fBufferAllocator.GetByteSize();
+
+#ifdef SPLIT_POINT_DYNAMICS_BUFFERS
+    footprint += mPositionUploadBuffer.GetByteSize() + mVelocityUploadBuffer.GetByteSize();
+#endif
+
+    return footprint;
+}
+
+void Points::SaveState(
+    CheckpointWriter & checkpoint,
+    MaterialDatabase const & materialDatabase) const
+{
+    VisitState(*this, checkpoint);
+
+    //
+    // Save the materials of ephemeral particles by their ordinal in the database
+    //
+
+    std::unordered_map<StructuralMaterial const *, std::uint32_t> materialOrdinals;
+    std::uint32_t materialOrdinal = 0;
+    for (auto const & entry : materialDatabase.GetStructuralMaterials())
+        materialOrdinals[&(entry.second)] = materialOrdinal++;
+
+    std::vector<std::uint32_t> ephemeralMaterialOrdinals;
+    ephemeralMaterialOrdinals.reserve(mEphemeralPointCount);
+    for (auto pointIndex : EphemeralPoints())
+    {
+        StructuralMaterial const * const material = mMaterialsBuffer[pointIndex].Structural;
+        ephemeralMaterialOrdinals.push_back(nullptr != material ? materialOrdinals.at(material) : NoneMaterialOrdinal);
+    }
+
+    checkpoint.Visit("EphemeralMaterial", ephemeralMaterialOrdinals);
+}
+
+void Points::LoadState(
+    CheckpointReader & checkpoint,
+    MaterialDatabase const & materialDatabase)
+{
+    VisitState(*this, checkpoint);
+
+    //
+    // Restore the materials of ephemeral particles
+    //
+
+    std::vector<StructuralMaterial const *> materials;
+    for (auto const & entry : materialDatabase.GetStructuralMaterials())
+        materials.push_back(&(entry.second));
+
+    std::vector<std::uint32_t> ephemeralMaterialOrdinals;
+    checkpoint.Visit("EphemeralMaterial", ephemeralMaterialOrdinals);
+    if (ephemeralMaterialOrdinals.size() != mEphemeralPointCount)
+    {
+        throw GameException("The checkpoint has a different number of ephemeral particles");
+    }
+
+    for (auto pointIndex : EphemeralPoints())
+    {
+        std::uint32_t const ordinal = ephemeralMaterialOrdinals[pointIndex - mShipPointCount];
+        if (ordinal != NoneMaterialOrdinal && ordinal >= materials.size())
+        {
+            throw GameException("The checkpoint references a material that does not exist");
+        }
+
+        mMaterialsBuffer[pointIndex] = Materials(
+            ordinal != NoneMaterialOrdinal ? materials[ordinal] : nullptr,
+            nullptr);
+    }
+
+    // Everything needs to be uploaded again
+    mIsDecayBufferDirty = true;
+    mIsTemperatureBufferDirty = true;
+    mIsPlaneIdBufferNonEphemeralDirty = true;
+    mIsPlaneIdBufferEphemeralDirty = true;
+    mIsWholeColorBufferDirty = true;
+    mIsTextureCoordinatesBufferDirty = true;
+    mAreEphemeralPointsDirty = true;
+}
+
 void Points::UploadAttributes(
     ShipId shipId,
     Render::RenderContext & renderContext) const
@@ -528,7 +675,7 @@ void Points::UploadAttributes(
 
     renderContext.UploadShipPointMutableAttributes(
         shipId,
-        mPositionBuffer.data(),
+        GetInterleavedPositionBuffer(),
         mLightBuffer.data(),
         mWaterBuffer.data());
 
@@ -607,7 +754,7 @@ void Points::UploadNonEphemeralPointElements(
     for (ElementIndex pointIndex : NonEphemeralPoints())
     {
         if (doUploadAllPoints
-            || mConnectedSpringsBuffer[pointIndex].ConnectedSprings.empty()) // orphaned
+            || mConnectedSprings.GetRow(pointIndex).empty()) // orphaned
         {
             renderContext.UploadShipElementPoint(
                 shipId,
@@ -627,9 +774,9 @@ void Points::UploadVectors(
         renderContext.UploadShipVectors(
             shipId,
             mElementCount,
-            mPositionBuffer.data(),
+            GetInterleavedPositionBuffer(),
             mPlaneIdFloatBuffer.data(),
-            mVelocityBuffer.data(),
+            GetInterleavedVelocityBuffer(),
             0.25f,
             VectorColor);
     }
@@ -638,7 +785,7 @@ void Points::UploadVectors(
         renderContext.UploadShipVectors(
             shipId,
             mElementCount,
-            mPositionBuffer.data(),
+            GetInterleavedPositionBuffer(),
             mPlaneIdFloatBuffer.data(),
             mForceRenderBuffer.data(),
             0.0005f,
@@ -649,7 +796,7 @@ void Points::UploadVectors(
         renderContext.UploadShipVectors(
             shipId,
             mElementCount,
-            mPositionBuffer.data(),
+            GetInterleavedPositionBuffer(),
             mPlaneIdFloatBuffer.data(),
             mWaterVelocityBuffer.data(),
             1.0f,
@@ -660,7 +807,7 @@ void Points::UploadVectors(
         renderContext.UploadShipVectors(
             shipId,
             mElementCount,
-            mPositionBuffer.data(),
+            GetInterleavedPositionBuffer(),
             mPlaneIdFloatBuffer.data(),
             mWaterMomentumBuffer.data(),
             0.4f,
@@ -754,7 +901,7 @@ void Points::AugmentMaterialMass(
         + offset;
 
     // Notify all connected springs
-    for (auto connectedSpring : mConnectedSpringsBuffer[pointElementIndex].ConnectedSprings)
+    for (auto connectedSpring : mConnectedSprings.GetRow(pointElementIndex))
     {
         springs.OnEndpointMassUpdated(connectedSpring.SpringIndex, *this);
     }
@@ -780,14 +927,97 @@ void Points::UpdateMasses(GameParameters const & gameParameters)
 
         mMassBuffer[i] = mass;
 
-        mIntegrationFactorBuffer[i] = vec2f(
+        mIntegrationFactorBuffer.set(i, vec2f(
             mIntegrationFactorTimeCoefficientBuffer[i] / mass,
-            mIntegrationFactorTimeCoefficientBuffer[i] / mass);
+            mIntegrationFactorTimeCoefficientBuffer[i] / mass));
     }
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////////
 
+template<typename TSelf, typename TArchive>
+void Points::VisitState(
+    TSelf & self,
+    TArchive & archive)
+{
+    // Dynamics
+    archive.Visit("Position", self.mPositionBuffer);
+    archive.Visit("Velocity", self.mVelocityBuffer);
+    archive.Visit("Force", self.mForceBuffer);
+    archive.Visit("AugmentedMaterialMass", self.mAugmentedMaterialMassBuffer);
+    archive.Visit("Mass", self.mMassBuffer);
+    archive.Visit("IntegrationFactorTimeCoefficient", self.mIntegrationFactorTimeCoefficientBuffer);
+    archive.Visit("IntegrationFactor", self.mIntegrationFactorBuffer);
+    archive.Visit("IsRope", self.mIsRopeBuffer);
+    archive.Visit("Decay", self.mDecayBuffer);
+    archive.Visit("ForceRender", self.mForceRenderBuffer);
+
+    // Water dynamics
+    archive.Visit("MaterialIsHull", self.mMaterialIsHullBuffer);
+    archive.Visit("MaterialWaterVolumeFill", self.mMaterialWaterVolumeFillBuffer);
+    archive.Visit("MaterialWaterIntake", self.mMaterialWaterIntakeBuffer);
+    archive.Visit("MaterialWaterRestitution", self.mMaterialWaterRestitutionBuffer);
+    archive.Visit("MaterialWaterDiffusionSpeed", self.mMaterialWaterDiffusionSpeedBuffer);
+    archive.Visit("Water", self.mWaterBuffer);
+    archive.Visit("WaterBack", self.mWaterBackBuffer);
+    archive.Visit("WaterVelocity", self.mWaterVelocityBuffer);
+    archive.Visit("WaterMomentum", self.mWaterMomentumBuffer);
+    archive.Visit("CumulatedIntakenWater", self.mCumulatedIntakenWater);
+    archive.Visit("IsLeaking", self.mIsLeakingBuffer);
+
+    // Heat dynamics
+    archive.Visit("Temperature", self.mTemperatureBuffer);
+    archive.Visit("TemperatureBack", self.mTemperatureBackBuffer);
+    archive.Visit("MaterialHeatCapacity", self.mMaterialHeatCapacityBuffer);
+    archive.Visit("MaterialIgnitionTemperature", self.mMaterialIgnitionTemperatureBuffer);
+
+    // Electrical, wind, and rust dynamics
+    archive.Visit("ElectricalElement", self.mElectricalElementBuffer);
+    archive.Visit("Light", self.mLightBuffer);
+    archive.Visit("MaterialWindReceptivity", self.mMaterialWindReceptivityBuffer);
+    archive.Visit("MaterialRustReceptivity", self.mMaterialRustReceptivityBuffer);
+
+    // Ephemeral particles
+    archive.Visit("EphemeralType", self.mEphemeralTypeBuffer);
+    archive.Visit("EphemeralStartTime", self.mEphemeralStartTimeBuffer);
+    archive.Visit("EphemeralMaxLifetime", self.mEphemeralMaxLifetimeBuffer);
+    archive.Visit("EphemeralState", self.mEphemeralStateBuffer);
+    archive.Visit("FreeEphemeralParticleSearchStartIndex", self.mFreeEphemeralParticleSearchStartIndex);
+
+    // Structure and connectivity
+    archive.Visit("ConnectedSprings", self.mConnectedSprings);
+    archive.Visit("ConnectedTriangles", self.mConnectedTriangles);
+    archive.Visit("ConnectedComponentId", self.mConnectedComponentIdBuffer);
+    archive.Visit("PlaneId", self.mPlaneIdBuffer);
+    archive.Visit("PlaneIdFloat", self.mPlaneIdFloatBuffer);
+    archive.Visit("CurrentConnectivityVisitSequenceNumber", self.mCurrentConnectivityVisitSequenceNumberBuffer);
+    archive.Visit("IsPinned", self.mIsPinnedBuffer);
+
+    // Render attributes
+    archive.Visit("Color", self.mColorBuffer);
+    archive.Visit("TextureCoordinates", self.mTextureCoordinatesBuffer);
+
+    // Factory state
+    archive.Visit("FactoryIsLeaking", self.mFactoryIsLeakingBuffer);
+    archive.Visit("FactoryConnectedSprings", self.mFactoryConnectedSprings);
+    archive.Visit("FactoryConnectedTriangles", self.mFactoryConnectedTriangles);
+
+    // Combustion and repair state
+    archive.Visit("CombustionState", self.mCombustionStateBuffer);
+    archive.Visit("RepairState", self.mRepairStateBuffer);
+
+    // Parameters we are current with
+    archive.Visit("CurrentNumMechanicalDynamicsIterations", self.mCurrentNumMechanicalDynamicsIterations);
+    archive.Visit("CurrentCumulatedIntakenWaterThresholdForAirBubbles", self.mCurrentCumulatedIntakenWaterThresholdForAirBubbles);
+}
+
+float Points::RandomizeCumulatedIntakenWater(float cumulatedIntakenWaterThresholdForAirBubbles)
+{
+    return mParentWorld.GetRandomEngine().GenerateRandomReal(
+        0.0f,
+        cumulatedIntakenWaterThresholdForAirBubbles);
+}
+
 ElementIndex Points::FindFreeEphemeralParticle(
     float currentSimulationTime,
     bool force)
@@ -7,17 +7,21 @@
 
 #include "GameEventDispatcher.h"
 #include "GameParameters.h"
+#include "MaterialDatabase.h"
 #include "Materials.h"
 #include "RenderContext.h"
 
+#include <GameCore/BitBuffer.h>
 #include <GameCore/Buffer.h>
 #include <GameCore/BufferAllocator.h>
+#include <GameCore/Checkpoint.h>
+#include <GameCore/CsrAdjacencyList.h>
 #include <GameCore/ElementContainer.h>
 #include <GameCore/ElementIndexRangeIterator.h>
 #include <GameCore/EnumFlags.h>
 #include <GameCore/FixedSizeVector.h>
-#include <GameCore/GameRandomEngine.h>
 #include <GameCore/GameTypes.h>
+#include <GameCore/Vec2fBuffers.h>
 #include <GameCore/Vectors.h>
 
 #include <cassert>
@@ -33,6 +37,17 @@ class Points : public ElementContainer
 {
 public:
 
+    /*
+     * The layout of the buffers of positions, velocities, forces, and integration factors;
+     * kernels that stream through these buffers are written against the interface common
+     * to both layouts.
+     */
+#ifdef SPLIT_POINT_DYNAMICS_BUFFERS
+    using DynamicsBuffer = SplitVec2fBuffer;
+#else
+    using DynamicsBuffer = InterleavedVec2fBuffer;
+#endif
+
     enum class DetachOptions
     {
         DoNotGenerateDebris = 0,
@@ -85,6 +100,37 @@ public:
         {}
     };
 
+    /*
+     * The metadata of a single spring connected to a point.
+     */
+    struct ConnectedSpring
+    {
+        ElementIndex SpringIndex;
+        ElementIndex OtherEndpointIndex;
+
+        ConnectedSpring()
+            : SpringIndex(NoneElementIndex)
+            , OtherEndpointIndex(NoneElementIndex)
+        {}
+
+        ConnectedSpring(
+            ElementIndex springIndex,
+            ElementIndex otherEndpointIndex)
+            : SpringIndex(springIndex)
+            , OtherEndpointIndex(otherEndpointIndex)
+        {}
+    };
+
+    /*
+     * The springs connected to all points, one row per point.
+     */
+    using ConnectedSpringsList = CsrAdjacencyList<ConnectedSpring>;
+
+    /*
+     * The triangles connected to all points, one row per point.
+     */
+    using ConnectedTrianglesList = CsrAdjacencyList<ElementIndex>;
+
 private:
 
     /*
@@ -178,131 +224,6 @@ private:
         {}
     };
 
-    /*
-     * The metadata of a single spring connected to a point.
-     */
-    struct ConnectedSpring
-    {
-        ElementIndex SpringIndex;
-        ElementIndex OtherEndpointIndex;
-
-        ConnectedSpring()
-            : SpringIndex(NoneElementIndex)
-            , OtherEndpointIndex(NoneElementIndex)
-        {}
-
-        ConnectedSpring(
-            ElementIndex springIndex,
-            ElementIndex otherEndpointIndex)
-            : SpringIndex(springIndex)
-            , OtherEndpointIndex(otherEndpointIndex)
-        {}
-    };
-
-    /*
-     * The metadata of all the springs connected to a point.
-     */
-    struct ConnectedSpringsVector
-    {
-        FixedSizeVector<ConnectedSpring, GameParameters::MaxSpringsPerPoint> ConnectedSprings;
-        size_t OwnedConnectedSpringsCount;
-
-        ConnectedSpringsVector()
-            : ConnectedSprings()
-            , OwnedConnectedSpringsCount(0u)
-        {}
-
-        inline void ConnectSpring(
-            ElementIndex springElementIndex,
-            ElementIndex otherEndpointElementIndex,
-            bool isAtOwner)
-        {
-            // Add so that all springs owned by this point come first
-            if (isAtOwner)
-            {
-                ConnectedSprings.emplace_front(springElementIndex, otherEndpointElementIndex);
-                ++OwnedConnectedSpringsCount;
-            }
-            else
-            {
-                ConnectedSprings.emplace_back(springElementIndex, otherEndpointElementIndex);
-            }
-        }
-
-        inline void DisconnectSpring(
-            ElementIndex springElementIndex,
-            bool isAtOwner)
-        {
-            bool found = ConnectedSprings.erase_first(
-                [springElementIndex](ConnectedSpring const & c)
-                {
-                    return c.SpringIndex == springElementIndex;
-                });
-
-            assert(found);
-            (void)found;
-
-            // Update count of owned springs, if this spring is owned
-            if (isAtOwner)
-            {
-                assert(OwnedConnectedSpringsCount > 0);
-                --OwnedConnectedSpringsCount;
-            }
-        }
-    };
-
-    /*
-     * The metadata of all the triangles connected to a point.
-     */
-    struct ConnectedTrianglesVector
-    {
-        FixedSizeVector<ElementIndex, GameParameters::MaxTrianglesPerPoint> ConnectedTriangles;
-        size_t OwnedConnectedTrianglesCount;
-
-        ConnectedTrianglesVector()
-            : ConnectedTriangles()
-            , OwnedConnectedTrianglesCount(0u)
-        {}
-
-        inline void ConnectTriangle(
-            ElementIndex triangleElementIndex,
-            bool isAtOwner)
-        {
-            // Add so that all triangles owned by this point come first
-            if (isAtOwner)
-            {
-                ConnectedTriangles.emplace_front(triangleElementIndex);
-                ++OwnedConnectedTrianglesCount;
-            }
-            else
-            {
-                ConnectedTriangles.emplace_back(triangleElementIndex);
-            }
-        }
-
-        inline void DisconnectTriangle(
-            ElementIndex triangleElementIndex,
-            bool isAtOwner)
-        {
-            bool found = ConnectedTriangles.erase_first(
-                [triangleElementIndex](ElementIndex c)
-                {
-                    return c == triangleElementIndex;
-                });
-
-            assert(found);
-            (void)found;
-
-            // Update count of owned triangles, if this triangle is owned
-            if (isAtOwner)
-            {
-                assert(OwnedConnectedTrianglesCount > 0);
-                --OwnedConnectedTrianglesCount;
-            }
-        }
-    };
-
-
     /*
      * The materials of this point.
      */
@@ -344,6 +265,10 @@ public:
         , mIntegrationFactorTimeCoefficientBuffer(mBufferElementCount, shipPointCount, 0.0f)
         , mIntegrationFactorBuffer(mBufferElementCount, shipPointCount, vec2f::zero())
         , mForceRenderBuffer(mBufferElementCount, shipPointCount, vec2f::zero())
+#ifdef SPLIT_POINT_DYNAMICS_BUFFERS
+        , mPositionUploadBuffer(mBufferElementCount, shipPointCount, vec2f::zero())
+        , mVelocityUploadBuffer(mBufferElementCount, shipPointCount, vec2f::zero())
+#endif
         // Water dynamics
         , mMaterialIsHullBuffer(mBufferElementCount, shipPointCount, false)
         , mMaterialWaterVolumeFillBuffer(mBufferElementCount, shipPointCount, 0.0f)
@@ -351,6 +276,7 @@ public:
         , mMaterialWaterRestitutionBuffer(mBufferElementCount, shipPointCount, 0.0f)
         , mMaterialWaterDiffusionSpeedBuffer(mBufferElementCount, shipPointCount, 0.0f)
         , mWaterBuffer(mBufferElementCount, shipPointCount, 0.0f)
+        , mWaterBackBuffer(mBufferElementCount, shipPointCount, 0.0f)
         , mWaterVelocityBuffer(mBufferElementCount, shipPointCount, vec2f::zero())
         , mWaterMomentumBuffer(mBufferElementCount, shipPointCount, vec2f::zero())
         , mCumulatedIntakenWater(mBufferElementCount, shipPointCount, 0.0f)
@@ -358,6 +284,7 @@ public:
         , mFactoryIsLeakingBuffer(mBufferElementCount, shipPointCount, false)
         // Heat dynamics
         , mTemperatureBuffer(mBufferElementCount, shipPointCount, 0.0f)
+        , mTemperatureBackBuffer(mBufferElementCount, shipPointCount, 0.0f)
         , mIsTemperatureBufferDirty(true)
         , mMaterialHeatCapacityBuffer(mBufferElementCount, shipPointCount, 0.0f)
         , mMaterialIgnitionTemperatureBuffer(mBufferElementCount, shipPointCount, 0.0f)
@@ -375,10 +302,10 @@ public:
         , mEphemeralMaxLifetimeBuffer(mBufferElementCount, shipPointCount, 0.0f)
         , mEphemeralStateBuffer(mBufferElementCount, shipPointCount, EphemeralState::DebrisState())
         // Structure
-        , mConnectedSpringsBuffer(mBufferElementCount, shipPointCount, ConnectedSpringsVector())
-        , mFactoryConnectedSpringsBuffer(mBufferElementCount, shipPointCount, ConnectedSpringsVector())
-        , mConnectedTrianglesBuffer(mBufferElementCount, shipPointCount, ConnectedTrianglesVector())
-        , mFactoryConnectedTrianglesBuffer(mBufferElementCount, shipPointCount, ConnectedTrianglesVector())
+        , mConnectedSprings(mElementCount)
+        , mFactoryConnectedSprings(mElementCount)
+        , mConnectedTriangles(mElementCount)
+        , mFactoryConnectedTriangles(mElementCount)
         // Connected component and plane ID
         , mConnectedComponentIdBuffer(mBufferElementCount, shipPointCount, NoneConnectedComponentId)
         , mPlaneIdBuffer(mBufferElementCount, shipPointCount, NonePlaneId)
@@ -407,8 +334,8 @@ public:
         , mEphemeralParticleDestroyHandler()
         , mCurrentNumMechanicalDynamicsIterations(gameParameters.NumMechanicalDynamicsIterations<float>())
         , mCurrentCumulatedIntakenWaterThresholdForAirBubbles(gameParameters.CumulatedIntakenWaterThresholdForAirBubbles)
-        , mFloatBufferAllocator(mBufferElementCount)
-        , mVec2fBufferAllocator(mBufferElementCount)
+        , mFloatBufferAllocator(mBufferElementCount, 1)
+        , mVec2fBufferAllocator(mBufferElementCount, 0)
         , mFreeEphemeralParticleSearchStartIndex(mShipPointCount)
         , mAreEphemeralPointsDirty(false)
     {
@@ -416,6 +343,25 @@ public:
 
     Points(Points && other) = default;
 
+    /*
+     * Returns the number of bytes currently occupied by all of the buffers of this container.
+     */
+    size_t GetMemoryFootprint() const;
+
+    /*
+     * Saves and restores the state of all points. The materials of ship points are not
+     * part of the state, hence the state may only be restored onto points built from
+     * the same ship definition; the materials of ephemeral particles are saved as
+     * references into the material database.
+     */
+    void SaveState(
+        CheckpointWriter & checkpoint,
+        MaterialDatabase const & materialDatabase) const;
+
+    void LoadState(
+        CheckpointReader & checkpoint,
+        MaterialDatabase const & materialDatabase);
+
     /*
      * Returns an iterator for the non-ephemeral (ship) points only.
      */
@@ -600,68 +546,72 @@ public:
     // Dynamics
     //
 
-    vec2f const & GetPosition(ElementIndex pointElementIndex) const
+    vec2f GetPosition(ElementIndex pointElementIndex) const
     {
-        return mPositionBuffer[pointElementIndex];
+        return mPositionBuffer.get(pointElementIndex);
     }
 
-    vec2f & GetPosition(ElementIndex pointElementIndex)
-    {
-        return mPositionBuffer[pointElementIndex];
-    }
-
-    vec2f * restrict GetPositionBufferAsVec2()
-    {
-        return mPositionBuffer.data();
-    }
-
-    float * restrict GetPositionBufferAsFloat()
+    void SetPosition(
+        ElementIndex pointElementIndex,
+        vec2f const & position)
     {
-        return reinterpret_cast<float *>(mPositionBuffer.data());
+        mPositionBuffer.set(pointElementIndex, position);
     }
 
-    vec2f const & GetVelocity(ElementIndex pointElementIndex) const
+    void AddPosition(
+        ElementIndex pointElementIndex,
+        vec2f const & offset)
     {
-        return mVelocityBuffer[pointElementIndex];
+        mPositionBuffer.add(pointElementIndex, offset);
     }
 
-    vec2f & GetVelocity(ElementIndex pointElementIndex)
+    DynamicsBuffer & GetPositionBuffer()
     {
-        return mVelocityBuffer[pointElementIndex];
+        return mPositionBuffer;
     }
 
-    vec2f * restrict GetVelocityBufferAsVec2()
+    DynamicsBuffer const & GetPositionBuffer() const
     {
-        return mVelocityBuffer.data();
+        return mPositionBuffer;
     }
 
-    float * restrict GetVelocityBufferAsFloat()
+    vec2f GetVelocity(ElementIndex pointElementIndex) const
     {
-        return reinterpret_cast<float *>(mVelocityBuffer.data());
+        return mVelocityBuffer.get(pointElementIndex);
     }
 
     void SetVelocity(
         ElementIndex pointElementIndex,
         vec2f const & velocity)
     {
-        mVelocityBuffer[pointElementIndex] = velocity;
+        mVelocityBuffer.set(pointElementIndex, velocity);
     }
 
-    vec2f const & GetForce(ElementIndex pointElementIndex) const
+    DynamicsBuffer & GetVelocityBuffer()
     {
-        return mForceBuffer[pointElementIndex];
+        return mVelocityBuffer;
     }
 
-    vec2f & GetForce(ElementIndex pointElementIndex)
+    DynamicsBuffer const & GetVelocityBuffer() const
     {
-        return mForceBuffer[pointElementIndex];
+        return mVelocityBuffer;
+    }
+
+    vec2f GetForce(ElementIndex pointElementIndex) const
+    {
+        return mForceBuffer.get(pointElementIndex);
     }
 
     void AddForce(
         ElementIndex pointElementIndex,
         vec2f const & force)
     {
-        mForceBuffer[pointElementIndex] += force;
+        mForceBuffer.add(pointElementIndex, force);
+    }
+
+    DynamicsBuffer & GetForceBuffer()
+    {
+        return mForceBuffer;
     }
 
     float GetAugmentedMaterialMass(ElementIndex pointElementIndex) const
@@ -712,9 +662,9 @@ public:
      * Only valid after a call to UpdateMasses() and when
      * neither water quantities nor masses have changed since then.
      */
-    float * restrict GetIntegrationFactorBufferAsFloat()
+    DynamicsBuffer & GetIntegrationFactorBuffer()
     {
-        return reinterpret_cast<float *>(mIntegrationFactorBuffer.data());
+        return mIntegrationFactorBuffer;
     }
 
     // Changes the point's dynamics so that it freezes in place
@@ -723,7 +673,7 @@ public:
     {
         // Zero-out integration factor time coefficient and velocity, freezing point
         mIntegrationFactorTimeCoefficientBuffer[pointElementIndex] = 0.0f;
-        mVelocityBuffer[pointElementIndex] = vec2f(0.0f, 0.0f);
+        mVelocityBuffer.set(pointElementIndex, vec2f(0.0f, 0.0f));
     }
 
     // Changes the point's dynamics so that the point reacts again to forces
@@ -734,14 +684,9 @@ public:
     }
 
 
-    float * restrict GetForceBufferAsFloat()
-    {
-        return reinterpret_cast<float *>(mForceBuffer.data());
-    }
-
     void CopyForceBufferToForceRenderBuffer()
     {
-        mForceRenderBuffer.copy_from(mForceBuffer);
+        mForceBuffer.copy_to(mForceRenderBuffer.data());
     }
 
     //
@@ -795,17 +740,20 @@ public:
         return mWaterBuffer[pointElementIndex] > threshold;
     }
 
-    std::shared_ptr<Buffer<float>> MakeWaterBufferCopy()
+    /*
+     * Initializes the water back buffer with the current water quantities and returns it;
+     * the back buffer becomes the current water buffer with SwapWaterBuffers().
+     */
+    float * PrepareWaterBackBuffer()
     {
-        auto waterBufferCopy = mFloatBufferAllocator.Allocate();
-        waterBufferCopy->copy_from(mWaterBuffer);
+        mWaterBackBuffer.copy_from(mWaterBuffer);
 
-        return waterBufferCopy;
+        return mWaterBackBuffer.data();
     }
 
-    void UpdateWaterBuffer(std::shared_ptr<Buffer<float>> newWaterBuffer)
+    void SwapWaterBuffers()
     {
-        mWaterBuffer.copy_from(*newWaterBuffer);
+        mWaterBuffer.swap(mWaterBackBuffer);
     }
 
     vec2f * restrict GetWaterVelocityBufferAsVec2()
@@ -875,7 +823,7 @@ public:
 
     void SetLeaking(ElementIndex pointElementIndex)
     {
-        mIsLeakingBuffer[pointElementIndex] = true;
+        mIsLeakingBuffer.set(pointElementIndex, true);
 
         // Randomize the initial water intaken, so that air bubbles won't come out all at the same moment
         mCumulatedIntakenWater[pointElementIndex] = RandomizeCumulatedIntakenWater(mCurrentCumulatedIntakenWaterThresholdForAirBubbles);
@@ -883,7 +831,7 @@ public:
 
     void RestoreFactoryIsLeaking(ElementIndex pointElementIndex)
     {
-        mIsLeakingBuffer[pointElementIndex] = mFactoryIsLeakingBuffer[pointElementIndex];
+        mIsLeakingBuffer.set(pointElementIndex, mFactoryIsLeakingBuffer[pointElementIndex]);
     }
 
     //
@@ -912,17 +860,20 @@ public:
         mIsTemperatureBufferDirty = true;
     }
 
-    std::shared_ptr<Buffer<float>> MakeTemperatureBufferCopy()
+    /*
+     * Initializes the temperature back buffer with the current temperatures and returns it;
+     * the back buffer becomes the current temperature buffer with SwapTemperatureBuffers().
+     */
+    float * PrepareTemperatureBackBuffer()
     {
-        auto temperatureBufferCopy = mFloatBufferAllocator.Allocate();
-        temperatureBufferCopy->copy_from(mTemperatureBuffer);
+        mTemperatureBackBuffer.copy_from(mTemperatureBuffer);
 
-        return temperatureBufferCopy;
+        return mTemperatureBackBuffer.data();
     }
 
-    void UpdateTemperatureBuffer(std::shared_ptr<Buffer<float>> newTemperatureBuffer)
+    void SwapTemperatureBuffers()
     {
-        mTemperatureBuffer.copy_from(*newTemperatureBuffer);
+        mTemperatureBuffer.swap(mTemperatureBackBuffer);
     }
 
     float GetMaterialHeatCapacity(ElementIndex pointElementIndex) const
@@ -980,9 +931,13 @@ public:
     // Network
     //
 
-    auto const & GetConnectedSprings(ElementIndex pointElementIndex) const
+    /*
+     * Returns a live view of the springs currently connected to the point;
+     * the springs owned by the point come first.
+     */
+    auto GetConnectedSprings(ElementIndex pointElementIndex) const
     {
-        return mConnectedSpringsBuffer[pointElementIndex];
+        return mConnectedSprings.GetRow(pointElementIndex);
     }
 
     void ConnectSpring(
@@ -991,15 +946,15 @@ public:
         ElementIndex otherEndpointElementIndex,
         bool isAtOwner)
     {
-        assert(mFactoryConnectedSpringsBuffer[pointElementIndex].ConnectedSprings.contains(
+        assert(mFactoryConnectedSprings.GetRow(pointElementIndex).contains(
             [springElementIndex](auto const & cs)
             {
                 return cs.SpringIndex == springElementIndex;
             }));
 
-        mConnectedSpringsBuffer[pointElementIndex].ConnectSpring(
-            springElementIndex,
-            otherEndpointElementIndex,
+        mConnectedSprings.Connect(
+            pointElementIndex,
+            ConnectedSpring(springElementIndex, otherEndpointElementIndex),
             isAtOwner);
     }
 
@@ -1008,39 +963,39 @@ public:
         ElementIndex springElementIndex,
         bool isAtOwner)
     {
-        mConnectedSpringsBuffer[pointElementIndex].DisconnectSpring(
-            springElementIndex,
+        mConnectedSprings.Disconnect(
+            pointElementIndex,
+            [springElementIndex](ConnectedSpring const & cs)
+            {
+                return cs.SpringIndex == springElementIndex;
+            },
             isAtOwner);
     }
 
-    auto const & GetFactoryConnectedSprings(ElementIndex pointElementIndex) const
+    auto GetFactoryConnectedSprings(ElementIndex pointElementIndex) const
     {
-        return mFactoryConnectedSpringsBuffer[pointElementIndex];
+        return mFactoryConnectedSprings.GetRow(pointElementIndex);
     }
 
-    void AddFactoryConnectedSpring(
-        ElementIndex pointElementIndex,
-        ElementIndex springElementIndex,
-        ElementIndex otherEndpointElementIndex,
-        bool isAtOwner)
+    /*
+     * Sets the springs connected to each point at factory time; all of these
+     * springs are initially connected.
+     */
+    void SetFactoryConnectedSprings(ConnectedSpringsList && factoryConnectedSprings)
     {
-        // Add spring
-        mFactoryConnectedSpringsBuffer[pointElementIndex].ConnectSpring(
-            springElementIndex,
-            otherEndpointElementIndex,
-            isAtOwner);
+        assert(factoryConnectedSprings.GetRowCount() == mElementCount);
 
-        // Connect spring
-        ConnectSpring(
-            pointElementIndex,
-            springElementIndex,
-            otherEndpointElementIndex,
-            isAtOwner);
+        mFactoryConnectedSprings = std::move(factoryConnectedSprings);
+        mConnectedSprings = mFactoryConnectedSprings;
     }
 
-    auto const & GetConnectedTriangles(ElementIndex pointElementIndex) const
+    /*
+     * Returns a live view of the triangles currently connected to the point;
+     * the triangles owned by the point come first.
+     */
+    auto GetConnectedTriangles(ElementIndex pointElementIndex) const
     {
-        return mConnectedTrianglesBuffer[pointElementIndex];
+        return mConnectedTriangles.GetRow(pointElementIndex);
     }
 
     void ConnectTriangle(
@@ -1048,13 +1003,14 @@ public:
         ElementIndex triangleElementIndex,
         bool isAtOwner)
     {
-        assert(mFactoryConnectedTrianglesBuffer[pointElementIndex].ConnectedTriangles.contains(
+        assert(mFactoryConnectedTriangles.GetRow(pointElementIndex).contains(
             [triangleElementIndex](auto const & ct)
             {
                 return ct == triangleElementIndex;
             }));
 
-        mConnectedTrianglesBuffer[pointElementIndex].ConnectTriangle(
+        mConnectedTriangles.Connect(
+            pointElementIndex,
             triangleElementIndex,
             isAtOwner);
     }
@@ -1064,36 +1020,35 @@ public:
         ElementIndex triangleElementIndex,
         bool isAtOwner)
     {
-        mConnectedTrianglesBuffer[pointElementIndex].DisconnectTriangle(
-            triangleElementIndex,
+        mConnectedTriangles.Disconnect(
+            pointElementIndex,
+            [triangleElementIndex](ElementIndex ct)
+            {
+                return ct == triangleElementIndex;
+            },
             isAtOwner);
     }
 
     size_t GetConnectedOwnedTrianglesCount(ElementIndex pointElementIndex) const
     {
-        return mConnectedTrianglesBuffer[pointElementIndex].OwnedConnectedTrianglesCount;
+        return mConnectedTriangles.GetRowOwnedSize(pointElementIndex);
     }
 
-    auto const & GetFactoryConnectedTriangles(ElementIndex pointElementIndex) const
+    auto GetFactoryConnectedTriangles(ElementIndex pointElementIndex) const
     {
-        return mFactoryConnectedTrianglesBuffer[pointElementIndex];
+        return mFactoryConnectedTriangles.GetRow(pointElementIndex);
     }
 
-    void AddFactoryConnectedTriangle(
-        ElementIndex pointElementIndex,
-        ElementIndex triangleElementIndex,
-        bool isAtOwner)
+    /*
+     * Sets the triangles connected to each point at factory time; all of these
+     * triangles are initially connected.
+     */
+    void SetFactoryConnectedTriangles(ConnectedTrianglesList && factoryConnectedTriangles)
     {
-        // Add triangle
-        mFactoryConnectedTrianglesBuffer[pointElementIndex].ConnectTriangle(
-            triangleElementIndex,
-            isAtOwner);
+        assert(factoryConnectedTriangles.GetRowCount() == mElementCount);
 
-        // Connect triangle
-        ConnectTriangle(
-            pointElementIndex,
-            triangleElementIndex,
-            isAtOwner);
+        mFactoryConnectedTriangles = std::move(factoryConnectedTriangles);
+        mConnectedTriangles = mFactoryConnectedTriangles;
     }
 
     //
@@ -1157,7 +1112,7 @@ public:
     {
         assert(false == mIsPinnedBuffer[pointElementIndex]);
 
-        mIsPinnedBuffer[pointElementIndex] = true;
+        mIsPinnedBuffer.set(pointElementIndex, true);
 
         Freeze(pointElementIndex);
     }
@@ -1166,7 +1121,7 @@ public:
     {
         assert(true == mIsPinnedBuffer[pointElementIndex]);
 
-        mIsPinnedBuffer[pointElementIndex] = false;
+        mIsPinnedBuffer.set(pointElementIndex, false);
 
         Thaw(pointElementIndex);
     }
@@ -1200,12 +1155,12 @@ public:
     // Temporary buffer
     //
 
-    std::shared_ptr<Buffer<float>> AllocateWorkBufferFloat()
+    BufferAllocator<float>::BufferHandle AllocateWorkBufferFloat()
     {
         return mFloatBufferAllocator.Allocate();
     }
 
-    std::shared_ptr<Buffer<vec2f>> AllocateWorkBufferVec2f()
+    BufferAllocator<vec2f>::BufferHandle AllocateWorkBufferVec2f()
     {
         return mVec2fBufferAllocator.Allocate();
     }
@@ -1218,17 +1173,39 @@ private:
             * GameParameters::MechanicalSimulationStepTimeDuration<float>(numMechanicalDynamicsIterations);
     }
 
-    static inline float RandomizeCumulatedIntakenWater(float cumulatedIntakenWaterThresholdForAirBubbles)
-    {
-        return GameRandomEngine::GetInstance().GenerateRandomReal(
-            0.0f,
-            cumulatedIntakenWaterThresholdForAirBubbles);
-    }
+    float RandomizeCumulatedIntakenWater(float cumulatedIntakenWaterThresholdForAirBubbles);
+
+    // Visits the members making up the state, both for saving and for restoring
+    template<typename TSelf, typename TArchive>
+    static void VisitState(
+        TSelf & self,
+        TArchive & archive);
 
     ElementIndex FindFreeEphemeralParticle(
         float currentSimulationTime,
         bool force);
 
+    // The render context consumes interleaved vectors
+    inline vec2f const * GetInterleavedPositionBuffer() const
+    {
+#ifdef SPLIT_POINT_DYNAMICS_BUFFERS
+        mPositionBuffer.copy_to(mPositionUploadBuffer.data());
+        return mPositionUploadBuffer.data();
+#else
+        return mPositionBuffer.data();
+#endif
+    }
+
+    inline vec2f const * GetInterleavedVelocityBuffer() const
+    {
+#ifdef SPLIT_POINT_DYNAMICS_BUFFERS
+        mVelocityBuffer.copy_to(mVelocityUploadBuffer.data());
+        return mVelocityUploadBuffer.data();
+#else
+        return mVelocityBuffer.data();
+#endif
+    }
+
     inline void ExpireEphemeralParticle(ElementIndex pointElementIndex)
     {
         // Freeze the particle (just to prevent drifting)
@@ -1246,31 +1223,39 @@ private:
     // Buffers
     //////////////////////////////////////////////////////////
 
+    // Boolean flags are packed one bit per point
+
     // Materials
     Buffer<Materials> mMaterialsBuffer;
-    Buffer<bool> mIsRopeBuffer;
+    BitBuffer mIsRopeBuffer;
 
     //
     // Dynamics
     //
 
-    Buffer<vec2f> mPositionBuffer;
-    Buffer<vec2f> mVelocityBuffer;
-    Buffer<vec2f> mForceBuffer;
+    DynamicsBuffer mPositionBuffer;
+    DynamicsBuffer mVelocityBuffer;
+    DynamicsBuffer mForceBuffer;
     Buffer<float> mAugmentedMaterialMassBuffer; // Structural + Offset
     Buffer<float> mMassBuffer; // Augmented + Water
     Buffer<float> mDecayBuffer; // 1.0 -> 0.0 (completely decayed)
     bool mutable mIsDecayBufferDirty;
     Buffer<float> mIntegrationFactorTimeCoefficientBuffer; // dt^2 or zero when the point is frozen
 
-    Buffer<vec2f> mIntegrationFactorBuffer;
+    DynamicsBuffer mIntegrationFactorBuffer;
     Buffer<vec2f> mForceRenderBuffer;
 
+#ifdef SPLIT_POINT_DYNAMICS_BUFFERS
+    // Interleaved copies of positions and velocities, for uploading
+    Buffer<vec2f> mutable mPositionUploadBuffer;
+    Buffer<vec2f> mutable mVelocityUploadBuffer;
+#endif
+
     //
     // Water dynamics
     //
 
-    Buffer<bool> mMaterialIsHullBuffer;
+    BitBuffer mMaterialIsHullBuffer;
     Buffer<float> mMaterialWaterVolumeFillBuffer;
     Buffer<float> mMaterialWaterIntakeBuffer;
     Buffer<float> mMaterialWaterRestitutionBuffer;
@@ -1279,6 +1264,7 @@ private:
     // Height of a 1m2 column of water which provides a pressure equivalent to the pressure at
     // this point. Quantity of water is max(water, 1.0)
     Buffer<float> mWaterBuffer;
+    Buffer<float> mWaterBackBuffer; // Target of water dynamics, swapped with the water buffer
 
     // Total velocity of the water at this point
     Buffer<vec2f> mWaterVelocityBuffer;
@@ -1291,14 +1277,15 @@ private:
     Buffer<float> mCumulatedIntakenWater;
 
     // When true, the point is intaking water
-    Buffer<bool> mIsLeakingBuffer;
-    Buffer<bool> mFactoryIsLeakingBuffer;
+    BitBuffer mIsLeakingBuffer;
+    BitBuffer mFactoryIsLeakingBuffer;
 
     //
     // Heat dynamics
     //
 
     Buffer<float> mTemperatureBuffer; // Kelvin
+    Buffer<float> mTemperatureBackBuffer; // Target of heat dynamics, swapped with the temperature buffer
     bool mutable mIsTemperatureBufferDirty;
     Buffer<float> mMaterialHeatCapacityBuffer;
     Buffer<float> mMaterialIgnitionTemperatureBuffer;
@@ -1339,10 +1326,10 @@ private:
     // Structure
     //
 
-    Buffer<ConnectedSpringsVector> mConnectedSpringsBuffer;
-    Buffer<ConnectedSpringsVector> mFactoryConnectedSpringsBuffer;
-    Buffer<ConnectedTrianglesVector> mConnectedTrianglesBuffer;
-    Buffer<ConnectedTrianglesVector> mFactoryConnectedTrianglesBuffer;
+    ConnectedSpringsList mConnectedSprings;
+    ConnectedSpringsList mFactoryConnectedSprings;
+    ConnectedTrianglesList mConnectedTriangles;
+    ConnectedTrianglesList mFactoryConnectedTriangles;
 
     //
     // Connectivity
@@ -1359,7 +1346,7 @@ private:
     // Pinning
     //
 
-    Buffer<bool> mIsPinnedBuffer;
+    BitBuffer mIsPinnedBuffer;
 
     //
     // Repair state
@@ -1376,7 +1363,6 @@ private:
     Buffer<vec2f> mTextureCoordinatesBuffer;
     bool mutable mIsTextureCoordinatesBufferDirty; // Whether or not is dirty since last render upload
 
-
     //////////////////////////////////////////////////////////
     // Container
     //////////////////////////////////////////////////////////
@@ -12,7 +12,9 @@
 #include <GameCore/ImageTools.h>
 #include <GameCore/Log.h>
 
+#include <chrono>
 #include <cstring>
+#include <future>
 
 namespace Render {
 
@@ -105,14 +107,53 @@ RenderContext::RenderContext(
     GLuint tmpGLuint;
 
 
+    //
+    // Start loading texture database - on a worker thread, as it's all file I/O
+    // and JSON parsing; meanwhile we do the OpenGL work on this thread
+    //
+
+    struct TextureDatabaseLoadResult
+    {
+        std::unique_ptr<TextureCache> Cache;
+        TextureDatabase Database;
+    };
+
+    std::future<TextureDatabaseLoadResult> textureDatabaseFuture = std::async(
+        std::launch::async,
+        [&resourceLoader]()
+        {
+            auto const startTimestamp = std::chrono::steady_clock::now();
+
+            // Load the cache of texture products, which spares us most of the work below
+            std::unique_ptr<TextureCache> textureCache = TextureCache::Load(
+                resourceLoader.GetTextureCacheFilePath(),
+                resourceLoader.GetTexturesFilePath());
+
+            TextureDatabase textureDatabase = TextureDatabase::Load(
+                resourceLoader,
+                *textureCache,
+                [](float, std::string const &) {});
+
+            LogMessage("RenderContext: loaded texture database in ",
+                std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTimestamp).count(), "ms");
+
+            return TextureDatabaseLoadResult{ std::move(textureCache), std::move(textureDatabase) };
+        });
+
+
     //
     // Load shader manager
     //
 
     progressCallback(0.0f, "Loading shaders...");
 
+    auto stageStartTimestamp = std::chrono::steady_clock::now();
+
     mShaderManager = ShaderManager<ShaderManagerTraits>::CreateInstance(resourceLoader.GetRenderShadersRootPath());
 
+    LogMessage("RenderContext: loaded shaders in ",
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - stageStartTimestamp).count(), "ms");
+
 
     //
     // Initialize OpenGL
@@ -126,6 +167,8 @@ RenderContext::RenderContext(
     // Initialize text render context
     //
 
+    stageStartTimestamp = std::chrono::steady_clock::now();
+
     mTextRenderContext = std::make_unique<TextRenderContext>(
         resourceLoader,
         *(mShaderManager.get()),
@@ -137,20 +180,22 @@ RenderContext::RenderContext(
             progressCallback((1.0f + progress) / TotalProgressSteps, message);
         });
 
+    LogMessage("RenderContext: loaded fonts in ",
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - stageStartTimestamp).count(), "ms");
+
 
 
     //
-    // Load texture database
+    // Wait for texture database
     //
 
     progressCallback(2.0f / TotalProgressSteps, "Loading textures...");
 
-    TextureDatabase textureDatabase = TextureDatabase::Load(
-        resourceLoader,
-        [&progressCallback](float progress, std::string const &)
-        {
-            progressCallback((2.0f + progress) / TotalProgressSteps, "Loading textures...");
-        });
+    TextureDatabaseLoadResult textureDatabaseLoadResult = textureDatabaseFuture.get();
+    std::unique_ptr<TextureCache> textureCache = std::move(textureDatabaseLoadResult.Cache);
+    TextureDatabase const & textureDatabase = textureDatabaseLoadResult.Database;
+
+    progressCallback(3.0f / TotalProgressSteps, "Loading textures...");
 
     // Create uploaded texture manager
     mUploadedTextureManager = std::make_unique<UploadedTextureManager>();
@@ -182,6 +227,9 @@ RenderContext::RenderContext(
     }
 
     TextureAtlas genericTextureAtlas = genericTextureAtlasBuilder.BuildAtlas(
+        "GenericTextureAtlas",
+        true,
+        *textureCache,
         [&progressCallback](float progress, std::string const & message)
         {
             progressCallback((3.0f + progress * GenericTextureProgressSteps) / TotalProgressSteps, message);
@@ -198,9 +246,9 @@ RenderContext::RenderContext(
     CheckOpenGLError();
 
     // Upload atlas texture
-    GameOpenGL::UploadMipmappedPowerOfTwoTexture(
-        std::move(genericTextureAtlas.AtlasData),
-        genericTextureAtlas.Metadata.GetMaxDimension());
+    GameOpenGL::UploadMipmappedTexture(
+        genericTextureAtlas.AtlasData,
+        genericTextureAtlas.Mipmaps);
 
     // Set repeat mode
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -380,6 +428,9 @@ RenderContext::RenderContext(
     cloudAtlasBuilder.Add(textureDatabase.GetGroup(TextureGroupType::Cloud));
 
     TextureAtlas cloudTextureAtlas = cloudAtlasBuilder.BuildAtlas(
+        "CloudTextureAtlas",
+        false,
+        *textureCache,
         [&progressCallback](float progress, std::string const &)
         {
             progressCallback((3.0f + GenericTextureProgressSteps + progress * CloudTextureProgressSteps) / TotalProgressSteps, "Loading cloud textures...");
@@ -511,6 +562,7 @@ RenderContext::RenderContext(
     mUploadedTextureManager->UploadMipmappedGroup(
         textureDatabase.GetGroup(TextureGroupType::WorldBorder),
         GL_LINEAR_MIPMAP_NEAREST,
+        *textureCache,
         [&progressCallback](float progress, std::string const &)
         {
             progressCallback((3.0f + GenericTextureProgressSteps + CloudTextureProgressSteps + 2.0f + progress) / TotalProgressSteps, "Loading world end textures...");
@@ -529,6 +581,23 @@ RenderContext::RenderContext(
     mShaderManager->SetTextureParameters<ProgramType::WorldBorder>();
 
 
+    //
+    // Persist texture cache, if anything has been added to it
+    //
+
+    if (textureCache->IsDirty())
+    {
+        try
+        {
+            textureCache->Save();
+        }
+        catch (std::exception const & ex)
+        {
+            LogMessage("Cannot save texture cache: ", ex.what());
+        }
+    }
+
+
     //
     // Initialize global settings
     //
@@ -6,6 +6,12 @@
 #include "ResourceLoader.h"
 
 ResourceLoader::ResourceLoader()
+    : ResourceLoader(std::filesystem::temp_directory_path() / "FloatingSandbox")
+{
+}
+
+ResourceLoader::ResourceLoader(std::filesystem::path const & cacheFolderPath)
+    : mCacheFolderPath(cacheFolderPath)
 {
     // Nothing special, for now.
     // We'll be busy though when Resource Packs are implemented.
@@ -40,6 +46,11 @@ std::filesystem::path ResourceLoader::GetTexturesFilePath() const
     return std::filesystem::path("Data") / "Textures";
 }
 
+std::filesystem::path ResourceLoader::GetTextureCacheFilePath() const
+{
+    return mCacheFolderPath / "TextureCache.bin";
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////
 // Fonts
 ////////////////////////////////////////////////////////////////////////////////////////////
@@ -13,8 +13,11 @@ class ResourceLoader
 {
 public:
 
+    // Caches go to a folder in the temporary directory
     ResourceLoader();
 
+    explicit ResourceLoader(std::filesystem::path const & cacheFolderPath);
+
 public:
 
     //
@@ -32,6 +35,8 @@ public:
 
     std::filesystem::path GetTexturesFilePath() const;
 
+    std::filesystem::path GetTextureCacheFilePath() const;
+
 
     //
     // Fonts
@@ -101,4 +106,10 @@ public:
     std::filesystem::path GetRenderShadersRootPath() const;
 
     static std::filesystem::path GetGPUCalcShadersRootPath();
+
+private:
+
+    // Where we keep the products of resource loading, e.g. the texture cache;
+    // not part of the installation, as the installation may be read-only
+    std::filesystem::path const mCacheFolderPath;
 };
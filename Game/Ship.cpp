@@ -5,8 +5,11 @@
  ***************************************************************************************/
 #include "Physics.h"
 
+#include "FrameProfiler.h"
+
 #include <GameCore/GameDebug.h>
 #include <GameCore/GameMath.h>
+#include <GameCore/GameMathBatch.h>
 #include <GameCore/GameRandomEngine.h>
 #include <GameCore/Log.h>
 
@@ -74,12 +77,15 @@ Ship::Ship(
         mPoints,
         mSprings)
     , mCurrentForceFields()
+    , mStructuralCommands()
+    , mRandomEngine(GameRandomEngine::DefaultSeed, static_cast<std::uint64_t>(id))
     , mCurrentSimulationSequenceNumber()
     , mCurrentConnectivityVisitSequenceNumber()
     , mMaxMaxPlaneId(0)
     , mCurrentElectricalVisitSequenceNumber()
     , mConnectedComponentSizes()
     , mIsStructureDirty(true)
+    , mStructuralChangeCounts()
     , mIsSinking(false)
     , mWaterSplashedRunningAverage()
     , mLastDebugShipRenderMode()
@@ -108,7 +114,7 @@ Ship::~Ship()
 void Ship::Update(
     float currentSimulationTime,
     GameParameters const & gameParameters,
-    Render::RenderContext const & renderContext)
+    VectorFieldRenderMode vectorFieldRenderMode)
 {
     // Get the current wall clock time
     auto const currentWallClockTime = GameWallClock::GetInstance().Now();
@@ -140,6 +146,8 @@ void Ship::Update(
 
     if (mCurrentSimulationSequenceNumber.IsStepOf(RotPointsPeriodStep - 1, LowFrequencyPeriod))
     {
+        PROFILE_SCOPE(ShipRotAndDecay);
+
         RotPoints(
             currentSimulationTime,
             gameParameters);
@@ -152,6 +160,8 @@ void Ship::Update(
 
     if (mCurrentSimulationSequenceNumber.IsStepOf(DecaySpringsPeriodStep - 1, LowFrequencyPeriod))
     {
+        PROFILE_SCOPE(ShipRotAndDecay);
+
         DecaySprings(
             currentSimulationTime,
             gameParameters);
@@ -163,17 +173,25 @@ void Ship::Update(
     // Update mechanical dynamics
     //
 
-    UpdateMechanicalDynamics(
-        currentSimulationTime,
-        gameParameters,
-        renderContext);
+    {
+        PROFILE_SCOPE(ShipMechanicalDynamics);
+
+        UpdateMechanicalDynamics(
+            currentSimulationTime,
+            gameParameters,
+            vectorFieldRenderMode);
+    }
 
 
     //
     // Trim for world bounds
     //
 
-    TrimForWorldBounds(gameParameters);
+    {
+        PROFILE_SCOPE(ShipTrimForWorldBounds);
+
+        TrimForWorldBounds(gameParameters);
+    }
 
 
     //
@@ -183,61 +201,194 @@ void Ship::Update(
     // (which would flag our structure as dirty)
     //
 
-    mBombs.Update(
-        currentWallClockTime,
-        gameParameters);
+    {
+        PROFILE_SCOPE(ShipBombs);
+
+        mBombs.Update(
+            currentWallClockTime,
+            gameParameters);
+    }
 
 
     //
-    // Update strain for all springs; might cause springs to break
-    // (which would flag our structure as dirty)
+    // Update strain for all springs; might decide to break springs
     //
 
-    mSprings.UpdateStrains(
-        gameParameters,
-        mPoints);
+    {
+        PROFILE_SCOPE(ShipStrains);
+
+        mSprings.UpdateStrains(
+            gameParameters,
+            mPoints,
+            mStructuralCommands);
+    }
+
+
+    //
+    // Apply the structural mutations decided upon so far in this step;
+    // might cause elements to be detached/destroyed (which would flag
+    // our structure as dirty)
+    //
+
+    {
+        PROFILE_SCOPE(ShipStructuralCommands);
+
+        ApplyStructuralCommands(
+            currentSimulationTime,
+            gameParameters);
+    }
 
 
     //
     // Update water dynamics
     //
 
-    UpdateWaterDynamics(
-        currentSimulationTime,
-        gameParameters);
+    {
+        PROFILE_SCOPE(ShipWaterDynamics);
+
+        UpdateWaterDynamics(
+            currentSimulationTime,
+            gameParameters);
+    }
 
 
     //
     // Update electrical dynamics
     //
 
-    UpdateElectricalDynamics(
-        currentWallClockTime,
-        gameParameters);
+    {
+        PROFILE_SCOPE(ShipElectricalDynamics);
+
+        UpdateElectricalDynamics(
+            currentWallClockTime,
+            gameParameters);
+    }
 
 
     //
     // Update heat dynamics
     //
 
-    UpdateHeatDynamics(
-        currentSimulationTime,
-        gameParameters);
+    {
+        PROFILE_SCOPE(ShipHeatDynamics);
+
+        UpdateHeatDynamics(
+            currentSimulationTime,
+            gameParameters);
+    }
 
 
     //
     // Update ephemeral particles
     //
 
-    mPoints.UpdateEphemeralParticles(
-        currentSimulationTime,
-        gameParameters);
+    {
+        PROFILE_SCOPE(ShipEphemeralParticles);
+
+        mPoints.UpdateEphemeralParticles(
+            currentSimulationTime,
+            gameParameters);
+    }
 
 #ifdef _DEBUG
     VerifyInvariants();
 #endif
 }
 
+void Ship::HashState(StateHasher & hasher) const
+{
+    for (auto pointIndex : mPoints)
+    {
+        hasher.Add(mPoints.GetPosition(pointIndex));
+        hasher.Add(mPoints.GetWater(pointIndex));
+    }
+
+    for (auto springIndex : mSprings)
+    {
+        hasher.Add(mSprings.IsDeleted(springIndex));
+    }
+}
+
+void Ship::SaveState(CheckpointWriter & checkpoint) const
+{
+    if (!CanSaveState())
+    {
+        throw GameException("Cannot save the state of a ship with bombs");
+    }
+
+    std::string const scope = "Ship" + std::to_string(mId) + ".";
+
+    checkpoint.SetScope(scope);
+    VisitState(*this, checkpoint);
+
+    checkpoint.SetScope(scope + "Points.");
+    mPoints.SaveState(checkpoint, mMaterialDatabase);
+
+    checkpoint.SetScope(scope + "Springs.");
+    mSprings.SaveState(checkpoint);
+
+    checkpoint.SetScope(scope + "Triangles.");
+    mTriangles.SaveState(checkpoint);
+
+    checkpoint.SetScope(scope + "ElectricalElements.");
+    mElectricalElements.SaveState(checkpoint);
+
+    checkpoint.SetScope(scope + "PinnedPoints.");
+    mPinnedPoints.SaveState(checkpoint);
+}
+
+void Ship::LoadState(CheckpointReader & checkpoint)
+{
+    if (!mBombs.IsEmpty())
+    {
+        throw GameException("Cannot restore the state of a ship with bombs");
+    }
+
+    std::string const scope = "Ship" + std::to_string(mId) + ".";
+
+    checkpoint.SetScope(scope);
+    VisitState(*this, checkpoint);
+
+    checkpoint.SetScope(scope + "Points.");
+    mPoints.LoadState(checkpoint, mMaterialDatabase);
+
+    checkpoint.SetScope(scope + "Springs.");
+    mSprings.LoadState(checkpoint);
+
+    checkpoint.SetScope(scope + "Triangles.");
+    mTriangles.LoadState(checkpoint);
+
+    checkpoint.SetScope(scope + "ElectricalElements.");
+    mElectricalElements.LoadState(checkpoint);
+
+    checkpoint.SetScope(scope + "PinnedPoints.");
+    mPinnedPoints.LoadState(checkpoint);
+
+    // Force fields only live within a step
+    mCurrentForceFields.clear();
+
+    // The per-plane triangle indices are not part of the state, hence the next render
+    // has to re-run the connectivity visit and re-upload all elements, triangles included;
+    // the visit yields the same planes as it would have without the restore
+    mIsStructureDirty = true;
+    mLastDebugShipRenderMode.reset();
+}
+
+template<typename TSelf, typename TArchive>
+void Ship::VisitState(
+    TSelf & self,
+    TArchive & archive)
+{
+    archive.Visit("RandomEngine", self.mRandomEngine);
+    archive.Visit("CurrentSimulationSequenceNumber", self.mCurrentSimulationSequenceNumber);
+    archive.Visit("CurrentConnectivityVisitSequenceNumber", self.mCurrentConnectivityVisitSequenceNumber);
+    archive.Visit("MaxMaxPlaneId", self.mMaxMaxPlaneId);
+    archive.Visit("CurrentElectricalVisitSequenceNumber", self.mCurrentElectricalVisitSequenceNumber);
+    archive.Visit("ConnectedComponentSizes", self.mConnectedComponentSizes);
+    archive.Visit("IsSinking", self.mIsSinking);
+    archive.Visit("WaterSplashedRunningAverage", self.mWaterSplashedRunningAverage);
+}
+
 void Ship::Render(
     GameParameters const & /*gameParameters*/,
     Render::RenderContext & renderContext)
@@ -419,7 +570,7 @@ void Ship::Render(
 void Ship::UpdateMechanicalDynamics(
     float currentSimulationTime,
     GameParameters const & gameParameters,
-    Render::RenderContext const & renderContext)
+    VectorFieldRenderMode vectorFieldRenderMode)
 {
     //
     // 1. Recalculate current masses and everything else that derives from them, once and for all
@@ -440,10 +591,18 @@ void Ship::UpdateMechanicalDynamics(
         {
             forceField->Apply(
                 mPoints,
+                mStructuralCommands,
+                mRandomEngine,
                 currentSimulationTime,
                 gameParameters);
         }
 
+        // Detach the points that force fields have decided to detach, before this
+        // iteration's forces are integrated
+        ApplyStructuralCommands(
+            currentSimulationTime,
+            gameParameters);
+
         // Update point forces
         UpdatePointForces(gameParameters);
 
@@ -452,7 +611,7 @@ void Ship::UpdateMechanicalDynamics(
 
         // Check whether we need to save the last force buffer before we zero it out
         if (iter == numMechanicalDynamicsIterations - 1
-            && VectorFieldRenderMode::PointForce == renderContext.GetVectorFieldRenderMode())
+            && VectorFieldRenderMode::PointForce == vectorFieldRenderMode)
         {
             mPoints.CopyForceBufferToForceRenderBuffer();
         }
@@ -497,9 +656,10 @@ void Ship::UpdatePointForces(GameParameters const & gameParameters)
         // 1. Add gravity and buoyancy
         //
 
-        mPoints.GetForce(pointIndex) +=
+        mPoints.AddForce(
+            pointIndex,
             gameParameters.Gravity
-            * mPoints.GetMass(pointIndex); // Material + Augmentation + Water
+            * mPoints.GetMass(pointIndex)); // Material + Augmentation + Water
 
         if (mPoints.GetPosition(pointIndex).y < waterHeightAtThisPoint)
         {
@@ -507,10 +667,11 @@ void Ship::UpdatePointForces(GameParameters const & gameParameters)
             // Apply upward push of water mass (i.e. buoyancy!)
             //
 
-            mPoints.GetForce(pointIndex) -=
-                gameParameters.Gravity
+            mPoints.AddForce(
+                pointIndex,
+                -gameParameters.Gravity
                 * mPoints.GetMaterialWaterVolumeFill(pointIndex)
-                * densityAdjustedWaterMass;
+                * densityAdjustedWaterMass);
         }
 
 
@@ -545,68 +706,82 @@ void Ship::UpdatePointForces(GameParameters const & gameParameters)
             ////    * (-waterDragCoefficient);
 
             // Linear law:
-            mPoints.GetForce(pointIndex) +=
+            mPoints.AddForce(
+                pointIndex,
                 mPoints.GetVelocity(pointIndex)
-                * (-waterDragCoefficient);
+                * (-waterDragCoefficient));
         }
         else
         {
             // Wind force
             //
             // Note: should be based on relative velocity, but we simplify here for performance reasons
-            mPoints.GetForce(pointIndex) +=
+            mPoints.AddForce(
+                pointIndex,
                 windForce
-                * mPoints.GetMaterialWindReceptivity(pointIndex);
+                * mPoints.GetMaterialWindReceptivity(pointIndex));
         }
     }
 }
 
 void Ship::UpdateSpringForces(GameParameters const & /*gameParameters*/)
 {
-    for (auto springIndex : mSprings)
+    auto const & positionBuffer = mPoints.GetPositionBuffer();
+    auto const & velocityBuffer = mPoints.GetVelocityBuffer();
+    auto & forceBuffer = mPoints.GetForceBuffer();
+
+    Springs::SolverSpringBlock const * restrict const solverSpringBlocks = mSprings.GetSolverSpringBlocks();
+    size_t const solverSpringBlockCount = mSprings.GetSolverSpringBlockCount();
+
+    for (size_t b = 0; b < solverSpringBlockCount; ++b)
     {
-        auto const pointAIndex = mSprings.GetEndpointAIndex(springIndex);
-        auto const pointBIndex = mSprings.GetEndpointBIndex(springIndex);
+        auto const & block = solverSpringBlocks[b];
 
-        // No need to check whether the spring is deleted, as a deleted spring
-        // has zero coefficients
+        for (size_t l = 0; l < Springs::SolverSpringBlockSize; ++l)
+        {
+            auto const pointAIndex = block.PointAIndex[l];
+            auto const pointBIndex = block.PointBIndex[l];
 
-        vec2f const displacement = mPoints.GetPosition(pointBIndex) - mPoints.GetPosition(pointAIndex);
-        float const displacementLength = displacement.length();
-        vec2f const springDir = displacement.normalise(displacementLength);
+            // No need to check whether the spring is deleted - or whether the lane
+            // is past the last spring - as such lanes have zero coefficients
 
-        //
-        // 1. Hooke's law
-        //
+            vec2f const displacement = positionBuffer.get(pointBIndex) - positionBuffer.get(pointAIndex);
+            float const displacementLength = displacement.length();
+            vec2f const springDir = displacement.normalise(displacementLength);
 
-        // Calculate spring force on point A
-        vec2f const fSpringA =
-            springDir
-            * (displacementLength - mSprings.GetRestLength(springIndex))
-            * mSprings.GetStiffnessCoefficient(springIndex);
+            //
+            // 1. Hooke's law
+            //
 
+            // Calculate spring force on point A
+            vec2f const fSpringA =
+                springDir
+                * (displacementLength - block.RestLength[l])
+                * block.StiffnessCoefficient[l];
 
-        //
-        // 2. Damper forces
-        //
-        // Damp the velocities of the two points, as if the points were also connected by a damper
-        // along the same direction as the spring
-        //
 
-        // Calculate damp force on point A
-        vec2f const relVelocity = mPoints.GetVelocity(pointBIndex) - mPoints.GetVelocity(pointAIndex);
-        vec2f const fDampA =
-            springDir
-            * relVelocity.dot(springDir)
-            * mSprings.GetDampingCoefficient(springIndex);
+            //
+            // 2. Damper forces
+            //
+            // Damp the velocities of the two points, as if the points were also connected by a damper
+            // along the same direction as the spring
+            //
 
+            // Calculate damp force on point A
+            vec2f const relVelocity = velocityBuffer.get(pointBIndex) - velocityBuffer.get(pointAIndex);
+            vec2f const fDampA =
+                springDir
+                * relVelocity.dot(springDir)
+                * block.DampingCoefficient[l];
 
-        //
-        // Apply forces
-        //
 
-        mPoints.GetForce(pointAIndex) += fSpringA + fDampA;
-        mPoints.GetForce(pointBIndex) -= fSpringA + fDampA;
+            //
+            // Apply forces
+            //
+
+            forceBuffer.add(pointAIndex, fSpringA + fDampA);
+            forceBuffer.add(pointBIndex, -(fSpringA + fDampA));
+        }
     }
 }
 
@@ -641,25 +816,41 @@ void Ship::IntegrateAndResetPointForces(GameParameters const & gameParameters)
     // This loop is compiled with single-precision packet SSE instructions on MSVC 17,
     // integrating two points at each iteration
     //
+    // Integration treats x and y the same way, hence we may run it on the raw component
+    // arrays, whatever the layout of the dynamics buffers
+    //
+    // Each component is independent from all others, hence we split the arrays among
+    // the workers of the thread pool
+    //
 
-    float * restrict positionBuffer = mPoints.GetPositionBufferAsFloat();
-    float * restrict velocityBuffer = mPoints.GetVelocityBufferAsFloat();
-    float * restrict forceBuffer = mPoints.GetForceBufferAsFloat();
-    float * restrict integrationFactorBuffer = mPoints.GetIntegrationFactorBufferAsFloat();
+    static constexpr ElementCount IntegrationGrain = 4096;
 
-    size_t const count = mPoints.GetBufferElementCount() * 2; // Two components per vector
-    for (size_t i = 0; i < count; ++i)
+    for (size_t a = 0; a < Points::DynamicsBuffer::ComponentArrayCount; ++a)
     {
-        //
-        // Verlet integration (fourth order, with velocity being first order)
-        //
+        float * restrict positionBuffer = mPoints.GetPositionBuffer().GetComponentArray(a);
+        float * restrict velocityBuffer = mPoints.GetVelocityBuffer().GetComponentArray(a);
+        float * restrict forceBuffer = mPoints.GetForceBuffer().GetComponentArray(a);
+        float * restrict integrationFactorBuffer = mPoints.GetIntegrationFactorBuffer().GetComponentArray(a);
+
+        mParentWorld.GetThreadPool().ParallelFor(
+            ElementIndexRange(0, static_cast<ElementIndex>(mPoints.GetPositionBuffer().GetComponentArrayLength())),
+            IntegrationGrain,
+            [=](ElementIndex start, ElementIndex end)
+            {
+                for (size_t i = start; i < end; ++i)
+                {
+                    //
+                    // Verlet integration (fourth order, with velocity being first order)
+                    //
 
-        float const deltaPos = velocityBuffer[i] * dt + forceBuffer[i] * integrationFactorBuffer[i];
-        positionBuffer[i] += deltaPos;
-        velocityBuffer[i] = deltaPos * globalDampCoefficient / dt;
+                    float const deltaPos = velocityBuffer[i] * dt + forceBuffer[i] * integrationFactorBuffer[i];
+                    positionBuffer[i] += deltaPos;
+                    velocityBuffer[i] = deltaPos * globalDampCoefficient / dt;
 
-        // Zero out force now that we've integrated it
-        forceBuffer[i] = 0.0f;
+                    // Zero out force now that we've integrated it
+                    forceBuffer[i] = 0.0f;
+                }
+            });
     }
 }
 
@@ -695,7 +886,7 @@ void Ship::HandleCollisionsWithSeaFloor(GameParameters const & gameParameters)
         if (mPoints.GetPosition(pointIndex).y < floorheight)
         {
             // Move point back to where it was
-            mPoints.GetPosition(pointIndex) -= mPoints.GetVelocity(pointIndex) * dt;
+            mPoints.AddPosition(pointIndex, -mPoints.GetVelocity(pointIndex) * dt);
 
             //
             // Calculate new velocity
@@ -724,42 +915,101 @@ void Ship::TrimForWorldBounds(GameParameters const & /*gameParameters*/)
     float constexpr MaxWorldTop = GameParameters::HalfMaxWorldHeight;
     float constexpr MaxWorldBottom = -GameParameters::HalfMaxWorldHeight;
 
+    auto & positionBuffer = mPoints.GetPositionBuffer();
+    auto & velocityBuffer = mPoints.GetVelocityBuffer();
+
     for (auto pointIndex : mPoints)
     {
-        auto & pos = mPoints.GetPosition(pointIndex);
+        float & posX = positionBuffer.x(pointIndex);
+        float & posY = positionBuffer.y(pointIndex);
 
-        if (pos.x < MaxWorldLeft)
+        if (posX < MaxWorldLeft)
         {
-            pos.x = MaxWorldLeft;
+            posX = MaxWorldLeft;
 
             // Bounce bounded
-            mPoints.GetVelocity(pointIndex).x = std::min(-mPoints.GetVelocity(pointIndex).x, MaxBounceVelocity);
+            velocityBuffer.x(pointIndex) = std::min(-velocityBuffer.x(pointIndex), MaxBounceVelocity);
         }
-        else if (pos.x > MaxWorldRight)
+        else if (posX > MaxWorldRight)
         {
-            pos.x = MaxWorldRight;
+            posX = MaxWorldRight;
 
             // Bounce bounded
-            mPoints.GetVelocity(pointIndex).x = std::max(-mPoints.GetVelocity(pointIndex).x, -MaxBounceVelocity);
+            velocityBuffer.x(pointIndex) = std::max(-velocityBuffer.x(pointIndex), -MaxBounceVelocity);
         }
 
-        if (pos.y > MaxWorldTop)
+        if (posY > MaxWorldTop)
         {
-            pos.y = MaxWorldTop;
+            posY = MaxWorldTop;
 
             // Bounce bounded
-            mPoints.GetVelocity(pointIndex).y = std::max(-mPoints.GetVelocity(pointIndex).y, -MaxBounceVelocity);
+            velocityBuffer.y(pointIndex) = std::max(-velocityBuffer.y(pointIndex), -MaxBounceVelocity);
         }
-        else if (pos.y < MaxWorldBottom)
+        else if (posY < MaxWorldBottom)
         {
-            pos.y = MaxWorldBottom;
+            posY = MaxWorldBottom;
 
             // Bounce bounded
-            mPoints.GetVelocity(pointIndex).y = std::min(-mPoints.GetVelocity(pointIndex).y, MaxBounceVelocity);
+            velocityBuffer.y(pointIndex) = std::min(-velocityBuffer.y(pointIndex), MaxBounceVelocity);
         }
     }
 }
 
+///////////////////////////////////////////////////////////////////////////////////
+// Structure
+///////////////////////////////////////////////////////////////////////////////////
+
+void Ship::ApplyStructuralCommands(
+    float currentSimulationTime,
+    GameParameters const & gameParameters)
+{
+    if (mStructuralCommands.IsEmpty())
+        return;
+
+    //
+    // Commands are applied in a deterministic order - point detachments first, then
+    // spring breaks - regardless of the order in which they have been recorded
+    //
+
+    for (auto const & command : mStructuralCommands.Seal())
+    {
+        switch (command.Type)
+        {
+            case StructuralCommandBuffer::CommandType::DetachPoint:
+            {
+                mPoints.Detach(
+                    command.Element,
+                    command.Velocity,
+                    command.GenerateDebris
+                        ? Points::DetachOptions::GenerateDebris
+                        : Points::DetachOptions::DoNotGenerateDebris,
+                    currentSimulationTime,
+                    gameParameters);
+
+                break;
+            }
+
+            case StructuralCommandBuffer::CommandType::BreakSpring:
+            {
+                // The spring might have gone already, e.g. with a detached endpoint
+                if (!mSprings.IsDeleted(command.Element))
+                {
+                    mSprings.Destroy(
+                        command.Element,
+                        Springs::DestroyOptions::FireBreakEvent // Notify Break
+                        | Springs::DestroyOptions::DestroyAllTriangles,
+                        gameParameters,
+                        mPoints);
+                }
+
+                break;
+            }
+        }
+    }
+
+    mStructuralCommands.Clear();
+}
+
 ///////////////////////////////////////////////////////////////////////////////////
 // Water Dynamics
 ///////////////////////////////////////////////////////////////////////////////////
@@ -788,7 +1038,12 @@ void Ship::UpdateWaterDynamics(
     //
 
     float waterSplashedInStep = 0.f;
-    UpdateWaterVelocities(gameParameters, waterSplashedInStep);
+
+    {
+        PROFILE_SCOPE(ShipWaterVelocities);
+
+        UpdateWaterVelocities(gameParameters, waterSplashedInStep);
+    }
 
     // Notify
     mGameEventHandler->OnWaterSplashed(waterSplashedInStep);
@@ -919,8 +1174,7 @@ void Ship::UpdateWaterVelocities(
 
     // Source and result water buffers
     float * restrict oldPointWaterBufferData = mPoints.GetWaterBufferAsFloat();
-    auto newPointWaterBuffer = mPoints.MakeWaterBufferCopy();
-    float * restrict newPointWaterBufferData = newPointWaterBuffer->data();
+    float * restrict newPointWaterBufferData = mPoints.PrepareWaterBackBuffer();
     vec2f * restrict oldPointWaterVelocityBufferData = mPoints.GetWaterVelocityBufferAsVec2();
     vec2f * restrict newPointWaterMomentumBufferData = mPoints.GetWaterMomentumBufferAsVec2f();
 
@@ -944,10 +1198,14 @@ void Ship::UpdateWaterVelocities(
     float * restrict pointFreenessFactorBufferData = pointFreenessFactorBuffer->data();
     for (auto pointIndex : mPoints)
     {
-        pointFreenessFactorBufferData[pointIndex] =
-            FastExp(-oldPointWaterBufferData[pointIndex] * 10.0f);
+        pointFreenessFactorBufferData[pointIndex] = -oldPointWaterBufferData[pointIndex] * 10.0f;
     }
 
+    FastExpBatch(
+        pointFreenessFactorBufferData,
+        pointFreenessFactorBufferData,
+        mPoints.GetElementCount());
+
 
     //
     // Visit all points and move water and its momenta
@@ -978,10 +1236,11 @@ void Ship::UpdateWaterVelocities(
 
         totalOutboundWaterFlowWeight = 0.0f;
 
-        size_t const connectedSpringCount = mPoints.GetConnectedSprings(pointIndex).ConnectedSprings.size();
+        auto const connectedSprings = mPoints.GetConnectedSprings(pointIndex);
+        size_t const connectedSpringCount = connectedSprings.size();
         for (size_t s = 0; s < connectedSpringCount; ++s)
         {
-            auto const & cs = mPoints.GetConnectedSprings(pointIndex).ConnectedSprings[s];
+            auto const & cs = connectedSprings[s];
 
             // Normalized spring vector, oriented point -> other endpoint
             vec2f const springNormalizedVector = (mPoints.GetPosition(cs.OtherEndpointIndex) - mPoints.GetPosition(pointIndex)).normalise();
@@ -1080,7 +1339,7 @@ void Ship::UpdateWaterVelocities(
 
         for (size_t s = 0; s < connectedSpringCount; ++s)
         {
-            auto const & cs = mPoints.GetConnectedSprings(pointIndex).ConnectedSprings[s];
+            auto const & cs = connectedSprings[s];
 
             // Calculate quantity of water directed outwards
             float const springOutboundQuantityOfWater =
@@ -1201,7 +1460,7 @@ void Ship::UpdateWaterVelocities(
     // Move result values back to point, transforming momenta into velocities
     //
 
-    mPoints.UpdateWaterBuffer(std::move(newPointWaterBuffer));
+    mPoints.SwapWaterBuffers();
     mPoints.UpdateWaterVelocitiesFromMomenta();
 }
 
@@ -1258,7 +1517,11 @@ void Ship::UpdateElectricalDynamics(
         mPoints,
         gameParameters);
 
-    DiffuseLight(gameParameters);
+    {
+        PROFILE_SCOPE(ShipDiffuseLight);
+
+        DiffuseLight(gameParameters);
+    }
 }
 
 void Ship::UpdateElectricalConnectivity(SequenceNumber currentVisitSequenceNumber)
@@ -1335,6 +1598,10 @@ void Ship::DiffuseLight(GameParameters const & gameParameters)
         mPoints.GetLight(pointIndex) = 0.0f;
     }
 
+    // Light attenuation at each point, for the current lamp
+    auto attenuationBuffer = mPoints.AllocateWorkBufferFloat();
+    float * restrict attenuationBufferData = attenuationBuffer->data();
+
     // Go through all lamps;
     // can safely visit deleted lamps as their current will always be zero
     for (auto lampIndex : mElectricalElements.Lamps())
@@ -1368,24 +1635,43 @@ void Ship::DiffuseLight(GameParameters const & gameParameters)
                 * gameParameters.LightSpreadAdjustment
                 / 2.0f; // We piggyback on the power to avoid taking a sqrt for distance
 
-            vec2f const & lampPosition = mPoints.GetPosition(lampPointIndex);
+            vec2f const lampPosition = mPoints.GetPosition(lampPointIndex);
             PlaneId const lampPlaneId = mPoints.GetPlaneId(lampPointIndex);
 
+            // Calculate the attenuation at all the points in range at once, packing
+            // their square distances at the start of the buffer
+            size_t attenuationCount = 0;
             for (auto pointIndex : mPoints)
             {
                 if (mPoints.GetPlaneId(pointIndex) <= lampPlaneId)
                 {
-                    float const squareDistance = (mPoints.GetPosition(pointIndex) - lampPosition).squareLength();
+                    attenuationBufferData[attenuationCount++] = (mPoints.GetPosition(pointIndex) - lampPosition).squareLength();
+                }
+            }
+
+            FastPowBatch(
+                attenuationBufferData,
+                effectiveExponent,
+                attenuationBufferData,
+                attenuationCount);
 
+            // Visit the same points in the same order, consuming the packed attenuations
+            size_t a = 0;
+            for (auto pointIndex : mPoints)
+            {
+                if (mPoints.GetPlaneId(pointIndex) <= lampPlaneId)
+                {
                     float const newLight =
                         effectiveLampLight
-                        / (1.0f + FastPow(squareDistance, effectiveExponent));
+                        / (1.0f + attenuationBufferData[a++]);
 
                     mPoints.GetLight(pointIndex) = std::max(
                         mPoints.GetLight(pointIndex),
                         newLight);
                 }
             }
+
+            assert(a == attenuationCount);
         }
     }
 }
@@ -1438,8 +1724,7 @@ void Ship::PropagateHeat(
 
     // Source and result temperature buffers
     float * restrict oldPointTemperatureBufferData = mPoints.GetTemperatureBufferAsFloat();
-    auto newPointTemperatureBuffer = mPoints.MakeTemperatureBufferCopy();
-    float * restrict newPointTemperatureBufferData = newPointTemperatureBuffer->data();
+    float * restrict newPointTemperatureBufferData = mPoints.PrepareTemperatureBackBuffer();
 
     ////// TODO: if needed
     ////// Weights of outbound water flows along each spring, including impermeable ones;
@@ -1466,10 +1751,11 @@ void Ship::PropagateHeat(
         float totalOutgoingHeat = 0.0f;
 
         // Visit all springs
-        size_t const connectedSpringCount = mPoints.GetConnectedSprings(pointIndex).ConnectedSprings.size();
+        auto const connectedSprings = mPoints.GetConnectedSprings(pointIndex);
+        size_t const connectedSpringCount = connectedSprings.size();
         for (size_t s = 0; s < connectedSpringCount; ++s)
         {
-            auto const & cs = mPoints.GetConnectedSprings(pointIndex).ConnectedSprings[s];
+            auto const & cs = connectedSprings[s];
 
             // Calculate outgoing heat flow
             //
@@ -1516,7 +1802,7 @@ void Ship::PropagateHeat(
 
         for (size_t s = 0; s < connectedSpringCount; ++s)
         {
-            auto const & cs = mPoints.GetConnectedSprings(pointIndex).ConnectedSprings[s];
+            auto const & cs = connectedSprings[s];
 
             // Calculate outgoing heat flow (again)
             float const outgoingHeatFlow =
@@ -1543,7 +1829,7 @@ void Ship::PropagateHeat(
     // Move result values back to point
     //
 
-    mPoints.UpdateTemperatureBuffer(std::move(newPointTemperatureBuffer));
+    mPoints.SwapTemperatureBuffers();
 
     // Remember that the temperature buffer is dirty
     mPoints.MarkTemperatureBufferAsDirty();
@@ -1701,7 +1987,7 @@ void Ship::RunConnectivityVisit()
 #endif
 
                 // Visit all its non-visited connected points
-                for (auto const & cs : mPoints.GetConnectedSprings(currentPointIndex).ConnectedSprings)
+                for (auto const & cs : mPoints.GetConnectedSprings(currentPointIndex))
                 {
                     if (visitSequenceNumber != mPoints.GetCurrentConnectivityVisitSequenceNumber(cs.OtherEndpointIndex))
                     {
@@ -1763,14 +2049,14 @@ void Ship::DestroyConnectedTriangles(ElementIndex pointElementIndex)
 
     // Note: we can't simply iterate and destroy, as destroying a triangle causes
     // that triangle to be removed from the vector being iterated
-    auto & connectedTriangles = mPoints.GetConnectedTriangles(pointElementIndex).ConnectedTriangles;
+    auto const connectedTriangles = mPoints.GetConnectedTriangles(pointElementIndex);
     while (!connectedTriangles.empty())
     {
         assert(!mTriangles.IsDeleted(connectedTriangles.back()));
         mTriangles.Destroy(connectedTriangles.back());
     }
 
-    assert(mPoints.GetConnectedTriangles(pointElementIndex).ConnectedTriangles.empty());
+    assert(mPoints.GetConnectedTriangles(pointElementIndex).empty());
 }
 
 void Ship::DestroyConnectedTriangles(
@@ -1781,7 +2067,7 @@ void Ship::DestroyConnectedTriangles(
     // Destroy the triangles that have an edge among the two points
     //
 
-    auto & connectedTriangles = mPoints.GetConnectedTriangles(pointAElementIndex).ConnectedTriangles;
+    auto const connectedTriangles = mPoints.GetConnectedTriangles(pointAElementIndex);
     if (!connectedTriangles.empty())
     {
         for (size_t t = connectedTriangles.size() - 1; ;--t)
@@ -1812,13 +2098,15 @@ void Ship::PointDetachHandler(
 {
     bool hasAnythingBeenDestroyed = false;
 
+    ++mStructuralChangeCounts.DetachedPoints;
+
     //
     // Destroy all springs attached to this point
     //
 
     // Note: we can't simply iterate and destroy, as destroying a spring causes
     // that spring to be removed from the vector being iterated
-    auto & connectedSprings = mPoints.GetConnectedSprings(pointElementIndex).ConnectedSprings;
+    auto const connectedSprings = mPoints.GetConnectedSprings(pointElementIndex);
     while (!connectedSprings.empty())
     {
         assert(!mSprings.IsDeleted(connectedSprings.back().SpringIndex));
@@ -1833,14 +2121,14 @@ void Ship::PointDetachHandler(
         hasAnythingBeenDestroyed = true;
     }
 
-    assert(mPoints.GetConnectedSprings(pointElementIndex).ConnectedSprings.empty());
+    assert(mPoints.GetConnectedSprings(pointElementIndex).empty());
 
     // At this moment, we've deleted all springs connected to this point, and we
     // asked those strings to destroy all triangles connected to each endpoint
     // (thus including this one).
     // Given that a point is connected to a triangle iff the point is an endpoint
     // of a spring-edge of that triangle, then we shouldn't have any triangles now
-    assert(mPoints.GetConnectedTriangles(pointElementIndex).ConnectedTriangles.empty());
+    assert(mPoints.GetConnectedTriangles(pointElementIndex).empty());
 
 
     //
@@ -1898,6 +2186,8 @@ void Ship::SpringDestroyHandler(
     auto const pointAIndex = mSprings.GetEndpointAIndex(springElementIndex);
     auto const pointBIndex = mSprings.GetEndpointBIndex(springElementIndex);
 
+    ++mStructuralChangeCounts.BrokenSprings;
+
     //
     // Remove spring from other elements
     //
@@ -2093,9 +2383,9 @@ void Ship::GenerateAirBubbles(
     PlaneId planeId,
     GameParameters const & /*gameParameters*/)
 {
-    float vortexAmplitude = GameRandomEngine::GetInstance().GenerateRandomReal(
+    float vortexAmplitude = mRandomEngine.GenerateRandomReal(
         GameParameters::MinAirBubblesVortexAmplitude, GameParameters::MaxAirBubblesVortexAmplitude);
-    float vortexPeriod = GameRandomEngine::GetInstance().GenerateRandomReal(
+    float vortexPeriod = mRandomEngine.GenerateRandomReal(
         GameParameters::MinAirBubblesVortexPeriod, GameParameters::MaxAirBubblesVortexPeriod);
 
     mPoints.CreateEphemeralParticleAirBubble(
@@ -2115,25 +2405,28 @@ void Ship::GenerateDebris(
 {
     if (gameParameters.DoGenerateDebris)
     {
-        auto const debrisParticleCount = GameRandomEngine::GetInstance().GenerateRandomInteger(
+        auto const debrisParticleCount = mRandomEngine.GenerateRandomInteger(
             GameParameters::MinDebrisParticlesPerEvent, GameParameters::MaxDebrisParticlesPerEvent);
 
+        // Choose all velocities at once
+        std::array<vec2f, GameParameters::MaxDebrisParticlesPerEvent> velocities;
+        mRandomEngine.FillRadialVectors(
+            velocities.data(),
+            debrisParticleCount,
+            GameParameters::MinDebrisParticlesVelocity,
+            GameParameters::MaxDebrisParticlesVelocity);
+
         for (size_t d = 0; d < debrisParticleCount; ++d)
         {
-            // Choose velocity
-            vec2f const velocity = GameRandomEngine::GetInstance().GenerateRandomRadialVector(
-                GameParameters::MinDebrisParticlesVelocity,
-                GameParameters::MaxDebrisParticlesVelocity);
-
             // Choose a lifetime
             std::chrono::milliseconds const maxLifetime = std::chrono::milliseconds(
-                GameRandomEngine::GetInstance().GenerateRandomInteger(
+                mRandomEngine.GenerateRandomInteger(
                     GameParameters::MinDebrisParticlesLifetime.count(),
                     GameParameters::MaxDebrisParticlesLifetime.count()));
 
             mPoints.CreateEphemeralParticleDebris(
                 mPoints.GetPosition(pointElementIndex),
-                velocity,
+                velocities[d],
                 mPoints.GetStructuralMaterial(pointElementIndex),
                 currentSimulationTime,
                 maxLifetime,
@@ -2155,7 +2448,7 @@ void Ship::GenerateSparkles(
         // Choose number of particles
         //
 
-        auto const sparkleParticleCount = GameRandomEngine::GetInstance().GenerateRandomInteger<size_t>(
+        auto const sparkleParticleCount = mRandomEngine.GenerateRandomInteger<size_t>(
             GameParameters::MinSparkleParticlesPerEvent, GameParameters::MaxSparkleParticlesPerEvent);
 
 
@@ -2177,17 +2470,17 @@ void Ship::GenerateSparkles(
         for (size_t d = 0; d < sparkleParticleCount; ++d)
         {
             // Velocity magnitude
-            float const velocityMagnitude = GameRandomEngine::GetInstance().GenerateRandomReal(
+            float const velocityMagnitude = mRandomEngine.GenerateRandomReal(
                 GameParameters::MinSparkleParticlesVelocity, GameParameters::MaxSparkleParticlesVelocity);
 
             // Velocity angle: butterfly perpendicular to *direction of sawing*, not spring
             float const velocityAngleCw =
-                GameRandomEngine::GetInstance().GenerateRandomReal(startAngleCw, endAngleCw)
-                + (GameRandomEngine::GetInstance().Choose(2) == 0 ? Pi<float> : 0.0f);
+                mRandomEngine.GenerateRandomReal(startAngleCw, endAngleCw)
+                + (mRandomEngine.Choose(2) == 0 ? Pi<float> : 0.0f);
 
             // Choose a lifetime
             std::chrono::milliseconds const maxLifetime = std::chrono::milliseconds(
-                GameRandomEngine::GetInstance().GenerateRandomInteger(
+                mRandomEngine.GenerateRandomInteger(
                     GameParameters::MinSparkleParticlesLifetime.count(),
                     GameParameters::MaxSparkleParticlesLifetime.count()));
 
@@ -2294,15 +2587,15 @@ void Ship::VerifyInvariants()
     {
         if (!mTriangles.IsDeleted(t))
         {
-            Verify(mPoints.GetConnectedTriangles(mTriangles.GetPointAIndex(t)).ConnectedTriangles.contains([t](auto const & c) { return c == t; }));
-            Verify(mPoints.GetConnectedTriangles(mTriangles.GetPointBIndex(t)).ConnectedTriangles.contains([t](auto const & c) { return c == t; }));
-            Verify(mPoints.GetConnectedTriangles(mTriangles.GetPointCIndex(t)).ConnectedTriangles.contains([t](auto const & c) { return c == t; }));
+            Verify(mPoints.GetConnectedTriangles(mTriangles.GetPointAIndex(t)).contains([t](auto const & c) { return c == t; }));
+            Verify(mPoints.GetConnectedTriangles(mTriangles.GetPointBIndex(t)).contains([t](auto const & c) { return c == t; }));
+            Verify(mPoints.GetConnectedTriangles(mTriangles.GetPointCIndex(t)).contains([t](auto const & c) { return c == t; }));
         }
         else
         {
-            Verify(!mPoints.GetConnectedTriangles(mTriangles.GetPointAIndex(t)).ConnectedTriangles.contains([t](auto const & c) { return c == t; }));
-            Verify(!mPoints.GetConnectedTriangles(mTriangles.GetPointBIndex(t)).ConnectedTriangles.contains([t](auto const & c) { return c == t; }));
-            Verify(!mPoints.GetConnectedTriangles(mTriangles.GetPointCIndex(t)).ConnectedTriangles.contains([t](auto const & c) { return c == t; }));
+            Verify(!mPoints.GetConnectedTriangles(mTriangles.GetPointAIndex(t)).contains([t](auto const & c) { return c == t; }));
+            Verify(!mPoints.GetConnectedTriangles(mTriangles.GetPointBIndex(t)).contains([t](auto const & c) { return c == t; }));
+            Verify(!mPoints.GetConnectedTriangles(mTriangles.GetPointCIndex(t)).contains([t](auto const & c) { return c == t; }));
         }
     }
 
@@ -2315,13 +2608,13 @@ void Ship::VerifyInvariants()
     {
         if (!mSprings.IsDeleted(s))
         {
-            Verify(mPoints.GetConnectedSprings(mSprings.GetEndpointAIndex(s)).ConnectedSprings.contains([s](auto const & c) { return c.SpringIndex == s; }));
-            Verify(mPoints.GetConnectedSprings(mSprings.GetEndpointBIndex(s)).ConnectedSprings.contains([s](auto const & c) { return c.SpringIndex == s; }));
+            Verify(mPoints.GetConnectedSprings(mSprings.GetEndpointAIndex(s)).contains([s](auto const & c) { return c.SpringIndex == s; }));
+            Verify(mPoints.GetConnectedSprings(mSprings.GetEndpointBIndex(s)).contains([s](auto const & c) { return c.SpringIndex == s; }));
         }
         else
         {
-            Verify(!mPoints.GetConnectedSprings(mSprings.GetEndpointAIndex(s)).ConnectedSprings.contains([s](auto const & c) { return c.SpringIndex == s; }));
-            Verify(!mPoints.GetConnectedSprings(mSprings.GetEndpointBIndex(s)).ConnectedSprings.contains([s](auto const & c) { return c.SpringIndex == s; }));
+            Verify(!mPoints.GetConnectedSprings(mSprings.GetEndpointAIndex(s)).contains([s](auto const & c) { return c.SpringIndex == s; }));
+            Verify(!mPoints.GetConnectedSprings(mSprings.GetEndpointBIndex(s)).contains([s](auto const & c) { return c.SpringIndex == s; }));
         }
     }
 
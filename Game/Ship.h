@@ -11,9 +11,13 @@
 #include "Physics.h"
 #include "RenderContext.h"
 #include "ShipDefinition.h"
+#include "StructuralCommandBuffer.h"
 
+#include <GameCore/Checkpoint.h>
 #include <GameCore/GameTypes.h>
+#include <GameCore/RandomEngine.h>
 #include <GameCore/RunningAverage.h>
+#include <GameCore/StateHasher.h>
 #include <GameCore/Vectors.h>
 
 #include <memory>
@@ -59,10 +63,54 @@ public:
     auto const & GetElectricalElements() const { return mElectricalElements; }
     auto & GetElectricalElements() { return mElectricalElements; }
 
+    /*
+     * Returns the number of bytes currently occupied by the element buffers of this ship.
+     */
+    size_t GetMemoryFootprint() const
+    {
+        return mPoints.GetMemoryFootprint()
+            + mSprings.GetMemoryFootprint()
+            + mTriangles.GetMemoryFootprint()
+            + mElectricalElements.GetMemoryFootprint();
+    }
+
+    /*
+     * Returns the structural changes that have occurred since the previous invocation
+     * of this method.
+     */
+    StructuralChangeCounts ConsumeStructuralChangeCounts()
+    {
+        StructuralChangeCounts const counts = mStructuralChangeCounts;
+        mStructuralChangeCounts = StructuralChangeCounts();
+
+        return counts;
+    }
+
+    /*
+     * Adds the state of this ship that matters for reproducibility - positions and water
+     * of all points, and which springs are deleted - to the specified hash.
+     */
+    void HashState(StateHasher & hasher) const;
+
+    /*
+     * Saves and restores the state of this ship, for checkpoints. The state may only
+     * be restored onto a ship built from the same definition, and with the same ID.
+     *
+     * Bombs are not part of the state, hence ships with bombs cannot be saved nor
+     * restored; both throw GameException in that case.
+     */
+    bool CanSaveState() const
+    {
+        return mBombs.IsEmpty();
+    }
+
+    void SaveState(CheckpointWriter & checkpoint) const;
+    void LoadState(CheckpointReader & checkpoint);
+
     void Update(
         float currentSimulationTime,
         GameParameters const & gameParameters,
-        Render::RenderContext const & renderContext);
+        VectorFieldRenderMode vectorFieldRenderMode);
 
     void Render(
         GameParameters const & gameParameters,
@@ -195,7 +243,7 @@ public:
     void UpdateMechanicalDynamics(
         float currentSimulationTime,
         GameParameters const & gameParameters,
-        Render::RenderContext const & renderContext);
+        VectorFieldRenderMode vectorFieldRenderMode);
 
     void UpdatePointForces(GameParameters const & gameParameters);
 
@@ -207,6 +255,12 @@ public:
 
     void TrimForWorldBounds(GameParameters const & gameParameters);
 
+    // Structure
+
+    void ApplyStructuralCommands(
+        float currentSimulationTime,
+        GameParameters const & gameParameters);
+
     // Water
 
     void UpdateWaterDynamics(
@@ -373,6 +427,15 @@ private:
 
 private:
 
+    friend class ShipUpdatePhasesBenchmark;
+    friend class ShipStateTests;
+
+    // Visits the members making up the state, both for saving and for restoring
+    template<typename TSelf, typename TArchive>
+    static void VisitState(
+        TSelf & self,
+        TArchive & archive);
+
 #ifdef _DEBUG
     void VerifyInvariants();
 #endif
@@ -399,6 +462,14 @@ private:
     // Force fields to apply at next iteration
     std::vector<std::unique_ptr<ForceField>> mCurrentForceFields;
 
+    // Structural mutations decided upon by the simulation loops, applied right
+    // after the force fields of each iteration and after the strain update
+    StructuralCommandBuffer mStructuralCommands;
+
+    // The random engine for this ship's own events, seeded from the game seed
+    // and from our ID, so that each ship gets its own reproducible sequence
+    RandomEngine mRandomEngine;
+
     // The current simulation sequence number
     SequenceNumber mCurrentSimulationSequenceNumber;
 
@@ -420,6 +491,9 @@ private:
     // to the rendering context
     bool mIsStructureDirty;
 
+    // The structural changes since they have last been consumed
+    StructuralChangeCounts mStructuralChangeCounts;
+
     // Sinking detection
     bool mIsSinking;
 
@@ -9,6 +9,7 @@
 
 #include <GameCore/ImageTools.h>
 #include <GameCore/Log.h>
+#include <GameCore/TraceRecorder.h>
 
 #include <algorithm>
 #include <cassert>
@@ -29,6 +30,8 @@ std::unique_ptr<Ship> ShipBuilder::Create(
     MaterialDatabase const & materialDatabase,
     GameParameters const & gameParameters)
 {
+    TRACE_SCOPE("ShipBuilder::Create");
+
     int const structureWidth = shipDefinition.StructuralLayerImage.Size.Width;
     float const halfWidth = static_cast<float>(structureWidth) / 2.0f;
     int const structureHeight = shipDefinition.StructuralLayerImage.Size.Height;
@@ -308,6 +311,9 @@ std::unique_ptr<Ship> ShipBuilder::Create(
         points.GetShipPointCount(), " points, ", springs.GetElementCount(), " springs, ", triangles.GetElementCount(), " triangles, ",
         electricalElements.GetElementCount(), " electrical elements.");
 
+    LogMessage("Ship memory footprint: points=", points.GetMemoryFootprint() / 1024, "KB, springs=", springs.GetMemoryFootprint() / 1024,
+        "KB, triangles=", triangles.GetMemoryFootprint() / 1024, "KB, electrical elements=", electricalElements.GetMemoryFootprint() / 1024, "KB");
+
     return std::make_unique<Ship>(
         shipId,
         parentWorld,
@@ -1197,6 +1203,8 @@ Physics::Springs ShipBuilder::CreateSprings(
         std::move(gameEventDispatcher),
         gameParameters);
 
+    Physics::Points::ConnectedSpringsList::Builder connectedSpringsBuilder(points.GetElementCount());
+
     for (ElementIndex s = 0; s < springInfos2.size(); ++s)
     {
         int characteristics = 0;
@@ -1224,18 +1232,18 @@ Physics::Springs ShipBuilder::CreateSprings(
             points);
 
         // Add spring to its endpoints
-        points.AddFactoryConnectedSpring(
+        connectedSpringsBuilder.Add(
             pointIndexRemap[springInfos2[s].PointAIndex1],
-            s,
-            pointIndexRemap[springInfos2[s].PointBIndex1],
+            Physics::Points::ConnectedSpring(s, pointIndexRemap[springInfos2[s].PointBIndex1]),
             true); // Owner
-        points.AddFactoryConnectedSpring(
+        connectedSpringsBuilder.Add(
             pointIndexRemap[springInfos2[s].PointBIndex1],
-            s,
-            pointIndexRemap[springInfos2[s].PointAIndex1],
+            Physics::Points::ConnectedSpring(s, pointIndexRemap[springInfos2[s].PointAIndex1]),
             false); // Not owner
     }
 
+    points.SetFactoryConnectedSprings(connectedSpringsBuilder.Build());
+
     return springs;
 }
 
@@ -1246,6 +1254,8 @@ Physics::Triangles ShipBuilder::CreateTriangles(
 {
     Physics::Triangles triangles(static_cast<ElementIndex>(triangleInfos2.size()));
 
+    Physics::Points::ConnectedTrianglesList::Builder connectedTrianglesBuilder(points.GetElementCount());
+
     for (ElementIndex t = 0; t < triangleInfos2.size(); ++t)
     {
         // Create triangle
@@ -1256,11 +1266,13 @@ Physics::Triangles ShipBuilder::CreateTriangles(
             triangleInfos2[t].SubSprings2);
 
         // Add triangle to its endpoints
-        points.AddFactoryConnectedTriangle(pointIndexRemap[triangleInfos2[t].PointIndices1[0]], t, true); // Owner
-        points.AddFactoryConnectedTriangle(pointIndexRemap[triangleInfos2[t].PointIndices1[1]], t, false); // Not owner
-        points.AddFactoryConnectedTriangle(pointIndexRemap[triangleInfos2[t].PointIndices1[2]], t, false); // Not owner
+        connectedTrianglesBuilder.Add(pointIndexRemap[triangleInfos2[t].PointIndices1[0]], t, true); // Owner
+        connectedTrianglesBuilder.Add(pointIndexRemap[triangleInfos2[t].PointIndices1[1]], t, false); // Not owner
+        connectedTrianglesBuilder.Add(pointIndexRemap[triangleInfos2[t].PointIndices1[2]], t, false); // Not owner
     }
 
+    points.SetFactoryConnectedTriangles(connectedTrianglesBuilder.Build());
+
     return triangles;
 }
 
@@ -1307,7 +1319,7 @@ ElectricalElements ShipBuilder::CreateElectricalElements(
     {
         auto pointIndex = electricalElements.GetPointIndex(electricalElementIndex);
 
-        for (auto const & cs : points.GetConnectedSprings(pointIndex).ConnectedSprings)
+        for (auto const & cs : points.GetConnectedSprings(pointIndex))
         {
             auto otherEndpointElectricalElementIndex = points.GetElectricalElement(cs.OtherEndpointIndex);
             if (NoneElementIndex != otherEndpointElectricalElementIndex)
@@ -8,10 +8,14 @@
 #include "ImageFileTools.h"
 #include "ShipDefinitionFile.h"
 
+#include <GameCore/TraceRecorder.h>
+
 #include <cassert>
 
 ShipDefinition ShipDefinition::Load(std::filesystem::path const & filepath)
 {
+    TRACE_SCOPE("ShipDefinition::Load");
+
     std::filesystem::path absoluteStructuralLayerImageFilePath;
     std::optional<RgbImageData> ropesLayerImage;
     std::optional<RgbImageData> electricalLayerImage;
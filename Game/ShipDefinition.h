@@ -47,6 +47,8 @@ public:
 
 private:
 
+    friend class ShipDefinitionGenerator;
+
     ShipDefinition(
         RgbImageData structuralLayerImage,
         std::optional<RgbImageData> ropesLayerImage,
@@ -0,0 +1,414 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2020-01-10
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "ShipDefinitionGenerator.h"
+
+#include "MaterialDatabase.h"
+
+#include <GameCore/GameException.h>
+#include <GameCore/RandomEngine.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <memory>
+#include <optional>
+
+namespace /* anonymous */ {
+
+    static constexpr rgbColor BackgroundColor = { 0xff, 0xff, 0xff };
+
+    // Ships are wider than they are tall
+    static constexpr float AspectRatio = 4.0f;
+
+    // Lattice geometry: walls at each multiple of the cell size
+    static constexpr int LatticeCellSize = 6;
+    static constexpr float LatticeSolidCellProbability = 0.25f;
+
+    // Rope rig geometry: a pair of masts in each group of columns, with ropes
+    // between rows of the same block
+    static constexpr int RopeRigMastPairWidth = 16;
+    static constexpr int RopeRigMastDistance = 8;
+    static constexpr int RopeRigRowBlockSize = 16;
+
+    // Lamp grid geometry
+    static constexpr int LampGridSpacing = 8;
+
+    /*
+     * The expected number of points per pixel of the image, including rope points.
+     */
+    float GetPointDensity(ShipDefinitionGenerator::HullType hullType)
+    {
+        switch (hullType)
+        {
+            case ShipDefinitionGenerator::HullType::Lattice:
+            {
+                float constexpr CellArea = static_cast<float>(LatticeCellSize * LatticeCellSize);
+                float constexpr WallArea = static_cast<float>(2 * LatticeCellSize - 1);
+
+                return (WallArea + LatticeSolidCellProbability * (CellArea - WallArea)) / CellArea;
+            }
+
+            case ShipDefinitionGenerator::HullType::RopeRig:
+            {
+                // A quarter of deck, two masts per mast pair, and about seven rope points
+                // for each row of each mast pair
+                return 0.25f + 0.75f * (2.0f + 7.0f) / static_cast<float>(RopeRigMastPairWidth);
+            }
+
+            case ShipDefinitionGenerator::HullType::SolidRectangle:
+            case ShipDefinitionGenerator::HullType::LampGrid:
+            case ShipDefinitionGenerator::HullType::MixedMaterials:
+            {
+                return 1.0f;
+            }
+        }
+
+        assert(false);
+        return 1.0f;
+    }
+
+    /*
+     * An image layer, addressed from the bottom row up as the ship builder visits it.
+     */
+    class Layer
+    {
+    public:
+
+        Layer(
+            int width,
+            int height)
+            : mWidth(width)
+            , mHeight(height)
+            , mData(new rgbColor[static_cast<size_t>(width) * static_cast<size_t>(height)])
+        {
+            std::fill(
+                mData.get(),
+                mData.get() + static_cast<size_t>(width) * static_cast<size_t>(height),
+                BackgroundColor);
+        }
+
+        rgbColor const & Get(int x, int y) const
+        {
+            return mData[Index(x, y)];
+        }
+
+        void Set(int x, int y, rgbColor const & color)
+        {
+            mData[Index(x, y)] = color;
+        }
+
+        RgbImageData ToImageData() &&
+        {
+            return RgbImageData(mWidth, mHeight, std::move(mData));
+        }
+
+    private:
+
+        size_t Index(int x, int y) const
+        {
+            assert(x >= 0 && x < mWidth && y >= 0 && y < mHeight);
+
+            return static_cast<size_t>(x) + static_cast<size_t>(mHeight - y - 1) * static_cast<size_t>(mWidth);
+        }
+
+        int const mWidth;
+        int const mHeight;
+        std::unique_ptr<rgbColor[]> mData;
+    };
+
+    template<typename T>
+    T const & ChooseFrom(
+        std::vector<T> const & items,
+        RandomEngine & randomEngine)
+    {
+        if (items.empty())
+        {
+            throw GameException("The palette of the ship definition generator is missing materials");
+        }
+
+        return items[randomEngine.Choose(items.size())];
+    }
+
+    rgbColor MakeRopeColor(size_t ropeIndex)
+    {
+        // Each rope needs its own color, and none may be the background
+        size_t const colorIndex = ropeIndex + 1;
+        if (colorIndex >= 0xffffff)
+        {
+            throw GameException("The generated ship has too many ropes");
+        }
+
+        return rgbColor(
+            static_cast<uint8_t>(colorIndex >> 16),
+            static_cast<uint8_t>(colorIndex >> 8),
+            static_cast<uint8_t>(colorIndex));
+    }
+}
+
+std::string ShipDefinitionGenerator::HullTypeToStr(HullType hullType)
+{
+    switch (hullType)
+    {
+        case HullType::SolidRectangle:
+            return "SolidRectangle";
+        case HullType::Lattice:
+            return "Lattice";
+        case HullType::RopeRig:
+            return "RopeRig";
+        case HullType::LampGrid:
+            return "LampGrid";
+        case HullType::MixedMaterials:
+            return "MixedMaterials";
+    }
+
+    assert(false);
+    return "";
+}
+
+ShipDefinitionGenerator::Palette ShipDefinitionGenerator::Palette::FromMaterialDatabase(MaterialDatabase const & materialDatabase)
+{
+    // The maps are sorted by color key, hence the palette does not depend on the
+    // order of the materials in their files
+
+    Palette palette;
+
+    for (auto const & [colorKey, material] : materialDatabase.GetStructuralMaterials())
+    {
+        if (!!material.UniqueType)
+            continue;
+
+        palette.StructuralMaterials.push_back(colorKey);
+
+        if (material.IsHull)
+            palette.HullMaterials.push_back(colorKey);
+    }
+
+    for (auto const & [colorKey, material] : materialDatabase.GetElectricalMaterials())
+    {
+        if (material.ElectricalType == ElectricalMaterial::ElectricalElementType::Lamp
+            && material.IsSelfPowered)
+        {
+            palette.LampMaterials.push_back(colorKey);
+        }
+    }
+
+    return palette;
+}
+
+ShipDefinition ShipDefinitionGenerator::Generate(
+    HullType hullType,
+    size_t pointCount,
+    std::uint64_t seed,
+    Palette const & palette)
+{
+    RandomEngine randomEngine(seed);
+
+    //
+    // Calculate size
+    //
+
+    float const area = static_cast<float>(std::max(pointCount, size_t(1))) / GetPointDensity(hullType);
+    int width = std::max(static_cast<int>(std::ceil(std::sqrt(area * AspectRatio))), 1);
+    int height = std::max(static_cast<int>(std::round(area / static_cast<float>(width))), 1);
+
+    switch (hullType)
+    {
+        case HullType::Lattice:
+        {
+            // Whole cells, closed on all sides
+            width = std::max((width + LatticeCellSize - 2) / LatticeCellSize, 1) * LatticeCellSize + 1;
+            height = std::max((height + LatticeCellSize - 2) / LatticeCellSize, 1) * LatticeCellSize + 1;
+            break;
+        }
+
+        case HullType::RopeRig:
+        {
+            // Whole mast pairs, and at least one row above the deck
+            width = std::max((width + RopeRigMastPairWidth / 2) / RopeRigMastPairWidth, 1) * RopeRigMastPairWidth;
+            height = std::max(height, 2);
+            break;
+        }
+
+        default:
+        {
+            break;
+        }
+    }
+
+    //
+    // Draw layers
+    //
+
+    Layer structuralLayer(width, height);
+    std::optional<Layer> ropesLayer;
+    std::optional<Layer> electricalLayer;
+
+    switch (hullType)
+    {
+        case HullType::SolidRectangle:
+        {
+            rgbColor const material = ChooseFrom(palette.HullMaterials, randomEngine);
+
+            for (int x = 0; x < width; ++x)
+                for (int y = 0; y < height; ++y)
+                    structuralLayer.Set(x, y, material);
+
+            break;
+        }
+
+        case HullType::Lattice:
+        {
+            rgbColor const material = ChooseFrom(palette.HullMaterials, randomEngine);
+
+            // Walls
+            for (int x = 0; x < width; ++x)
+            {
+                for (int y = 0; y < height; ++y)
+                {
+                    if (x % LatticeCellSize == 0 || y % LatticeCellSize == 0)
+                        structuralLayer.Set(x, y, material);
+                }
+            }
+
+            // Solid cells
+            for (int cellX = 0; cellX + 1 < width; cellX += LatticeCellSize)
+            {
+                for (int cellY = 0; cellY + 1 < height; cellY += LatticeCellSize)
+                {
+                    if (randomEngine.GenerateRandomBoolean(LatticeSolidCellProbability))
+                    {
+                        for (int x = cellX + 1; x < cellX + LatticeCellSize; ++x)
+                            for (int y = cellY + 1; y < cellY + LatticeCellSize; ++y)
+                                structuralLayer.Set(x, y, material);
+                    }
+                }
+            }
+
+            break;
+        }
+
+        case HullType::RopeRig:
+        {
+            rgbColor const material = ChooseFrom(palette.HullMaterials, randomEngine);
+
+            int const deckHeight = std::max(height / 4, 1);
+
+            // Deck
+            for (int x = 0; x < width; ++x)
+                for (int y = 0; y < deckHeight; ++y)
+                    structuralLayer.Set(x, y, material);
+
+            // Masts, and ropes between the rows of each mast pair; each row of the
+            // first mast is tied to a random row of the second mast, within the same
+            // block of rows, so that each endpoint has exactly one rope
+            ropesLayer.emplace(width, height);
+
+            size_t ropeCount = 0;
+            std::vector<int> partnerRows;
+
+            for (int pairX = 0; pairX < width; pairX += RopeRigMastPairWidth)
+            {
+                int const mastAX = pairX + (RopeRigMastPairWidth - RopeRigMastDistance) / 2;
+                int const mastBX = mastAX + RopeRigMastDistance;
+
+                for (int y = deckHeight; y < height; ++y)
+                {
+                    structuralLayer.Set(mastAX, y, material);
+                    structuralLayer.Set(mastBX, y, material);
+                }
+
+                for (int blockY = deckHeight; blockY < height; blockY += RopeRigRowBlockSize)
+                {
+                    int const blockEndY = std::min(blockY + RopeRigRowBlockSize, height);
+
+                    partnerRows.clear();
+                    for (int y = blockY; y < blockEndY; ++y)
+                        partnerRows.push_back(y);
+
+                    // Fisher-Yates
+                    for (size_t i = partnerRows.size() - 1; i > 0; --i)
+                    {
+                        std::swap(partnerRows[i], partnerRows[randomEngine.Choose(i + 1)]);
+                    }
+
+                    for (int y = blockY; y < blockEndY; ++y)
+                    {
+                        rgbColor const ropeColor = MakeRopeColor(ropeCount++);
+
+                        ropesLayer->Set(mastAX, y, ropeColor);
+                        ropesLayer->Set(mastBX, partnerRows[y - blockY], ropeColor);
+                    }
+                }
+            }
+
+            break;
+        }
+
+        case HullType::LampGrid:
+        {
+            rgbColor const material = ChooseFrom(palette.HullMaterials, randomEngine);
+
+            for (int x = 0; x < width; ++x)
+                for (int y = 0; y < height; ++y)
+                    structuralLayer.Set(x, y, material);
+
+            electricalLayer.emplace(width, height);
+
+            for (int x = LampGridSpacing / 2; x < width; x += LampGridSpacing)
+                for (int y = LampGridSpacing / 2; y < height; y += LampGridSpacing)
+                    electricalLayer->Set(x, y, ChooseFrom(palette.LampMaterials, randomEngine));
+
+            break;
+        }
+
+        case HullType::MixedMaterials:
+        {
+            for (int x = 0; x < width; ++x)
+                for (int y = 0; y < height; ++y)
+                    structuralLayer.Set(x, y, ChooseFrom(palette.StructuralMaterials, randomEngine));
+
+            break;
+        }
+    }
+
+    //
+    // Make texture out of the structural layer, from the bottom row up
+    //
+
+    std::unique_ptr<rgbaColor[]> textureData(new rgbaColor[static_cast<size_t>(width) * static_cast<size_t>(height)]);
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            rgbColor const & color = structuralLayer.Get(x, y);
+            textureData[static_cast<size_t>(x) + static_cast<size_t>(y) * static_cast<size_t>(width)] =
+                (color == BackgroundColor)
+                ? rgbaColor(color.r, color.g, color.b, 0)
+                : rgbaColor(color.r, color.g, color.b, 0xff);
+        }
+    }
+
+    //
+    // Assemble definition
+    //
+
+    std::optional<RgbImageData> ropesLayerImage;
+    if (!!ropesLayer)
+        ropesLayerImage.emplace(std::move(*ropesLayer).ToImageData());
+
+    std::optional<RgbImageData> electricalLayerImage;
+    if (!!electricalLayer)
+        electricalLayerImage.emplace(std::move(*electricalLayer).ToImageData());
+
+    return ShipDefinition(
+        std::move(structuralLayer).ToImageData(),
+        std::move(ropesLayerImage),
+        std::move(electricalLayerImage),
+        RgbaImageData(width, height, std::move(textureData)),
+        ShipDefinition::TextureOriginType::StructuralImage,
+        ShipMetadata(
+            "Synthetic " + HullTypeToStr(hullType) + " " + std::to_string(pointCount) + " #" + std::to_string(seed)));
+}
@@ -0,0 +1,69 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2020-01-10
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "ShipDefinition.h"
+
+#include <GameCore/Colors.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class MaterialDatabase;
+
+/*
+ * Generates ship definitions programmatically, so that the scaling of the simulation
+ * may be studied on ships of any size, without painting images by hand.
+ *
+ * The same hull type, point count, seed, and palette always produce the same definition.
+ */
+class ShipDefinitionGenerator
+{
+public:
+
+    enum class HullType
+    {
+        // A solid block of a single hull material
+        SolidRectangle,
+
+        // A grid of walls, with most of its cells hollow
+        Lattice,
+
+        // A deck with masts, each pair of masts cross-braced by ropes
+        RopeRig,
+
+        // A solid block with self-powered lamps at regular intervals
+        LampGrid,
+
+        // A solid block with a random material at each particle
+        MixedMaterials
+    };
+
+    static std::string HullTypeToStr(HullType hullType);
+
+    /*
+     * The color keys of the materials that the generator draws from.
+     */
+    struct Palette
+    {
+        std::vector<rgbColor> StructuralMaterials;
+        std::vector<rgbColor> HullMaterials;
+        std::vector<rgbColor> LampMaterials; // Self-powered only
+
+        static Palette FromMaterialDatabase(MaterialDatabase const & materialDatabase);
+    };
+
+    /*
+     * Generates a ship with approximately the specified number of points, including
+     * the points of its ropes.
+     */
+    static ShipDefinition Generate(
+        HullType hullType,
+        size_t pointCount,
+        std::uint64_t seed,
+        Palette const & palette);
+};
@@ -39,6 +39,8 @@ public:
 
 private:
 
+    friend class ShipPreviewCache;
+
     ShipPreview(
         RgbaImageData previewImage,
         ImageSize originalSize,
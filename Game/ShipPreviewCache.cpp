@@ -0,0 +1,349 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2019-12-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "ShipPreviewCache.h"
+
+#include <GameCore/GameException.h>
+#include <GameCore/Log.h>
+
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace /* anonymous */ {
+
+    size_t AlignPayloadSize(size_t size)
+    {
+        return (size + 7) & ~static_cast<size_t>(7);
+    }
+
+    void AppendString(
+        std::vector<std::uint8_t> & payload,
+        std::string const & str)
+    {
+        payload.insert(payload.end(), str.cbegin(), str.cend());
+    }
+}
+
+ShipPreviewCache::ShipPreviewCache(
+    std::filesystem::path const & cacheFolderPath,
+    std::filesystem::path const & shipDirectoryPath)
+    : mIndexFilepath(MakeIndexFilepath(cacheFolderPath, shipDirectoryPath))
+    , mIndexFile()
+    , mMappedEntries()
+    , mPendingEntries()
+    , mPendingEntriesMutex()
+{
+    try
+    {
+        LoadIndex();
+    }
+    catch (std::exception const & ex)
+    {
+        LogMessage("ShipPreviewCache: ignoring index \"", mIndexFilepath.string(), "\": ", ex.what());
+
+        mMappedEntries.clear();
+        mIndexFile.reset();
+    }
+}
+
+std::optional<ShipPreview> ShipPreviewCache::TryGet(std::filesystem::path const & shipFilepath)
+{
+    auto const fileKey = MakeFileKey(shipFilepath);
+    if (!fileKey)
+        return std::nullopt;
+
+    auto const entryIt = mMappedEntries.find(fileKey->Path);
+    if (entryIt == mMappedEntries.end())
+        return std::nullopt;
+
+    EntryHeader const & entryHeader = *(entryIt->second);
+    if (entryHeader.FileSize != fileKey->FileSize
+        || entryHeader.LastWriteTime != fileKey->LastWriteTime)
+    {
+        // Stale
+        return std::nullopt;
+    }
+
+    //
+    // Unpack payload
+    //
+
+    std::uint8_t const * payload = mIndexFile->GetData() + entryHeader.PayloadOffset;
+
+    size_t const pixelCount = static_cast<size_t>(entryHeader.PreviewWidth) * static_cast<size_t>(entryHeader.PreviewHeight);
+    auto previewData = std::make_unique<rgbaColor[]>(pixelCount);
+    std::memcpy(static_cast<void *>(previewData.get()), payload, pixelCount * sizeof(rgbaColor));
+
+    char const * strings = reinterpret_cast<char const *>(payload + pixelCount * sizeof(rgbaColor) + entryHeader.PathLength);
+    std::optional<std::string> metadataStrings[4];
+    for (size_t s = 0; s < 4; ++s)
+    {
+        if (entryHeader.StringLengths[s] != NoneStringLength)
+        {
+            metadataStrings[s].emplace(strings, entryHeader.StringLengths[s]);
+            strings += entryHeader.StringLengths[s];
+        }
+    }
+
+    ShipPreview shipPreview(
+        RgbaImageData(
+            ImageSize(entryHeader.PreviewWidth, entryHeader.PreviewHeight),
+            std::move(previewData)),
+        ImageSize(entryHeader.OriginalWidth, entryHeader.OriginalHeight),
+        ShipMetadata(
+            metadataStrings[0].value_or(std::string()),
+            metadataStrings[1],
+            metadataStrings[2],
+            metadataStrings[3],
+            vec2f(entryHeader.OffsetX, entryHeader.OffsetY)));
+
+    //
+    // Retain entry for the next save
+    //
+
+    {
+        std::lock_guard<std::mutex> lock(mPendingEntriesMutex);
+
+        PendingEntry pendingEntry;
+        pendingEntry.Header = entryHeader;
+        pendingEntry.Payload.assign(payload, payload + entryHeader.PayloadSize);
+
+        mPendingEntries[fileKey->Path] = std::move(pendingEntry);
+    }
+
+    return shipPreview;
+}
+
+void ShipPreviewCache::Put(
+    std::filesystem::path const & shipFilepath,
+    ShipPreview const & shipPreview)
+{
+    auto const fileKey = MakeFileKey(shipFilepath);
+    if (!fileKey)
+        return;
+
+    ShipMetadata const & metadata = shipPreview.Metadata;
+
+    PendingEntry pendingEntry;
+
+    pendingEntry.Header.FileSize = fileKey->FileSize;
+    pendingEntry.Header.LastWriteTime = fileKey->LastWriteTime;
+    pendingEntry.Header.PayloadOffset = 0; // Calculated at save time
+    pendingEntry.Header.PathLength = static_cast<std::uint32_t>(fileKey->Path.size());
+    pendingEntry.Header.PreviewWidth = shipPreview.PreviewImage.Size.Width;
+    pendingEntry.Header.PreviewHeight = shipPreview.PreviewImage.Size.Height;
+    pendingEntry.Header.OriginalWidth = shipPreview.OriginalSize.Width;
+    pendingEntry.Header.OriginalHeight = shipPreview.OriginalSize.Height;
+    pendingEntry.Header.OffsetX = metadata.Offset.x;
+    pendingEntry.Header.OffsetY = metadata.Offset.y;
+    pendingEntry.Header.StringLengths[0] = static_cast<std::uint32_t>(metadata.ShipName.size());
+    pendingEntry.Header.StringLengths[1] = !!metadata.Author ? static_cast<std::uint32_t>(metadata.Author->size()) : NoneStringLength;
+    pendingEntry.Header.StringLengths[2] = !!metadata.YearBuilt ? static_cast<std::uint32_t>(metadata.YearBuilt->size()) : NoneStringLength;
+    pendingEntry.Header.StringLengths[3] = !!metadata.Description ? static_cast<std::uint32_t>(metadata.Description->size()) : NoneStringLength;
+
+    size_t const pixelByteSize =
+        static_cast<size_t>(shipPreview.PreviewImage.Size.Width)
+        * static_cast<size_t>(shipPreview.PreviewImage.Size.Height)
+        * sizeof(rgbaColor);
+
+    pendingEntry.Payload.reserve(pixelByteSize + fileKey->Path.size() + 256);
+
+    auto const * pixels = reinterpret_cast<std::uint8_t const *>(shipPreview.PreviewImage.Data.get());
+    pendingEntry.Payload.insert(pendingEntry.Payload.end(), pixels, pixels + pixelByteSize);
+
+    AppendString(pendingEntry.Payload, fileKey->Path);
+    AppendString(pendingEntry.Payload, metadata.ShipName);
+    if (!!metadata.Author)
+        AppendString(pendingEntry.Payload, *metadata.Author);
+    if (!!metadata.YearBuilt)
+        AppendString(pendingEntry.Payload, *metadata.YearBuilt);
+    if (!!metadata.Description)
+        AppendString(pendingEntry.Payload, *metadata.Description);
+
+    // Keep the next entry's pixels aligned
+    pendingEntry.Payload.resize(AlignPayloadSize(pendingEntry.Payload.size()), 0);
+
+    pendingEntry.Header.PayloadSize = pendingEntry.Payload.size();
+
+    {
+        std::lock_guard<std::mutex> lock(mPendingEntriesMutex);
+
+        mPendingEntries[fileKey->Path] = std::move(pendingEntry);
+    }
+}
+
+void ShipPreviewCache::Save()
+{
+    std::lock_guard<std::mutex> lock(mPendingEntriesMutex);
+
+    std::filesystem::create_directories(mIndexFilepath.parent_path());
+
+    //
+    // Write to a temporary file first
+    //
+
+    std::filesystem::path const tempIndexFilepath = mIndexFilepath.string() + ".tmp";
+
+    {
+        std::ofstream file(tempIndexFilepath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            throw GameException("Cannot open file \"" + tempIndexFilepath.string() + "\" for writing");
+        }
+
+        IndexHeader indexHeader;
+        indexHeader.Magic = Magic;
+        indexHeader.Version = Version;
+        indexHeader.EntryCount = static_cast<std::uint32_t>(mPendingEntries.size());
+        indexHeader.Reserved = 0;
+
+        file.write(reinterpret_cast<char const *>(&indexHeader), sizeof(IndexHeader));
+
+        // Entry headers
+
+        std::uint64_t payloadOffset = AlignPayloadSize(sizeof(IndexHeader) + mPendingEntries.size() * sizeof(EntryHeader));
+
+        for (auto const & entry : mPendingEntries)
+        {
+            EntryHeader entryHeader = entry.second.Header;
+            entryHeader.PayloadOffset = payloadOffset;
+
+            file.write(reinterpret_cast<char const *>(&entryHeader), sizeof(EntryHeader));
+
+            payloadOffset += entry.second.Payload.size();
+        }
+
+        // Payloads
+
+        size_t const paddingSize =
+            AlignPayloadSize(sizeof(IndexHeader) + mPendingEntries.size() * sizeof(EntryHeader))
+            - (sizeof(IndexHeader) + mPendingEntries.size() * sizeof(EntryHeader));
+
+        char const padding[8] = { 0 };
+        file.write(padding, paddingSize);
+
+        for (auto const & entry : mPendingEntries)
+        {
+            file.write(reinterpret_cast<char const *>(entry.second.Payload.data()), entry.second.Payload.size());
+        }
+
+        if (!file)
+        {
+            throw GameException("Error writing file \"" + tempIndexFilepath.string() + "\"");
+        }
+    }
+
+    //
+    // Replace index - the mapping must be released first
+    //
+
+    mMappedEntries.clear();
+    mIndexFile.reset();
+
+    std::filesystem::rename(tempIndexFilepath, mIndexFilepath);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+std::optional<ShipPreviewCache::FileKey> ShipPreviewCache::MakeFileKey(std::filesystem::path const & shipFilepath)
+{
+    std::error_code ec;
+
+    auto const fileSize = std::filesystem::file_size(shipFilepath, ec);
+    if (ec)
+        return std::nullopt;
+
+    auto const lastWriteTime = std::filesystem::last_write_time(shipFilepath, ec);
+    if (ec)
+        return std::nullopt;
+
+    return FileKey{
+        shipFilepath.string(),
+        static_cast<std::uint64_t>(fileSize),
+        static_cast<std::int64_t>(lastWriteTime.time_since_epoch().count()) };
+}
+
+std::filesystem::path ShipPreviewCache::MakeIndexFilepath(
+    std::filesystem::path const & cacheFolderPath,
+    std::filesystem::path const & shipDirectoryPath)
+{
+    // FNV-1a of the directory path - stable across runs and platforms
+    std::uint64_t hash = 14695981039346656037ull;
+    for (char c : shipDirectoryPath.string())
+    {
+        hash ^= static_cast<std::uint8_t>(c);
+        hash *= 1099511628211ull;
+    }
+
+    std::stringstream ss;
+    ss << "ShipPreviews_" << std::hex << std::setw(16) << std::setfill('0') << hash << ".idx";
+
+    return cacheFolderPath / ss.str();
+}
+
+void ShipPreviewCache::LoadIndex()
+{
+    if (!std::filesystem::exists(mIndexFilepath))
+        return;
+
+    mIndexFile = MemoryMappedFile::Open(mIndexFilepath);
+
+    std::uint8_t const * const data = mIndexFile->GetData();
+    size_t const size = mIndexFile->GetSize();
+
+    //
+    // Validate header
+    //
+
+    if (size < sizeof(IndexHeader))
+        throw GameException("The index is truncated");
+
+    IndexHeader const & indexHeader = *reinterpret_cast<IndexHeader const *>(data);
+    if (indexHeader.Magic != Magic || indexHeader.Version != Version)
+        throw GameException("The index has an unrecognized format");
+
+    if (size < sizeof(IndexHeader) + static_cast<size_t>(indexHeader.EntryCount) * sizeof(EntryHeader))
+        throw GameException("The index is truncated");
+
+    //
+    // Validate and map entries
+    //
+
+    EntryHeader const * const entryHeaders = reinterpret_cast<EntryHeader const *>(data + sizeof(IndexHeader));
+    for (std::uint32_t e = 0; e < indexHeader.EntryCount; ++e)
+    {
+        EntryHeader const & entryHeader = entryHeaders[e];
+
+        if (entryHeader.PayloadOffset > size
+            || entryHeader.PayloadSize > size - entryHeader.PayloadOffset
+            || entryHeader.PreviewWidth < 0
+            || entryHeader.PreviewHeight < 0)
+        {
+            throw GameException("The index contains an invalid entry");
+        }
+
+        std::uint64_t requiredPayloadSize =
+            static_cast<std::uint64_t>(entryHeader.PreviewWidth) * static_cast<std::uint64_t>(entryHeader.PreviewHeight) * sizeof(rgbaColor)
+            + entryHeader.PathLength;
+        for (size_t s = 0; s < 4; ++s)
+        {
+            if (entryHeader.StringLengths[s] != NoneStringLength)
+                requiredPayloadSize += entryHeader.StringLengths[s];
+        }
+
+        if (requiredPayloadSize > entryHeader.PayloadSize)
+            throw GameException("The index contains an invalid entry");
+
+        std::string path(
+            reinterpret_cast<char const *>(data + entryHeader.PayloadOffset)
+            + static_cast<size_t>(entryHeader.PreviewWidth) * static_cast<size_t>(entryHeader.PreviewHeight) * sizeof(rgbaColor),
+            entryHeader.PathLength);
+
+        mMappedEntries[std::move(path)] = &entryHeader;
+    }
+}
@@ -0,0 +1,127 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2019-12-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "ShipPreview.h"
+
+#include <GameCore/Colors.h>
+#include <GameCore/MemoryMappedFile.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * A persistent cache of ship previews for a single directory.
+ *
+ * The cache lives in a single index file, which is memory-mapped when the cache is
+ * opened; each entry stores the trimmed preview image and the ship's metadata,
+ * and it is keyed by the ship file's path, size, and last write time.
+ *
+ * Saving the cache only retains the entries that have been either retrieved or
+ * stored since the cache was opened, hence ships that have been deleted from the
+ * directory are pruned automatically.
+ *
+ * TryGet() and Put() may be invoked concurrently.
+ */
+class ShipPreviewCache
+{
+public:
+
+    /*
+     * Opens the cache for the specified directory of ships, storing its index in the specified folder.
+     * Never throws: a missing or invalid index file simply yields an empty cache.
+     */
+    ShipPreviewCache(
+        std::filesystem::path const & cacheFolderPath,
+        std::filesystem::path const & shipDirectoryPath);
+
+    std::optional<ShipPreview> TryGet(std::filesystem::path const & shipFilepath);
+
+    void Put(
+        std::filesystem::path const & shipFilepath,
+        ShipPreview const & shipPreview);
+
+    /*
+     * Writes the index file; throws GameException if the file cannot be written.
+     */
+    void Save();
+
+private:
+
+    static constexpr std::uint32_t Magic = 0x43505346; // "FSPC"
+    static constexpr std::uint32_t Version = 1;
+    static constexpr std::uint32_t NoneStringLength = 0xffffffff;
+
+#pragma pack(push, 4)
+
+    struct IndexHeader
+    {
+        std::uint32_t Magic;
+        std::uint32_t Version;
+        std::uint32_t EntryCount;
+        std::uint32_t Reserved;
+    };
+
+    struct EntryHeader
+    {
+        std::uint64_t FileSize;
+        std::int64_t LastWriteTime;
+        std::uint64_t PayloadOffset; // From beginning of file; payload is: pixels, path, name, author, year, description
+        std::uint64_t PayloadSize;
+        std::uint32_t PathLength;
+        std::int32_t PreviewWidth;
+        std::int32_t PreviewHeight;
+        std::int32_t OriginalWidth;
+        std::int32_t OriginalHeight;
+        float OffsetX;
+        float OffsetY;
+        std::uint32_t StringLengths[4]; // Name, Author, YearBuilt, Description
+    };
+
+#pragma pack(pop)
+
+    struct FileKey
+    {
+        std::string Path;
+        std::uint64_t FileSize;
+        std::int64_t LastWriteTime;
+    };
+
+    // An entry ready to be written to the index
+    struct PendingEntry
+    {
+        EntryHeader Header;
+        std::vector<std::uint8_t> Payload;
+    };
+
+    static std::optional<FileKey> MakeFileKey(std::filesystem::path const & shipFilepath);
+
+    static std::filesystem::path MakeIndexFilepath(
+        std::filesystem::path const & cacheFolderPath,
+        std::filesystem::path const & shipDirectoryPath);
+
+    void LoadIndex();
+
+private:
+
+    std::filesystem::path const mIndexFilepath;
+
+    // The currently-mapped index, if any
+    std::unique_ptr<MemoryMappedFile> mIndexFile;
+
+    // Entries in the mapped index, by path
+    std::unordered_map<std::string, EntryHeader const *> mMappedEntries;
+
+    // Entries to be written at the next save, by path
+    std::unordered_map<std::string, PendingEntry> mPendingEntries;
+    std::mutex mPendingEntriesMutex;
+};
@@ -8,7 +8,6 @@
 #include <GameCore/AABB.h>
 #include <GameCore/GameDebug.h>
 #include <GameCore/GameMath.h>
-#include <GameCore/GameRandomEngine.h>
 #include <GameCore/Log.h>
 #include <GameCore/Segment.h>
 
@@ -43,7 +42,7 @@ std::optional<ElementIndex> Ship::PickPointToMove(
 
     for (auto p : mPoints.NonEphemeralPoints())
     {
-        if (!mPoints.GetConnectedSprings(p).ConnectedSprings.empty())
+        if (!mPoints.GetConnectedSprings(p).empty())
         {
             float const squareDistance = (mPoints.GetPosition(p) - pickPosition).squareLength();
             if (squareDistance < squareSearchRadius
@@ -81,7 +80,7 @@ void Ship::MoveBy(
         {
             if (mPoints.GetConnectedComponentId(p) == connectedComponentId)
             {
-                mPoints.GetPosition(p) += offset;
+                mPoints.AddPosition(p, offset);
                 mPoints.SetVelocity(p, actualInertialVelocity);
             }
         }
@@ -100,14 +99,14 @@ void Ship::MoveBy(
         * gameParameters.MoveToolInertia
         * (gameParameters.IsUltraViolentMode ? 5.0f : 1.0f);
 
-    vec2f * restrict positionBuffer = mPoints.GetPositionBufferAsVec2();
-    vec2f * restrict velocityBuffer = mPoints.GetVelocityBufferAsVec2();
+    auto & positionBuffer = mPoints.GetPositionBuffer();
+    auto & velocityBuffer = mPoints.GetVelocityBuffer();
 
     size_t const count = mPoints.GetBufferElementCount();
     for (size_t p = 0; p < count; ++p)
     {
-        positionBuffer[p] += offset;
-        velocityBuffer[p] = actualInertialVelocity;
+        positionBuffer.add(p, offset);
+        velocityBuffer.set(p, actualInertialVelocity);
     }
 
     TrimForWorldBounds(gameParameters);
@@ -145,7 +144,7 @@ void Ship::RotateBy(
                     p,
                     (vec2f(centeredPos.dot(inertialRotX), centeredPos.dot(inertialRotY)) - centeredPos) * inertiaMagnitude);
 
-                mPoints.GetPosition(p) = vec2f(centeredPos.dot(rotX), centeredPos.dot(rotY)) + center;
+                mPoints.SetPosition(p, vec2f(centeredPos.dot(rotX), centeredPos.dot(rotY)) + center);
             }
         }
 
@@ -169,18 +168,19 @@ void Ship::RotateBy(
     vec2f const inertialRotX(cos(inertialAngle), sin(inertialAngle));
     vec2f const inertialRotY(-sin(inertialAngle), cos(inertialAngle));
 
-    vec2f * restrict positionBuffer = mPoints.GetPositionBufferAsVec2();
-    vec2f * restrict velocityBuffer = mPoints.GetVelocityBufferAsVec2();
+    auto & positionBuffer = mPoints.GetPositionBuffer();
+    auto & velocityBuffer = mPoints.GetVelocityBuffer();
 
     size_t const count = mPoints.GetBufferElementCount();
     for (size_t p = 0; p < count; ++p)
     {
-        vec2f const centeredPos = positionBuffer[p] - center;
+        vec2f const centeredPos = positionBuffer.get(p) - center;
 
-        velocityBuffer[p] =
-            (vec2f(centeredPos.dot(inertialRotX), centeredPos.dot(inertialRotY)) - centeredPos) * inertiaMagnitude;
+        velocityBuffer.set(
+            p,
+            (vec2f(centeredPos.dot(inertialRotX), centeredPos.dot(inertialRotY)) - centeredPos) * inertiaMagnitude);
 
-        positionBuffer[p] = vec2f(centeredPos.dot(rotX), centeredPos.dot(rotY)) + center;
+        positionBuffer.set(p, vec2f(centeredPos.dot(rotX), centeredPos.dot(rotY)) + center);
     }
 
     TrimForWorldBounds(gameParameters);
@@ -217,7 +217,7 @@ void Ship::DestroyAt(
             //
 
             if (Points::EphemeralType::None == mPoints.GetEphemeralType(pointIndex)
-                && mPoints.GetConnectedSprings(pointIndex).ConnectedSprings.size() > 0)
+                && mPoints.GetConnectedSprings(pointIndex).size() > 0)
             {
                 //
                 // Calculate probability: 1.0 at distance = 0.0 and 0.0 at distance = radius;
@@ -229,10 +229,10 @@ void Ship::DestroyAt(
                     ? 1.0f
                     : (1.0f - (pointSquareDistance / squareRadius)) * (1.0f - (pointSquareDistance / squareRadius));
 
-                if (GameRandomEngine::GetInstance().GenerateRandomNormalizedReal() <= destroyProbability)
+                if (mRandomEngine.GenerateRandomNormalizedReal() <= destroyProbability)
                 {
                     // Choose a detach velocity - using the same distribution as Debris
-                    vec2f detachVelocity = GameRandomEngine::GetInstance().GenerateRandomRadialVector(
+                    vec2f detachVelocity = mRandomEngine.GenerateRandomRadialVector(
                         GameParameters::MinDebrisParticlesVelocity,
                         GameParameters::MaxDebrisParticlesVelocity);
 
@@ -293,7 +293,7 @@ void Ship::RepairAt(
         // the effort put by the main structure's points
         float const squareRadius = (mPoints.GetPosition(pointIndex) - targetPos).squareLength();
         if (squareRadius <= squareSearchRadius
-            && mPoints.GetConnectedSprings(pointIndex).ConnectedSprings.size() > 0
+            && mPoints.GetConnectedSprings(pointIndex).size() > 0
             && (mPoints.GetRepairState(pointIndex).LastAttractedSessionId != sessionId
                  || mPoints.GetRepairState(pointIndex).LastAttractedSessionStepId + 1 < sessionStepId))
         {
@@ -312,7 +312,7 @@ void Ship::RepairAt(
                 * (gameParameters.IsUltraViolentMode ? 10.0f : 1.0f);
 
             // Visit all the deleted springs that were connected at factory time
-            for (auto const & fcs : mPoints.GetFactoryConnectedSprings(pointIndex).ConnectedSprings)
+            for (auto const & fcs : mPoints.GetFactoryConnectedSprings(pointIndex))
             {
                 if (mSprings.IsDeleted(fcs.SpringIndex))
                 {
@@ -374,7 +374,7 @@ void Ship::RepairAt(
                         int nearestCWSpringDeltaOctant = std::numeric_limits<int>::max();
                         int nearestCCWSpringIndex = -1;
                         int nearestCCWSpringDeltaOctant = std::numeric_limits<int>::max();
-                        for (auto const & cs : mPoints.GetConnectedSprings(pointIndex).ConnectedSprings)
+                        for (auto const & cs : mPoints.GetConnectedSprings(pointIndex))
                         {
                             //
                             // CW
@@ -506,9 +506,10 @@ void Ship::RepairAt(
                                 * toolStrength;
 
                             // Move point
-                            mPoints.GetPosition(otherEndpointIndex) +=
+                            mPoints.AddPosition(
+                                otherEndpointIndex,
                                 movementDir
-                                * movementMagnitude;
+                                * movementMagnitude);
 
                             // Adjust displacement
                             assert(movementMagnitude < displacementMagnitude);
@@ -589,7 +590,7 @@ void Ship::RepairAt(
             //
 
             // Visit all the triangles that were connected at factory time
-            for (auto fct : mPoints.GetFactoryConnectedTriangles(pointIndex).ConnectedTriangles)
+            for (auto fct : mPoints.GetFactoryConnectedTriangles(pointIndex))
             {
                 if (mTriangles.IsDeleted(fct))
                 {
@@ -613,8 +614,8 @@ void Ship::RepairAt(
             // Eligible endpoints are those that now have all of their factory springs
             //
 
-            if (mPoints.GetConnectedSprings(pointIndex).ConnectedSprings.size()
-                == mPoints.GetFactoryConnectedSprings(pointIndex).ConnectedSprings.size())
+            if (mPoints.GetConnectedSprings(pointIndex).size()
+                == mPoints.GetFactoryConnectedSprings(pointIndex).size())
             {
                 mPoints.RestoreFactoryIsLeaking(pointIndex);
             }
@@ -5,6 +5,8 @@
  ***************************************************************************************/
 #include "Physics.h"
 
+#include <GameCore/TraceRecorder.h>
+
 #include <cmath>
 
 namespace Physics {
@@ -40,9 +42,20 @@ void Springs::Add(
         / 2.0f;
     mMaterialStiffnessBuffer.emplace_back(stiffness);
 
-    mRestLengthBuffer.emplace_back((points.GetPosition(pointAIndex) - points.GetPosition(pointBIndex)).length());
+    float const restLength = (points.GetPosition(pointAIndex) - points.GetPosition(pointBIndex)).length();
+    mRestLengthBuffer.emplace_back(restLength);
+
+    mCoefficientsBuffer.emplace_back(0.0f, 0.0f);
+
+    // Populate solver record
+    ElementIndex const springIndex = static_cast<ElementIndex>(mEndpointsBuffer.GetCurrentPopulatedSize() - 1);
+    auto & solverSpringBlock = mSolverSpringBlocksBuffer[springIndex / SolverSpringBlockSize];
+    solverSpringBlock.PointAIndex[springIndex % SolverSpringBlockSize] = pointAIndex;
+    solverSpringBlock.PointBIndex[springIndex % SolverSpringBlockSize] = pointBIndex;
+    solverSpringBlock.RestLength[springIndex % SolverSpringBlockSize] = restLength;
 
-    mCoefficientsBuffer.emplace_back(
+    SetCoefficients(
+        springIndex,
         CalculateStiffnessCoefficient(
             pointAIndex,
             pointBIndex,
@@ -93,6 +106,8 @@ void Springs::Destroy(
     GameParameters const & gameParameters,
     Points const & points)
 {
+    TRACE_SCOPE("Springs::Destroy");
+
     assert(springElementIndex < mElementCount);
     assert(!IsDeleted(springElementIndex));
 
@@ -117,11 +132,10 @@ void Springs::Destroy(
     // Zero out our coefficients, so that we can still calculate Hooke's
     // and damping forces for this spring without running the risk of
     // affecting non-deleted points
-    mCoefficientsBuffer[springElementIndex].StiffnessCoefficient = 0.0f;
-    mCoefficientsBuffer[springElementIndex].DampingCoefficient = 0.0f;
+    SetCoefficients(springElementIndex, 0.0f, 0.0f);
 
     // Flag ourselves as deleted
-    mIsDeletedBuffer[springElementIndex] = true;
+    mIsDeletedBuffer.set(springElementIndex, true);
 }
 
 void Springs::Restore(
@@ -133,24 +147,25 @@ void Springs::Restore(
     assert(IsDeleted(springElementIndex));
 
     // Clear the delete flag
-    mIsDeletedBuffer[springElementIndex] = false;
+    mIsDeletedBuffer.set(springElementIndex, false);
 
     // Recalculate coefficients
 
-    mCoefficientsBuffer[springElementIndex].StiffnessCoefficient = CalculateStiffnessCoefficient(
-        GetEndpointAIndex(springElementIndex),
-        GetEndpointBIndex(springElementIndex),
-        GetMaterialStiffness(springElementIndex),
-        gameParameters.SpringStiffnessAdjustment,
-        gameParameters.NumMechanicalDynamicsIterations<float>(),
-        points);
-
-    mCoefficientsBuffer[springElementIndex].DampingCoefficient = CalculateDampingCoefficient(
-        GetEndpointAIndex(springElementIndex),
-        GetEndpointBIndex(springElementIndex),
-        gameParameters.SpringDampingAdjustment,
-        gameParameters.NumMechanicalDynamicsIterations<float>(),
-        points);
+    SetCoefficients(
+        springElementIndex,
+        CalculateStiffnessCoefficient(
+            GetEndpointAIndex(springElementIndex),
+            GetEndpointBIndex(springElementIndex),
+            GetMaterialStiffness(springElementIndex),
+            gameParameters.SpringStiffnessAdjustment,
+            gameParameters.NumMechanicalDynamicsIterations<float>(),
+            points),
+        CalculateDampingCoefficient(
+            GetEndpointAIndex(springElementIndex),
+            GetEndpointBIndex(springElementIndex),
+            gameParameters.SpringDampingAdjustment,
+            gameParameters.NumMechanicalDynamicsIterations<float>(),
+            points));
 
     // Invoke restore handler
     if (!!mRestoreHandler)
@@ -175,20 +190,21 @@ void Springs::UpdateGameParameters(
         {
             if (!IsDeleted(i))
             {
-                mCoefficientsBuffer[i].StiffnessCoefficient = CalculateStiffnessCoefficient(
-                    GetEndpointAIndex(i),
-                    GetEndpointBIndex(i),
-                    GetMaterialStiffness(i),
-                    gameParameters.SpringStiffnessAdjustment,
-                    numMechanicalDynamicsIterations,
-                    points);
-
-                mCoefficientsBuffer[i].DampingCoefficient = CalculateDampingCoefficient(
-                    GetEndpointAIndex(i),
-                    GetEndpointBIndex(i),
-                    gameParameters.SpringDampingAdjustment,
-                    numMechanicalDynamicsIterations,
-                    points);
+                SetCoefficients(
+                    i,
+                    CalculateStiffnessCoefficient(
+                        GetEndpointAIndex(i),
+                        GetEndpointBIndex(i),
+                        GetMaterialStiffness(i),
+                        gameParameters.SpringStiffnessAdjustment,
+                        numMechanicalDynamicsIterations,
+                        points),
+                    CalculateDampingCoefficient(
+                        GetEndpointAIndex(i),
+                        GetEndpointBIndex(i),
+                        gameParameters.SpringDampingAdjustment,
+                        numMechanicalDynamicsIterations,
+                        points));
             }
         }
 
@@ -199,6 +215,76 @@ void Springs::UpdateGameParameters(
     }
 }
 
+size_t Springs::GetMemoryFootprint() const
+{
+    return
+        mIsDeletedBuffer.GetByteSize()
+        + mEndpointsBuffer.GetByteSize()
+        + mFactoryEndpointOctantsBuffer.GetByteSize()
+        + mSuperTrianglesBuffer.GetByteSize()
+        + mFactorySuperTrianglesBuffer.GetByteSize()
+        + mStrengthBuffer.GetByteSize()
+        + mMaterialStrengthBuffer.GetByteSize()
+        + mMaterialStiffnessBuffer.GetByteSize()
+        + mRestLengthBuffer.GetByteSize()
+        + mCoefficientsBuffer.GetByteSize()
+        + mSolverSpringBlocksBuffer.GetByteSize()
+        + mMaterialCharacteristicsBuffer.GetByteSize()
+        + mBaseStructuralMaterialBuffer.GetByteSize()
+        + mMaterialWaterPermeabilityBuffer.GetByteSize()
+        + mMaterialThermalConductivityBuffer.GetByteSize()
+        + mMaterialMeltingTemperatureBuffer.GetByteSize()
+        + mIsStressedBuffer.GetByteSize()
+        + mIsBombAttachedBuffer.GetByteSize()
+        + mFloatBufferAllocator.GetByteSize()
+        + mVec2fBufferAllocator.GetByteSize();
+}
+
+void Springs::SaveState(CheckpointWriter & checkpoint) const
+{
+    VisitState(*this, checkpoint);
+}
+
+void Springs::LoadState(CheckpointReader & checkpoint)
+{
+    VisitState(*this, checkpoint);
+}
+
+template<typename TSelf, typename TArchive>
+void Springs::VisitState(
+    TSelf & self,
+    TArchive & archive)
+{
+    archive.Visit("IsDeleted", self.mIsDeletedBuffer);
+    archive.Visit("Endpoints", self.mEndpointsBuffer);
+    archive.Visit("FactoryEndpointOctants", self.mFactoryEndpointOctantsBuffer);
+    archive.Visit("SuperTriangles", self.mSuperTrianglesBuffer);
+    archive.Visit("FactorySuperTriangles", self.mFactorySuperTrianglesBuffer);
+
+    // Physical
+    archive.Visit("Strength", self.mStrengthBuffer);
+    archive.Visit("MaterialStrength", self.mMaterialStrengthBuffer);
+    archive.Visit("MaterialStiffness", self.mMaterialStiffnessBuffer);
+    archive.Visit("RestLength", self.mRestLengthBuffer);
+    archive.Visit("Coefficients", self.mCoefficientsBuffer);
+    archive.Visit("SolverSpringBlocks", self.mSolverSpringBlocksBuffer);
+    archive.Visit("MaterialCharacteristics", self.mMaterialCharacteristicsBuffer);
+
+    // Water and heat
+    archive.Visit("MaterialWaterPermeability", self.mMaterialWaterPermeabilityBuffer);
+    archive.Visit("MaterialThermalConductivity", self.mMaterialThermalConductivityBuffer);
+    archive.Visit("MaterialMeltingTemperature", self.mMaterialMeltingTemperatureBuffer);
+
+    // Stress and bombs
+    archive.Visit("IsStressed", self.mIsStressedBuffer);
+    archive.Visit("IsBombAttached", self.mIsBombAttachedBuffer);
+
+    // Parameters we are current with
+    archive.Visit("CurrentNumMechanicalDynamicsIterations", self.mCurrentNumMechanicalDynamicsIterations);
+    archive.Visit("CurrentSpringStiffnessAdjustment", self.mCurrentSpringStiffnessAdjustment);
+    archive.Visit("CurrentSpringDampingAdjustment", self.mCurrentSpringDampingAdjustment);
+}
+
 void Springs::UploadElements(
     ShipId shipId,
     Render::RenderContext & renderContext) const
@@ -259,7 +345,8 @@ void Springs::UploadStressedSpringElements(
 
 bool Springs::UpdateStrains(
     GameParameters const & gameParameters,
-    Points & points)
+    Points & points,
+    StructuralCommandBuffer & structuralCommands)
 {
     // We need to adjust the strength - i.e. the displacement tolerance or spring breaking point - based
     // on the actual number of mechanics iterations we'll be performing.
@@ -308,13 +395,8 @@ bool Springs::UpdateStrains(
             {
                 // It's broken!
 
-                // Destroy this spring
-                this->Destroy(
-                    s,
-                    DestroyOptions::FireBreakEvent // Notify Break
-                    | DestroyOptions::DestroyAllTriangles,
-                    gameParameters,
-                    points);
+                // Destroy this spring - at the end of the step
+                structuralCommands.RecordSpringBreak(s);
 
                 isAtLeastOneBroken = true;
             }
@@ -326,7 +408,7 @@ bool Springs::UpdateStrains(
                 if (strain < StrainLowWatermark * effectiveStrength)
                 {
                     // It's not stressed anymore
-                    mIsStressedBuffer[s] = false;
+                    mIsStressedBuffer.set(s, false);
                 }
             }
             else
@@ -337,7 +419,7 @@ bool Springs::UpdateStrains(
                 if (strain > StrainHighWatermark * effectiveStrength)
                 {
                     // It's stressed!
-                    mIsStressedBuffer[s] = true;
+                    mIsStressedBuffer.set(s, true);
 
                     // Notify stress
                     mGameEventHandler->OnStress(
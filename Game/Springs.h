@@ -9,9 +9,12 @@
 #include "GameParameters.h"
 #include "Materials.h"
 #include "RenderContext.h"
+#include "StructuralCommandBuffer.h"
 
+#include <GameCore/BitBuffer.h>
 #include <GameCore/Buffer.h>
 #include <GameCore/BufferAllocator.h>
+#include <GameCore/Checkpoint.h>
 #include <GameCore/ElementContainer.h>
 #include <GameCore/EnumFlags.h>
 #include <GameCore/FixedSizeVector.h>
@@ -52,6 +55,46 @@ public:
         ElementIndex,
         GameParameters const &)>;
 
+    /*
+     * The number of springs in a solver spring block.
+     */
+    static constexpr size_t SolverSpringBlockSize = 8;
+
+    // The buffer of blocks is sized by dividing the spring buffer's element count - a
+    // multiple of the vectorization word size - by the block size
+    static_assert(VectorizationWordSize == SolverSpringBlockSize);
+
+    /*
+     * All that the mechanical solver needs to know about a block of consecutive springs,
+     * packed together so that the solver may stream through one single buffer, and laid
+     * out in lanes so that the solver may process a whole block at once.
+     *
+     * Deleted springs - and lanes past the last spring - have zero coefficients. Lanes past
+     * the last spring also have both endpoints at point zero: this is harmless only because
+     * normalise() of a zero vector returns a zero vector, rather than NaNs that the zero
+     * coefficients would not cancel.
+     */
+    struct SolverSpringBlock
+    {
+        ElementIndex PointAIndex[SolverSpringBlockSize];
+        ElementIndex PointBIndex[SolverSpringBlockSize];
+        float RestLength[SolverSpringBlockSize];
+        float StiffnessCoefficient[SolverSpringBlockSize];
+        float DampingCoefficient[SolverSpringBlockSize];
+
+        SolverSpringBlock()
+        {
+            for (size_t l = 0; l < SolverSpringBlockSize; ++l)
+            {
+                PointAIndex[l] = 0;
+                PointBIndex[l] = 0;
+                RestLength[l] = 1.0f;
+                StiffnessCoefficient[l] = 0.0f;
+                DampingCoefficient[l] = 0.0f;
+            }
+        }
+    };
+
 private:
 
     /*
@@ -135,6 +178,7 @@ public:
         , mMaterialStiffnessBuffer(mBufferElementCount, mElementCount, 0.0f)
         , mRestLengthBuffer(mBufferElementCount, mElementCount, 1.0f)
         , mCoefficientsBuffer(mBufferElementCount, mElementCount, Coefficients(0.0f, 0.0f))
+        , mSolverSpringBlocksBuffer(make_aligned_element_count(mBufferElementCount / SolverSpringBlockSize), 0, SolverSpringBlock())
         , mMaterialCharacteristicsBuffer(mBufferElementCount, mElementCount, Characteristics::None)
         , mBaseStructuralMaterialBuffer(mBufferElementCount, mElementCount, nullptr)
         // Water
@@ -156,13 +200,26 @@ public:
         , mCurrentNumMechanicalDynamicsIterations(gameParameters.NumMechanicalDynamicsIterations<float>())
         , mCurrentSpringStiffnessAdjustment(gameParameters.SpringStiffnessAdjustment)
         , mCurrentSpringDampingAdjustment(gameParameters.SpringDampingAdjustment)
-        , mFloatBufferAllocator(mBufferElementCount)
-        , mVec2fBufferAllocator(mBufferElementCount)
+        , mFloatBufferAllocator(mBufferElementCount, 0)
+        , mVec2fBufferAllocator(mBufferElementCount, 0)
     {
     }
 
     Springs(Springs && other) = default;
 
+    /*
+     * Returns the number of bytes currently occupied by all of the buffers of this container.
+     */
+    size_t GetMemoryFootprint() const;
+
+    /*
+     * Saves and restores the state of all springs; the materials are not part of the
+     * state, hence the state may only be restored onto springs built from the same
+     * ship definition.
+     */
+    void SaveState(CheckpointWriter & checkpoint) const;
+    void LoadState(CheckpointReader & checkpoint);
+
     /*
      * Sets a (single) handler that is invoked whenever a spring is destroyed.
      *
@@ -229,32 +286,34 @@ public:
     {
         assert(springElementIndex < mElementCount);
 
-        mCoefficientsBuffer[springElementIndex].StiffnessCoefficient =
+        SetCoefficients(
+            springElementIndex,
             CalculateStiffnessCoefficient(
                 mEndpointsBuffer[springElementIndex].PointAIndex,
                 mEndpointsBuffer[springElementIndex].PointBIndex,
                 mMaterialStiffnessBuffer[springElementIndex],
                 mCurrentSpringStiffnessAdjustment,
                 mCurrentNumMechanicalDynamicsIterations,
-                points);
-
-        mCoefficientsBuffer[springElementIndex].DampingCoefficient =
+                points),
             CalculateDampingCoefficient(
                 mEndpointsBuffer[springElementIndex].PointAIndex,
                 mEndpointsBuffer[springElementIndex].PointBIndex,
                 mCurrentSpringDampingAdjustment,
                 mCurrentNumMechanicalDynamicsIterations,
-                points);
+                points));
     }
 
     /*
-     * Calculates the current strain - due to tension or compression - and acts depending on it.
+     * Calculates the current strain - due to tension or compression - and acts depending on it;
+     * springs that break are not destroyed here, but rather recorded for destruction at the end
+     * of the step.
      *
-     * Returns true if the spring got broken.
+     * Returns true if at least one spring got broken.
      */
     bool UpdateStrains(
         GameParameters const & gameParameters,
-        Points & points);
+        Points & points,
+        StructuralCommandBuffer & structuralCommands);
 
     //
     // Render
@@ -318,14 +377,14 @@ public:
             return -1.0f;
     }
 
-    vec2f const & GetEndpointAPosition(
+    vec2f GetEndpointAPosition(
         ElementIndex springElementIndex,
         Points const & points) const
     {
         return points.GetPosition(mEndpointsBuffer[springElementIndex].PointAIndex);
     }
 
-    vec2f const & GetEndpointBPosition(
+    vec2f GetEndpointBPosition(
         ElementIndex springElementIndex,
         Points const & points) const
     {
@@ -492,6 +551,20 @@ public:
         return mCoefficientsBuffer[springElementIndex].DampingCoefficient;
     }
 
+    SolverSpringBlock const * GetSolverSpringBlocks() const
+    {
+        return mSolverSpringBlocksBuffer.data();
+    }
+
+    /*
+     * The number of solver spring blocks covering all springs; the last block
+     * might be partially populated.
+     */
+    size_t GetSolverSpringBlockCount() const
+    {
+        return (static_cast<size_t>(mElementCount) + SolverSpringBlockSize - 1) / SolverSpringBlockSize;
+    }
+
     StructuralMaterial const & GetBaseStructuralMaterial(ElementIndex springElementIndex) const
     {
         // If this method is invoked, this is not a placeholder
@@ -541,7 +614,7 @@ public:
         assert(false == mIsDeletedBuffer[springElementIndex]);
         assert(false == mIsBombAttachedBuffer[springElementIndex]);
 
-        mIsBombAttachedBuffer[springElementIndex] = true;
+        mIsBombAttachedBuffer.set(springElementIndex, true);
 
         // Augment mass of endpoints due to bomb
 
@@ -563,7 +636,7 @@ public:
         assert(false == mIsDeletedBuffer[springElementIndex]);
         assert(true == mIsBombAttachedBuffer[springElementIndex]);
 
-        mIsBombAttachedBuffer[springElementIndex] = false;
+        mIsBombAttachedBuffer.set(springElementIndex, false);
 
         // Reset mass of endpoints
 
@@ -582,18 +655,37 @@ public:
     // Temporary buffer
     //
 
-    std::shared_ptr<Buffer<float>> AllocateWorkBufferFloat()
+    BufferAllocator<float>::BufferHandle AllocateWorkBufferFloat()
     {
         return mFloatBufferAllocator.Allocate();
     }
 
-    std::shared_ptr<Buffer<vec2f>> AllocateWorkBufferVec2f()
+    BufferAllocator<vec2f>::BufferHandle AllocateWorkBufferVec2f()
     {
         return mVec2fBufferAllocator.Allocate();
     }
 
 private:
 
+    // Visits the members making up the state, both for saving and for restoring
+    template<typename TSelf, typename TArchive>
+    static void VisitState(
+        TSelf & self,
+        TArchive & archive);
+
+    inline void SetCoefficients(
+        ElementIndex springElementIndex,
+        float stiffnessCoefficient,
+        float dampingCoefficient)
+    {
+        mCoefficientsBuffer[springElementIndex].StiffnessCoefficient = stiffnessCoefficient;
+        mCoefficientsBuffer[springElementIndex].DampingCoefficient = dampingCoefficient;
+
+        auto & solverSpringBlock = mSolverSpringBlocksBuffer[springElementIndex / SolverSpringBlockSize];
+        solverSpringBlock.StiffnessCoefficient[springElementIndex % SolverSpringBlockSize] = stiffnessCoefficient;
+        solverSpringBlock.DampingCoefficient[springElementIndex % SolverSpringBlockSize] = dampingCoefficient;
+    }
+
     static float CalculateStiffnessCoefficient(
         ElementIndex pointAIndex,
         ElementIndex pointBIndex,
@@ -616,7 +708,7 @@ private:
     //////////////////////////////////////////////////////////
 
     // Deletion
-    Buffer<bool> mIsDeletedBuffer;
+    BitBuffer mIsDeletedBuffer;
 
     // Endpoints
     Buffer<Endpoints> mEndpointsBuffer;
@@ -641,6 +733,9 @@ private:
     Buffer<float> mMaterialStiffnessBuffer;
     Buffer<float> mRestLengthBuffer;
     Buffer<Coefficients> mCoefficientsBuffer;
+
+    // Endpoints, rest length, and coefficients again, packed for the mechanical solver
+    Buffer<SolverSpringBlock> mSolverSpringBlocksBuffer;
     Buffer<Characteristics> mMaterialCharacteristicsBuffer;
     Buffer<StructuralMaterial const *> mBaseStructuralMaterialBuffer;
 
@@ -664,13 +759,13 @@ private:
     //
 
     // State variable that tracks when we enter and exit the stressed state
-    Buffer<bool> mIsStressedBuffer;
+    BitBuffer mIsStressedBuffer;
 
     //
     // Bombs
     //
 
-    Buffer<bool> mIsBombAttachedBuffer;
+    BitBuffer mIsBombAttachedBuffer;
 
     //////////////////////////////////////////////////////////
     // Container
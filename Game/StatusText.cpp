@@ -39,7 +39,9 @@ void StatusText::SetText(
     vec2f const & camera,
     float totalUpdateToRenderDurationRatio,
     float lastUpdateToRenderDurationRatio,
-    Render::RenderStatistics const & renderStatistics)
+    Render::RenderStatistics const & renderStatistics,
+    std::vector<float> const & threadPoolUtilizations,
+    std::vector<ProfiledSectionStatistics> const & frameProfile)
 {
     int elapsedSecondsGameInt = static_cast<int>(roundf(elapsedGameSeconds.count()));
     int minutesGame = elapsedSecondsGameInt / 60;
@@ -91,6 +93,41 @@ void StatusText::SetText(
             << " GENTEX:" << renderStatistics.LastRenderedShipGenericTextures;
 
         mTextLines.emplace_back(ss.str());
+
+        // Fraction of time each thread spent in parallel loops, main thread first
+        ss.str("");
+
+        ss << std::setprecision(0) << "WRK:";
+        for (float utilization : threadPoolUtilizations)
+        {
+            ss << " " << (100.0f * utilization) << "%";
+        }
+
+        mTextLines.emplace_back(ss.str());
+
+        // Time spent in each frame section, per second, skipping the negligible ones
+        for (auto const & section : frameProfile)
+        {
+            if (section.MillisecondsPerSecond < 1.0f)
+                continue;
+
+            ss.str("");
+
+            ss << std::setprecision(1)
+                << (section.Depth == 0 ? "PRF:" : "    ") << std::string(2 * section.Depth, ' ')
+                << section.Name << " " << section.MillisecondsPerSecond << "ms/s"
+                << " (" << (100.0f * section.FractionOfParent) << "%)";
+
+            if (section.HardwareCounters.Cycles != 0)
+            {
+                ss << std::setprecision(2)
+                    << " IPC:" << section.HardwareCounters.GetInstructionsPerCycle()
+                    << " LLC:" << (section.HardwareCounters.LLCMisses / 1000) << "K"
+                    << " TLB:" << (section.HardwareCounters.DTLBMisses / 1000) << "K";
+            }
+
+            mTextLines.emplace_back(ss.str());
+        }
     }
 
     mIsTextDirty = true;
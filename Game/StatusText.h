@@ -5,6 +5,7 @@
 ***************************************************************************************/
 #pragma once
 
+#include "FrameProfiler.h"
 #include "RenderContext.h"
 
 #include <GameCore/GameTypes.h>
@@ -34,7 +35,9 @@ public:
         vec2f const & camera,
         float totalUpdateToRenderDurationRatio,
         float lastUpdateToRenderDurationRatio,
-        Render::RenderStatistics const & renderStatistics);
+        Render::RenderStatistics const & renderStatistics,
+        std::vector<float> const & threadPoolUtilizations,
+        std::vector<ProfiledSectionStatistics> const & frameProfile);
 
     void Render(Render::RenderContext & renderContext);
 
@@ -0,0 +1,230 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2020-01-02
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <GameCore/GameTypes.h>
+#include <GameCore/Vectors.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Physics
+{
+
+/*
+ * Collects the structural mutations - spring breaks and point detachments - that the
+ * simulation loops of a step decide upon, so that the loops themselves never modify the
+ * topology they are iterating; the ship applies all of the commands, and fires all of their
+ * events, in a single phase of its update.
+ *
+ * Commands may be recorded concurrently from within parallel loops: each thread records them
+ * into its own buffer, without locking. The order in which they are applied does not depend
+ * on the order in which they have been recorded, nor on the threads that recorded them.
+ *
+ * The destruction of triangles and electrical elements is not recorded here, as it only ever
+ * follows from the commands themselves, while they are being applied.
+ */
+class StructuralCommandBuffer
+{
+public:
+
+    enum class CommandType : std::uint8_t
+    {
+        // Declared in order of application
+        DetachPoint,
+        BreakSpring
+    };
+
+    struct Command
+    {
+        CommandType Type;
+        ElementIndex Element;
+        vec2f Velocity; // DetachPoint only
+        bool GenerateDebris; // DetachPoint only
+
+        Command(
+            CommandType type,
+            ElementIndex element,
+            vec2f const & velocity,
+            bool generateDebris)
+            : Type(type)
+            , Element(element)
+            , Velocity(velocity)
+            , GenerateDebris(generateDebris)
+        {}
+    };
+
+public:
+
+    StructuralCommandBuffer()
+        : mId(NextId++)
+        , mThreadCommands()
+        , mThreadCommandsMutex()
+        , mCommands()
+    {}
+
+    void RecordPointDetach(
+        ElementIndex pointElementIndex,
+        vec2f const & velocity,
+        bool generateDebris)
+    {
+        GetThreadCommands().emplace_back(CommandType::DetachPoint, pointElementIndex, velocity, generateDebris);
+    }
+
+    void RecordSpringBreak(ElementIndex springElementIndex)
+    {
+        GetThreadCommands().emplace_back(CommandType::BreakSpring, springElementIndex, vec2f::zero(), false);
+    }
+
+    /*
+     * Not thread-safe: to be invoked while no thread is recording.
+     */
+    bool IsEmpty() const
+    {
+        return std::all_of(
+            mThreadCommands.cbegin(),
+            mThreadCommands.cend(),
+            [](ThreadCommands const & threadCommands)
+            {
+                return threadCommands.Commands->empty();
+            });
+    }
+
+    /*
+     * Gathers the commands recorded by all threads, sorts them by type and then by element,
+     * and returns them. Of the commands for the same element only one survives: the strongest
+     * detachment - with debris, and then with the fastest velocity - or the one spring break.
+     *
+     * Not thread-safe: to be invoked once all recording has completed.
+     */
+    std::vector<Command> const & Seal()
+    {
+        mCommands.clear();
+
+        for (auto & threadCommands : mThreadCommands)
+        {
+            mCommands.insert(
+                mCommands.end(),
+                threadCommands.Commands->cbegin(),
+                threadCommands.Commands->cend());
+
+            threadCommands.Commands->clear();
+        }
+
+        // A total order, so that the surviving command does not depend on the recording order
+        std::sort(
+            mCommands.begin(),
+            mCommands.end(),
+            [](Command const & lhs, Command const & rhs)
+            {
+                if (lhs.Type != rhs.Type)
+                    return lhs.Type < rhs.Type;
+                if (lhs.Element != rhs.Element)
+                    return lhs.Element < rhs.Element;
+                if (lhs.GenerateDebris != rhs.GenerateDebris)
+                    return lhs.GenerateDebris;
+
+                float const lhsSquareSpeed = lhs.Velocity.squareLength();
+                float const rhsSquareSpeed = rhs.Velocity.squareLength();
+                if (lhsSquareSpeed != rhsSquareSpeed)
+                    return lhsSquareSpeed > rhsSquareSpeed;
+                if (lhs.Velocity.x != rhs.Velocity.x)
+                    return lhs.Velocity.x > rhs.Velocity.x;
+
+                return lhs.Velocity.y > rhs.Velocity.y;
+            });
+
+        mCommands.erase(
+            std::unique(
+                mCommands.begin(),
+                mCommands.end(),
+                [](Command const & lhs, Command const & rhs)
+                {
+                    return lhs.Type == rhs.Type && lhs.Element == rhs.Element;
+                }),
+            mCommands.end());
+
+        return mCommands;
+    }
+
+    /*
+     * Forgets all commands, retaining the memory for the next step.
+     *
+     * Not thread-safe: to be invoked while no thread is recording.
+     */
+    void Clear()
+    {
+        for (auto & threadCommands : mThreadCommands)
+        {
+            threadCommands.Commands->clear();
+        }
+
+        mCommands.clear();
+    }
+
+private:
+
+    std::vector<Command> & GetThreadCommands()
+    {
+        // Remembers the buffer of the last command buffer used by this thread
+        thread_local std::uint64_t cachedId = 0;
+        thread_local std::vector<Command> * cachedCommands = nullptr;
+
+        if (cachedId != mId)
+        {
+            std::lock_guard<std::mutex> lock(mThreadCommandsMutex);
+
+            auto const threadId = std::this_thread::get_id();
+
+            auto it = std::find_if(
+                mThreadCommands.begin(),
+                mThreadCommands.end(),
+                [&threadId](ThreadCommands const & threadCommands)
+                {
+                    return threadCommands.ThreadId == threadId;
+                });
+
+            if (it == mThreadCommands.end())
+            {
+                mThreadCommands.push_back({ threadId, std::make_unique<std::vector<Command>>() });
+                it = std::prev(mThreadCommands.end());
+            }
+
+            cachedId = mId;
+            cachedCommands = it->Commands.get();
+        }
+
+        return *cachedCommands;
+    }
+
+private:
+
+    // IDs start at 1, so that 0 never matches a thread's cached command buffer
+    static inline std::atomic<std::uint64_t> NextId{ 1 };
+
+    std::uint64_t const mId;
+
+    // The commands recorded by each thread
+    struct ThreadCommands
+    {
+        std::thread::id ThreadId;
+        std::unique_ptr<std::vector<Command>> Commands;
+    };
+
+    std::vector<ThreadCommands> mThreadCommands;
+    std::mutex mThreadCommandsMutex;
+
+    // The commands of all threads, once sealed
+    std::vector<Command> mCommands;
+};
+
+}
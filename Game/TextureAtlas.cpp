@@ -7,6 +7,7 @@
 
 #include <GameCore/GameException.h>
 #include <GameCore/GameMath.h>
+#include <GameCore/ImageTools.h>
 
 #include <algorithm>
 #include <cstring>
@@ -82,6 +83,102 @@ TextureAtlas TextureAtlasBuilder::BuildAtlas(ProgressCallback const & progressCa
         progressCallback);
 }
 
+TextureAtlas TextureAtlasBuilder::BuildAtlas(
+    std::string const & cacheKey,
+    bool doMipmaps,
+    TextureCache & textureCache,
+    ProgressCallback const & progressCallback)
+{
+    //
+    // Check whether the cache has an atlas for exactly our frames
+    //
+
+    TextureCache::Entry const * cacheEntry = textureCache.GetEntry(cacheKey);
+    if (nullptr != cacheEntry
+        && !cacheEntry->Levels.empty()
+        && cacheEntry->Levels[0].Size == cacheEntry->AtlasSize
+        && (cacheEntry->Levels.size() > 1) == doMipmaps
+        && cacheEntry->FramePositions.size() == mTextureFrameSpecifications.size()
+        && std::all_of(
+            cacheEntry->FramePositions.cbegin(),
+            cacheEntry->FramePositions.cend(),
+            [this](TextureCache::FramePosition const & fp)
+            {
+                return this->mTextureFrameSpecifications.count(fp.FrameId) != 0;
+            }))
+    {
+        // Build metadata from cached layout
+        std::vector<TextureAtlasFrameMetadata> metadata;
+        for (auto const & framePosition : cacheEntry->FramePositions)
+        {
+            metadata.emplace_back(
+                MakeFrameMetadata(
+                    AtlasSpecification::TexturePosition(
+                        framePosition.FrameId,
+                        framePosition.FrameLeftX,
+                        framePosition.FrameBottomY),
+                    cacheEntry->AtlasSize,
+                    mTextureFrameSpecifications.at(framePosition.FrameId).Metadata));
+        }
+
+        // Copy images out of the cache
+        std::vector<RgbaImageData> mipmaps;
+        for (size_t l = 1; l < cacheEntry->Levels.size(); ++l)
+        {
+            mipmaps.emplace_back(TextureCache::CloneImage(cacheEntry->Levels[l]));
+        }
+
+        progressCallback(1.0f, "Building texture atlas...");
+
+        return TextureAtlas(
+            metadata,
+            TextureCache::CloneImage(cacheEntry->Levels[0]),
+            std::move(mipmaps));
+    }
+
+    //
+    // Build atlas from scratch
+    //
+
+    TextureAtlas atlas = BuildAtlas(progressCallback);
+
+    if (doMipmaps)
+    {
+        atlas.Mipmaps = ImageTools::MakePowerOfTwoMipmaps(
+            atlas.AtlasData,
+            atlas.Metadata.GetMaxDimension());
+    }
+
+    //
+    // Store in cache
+    //
+
+    std::vector<TextureCache::FramePosition> framePositions;
+    for (auto const & frameMetadata : atlas.Metadata.GetFrameMetadata())
+    {
+        framePositions.emplace_back(
+            frameMetadata.FrameMetadata.FrameId,
+            frameMetadata.FrameLeftX,
+            frameMetadata.FrameBottomY);
+    }
+
+    std::vector<RgbaImageData> levels;
+    levels.emplace_back(TextureCache::CloneImage(atlas.AtlasData));
+    for (auto const & mipmap : atlas.Mipmaps)
+    {
+        levels.emplace_back(TextureCache::CloneImage(mipmap));
+    }
+
+    textureCache.PutEntry(
+        cacheKey,
+        TextureCache::Entry(
+            atlas.AtlasData.Size,
+            std::move(framePositions),
+            std::move(levels)));
+
+    return atlas;
+}
+
 /////////////////////////////////////////////////////////////////////////////////////
 
 TextureAtlasBuilder::AtlasSpecification TextureAtlasBuilder::BuildAtlasSpecification(std::vector<TextureInfo> const & inputTextureInfos)
@@ -220,9 +317,6 @@ TextureAtlas TextureAtlasBuilder::BuildAtlas(
     std::function<TextureFrame(TextureFrameId const &)> frameLoader,
     ProgressCallback const & progressCallback)
 {
-    float const dx = 0.5f / static_cast<float>(specification.AtlasSize.Width);
-    float const dy = 0.5f / static_cast<float>(specification.AtlasSize.Height);
-
     // Allocate image
     size_t const imagePoints = specification.AtlasSize.Width * specification.AtlasSize.Height;
     std::unique_ptr<rgbaColor[]> atlasImage(new rgbaColor[imagePoints]);
@@ -252,17 +346,10 @@ TextureAtlas TextureAtlasBuilder::BuildAtlas(
 
         // Store texture coordinates
         metadata.emplace_back(
-            // Bottom-left
-            vec2f(
-                dx + static_cast<float>(texturePosition.FrameLeftX) / static_cast<float>(specification.AtlasSize.Width),
-                dy + static_cast<float>(texturePosition.FrameBottomY) / static_cast<float>(specification.AtlasSize.Height)),
-            // Top-right
-            vec2f(
-                static_cast<float>(texturePosition.FrameLeftX + textureFrame.TextureData.Size.Width) / static_cast<float>(specification.AtlasSize.Width) - dx,
-                static_cast<float>(texturePosition.FrameBottomY + textureFrame.TextureData.Size.Height) / static_cast<float>(specification.AtlasSize.Height) - dy),
-            texturePosition.FrameLeftX,
-            texturePosition.FrameBottomY,
-            textureFrame.Metadata);
+            MakeFrameMetadata(
+                texturePosition,
+                specification.AtlasSize,
+                textureFrame.Metadata));
     }
 
     RgbaImageData atlasImageData(
@@ -279,6 +366,28 @@ TextureAtlas TextureAtlasBuilder::BuildAtlas(
         std::move(atlasImageData));
 }
 
+TextureAtlasFrameMetadata TextureAtlasBuilder::MakeFrameMetadata(
+    AtlasSpecification::TexturePosition const & texturePosition,
+    ImageSize const & atlasSize,
+    TextureFrameMetadata const & frameMetadata)
+{
+    float const dx = 0.5f / static_cast<float>(atlasSize.Width);
+    float const dy = 0.5f / static_cast<float>(atlasSize.Height);
+
+    return TextureAtlasFrameMetadata(
+        // Bottom-left
+        vec2f(
+            dx + static_cast<float>(texturePosition.FrameLeftX) / static_cast<float>(atlasSize.Width),
+            dy + static_cast<float>(texturePosition.FrameBottomY) / static_cast<float>(atlasSize.Height)),
+        // Top-right
+        vec2f(
+            static_cast<float>(texturePosition.FrameLeftX + frameMetadata.Size.Width) / static_cast<float>(atlasSize.Width) - dx,
+            static_cast<float>(texturePosition.FrameBottomY + frameMetadata.Size.Height) / static_cast<float>(atlasSize.Height) - dy),
+        texturePosition.FrameLeftX,
+        texturePosition.FrameBottomY,
+        frameMetadata);
+}
+
 void TextureAtlasBuilder::CopyImage(
     std::unique_ptr<rgbaColor const []> sourceImage,
     ImageSize sourceImageSize,
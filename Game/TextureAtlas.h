@@ -5,6 +5,7 @@
 ***************************************************************************************/
 #pragma once
 
+#include "TextureCache.h"
 #include "TextureDatabase.h"
 
 #include <GameCore/ImageData.h>
@@ -15,6 +16,7 @@
 #include <cassert>
 #include <memory>
 #include <numeric>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -130,11 +132,24 @@ struct TextureAtlas
     // The image itself
     RgbaImageData AtlasData;
 
+    // The mipmaps of the image, from level 1 onwards; empty when the atlas is not mipmapped
+    std::vector<RgbaImageData> Mipmaps;
+
     TextureAtlas(
         TextureAtlasMetadata const & metadata,
         RgbaImageData atlasData)
         : Metadata(metadata)
         , AtlasData(std::move(atlasData))
+        , Mipmaps()
+    {}
+
+    TextureAtlas(
+        TextureAtlasMetadata const & metadata,
+        RgbaImageData atlasData,
+        std::vector<RgbaImageData> mipmaps)
+        : Metadata(metadata)
+        , AtlasData(std::move(atlasData))
+        , Mipmaps(std::move(mipmaps))
     {}
 };
 
@@ -181,6 +196,16 @@ public:
      */
     TextureAtlas BuildAtlas(ProgressCallback const & progressCallback);
 
+    /*
+     * Builds an atlas for the groups added so far, optionally together with its mipmaps,
+     * taking it from the specified cache when available and storing it there otherwise.
+     */
+    TextureAtlas BuildAtlas(
+        std::string const & cacheKey,
+        bool doMipmaps,
+        TextureCache & textureCache,
+        ProgressCallback const & progressCallback);
+
 private:
 
     struct TextureInfo
@@ -236,6 +261,11 @@ private:
         std::function<TextureFrame(TextureFrameId const &)> frameLoader,
         ProgressCallback const & progressCallback);
 
+    static TextureAtlasFrameMetadata MakeFrameMetadata(
+        AtlasSpecification::TexturePosition const & texturePosition,
+        ImageSize const & atlasSize,
+        TextureFrameMetadata const & frameMetadata);
+
     static void CopyImage(
         std::unique_ptr<rgbaColor const []> sourceImage,
         ImageSize sourceImageSize,
@@ -0,0 +1,426 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2019-12-21
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "TextureCache.h"
+
+#include <GameCore/GameException.h>
+#include <GameCore/Log.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace Render {
+
+namespace /* anonymous */ {
+
+    std::uint64_t constexpr FnvOffsetBasis = 14695981039346656037ull;
+    std::uint64_t constexpr FnvPrime = 1099511628211ull;
+
+    void HashBytes(
+        std::uint64_t & hash,
+        void const * data,
+        size_t size)
+    {
+        auto const * bytes = static_cast<std::uint8_t const *>(data);
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= FnvPrime;
+        }
+    }
+
+    class BufferReader
+    {
+    public:
+
+        explicit BufferReader(std::vector<std::uint8_t> const & buffer)
+            : mBuffer(buffer)
+            , mOffset(0)
+        {}
+
+        template<typename T>
+        T Read()
+        {
+            T value;
+            std::memcpy(&value, Advance(sizeof(T)), sizeof(T));
+            return value;
+        }
+
+        std::string ReadString(size_t length)
+        {
+            return std::string(reinterpret_cast<char const *>(Advance(length)), length);
+        }
+
+        void ReadBytes(
+            void * destination,
+            size_t size)
+        {
+            std::memcpy(destination, Advance(size), size);
+        }
+
+        bool IsAtEnd() const
+        {
+            return mOffset == mBuffer.size();
+        }
+
+    private:
+
+        std::uint8_t const * Advance(size_t size)
+        {
+            if (size > mBuffer.size() - mOffset)
+                throw GameException("The cache file is truncated");
+
+            std::uint8_t const * const data = mBuffer.data() + mOffset;
+            mOffset += size;
+            return data;
+        }
+
+        std::vector<std::uint8_t> const & mBuffer;
+        size_t mOffset;
+    };
+
+    class FileWriter
+    {
+    public:
+
+        explicit FileWriter(std::ofstream & file)
+            : mFile(file)
+        {}
+
+        template<typename T>
+        void Write(T value)
+        {
+            mFile.write(reinterpret_cast<char const *>(&value), sizeof(T));
+        }
+
+        void WriteString(std::string const & str)
+        {
+            Write(static_cast<std::uint32_t>(str.size()));
+            mFile.write(str.data(), str.size());
+        }
+
+        void WriteBytes(
+            void const * data,
+            size_t size)
+        {
+            mFile.write(static_cast<char const *>(data), size);
+        }
+
+    private:
+
+        std::ofstream & mFile;
+    };
+}
+
+std::unique_ptr<TextureCache> TextureCache::Load(
+    std::filesystem::path const & cacheFilePath,
+    std::filesystem::path const & texturesRootPath)
+{
+    std::uint64_t contentHash = 0;
+    try
+    {
+        contentHash = CalculateContentHash(texturesRootPath);
+    }
+    catch (std::exception const & ex)
+    {
+        LogMessage("TextureCache: cannot hash textures folder \"", texturesRootPath.string(), "\": ", ex.what());
+    }
+
+    auto textureCache = std::unique_ptr<TextureCache>(new TextureCache(cacheFilePath, contentHash));
+
+    if (!std::filesystem::exists(cacheFilePath))
+    {
+        LogMessage("TextureCache: no cache file found at \"", cacheFilePath.string(), "\"");
+        return textureCache;
+    }
+
+    try
+    {
+        //
+        // Read the whole file at once
+        //
+
+        std::ifstream file(cacheFilePath, std::ios::binary | std::ios::ate);
+        if (!file.is_open())
+        {
+            throw GameException("Cannot open file");
+        }
+
+        std::vector<std::uint8_t> buffer(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(reinterpret_cast<char *>(buffer.data()), buffer.size());
+        if (!file)
+        {
+            throw GameException("Cannot read file");
+        }
+
+        textureCache->Deserialize(buffer);
+
+        LogMessage("TextureCache: loaded ", textureCache->mImageSizes.size(), " image sizes and ", textureCache->mEntries.size(), " entries");
+    }
+    catch (std::exception const & ex)
+    {
+        LogMessage("TextureCache: ignoring cache file \"", cacheFilePath.string(), "\": ", ex.what());
+
+        textureCache->mImageSizes.clear();
+        textureCache->mEntries.clear();
+    }
+
+    return textureCache;
+}
+
+std::optional<ImageSize> TextureCache::GetImageSize(std::filesystem::path const & textureFilePath) const
+{
+    auto const it = mImageSizes.find(textureFilePath.filename().string());
+    if (it == mImageSizes.end())
+        return std::nullopt;
+
+    return it->second;
+}
+
+void TextureCache::PutImageSize(
+    std::filesystem::path const & textureFilePath,
+    ImageSize const & imageSize)
+{
+    mImageSizes.insert_or_assign(textureFilePath.filename().string(), imageSize);
+    mIsDirty = true;
+}
+
+TextureCache::Entry const * TextureCache::GetEntry(std::string const & key) const
+{
+    auto const it = mEntries.find(key);
+    if (it == mEntries.end())
+        return nullptr;
+
+    return &(it->second);
+}
+
+void TextureCache::PutEntry(
+    std::string const & key,
+    Entry && entry)
+{
+    mEntries.erase(key);
+    mEntries.emplace(key, std::move(entry));
+    mIsDirty = true;
+}
+
+void TextureCache::Save()
+{
+    std::filesystem::create_directories(mCacheFilePath.parent_path());
+
+    std::filesystem::path const tempCacheFilePath = mCacheFilePath.string() + ".tmp";
+
+    {
+        std::ofstream file(tempCacheFilePath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            throw GameException("Cannot open file \"" + tempCacheFilePath.string() + "\" for writing");
+        }
+
+        FileWriter writer(file);
+
+        //
+        // Header
+        //
+
+        writer.Write(Magic);
+        writer.Write(Version);
+        writer.Write(mContentHash);
+        writer.Write(static_cast<std::uint32_t>(mImageSizes.size()));
+        writer.Write(static_cast<std::uint32_t>(mEntries.size()));
+
+        //
+        // Image sizes
+        //
+
+        for (auto const & imageSize : mImageSizes)
+        {
+            writer.WriteString(imageSize.first);
+            writer.Write(static_cast<std::int32_t>(imageSize.second.Width));
+            writer.Write(static_cast<std::int32_t>(imageSize.second.Height));
+        }
+
+        //
+        // Entries
+        //
+
+        for (auto const & entry : mEntries)
+        {
+            writer.WriteString(entry.first);
+
+            writer.Write(static_cast<std::int32_t>(entry.second.AtlasSize.Width));
+            writer.Write(static_cast<std::int32_t>(entry.second.AtlasSize.Height));
+
+            writer.Write(static_cast<std::uint32_t>(entry.second.FramePositions.size()));
+            for (auto const & framePosition : entry.second.FramePositions)
+            {
+                writer.Write(static_cast<std::uint16_t>(framePosition.FrameId.Group));
+                writer.Write(static_cast<std::uint16_t>(framePosition.FrameId.FrameIndex));
+                writer.Write(static_cast<std::int32_t>(framePosition.FrameLeftX));
+                writer.Write(static_cast<std::int32_t>(framePosition.FrameBottomY));
+            }
+
+            writer.Write(static_cast<std::uint32_t>(entry.second.Levels.size()));
+            for (auto const & level : entry.second.Levels)
+            {
+                writer.Write(static_cast<std::int32_t>(level.Size.Width));
+                writer.Write(static_cast<std::int32_t>(level.Size.Height));
+                writer.WriteBytes(
+                    level.Data.get(),
+                    static_cast<size_t>(level.Size.Width) * static_cast<size_t>(level.Size.Height) * sizeof(rgbaColor));
+            }
+        }
+
+        if (!file)
+        {
+            throw GameException("Error writing file \"" + tempCacheFilePath.string() + "\"");
+        }
+    }
+
+    std::filesystem::rename(tempCacheFilePath, mCacheFilePath);
+
+    mIsDirty = false;
+}
+
+RgbaImageData TextureCache::CloneImage(RgbaImageData const & image)
+{
+    size_t const pixelCount = static_cast<size_t>(image.Size.Width) * static_cast<size_t>(image.Size.Height);
+
+    auto data = std::make_unique<rgbaColor[]>(pixelCount);
+    std::copy_n(image.Data.get(), pixelCount, data.get());
+
+    return RgbaImageData(image.Size, std::move(data));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+std::uint64_t TextureCache::CalculateContentHash(std::filesystem::path const & texturesRootPath)
+{
+    //
+    // Hash names, sizes, and modification times of all files, in a stable order;
+    // reading the files themselves would cost as much as the work we're caching
+    //
+
+    std::vector<std::filesystem::path> filePaths;
+    for (auto const & entryIt : std::filesystem::directory_iterator(texturesRootPath))
+    {
+        if (std::filesystem::is_regular_file(entryIt.path()))
+            filePaths.emplace_back(entryIt.path());
+    }
+
+    std::sort(filePaths.begin(), filePaths.end());
+
+    std::uint64_t hash = FnvOffsetBasis;
+
+    for (auto const & filePath : filePaths)
+    {
+        std::string const filename = filePath.filename().string();
+        HashBytes(hash, filename.data(), filename.size());
+
+        auto const fileSize = static_cast<std::uint64_t>(std::filesystem::file_size(filePath));
+        HashBytes(hash, &fileSize, sizeof(fileSize));
+
+        auto const lastWriteTime = static_cast<std::int64_t>(std::filesystem::last_write_time(filePath).time_since_epoch().count());
+        HashBytes(hash, &lastWriteTime, sizeof(lastWriteTime));
+    }
+
+    return hash;
+}
+
+void TextureCache::Deserialize(std::vector<std::uint8_t> const & buffer)
+{
+    BufferReader reader(buffer);
+
+    //
+    // Header
+    //
+
+    if (reader.Read<std::uint32_t>() != Magic
+        || reader.Read<std::uint32_t>() != Version)
+    {
+        throw GameException("The cache file has an unrecognized format");
+    }
+
+    if (reader.Read<std::uint64_t>() != mContentHash)
+    {
+        throw GameException("The cache file is stale");
+    }
+
+    std::uint32_t const imageSizeCount = reader.Read<std::uint32_t>();
+    std::uint32_t const entryCount = reader.Read<std::uint32_t>();
+
+    //
+    // Image sizes
+    //
+
+    for (std::uint32_t i = 0; i < imageSizeCount; ++i)
+    {
+        std::string filename = reader.ReadString(reader.Read<std::uint32_t>());
+        int const width = reader.Read<std::int32_t>();
+        int const height = reader.Read<std::int32_t>();
+
+        mImageSizes.insert_or_assign(std::move(filename), ImageSize(width, height));
+    }
+
+    //
+    // Entries
+    //
+
+    for (std::uint32_t e = 0; e < entryCount; ++e)
+    {
+        std::string key = reader.ReadString(reader.Read<std::uint32_t>());
+
+        int const atlasWidth = reader.Read<std::int32_t>();
+        int const atlasHeight = reader.Read<std::int32_t>();
+
+        std::uint32_t const framePositionCount = reader.Read<std::uint32_t>();
+        std::vector<FramePosition> framePositions;
+        for (std::uint32_t f = 0; f < framePositionCount; ++f)
+        {
+            auto const group = static_cast<TextureGroupType>(reader.Read<std::uint16_t>());
+            auto const frameIndex = static_cast<TextureFrameIndex>(reader.Read<std::uint16_t>());
+            int const frameLeftX = reader.Read<std::int32_t>();
+            int const frameBottomY = reader.Read<std::int32_t>();
+
+            framePositions.emplace_back(
+                TextureFrameId(group, frameIndex),
+                frameLeftX,
+                frameBottomY);
+        }
+
+        std::uint32_t const levelCount = reader.Read<std::uint32_t>();
+        std::vector<RgbaImageData> levels;
+        for (std::uint32_t l = 0; l < levelCount; ++l)
+        {
+            int const width = reader.Read<std::int32_t>();
+            int const height = reader.Read<std::int32_t>();
+            if (width <= 0 || height <= 0)
+            {
+                throw GameException("The cache file contains an invalid image");
+            }
+
+            size_t const pixelCount = static_cast<size_t>(width) * static_cast<size_t>(height);
+            auto data = std::make_unique<rgbaColor[]>(pixelCount);
+            reader.ReadBytes(data.get(), pixelCount * sizeof(rgbaColor));
+
+            levels.emplace_back(ImageSize(width, height), std::move(data));
+        }
+
+        mEntries.emplace(
+            std::move(key),
+            Entry(
+                ImageSize(atlasWidth, atlasHeight),
+                std::move(framePositions),
+                std::move(levels)));
+    }
+
+    if (!reader.IsAtEnd())
+    {
+        throw GameException("The cache file has trailing data");
+    }
+}
+
+}
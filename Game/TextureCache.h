@@ -0,0 +1,144 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2019-12-21
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <GameCore/GameTypes.h>
+#include <GameCore/ImageData.h>
+#include <GameCore/ImageSize.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Render {
+
+/*
+ * A persistent cache of the products of texture loading: the sizes of all texture
+ * files, the packed atlases together with their layouts, and the mip chains of
+ * individual textures.
+ *
+ * The whole cache lives in a single binary file, which is read in one go at startup;
+ * the file is validated against a hash of the names, sizes, and modification times
+ * of the files in the textures folder, hence any change to any texture (or to the
+ * texture database) invalidates it.
+ */
+class TextureCache
+{
+public:
+
+    struct FramePosition
+    {
+        TextureFrameId FrameId;
+        int FrameLeftX;
+        int FrameBottomY;
+
+        FramePosition(
+            TextureFrameId frameId,
+            int frameLeftX,
+            int frameBottomY)
+            : FrameId(frameId)
+            , FrameLeftX(frameLeftX)
+            , FrameBottomY(frameBottomY)
+        {}
+    };
+
+    struct Entry
+    {
+        // Only populated for atlases
+        ImageSize AtlasSize;
+        std::vector<FramePosition> FramePositions;
+
+        // Level 0 is the image itself, followed by its mipmaps (if any)
+        std::vector<RgbaImageData> Levels;
+
+        Entry(
+            ImageSize atlasSize,
+            std::vector<FramePosition> framePositions,
+            std::vector<RgbaImageData> levels)
+            : AtlasSize(atlasSize)
+            , FramePositions(std::move(framePositions))
+            , Levels(std::move(levels))
+        {}
+    };
+
+public:
+
+    /*
+     * Loads the cache from the specified file, validating it against the current content of the
+     * specified textures folder. Never throws: a missing, invalid, or stale file simply yields
+     * an empty cache.
+     */
+    static std::unique_ptr<TextureCache> Load(
+        std::filesystem::path const & cacheFilePath,
+        std::filesystem::path const & texturesRootPath);
+
+    std::optional<ImageSize> GetImageSize(std::filesystem::path const & textureFilePath) const;
+
+    void PutImageSize(
+        std::filesystem::path const & textureFilePath,
+        ImageSize const & imageSize);
+
+    Entry const * GetEntry(std::string const & key) const;
+
+    void PutEntry(
+        std::string const & key,
+        Entry && entry);
+
+    /*
+     * Returns true when the cache has been modified since it was loaded.
+     */
+    bool IsDirty() const
+    {
+        return mIsDirty;
+    }
+
+    /*
+     * Writes the cache file; throws GameException if the file cannot be written.
+     */
+    void Save();
+
+    /*
+     * Makes a copy of one of the images in an entry.
+     */
+    static RgbaImageData CloneImage(RgbaImageData const & image);
+
+private:
+
+    static constexpr std::uint32_t Magic = 0x43545346; // "FSTC"
+    static constexpr std::uint32_t Version = 1;
+
+    TextureCache(
+        std::filesystem::path const & cacheFilePath,
+        std::uint64_t contentHash)
+        : mCacheFilePath(cacheFilePath)
+        , mContentHash(contentHash)
+        , mImageSizes()
+        , mEntries()
+        , mIsDirty(false)
+    {}
+
+    static std::uint64_t CalculateContentHash(std::filesystem::path const & texturesRootPath);
+
+    void Deserialize(std::vector<std::uint8_t> const & buffer);
+
+private:
+
+    std::filesystem::path const mCacheFilePath;
+    std::uint64_t const mContentHash;
+
+    // Keyed by filename
+    std::unordered_map<std::string, ImageSize> mImageSizes;
+
+    std::unordered_map<std::string, Entry> mEntries;
+
+    bool mIsDirty;
+};
+
+}
@@ -27,6 +27,7 @@ TextureFrame TextureFrameSpecification::LoadFrame() const
 
 TextureDatabase TextureDatabase::Load(
     ResourceLoader const & resourceLoader,
+    TextureCache & textureCache,
     ProgressCallback const & progressCallback)
 {
     auto const texturesRoot = resourceLoader.GetTexturesFilePath();
@@ -151,7 +152,16 @@ TextureDatabase TextureDatabase::Load(
                     // Get frame size
                     //
 
-                    ImageSize textureSize = ImageFileTools::GetImageSize(fileData.Path);
+                    ImageSize textureSize = ImageSize::Zero();
+                    if (auto const cachedTextureSize = textureCache.GetImageSize(fileData.Path); !!cachedTextureSize)
+                    {
+                        textureSize = *cachedTextureSize;
+                    }
+                    else
+                    {
+                        textureSize = ImageFileTools::GetImageSize(fileData.Path);
+                        textureCache.PutImageSize(fileData.Path, textureSize);
+                    }
 
 
                     //
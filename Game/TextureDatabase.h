@@ -10,6 +10,7 @@
  */
 
 #include "ResourceLoader.h"
+#include "TextureCache.h"
 
 #include <GameCore/GameTypes.h>
 #include <GameCore/ImageData.h>
@@ -156,6 +157,7 @@ public:
 
     static TextureDatabase Load(
         ResourceLoader const & resourceLoader,
+        TextureCache & textureCache,
         ProgressCallback const & progressCallback);
 
     auto const & GetGroups() const
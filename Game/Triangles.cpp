@@ -51,4 +51,34 @@ void Triangles::Restore(ElementIndex triangleElementIndex)
     }
 }
 
+size_t Triangles::GetMemoryFootprint() const
+{
+    return
+        mIsDeletedBuffer.GetByteSize()
+        + mEndpointsBuffer.GetByteSize()
+        + mSubSpringsBuffer.GetByteSize()
+        + mFactorySubSpringsBuffer.GetByteSize();
+}
+
+void Triangles::SaveState(CheckpointWriter & checkpoint) const
+{
+    VisitState(*this, checkpoint);
+}
+
+void Triangles::LoadState(CheckpointReader & checkpoint)
+{
+    VisitState(*this, checkpoint);
+}
+
+template<typename TSelf, typename TArchive>
+void Triangles::VisitState(
+    TSelf & self,
+    TArchive & archive)
+{
+    archive.Visit("IsDeleted", self.mIsDeletedBuffer);
+    archive.Visit("Endpoints", self.mEndpointsBuffer);
+    archive.Visit("SubSprings", self.mSubSpringsBuffer);
+    archive.Visit("FactorySubSprings", self.mFactorySubSpringsBuffer);
+}
+
 }
\ No newline at end of file
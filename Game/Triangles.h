@@ -9,6 +9,7 @@
 #include "RenderContext.h"
 
 #include <GameCore/Buffer.h>
+#include <GameCore/Checkpoint.h>
 #include <GameCore/ElementContainer.h>
 #include <GameCore/FixedSizeVector.h>
 
@@ -72,6 +73,18 @@ public:
 
     Triangles(Triangles && other) = default;
 
+    /*
+     * Returns the number of bytes currently occupied by all of the buffers of this container.
+     */
+    size_t GetMemoryFootprint() const;
+
+    /*
+     * Saves and restores the state of all triangles; the state may only be restored onto
+     * triangles built from the same ship definition.
+     */
+    void SaveState(CheckpointWriter & checkpoint) const;
+    void LoadState(CheckpointReader & checkpoint);
+
     /*
      * Sets a (single) handler that is invoked whenever a triangle is destroyed.
      *
@@ -241,6 +254,14 @@ public:
         }
     }
 
+private:
+
+    // Visits the members making up the state, both for saving and for restoring
+    template<typename TSelf, typename TArchive>
+    static void VisitState(
+        TSelf & self,
+        TArchive & archive);
+
 private:
 
     //////////////////////////////////////////////////////////
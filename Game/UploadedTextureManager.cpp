@@ -6,6 +6,7 @@
 #include "UploadedTextureManager.h"
 
 #include <GameCore/GameException.h>
+#include <GameCore/ImageTools.h>
 
 namespace Render {
 
@@ -83,6 +84,7 @@ void UploadedTextureManager::UploadGroup(
 void UploadedTextureManager::UploadMipmappedGroup(
     TextureGroup const & group,
     GLint minFilter,
+    TextureCache & textureCache,
     ProgressCallback const & progressCallback)
 {
     // Make sure we have room for this group
@@ -95,8 +97,32 @@ void UploadedTextureManager::UploadMipmappedGroup(
 
     for (TextureFrameSpecification const & frameSpec : group.GetFrameSpecifications())
     {
-        // Load frame
-        TextureFrame frame = frameSpec.LoadFrame();
+        // Get frame and its mipmaps, from the cache if possible
+        std::string const cacheKey = "MipmappedFrame:" + frameSpec.Metadata.FrameId.ToString();
+        TextureCache::Entry const * cacheEntry = textureCache.GetEntry(cacheKey);
+        if (nullptr == cacheEntry)
+        {
+            TextureFrame frame = frameSpec.LoadFrame();
+
+            std::vector<RgbaImageData> mipmaps = ImageTools::MakeMipmaps(frame.TextureData);
+
+            std::vector<RgbaImageData> levels;
+            levels.reserve(1 + mipmaps.size());
+            levels.emplace_back(std::move(frame.TextureData));
+            for (auto & mipmap : mipmaps)
+                levels.emplace_back(std::move(mipmap));
+
+            textureCache.PutEntry(
+                cacheKey,
+                TextureCache::Entry(
+                    ImageSize::Zero(),
+                    {},
+                    std::move(levels)));
+
+            cacheEntry = textureCache.GetEntry(cacheKey);
+        }
+
+        assert(nullptr != cacheEntry && !cacheEntry->Levels.empty());
 
         // Notify progress
         currentFramesCount += 1.0f;
@@ -110,7 +136,10 @@ void UploadedTextureManager::UploadMipmappedGroup(
         glBindTexture(GL_TEXTURE_2D, openGLHandle);
 
         // Upload texture
-        GameOpenGL::UploadMipmappedTexture(std::move(frame.TextureData));
+        GameOpenGL::UploadMipmappedTexture(
+            cacheEntry->Levels[0],
+            std::next(cacheEntry->Levels.cbegin()),
+            cacheEntry->Levels.cend());
 
         // Set repeat mode
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
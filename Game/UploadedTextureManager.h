@@ -6,6 +6,7 @@
 #pragma once
 
 #include "RenderCore.h"
+#include "TextureCache.h"
 #include "TextureDatabase.h"
 
 #include <GameOpenGL/GameOpenGL.h>
@@ -41,6 +42,7 @@ public:
     void UploadMipmappedGroup(
         TextureGroup const & group,
         GLint minFilter,
+        TextureCache & textureCache,
         ProgressCallback const & progressCallback);
 
     inline TextureFrameMetadata const & GetFrameMetadata(TextureFrameId const & frameId) const
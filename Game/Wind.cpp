@@ -5,8 +5,6 @@
 ***************************************************************************************/
 #include "Physics.h"
 
-#include <GameCore/GameRandomEngine.h>
-
 #include <limits.h>
 
 namespace Physics {
@@ -18,8 +16,11 @@ float constexpr GustRate = 1.0f;
 float constexpr PoissonSampleRate = 4.0f;
 float constexpr PoissonSampleDeltaT = 1.0f / PoissonSampleRate;
 
-Wind::Wind(std::shared_ptr<GameEventDispatcher> gameEventDispatcher)
+Wind::Wind(
+    std::shared_ptr<GameEventDispatcher> gameEventDispatcher,
+    RandomEngine & randomEngine)
     : mGameEventHandler(std::move(gameEventDispatcher))
+    , mRandomEngine(randomEngine)
     // Pre-calculated parameters
     , mZeroSpeedMagnitude(0.0f)
     , mBaseSpeedMagnitude(0.0f)
@@ -158,7 +159,7 @@ void Wind::Update(GameParameters const & gameParameters)
                     if (now >= mNextPoissonSampleTimestamp)
                     {
                         // Check if we should gust
-                        if (GameRandomEngine::GetInstance().GenerateRandomBoolean(mGustCdf))
+                        if (mRandomEngine.GenerateRandomBoolean(mGustCdf))
                         {
                             // Transition to EnterGust
                             mCurrentState = State::EnterGust;
@@ -290,9 +291,45 @@ void Wind::Update(GameParameters const & gameParameters)
         mCurrentWindSpeed);
 }
 
+void Wind::SaveState(CheckpointWriter & checkpoint) const
+{
+    VisitState(*this, checkpoint);
+}
+
+void Wind::LoadState(CheckpointReader & checkpoint)
+{
+    VisitState(*this, checkpoint);
+}
+
+template<typename TSelf, typename TArchive>
+void Wind::VisitState(
+    TSelf & self,
+    TArchive & archive)
+{
+    // Parameters we are current with
+    archive.Visit("ZeroSpeedMagnitude", self.mZeroSpeedMagnitude);
+    archive.Visit("BaseSpeedMagnitude", self.mBaseSpeedMagnitude);
+    archive.Visit("PreMaxSpeedMagnitude", self.mPreMaxSpeedMagnitude);
+    archive.Visit("MaxSpeedMagnitude", self.mMaxSpeedMagnitude);
+    archive.Visit("GustCdf", self.mGustCdf);
+    archive.Visit("CurrentDoModulateWindParameter", self.mCurrentDoModulateWindParameter);
+    archive.Visit("CurrentSpeedBaseParameter", self.mCurrentSpeedBaseParameter);
+    archive.Visit("CurrentSpeedMaxFactorParameter", self.mCurrentSpeedMaxFactorParameter);
+    archive.Visit("CurrentGustFrequencyAdjustmentParameter", self.mCurrentGustFrequencyAdjustmentParameter);
+
+    // State machine
+    archive.Visit("CurrentState", self.mCurrentState);
+    archive.Visit("NextStateTransitionTimestamp", self.mNextStateTransitionTimestamp);
+    archive.Visit("NextPoissonSampleTimestamp", self.mNextPoissonSampleTimestamp);
+    archive.Visit("CurrentGustTransitionTimestamp", self.mCurrentGustTransitionTimestamp);
+    archive.Visit("CurrentRawWindSpeedMagnitude", self.mCurrentRawWindSpeedMagnitude);
+    archive.Visit("CurrentWindSpeedMagnitudeRunningAverage", self.mCurrentWindSpeedMagnitudeRunningAverage);
+    archive.Visit("CurrentWindSpeed", self.mCurrentWindSpeed);
+}
+
 GameWallClock::duration Wind::ChooseDuration(float minSeconds, float maxSeconds)
 {
-    float chosenSeconds = GameRandomEngine::GetInstance().GenerateRandomReal(minSeconds, maxSeconds);
+    float chosenSeconds = mRandomEngine.GenerateRandomReal(minSeconds, maxSeconds);
     return std::chrono::duration_cast<GameWallClock::duration>(std::chrono::duration<float>(chosenSeconds));
 }
 
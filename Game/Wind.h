@@ -10,8 +10,10 @@
 #include "GameEventDispatcher.h"
 #include "GameParameters.h"
 
+#include <GameCore/Checkpoint.h>
 #include <GameCore/GameMath.h>
 #include <GameCore/GameWallClock.h>
+#include <GameCore/RandomEngine.h>
 #include <GameCore/RunningAverage.h>
 
 namespace Physics
@@ -21,10 +23,19 @@ class Wind
 {
 public:
 
-    Wind(std::shared_ptr<GameEventDispatcher> gameEventDispatcher);
+    Wind(
+        std::shared_ptr<GameEventDispatcher> gameEventDispatcher,
+        RandomEngine & randomEngine);
 
     void Update(GameParameters const & gameParameters);
 
+    /*
+     * Saves and restores the state of the wind. Gust transitions are timed on the
+     * wall clock, hence they only resume exactly in deterministic mode.
+     */
+    void SaveState(CheckpointWriter & checkpoint) const;
+    void LoadState(CheckpointReader & checkpoint);
+
     /*
      * Returns the (signed) base magnitude, i.e. the magnitude of the unmodulated wind speed.
      *
@@ -57,14 +68,23 @@ public:
 
 private:
 
-    static GameWallClock::duration ChooseDuration(float minSeconds, float maxSeconds);
+    GameWallClock::duration ChooseDuration(float minSeconds, float maxSeconds);
 
     void RecalculateParameters(GameParameters const & gameParameters);
 
+    // Visits the members making up the state, both for saving and for restoring
+    template<typename TSelf, typename TArchive>
+    static void VisitState(
+        TSelf & self,
+        TArchive & archive);
+
 private:
 
     std::shared_ptr<GameEventDispatcher> mGameEventHandler;
 
+    // The random engine of the world
+    RandomEngine & mRandomEngine;
+
     //
     // Pre-calculated parameters
     //
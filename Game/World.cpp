@@ -5,27 +5,35 @@
  ***************************************************************************************/
 #include "Physics.h"
 
+#include "FrameProfiler.h"
 #include "ShipBuilder.h"
 
 #include <GameCore/GameRandomEngine.h>
 
 #include <algorithm>
 #include <cassert>
+#include <limits>
 
 namespace Physics {
 
+// The stream of the world's random engine; ships use their IDs as streams
+static std::uint64_t constexpr WorldRandomStream = std::numeric_limits<std::uint64_t>::max();
+
 World::World(
     std::shared_ptr<GameEventDispatcher> gameEventDispatcher,
+    std::shared_ptr<ThreadPool> threadPool,
     GameParameters const & gameParameters,
     ResourceLoader & resourceLoader)
     : mCurrentSimulationTime(0.0f)
+    , mRandomEngine(GameRandomEngine::DefaultSeed, WorldRandomStream)
     , mAllShips()
     , mStars()
-    , mWind(gameEventDispatcher)
+    , mWind(gameEventDispatcher, mRandomEngine)
     , mClouds()
-    , mOceanSurface(gameEventDispatcher)
+    , mOceanSurface(gameEventDispatcher, mRandomEngine)
     , mOceanFloor(resourceLoader)
     , mGameEventHandler(gameEventDispatcher)
+    , mThreadPool(std::move(threadPool))
 {
     // Initialize world pieces
     mStars.Update(gameParameters);
@@ -67,6 +75,95 @@ size_t World::GetShipPointCount(ShipId shipId) const
     return mAllShips[shipId]->GetPointCount();
 }
 
+StructuralChangeCounts World::ConsumeStructuralChangeCounts()
+{
+    StructuralChangeCounts counts;
+
+    for (auto & ship : mAllShips)
+    {
+        counts += ship->ConsumeStructuralChangeCounts();
+    }
+
+    return counts;
+}
+
+std::uint64_t World::CalculateStateHash() const
+{
+    StateHasher hasher;
+
+    hasher.Add(mCurrentSimulationTime);
+
+    for (auto const & ship : mAllShips)
+    {
+        ship->HashState(hasher);
+    }
+
+    return hasher.GetHash();
+}
+
+bool World::CanSaveState() const
+{
+    return std::all_of(
+        mAllShips.cbegin(),
+        mAllShips.cend(),
+        [](auto const & ship)
+        {
+            return ship->CanSaveState();
+        });
+}
+
+void World::SaveState(CheckpointWriter & checkpoint) const
+{
+    checkpoint.SetScope("World.");
+    checkpoint.Visit("CurrentSimulationTime", mCurrentSimulationTime);
+    checkpoint.Visit("RandomEngine", mRandomEngine);
+    checkpoint.Visit("ShipCount", static_cast<std::uint32_t>(mAllShips.size()));
+
+    for (auto const & ship : mAllShips)
+    {
+        ship->SaveState(checkpoint);
+    }
+
+    checkpoint.SetScope("World.Wind.");
+    mWind.SaveState(checkpoint);
+
+    checkpoint.SetScope("World.OceanSurface.");
+    mOceanSurface.SaveState(checkpoint);
+
+    checkpoint.SetScope("World.OceanFloor.");
+    mOceanFloor.SaveState(checkpoint);
+}
+
+void World::LoadState(CheckpointReader & checkpoint)
+{
+    checkpoint.SetScope("World.");
+
+    std::uint32_t shipCount;
+    checkpoint.Visit("ShipCount", shipCount);
+    if (shipCount != mAllShips.size())
+    {
+        throw GameException("The checkpoint has " + std::to_string(shipCount) + " ships, while the world has "
+            + std::to_string(mAllShips.size()));
+    }
+
+    checkpoint.Visit("CurrentSimulationTime", mCurrentSimulationTime);
+    checkpoint.Visit("RandomEngine", mRandomEngine);
+
+    for (auto & ship : mAllShips)
+    {
+        ship->LoadState(checkpoint);
+    }
+
+    checkpoint.SetScope("World.Wind.");
+    mWind.LoadState(checkpoint);
+
+    checkpoint.SetScope("World.OceanSurface.");
+    mOceanSurface.LoadState(checkpoint);
+
+    checkpoint.SetScope("World.OceanFloor.");
+    mOceanFloor.LoadState(checkpoint);
+}
+
 //////////////////////////////////////////////////////////////////////////////
 // Interactions
 //////////////////////////////////////////////////////////////////////////////
@@ -498,19 +595,25 @@ void World::Update(
     mCurrentSimulationTime += GameParameters::SimulationStepTimeDuration<float>;
 
     // Update world parts
-    mStars.Update(gameParameters);
-    mWind.Update(gameParameters);
-    mClouds.Update(mCurrentSimulationTime, gameParameters);
-    mOceanSurface.Update(mCurrentSimulationTime, mWind, gameParameters);
-    mOceanFloor.Update(gameParameters);
+    {
+        PROFILE_SCOPE(UpdateWorldEnvironment);
+
+        mStars.Update(gameParameters);
+        mWind.Update(gameParameters);
+        mClouds.Update(mCurrentSimulationTime, gameParameters);
+        mOceanSurface.Update(mCurrentSimulationTime, mWind, gameParameters);
+        mOceanFloor.Update(gameParameters);
+    }
 
     // Update all ships
     for (auto & ship : mAllShips)
     {
+        PROFILE_SCOPE(UpdateShip);
+
         ship->Update(
             mCurrentSimulationTime,
             gameParameters,
-            renderContext);
+            renderContext.GetVectorFieldRenderMode());
     }
 }
 
@@ -552,16 +655,20 @@ void World::Render(
     // Render all ships
     //
 
-    renderContext.RenderShipsStart();
-
-    for (auto const & ship : mAllShips)
     {
-        ship->Render(
-            gameParameters,
-            renderContext);
-    }
+        PROFILE_SCOPE(RenderShips);
+
+        renderContext.RenderShipsStart();
 
-    renderContext.RenderShipsEnd();
+        for (auto const & ship : mAllShips)
+        {
+            ship->Render(
+                gameParameters,
+                renderContext);
+        }
+
+        renderContext.RenderShipsEnd();
+    }
 
 
     //
@@ -14,6 +14,9 @@
 #include "ShipDefinition.h"
 
 #include <GameCore/AABB.h>
+#include <GameCore/Checkpoint.h>
+#include <GameCore/RandomEngine.h>
+#include <GameCore/ThreadPool.h>
 #include <GameCore/Vectors.h>
 
 #include <cstdint>
@@ -24,12 +27,35 @@
 namespace Physics
 {
 
+/*
+ * The structural changes that have occurred in ships.
+ */
+struct StructuralChangeCounts
+{
+    size_t BrokenSprings;
+    size_t DetachedPoints;
+
+    StructuralChangeCounts()
+        : BrokenSprings(0)
+        , DetachedPoints(0)
+    {}
+
+    StructuralChangeCounts & operator+=(StructuralChangeCounts const & other)
+    {
+        BrokenSprings += other.BrokenSprings;
+        DetachedPoints += other.DetachedPoints;
+
+        return *this;
+    }
+};
+
 class World
 {
 public:
 
     World(
         std::shared_ptr<GameEventDispatcher> gameEventDispatcher,
+        std::shared_ptr<ThreadPool> threadPool,
         GameParameters const & gameParameters,
         ResourceLoader & resourceLoader);
 
@@ -47,6 +73,30 @@ public:
 
     size_t GetShipPointCount(ShipId shipId) const;
 
+    /*
+     * Returns the structural changes that have occurred in all ships since the previous
+     * invocation of this method.
+     */
+    StructuralChangeCounts ConsumeStructuralChangeCounts();
+
+    /*
+     * Returns a hash of the current state of the simulation; two runs with the same
+     * inputs in deterministic mode have the same hash after each step.
+     */
+    std::uint64_t CalculateStateHash() const;
+
+    /*
+     * Saves and restores the state of the simulation. The state may only be restored
+     * onto a world with the same ships, built from the same definitions, as the world
+     * it was saved from; stars and clouds are purely visual and are not part of it.
+     *
+     * The state cannot be saved while any ship cannot, e.g. while it has bombs.
+     */
+    bool CanSaveState() const;
+
+    void SaveState(CheckpointWriter & checkpoint) const;
+    void LoadState(CheckpointReader & checkpoint);
+
     inline float GetOceanSurfaceHeightAt(float x) const
     {
         return mOceanSurface.GetHeightAt(x);
@@ -67,6 +117,21 @@ public:
         return mWind.GetCurrentWindSpeed();
     }
 
+    inline ThreadPool & GetThreadPool()
+    {
+        return *mThreadPool;
+    }
+
+    /*
+     * The random engine for everything in the world that is not owned by a ship;
+     * seeded anew for each world, so that a world's randomness does not depend on
+     * what happened before it was created.
+     */
+    inline RandomEngine & GetRandomEngine()
+    {
+        return mRandomEngine;
+    }
+
     //
     // Interactions
     //
@@ -207,6 +272,9 @@ private:
     // The current simulation time
     float mCurrentSimulationTime;
 
+    // Must be initialized before the world pieces that use it
+    RandomEngine mRandomEngine;
+
     // Repository
     std::vector<std::unique_ptr<Ship>> mAllShips;
     Stars mStars;
@@ -217,6 +285,9 @@ private:
 
     // The game event handler
     std::shared_ptr<GameEventDispatcher> mGameEventHandler;
+
+    // The workers for parallel loops
+    std::shared_ptr<ThreadPool> mThreadPool;
 };
 
 }
@@ -0,0 +1,147 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2019-12-28
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+/*
+* This class implements a fixed-size buffer of boolean flags, packed one bit per element.
+*
+* It mirrors the interface of Buffer<bool> for reading, while writes go through set(), as
+* there is no addressable element to return a reference to. A BitBuffer takes one eighth
+* of the memory of the corresponding Buffer<bool>, which lets more of the flags of a ship
+* fit in cache during the per-element loops that test them.
+*/
+class BitBuffer
+{
+public:
+
+    using WordType = std::uint64_t;
+
+    BitBuffer(size_t size)
+        : mWords(std::make_unique<WordType[]>(CalculateWordCount(size)))
+        , mSize(size)
+        , mCurrentPopulatedSize(0)
+    {
+        fill(false);
+    }
+
+    BitBuffer(
+        size_t size,
+        size_t fillStart,
+        bool fillValue)
+        : BitBuffer(size)
+    {
+        assert(fillStart <= mSize);
+
+        // Fill-in values
+        for (size_t i = fillStart; i < mSize; ++i)
+            set(i, fillValue);
+    }
+
+    BitBuffer(BitBuffer && other) = default;
+
+    /*
+     * Gets the current number of elements populated in the buffer via emplace_back();
+     * less than or equal the declared buffer size.
+     */
+    size_t GetCurrentPopulatedSize() const
+    {
+        return mCurrentPopulatedSize;
+    }
+
+    /*
+     * Gets the number of bytes occupied by the buffer.
+     */
+    size_t GetByteSize() const
+    {
+        return CalculateWordCount(mSize) * sizeof(WordType);
+    }
+
+    /*
+     * Adds an element to the buffer. Assumed to be invoked only at initialization time.
+     *
+     * Cannot add more elements than the size specified at constructor time.
+     */
+    void emplace_back(bool value)
+    {
+        if (mCurrentPopulatedSize < mSize)
+        {
+            set(mCurrentPopulatedSize++, value);
+        }
+        else
+        {
+            throw std::runtime_error("The buffer is already full");
+        }
+    }
+
+    /*
+     * Fills the buffer with a value.
+     */
+    void fill(bool value)
+    {
+        WordType const word = value ? ~WordType(0) : WordType(0);
+
+        for (size_t w = 0; w < CalculateWordCount(mSize); ++w)
+            mWords[w] = word;
+    }
+
+    /*
+     * Gets an element.
+     */
+    inline bool operator[](size_t index) const noexcept
+    {
+        assert(index < mSize);
+
+        return 0 != (mWords[index / BitsPerWord] & (WordType(1) << (index % BitsPerWord)));
+    }
+
+    /*
+     * Sets an element.
+     */
+    inline void set(
+        size_t index,
+        bool value) noexcept
+    {
+        assert(index < mSize);
+
+        WordType const mask = WordType(1) << (index % BitsPerWord);
+
+        if (value)
+            mWords[index / BitsPerWord] |= mask;
+        else
+            mWords[index / BitsPerWord] &= ~mask;
+    }
+
+    /*
+     * Gets the packed words, for bulk copies.
+     */
+    inline WordType const * data() const noexcept
+    {
+        return mWords.get();
+    }
+
+    inline WordType * data() noexcept
+    {
+        return mWords.get();
+    }
+
+private:
+
+    static constexpr size_t BitsPerWord = sizeof(WordType) * 8;
+
+    static constexpr size_t CalculateWordCount(size_t size)
+    {
+        return (size + BitsPerWord - 1) / BitsPerWord;
+    }
+
+    std::unique_ptr<WordType[]> mWords;
+    size_t const mSize;
+    size_t mCurrentPopulatedSize;
+};
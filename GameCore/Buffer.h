@@ -12,6 +12,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <stdexcept>
+#include <utility>
 
 /*
 * This class implements a simple buffer of "things". The buffer is fixed-size and cannot
@@ -73,6 +74,14 @@ public:
         return mCurrentPopulatedSize;
     }
 
+    /*
+     * Gets the number of bytes occupied by the buffer.
+     */
+    size_t GetByteSize() const
+    {
+        return mSize * sizeof(TElement);
+    }
+
     /*
      * Adds an element to the buffer. Assumed to be invoked only at initialization time.
      *
@@ -112,6 +121,23 @@ public:
         std::memcpy(mBuffer, other.mBuffer, mSize * sizeof(TElement));
     }
 
+    /*
+     * Swaps the content of this buffer with the content of another buffer,
+     * by exchanging the underlying memory.
+     *
+     * The sizes of the buffers must match.
+     */
+    void swap(Buffer<TElement> & other) noexcept
+    {
+        assert(mSize == other.mSize);
+
+        TElement * const tmpBuffer = mBuffer;
+        mBuffer = other.mBuffer;
+        other.mBuffer = tmpBuffer;
+
+        std::swap(mCurrentPopulatedSize, other.mCurrentPopulatedSize);
+    }
+
     /*
      * Gets an element.
      */
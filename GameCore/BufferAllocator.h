@@ -11,18 +11,51 @@
 #include <memory>
 #include <vector>
 
+/*
+ * A pool of work buffers, all of the same size.
+ *
+ * Buffers are returned to the pool when the handle returned by Allocate() goes
+ * out of scope, hence once the pool has grown to the maximum number of buffers
+ * in use at the same time, allocating and releasing buffers never touches the heap.
+ */
 template <typename TElement>
 class BufferAllocator
 {
+private:
+
+    struct BufferReleaser
+    {
+        BufferAllocator * Allocator;
+
+        void operator()(Buffer<TElement> * buffer) const
+        {
+            Allocator->Release(buffer);
+        }
+    };
+
+public:
+
+    using BufferHandle = std::unique_ptr<Buffer<TElement>, BufferReleaser>;
+
 public:
 
-    BufferAllocator(size_t bufferSize)
+    BufferAllocator(
+        size_t bufferSize,
+        size_t initialBufferCount)
         : mBufferSize(bufferSize)
         , mPool()
+        , mAllocatedBufferCount(initialBufferCount)
     {
+        // Pre-populate the pool, so that the buffers typically in use at the same time
+        // do not need to be allocated while simulating
+        mPool.reserve(initialBufferCount);
+        for (size_t b = 0; b < initialBufferCount; ++b)
+        {
+            mPool.emplace_back(new Buffer<TElement>(mBufferSize));
+        }
     }
 
-    std::shared_ptr<Buffer<TElement>> Allocate()
+    BufferHandle Allocate()
     {
         Buffer<TElement> * buffer;
         if (!mPool.empty())
@@ -33,23 +66,31 @@ public:
         else
         {
             buffer = new Buffer<TElement>(mBufferSize);
+
+            // Make room for this buffer to come back without having to grow the pool then
+            mPool.reserve(++mAllocatedBufferCount);
         }
 
-        return std::shared_ptr<Buffer<TElement>>(
-            buffer,
-            [this](auto p)
-            {
-                this->Release(p);
-            });
+        return BufferHandle(buffer, BufferReleaser{ this });
+    }
+
+    /*
+     * Gets the number of bytes occupied by all the buffers allocated so far.
+     */
+    size_t GetByteSize() const
+    {
+        return mAllocatedBufferCount * mBufferSize * sizeof(TElement);
     }
 
 private:
 
     void Release(Buffer<TElement> * buffer)
     {
-        mPool.push_back(std::unique_ptr<Buffer<TElement>>(buffer));
+        assert(mPool.size() < mPool.capacity());
+        mPool.emplace_back(buffer);
     }
 
     size_t const mBufferSize;
     std::vector<std::unique_ptr<Buffer<TElement>>> mPool;
-};
\ No newline at end of file
+    size_t mAllocatedBufferCount;
+};
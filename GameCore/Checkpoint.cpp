@@ -0,0 +1,297 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2020-01-13
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "Checkpoint.h"
+
+#include <cassert>
+#include <cstring>
+#include <fstream>
+
+namespace /* anonymous */ {
+
+    size_t AlignOffset(
+        size_t offset,
+        size_t alignment)
+    {
+        return (offset + alignment - 1) & ~(alignment - 1);
+    }
+
+    size_t CalculateBlockHeaderSize(size_t nameLength)
+    {
+        return sizeof(CheckpointReader::BlockHeader) + AlignOffset(nameLength, 8);
+    }
+
+    /*
+     * Checks the extent of the block without overflowing, as the header may come from
+     * a corrupted file.
+     */
+    bool IsBlockWithinImage(
+        CheckpointReader::BlockHeader const & blockHeader,
+        size_t imageSize)
+    {
+        if (blockHeader.Offset > imageSize)
+            return false;
+
+        // No block has zero-sized elements
+        if (blockHeader.ElementSize == 0)
+            return false;
+
+        return blockHeader.ElementCount <= (imageSize - blockHeader.Offset) / blockHeader.ElementSize;
+    }
+}
+
+CheckpointWriter::CheckpointWriter()
+    : CheckpointWriter(mOwnImage)
+{
+}
+
+CheckpointWriter::CheckpointWriter(std::vector<std::uint8_t> & image)
+    : mOwnImage()
+    , mImage(image)
+    , mScope()
+    , mSchema()
+    , mSchemaNames()
+    , mByteSize(0)
+    , mIsFinished(false)
+{
+    // Make room for the header, which is only known once the image is complete
+    mImage.clear();
+    AppendPadding(sizeof(CheckpointReader::FileHeader));
+}
+
+void CheckpointWriter::Finish()
+{
+    if (mIsFinished)
+        return;
+
+    //
+    // Schema
+    //
+
+    AppendPadding(AlignOffset(mImage.size(), 8) - mImage.size());
+
+    size_t const schemaOffset = mImage.size();
+
+    for (auto const & schemaEntry : mSchema)
+    {
+        CheckpointReader::BlockHeader blockHeader;
+        blockHeader.Offset = schemaEntry.Offset;
+        blockHeader.ElementCount = schemaEntry.ElementCount;
+        blockHeader.ElementSize = static_cast<std::uint32_t>(schemaEntry.ElementSize);
+        blockHeader.NameLength = static_cast<std::uint32_t>(schemaEntry.NameLength);
+
+        auto const * const blockHeaderBytes = reinterpret_cast<std::uint8_t const *>(&blockHeader);
+        mImage.insert(mImage.end(), blockHeaderBytes, blockHeaderBytes + sizeof(CheckpointReader::BlockHeader));
+
+        auto const * const nameBytes = reinterpret_cast<std::uint8_t const *>(mSchemaNames.data() + schemaEntry.NameOffset);
+        mImage.insert(mImage.end(), nameBytes, nameBytes + schemaEntry.NameLength);
+
+        AppendPadding(AlignOffset(schemaEntry.NameLength, 8) - schemaEntry.NameLength);
+    }
+
+    //
+    // Header
+    //
+
+    CheckpointReader::FileHeader fileHeader;
+    fileHeader.Magic = CheckpointReader::Magic;
+    fileHeader.Version = CheckpointReader::Version;
+    fileHeader.BlockCount = static_cast<std::uint32_t>(mSchema.size());
+    fileHeader.Reserved = 0;
+    fileHeader.SchemaOffset = schemaOffset;
+
+    std::memcpy(mImage.data(), &fileHeader, sizeof(CheckpointReader::FileHeader));
+
+    mIsFinished = true;
+}
+
+void CheckpointWriter::Save(std::filesystem::path const & filePath)
+{
+    Finish();
+
+    if (filePath.has_parent_path())
+        std::filesystem::create_directories(filePath.parent_path());
+
+    //
+    // Write to a temporary file first, so that a failed save does not destroy
+    // the previous checkpoint
+    //
+
+    std::filesystem::path const tempFilePath = filePath.string() + ".tmp";
+
+    {
+        std::ofstream file(tempFilePath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            throw GameException("Cannot open file \"" + tempFilePath.string() + "\" for writing");
+        }
+
+        file.write(reinterpret_cast<char const *>(mImage.data()), mImage.size());
+
+        if (!file)
+        {
+            throw GameException("Error writing file \"" + tempFilePath.string() + "\"");
+        }
+    }
+
+    std::filesystem::rename(tempFilePath, filePath);
+}
+
+void CheckpointWriter::AddBlock(
+    std::string const & name,
+    void const * data,
+    size_t elementSize,
+    size_t elementCount)
+{
+    assert(data != nullptr || elementCount == 0);
+    assert(!mIsFinished);
+
+    AppendPadding(AlignOffset(mImage.size(), CheckpointReader::BlockAlignment) - mImage.size());
+
+    SchemaEntry schemaEntry;
+    schemaEntry.Offset = mImage.size();
+    schemaEntry.ElementCount = elementCount;
+    schemaEntry.ElementSize = elementSize;
+    schemaEntry.NameOffset = mSchemaNames.size();
+    schemaEntry.NameLength = mScope.size() + name.size();
+
+    mSchema.push_back(schemaEntry);
+    mSchemaNames.append(mScope);
+    mSchemaNames.append(name);
+
+    size_t const blockSize = elementSize * elementCount;
+    if (blockSize > 0)
+    {
+        auto const * const bytes = reinterpret_cast<std::uint8_t const *>(data);
+        mImage.insert(mImage.end(), bytes, bytes + blockSize);
+    }
+
+    mByteSize += blockSize;
+}
+
+void CheckpointWriter::AppendPadding(size_t size)
+{
+    mImage.insert(mImage.end(), size, std::uint8_t(0));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+CheckpointReader::CheckpointReader(std::filesystem::path const & filePath)
+    : mSourceName(filePath.string())
+    , mFile(MemoryMappedFile::Open(filePath))
+    , mData(mFile->GetData())
+    , mSize(mFile->GetSize())
+    , mBlocks()
+    , mScope()
+{
+    IndexBlocks();
+}
+
+CheckpointReader::CheckpointReader(
+    std::uint8_t const * data,
+    size_t size)
+    : mSourceName("<memory>")
+    , mFile()
+    , mData(data)
+    , mSize(size)
+    , mBlocks()
+    , mScope()
+{
+    IndexBlocks();
+}
+
+void CheckpointReader::IndexBlocks()
+{
+    if (mSize < sizeof(FileHeader))
+    {
+        throw GameException("\"" + mSourceName + "\" is not a checkpoint");
+    }
+
+    FileHeader const & fileHeader = *reinterpret_cast<FileHeader const *>(mData);
+    if (fileHeader.Magic != Magic)
+    {
+        throw GameException("\"" + mSourceName + "\" is not a checkpoint");
+    }
+
+    if (fileHeader.Version != Version)
+    {
+        throw GameException("Checkpoint \"" + mSourceName + "\" has an unsupported version ("
+            + std::to_string(fileHeader.Version) + ")");
+    }
+
+    //
+    // Index the schema, making sure that all blocks lie within the image
+    //
+
+    if (fileHeader.SchemaOffset < sizeof(FileHeader)
+        || fileHeader.SchemaOffset > mSize
+        || fileHeader.SchemaOffset % 8 != 0)
+    {
+        throw GameException("Checkpoint \"" + mSourceName + "\" is truncated");
+    }
+
+    size_t headerOffset = static_cast<size_t>(fileHeader.SchemaOffset);
+
+    for (std::uint32_t b = 0; b < fileHeader.BlockCount; ++b)
+    {
+        if (headerOffset + sizeof(BlockHeader) > mSize)
+        {
+            throw GameException("Checkpoint \"" + mSourceName + "\" is truncated");
+        }
+
+        BlockHeader const & blockHeader = *reinterpret_cast<BlockHeader const *>(mData + headerOffset);
+
+        size_t const blockHeaderSize = CalculateBlockHeaderSize(blockHeader.NameLength);
+        if (blockHeaderSize > mSize - headerOffset
+            || !IsBlockWithinImage(blockHeader, mSize))
+        {
+            throw GameException("Checkpoint \"" + mSourceName + "\" is truncated");
+        }
+
+        std::string name(
+            reinterpret_cast<char const *>(mData + headerOffset + sizeof(BlockHeader)),
+            blockHeader.NameLength);
+
+        mBlocks[std::move(name)] = &blockHeader;
+
+        headerOffset += blockHeaderSize;
+    }
+}
+
+CheckpointReader::BlockHeader const & CheckpointReader::GetBlockHeader(std::string const & name) const
+{
+    auto const blockIt = mBlocks.find(mScope + name);
+    if (blockIt == mBlocks.end())
+    {
+        throw GameException("Checkpoint \"" + mSourceName + "\" does not contain \"" + mScope + name + "\"");
+    }
+
+    return *(blockIt->second);
+}
+
+void CheckpointReader::CopyBlock(
+    std::string const & name,
+    void * data,
+    size_t elementSize,
+    size_t elementCount) const
+{
+    BlockHeader const & blockHeader = GetBlockHeader(name);
+
+    if (blockHeader.ElementSize != elementSize
+        || blockHeader.ElementCount != elementCount)
+    {
+        throw GameException("Checkpoint \"" + mSourceName + "\" does not match \"" + mScope + name + "\": it has "
+            + std::to_string(blockHeader.ElementCount) + " elements of " + std::to_string(blockHeader.ElementSize)
+            + " bytes, expected " + std::to_string(elementCount) + " elements of " + std::to_string(elementSize) + " bytes");
+    }
+
+    if (elementCount > 0)
+    {
+        std::memcpy(
+            data,
+            mData + blockHeader.Offset,
+            elementSize * elementCount);
+    }
+}
@@ -0,0 +1,438 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2020-01-13
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "BitBuffer.h"
+#include "Buffer.h"
+#include "CsrAdjacencyList.h"
+#include "GameException.h"
+#include "MemoryMappedFile.h"
+#include "Vec2fBuffers.h"
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * A checkpoint is a binary snapshot of a set of named blocks of memory.
+ *
+ * The image starts with a header, followed by the blocks themselves, written raw and
+ * aligned, and ends with the schema - the name, element size, and element count of
+ * each block; as the schema comes last, blocks are copied into the image as soon as
+ * they are visited. Restoring a block is a single copy out of the memory-mapped file,
+ * after checking that its element size and count match those of the destination. The
+ * same image may also be kept in memory, for frequent captures.
+ *
+ * Objects describe their state once, in a template that invokes Visit(name, member)
+ * on an archive for each member; the writer reads the members, and the reader - with
+ * the very same template - writes them. Trivially-copyable values are stored as they
+ * are, hence a checkpoint is only meant to be restored by the same build on the same
+ * platform.
+ */
+
+class CheckpointWriter
+{
+public:
+
+    /*
+     * Writes into an image of its own, to be saved with Save().
+     */
+    CheckpointWriter();
+
+    /*
+     * Writes into the specified image, which is cleared first; the image's capacity is
+     * reused across captures. The image is complete once Finish() has been invoked.
+     */
+    explicit CheckpointWriter(std::vector<std::uint8_t> & image);
+
+    CheckpointWriter(CheckpointWriter const &) = delete;
+    CheckpointWriter & operator=(CheckpointWriter const &) = delete;
+
+    /*
+     * Sets the prefix of the names of the blocks visited from now on.
+     */
+    void SetScope(std::string const & scope)
+    {
+        mScope = scope;
+    }
+
+    //
+    // Blocks are copied into the image as they are visited.
+    //
+
+    template<typename T>
+    void Visit(
+        std::string const & name,
+        T const & value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value);
+
+        AddBlock(name, &value, sizeof(T), 1);
+    }
+
+    template<typename T>
+    void Visit(
+        std::string const & name,
+        T const * data,
+        size_t count)
+    {
+        static_assert(std::is_trivially_copyable<T>::value);
+
+        AddBlock(name, data, sizeof(T), count);
+    }
+
+    template<typename T>
+    void Visit(
+        std::string const & name,
+        std::optional<T> const & value)
+    {
+        Visit(name + ".HasValue", value.has_value());
+        if (value.has_value())
+        {
+            Visit(name, *value);
+        }
+    }
+
+    template<typename T>
+    void Visit(
+        std::string const & name,
+        Buffer<T> const & buffer)
+    {
+        Visit(name, buffer.data(), buffer.GetByteSize() / sizeof(T));
+    }
+
+    template<typename T>
+    void Visit(
+        std::string const & name,
+        std::unique_ptr<Buffer<T>> const & buffer)
+    {
+        // Absent buffers are simply not written
+        if (!!buffer)
+        {
+            Visit(name, *buffer);
+        }
+    }
+
+    void Visit(
+        std::string const & name,
+        BitBuffer const & buffer)
+    {
+        Visit(name, buffer.data(), buffer.GetByteSize() / sizeof(BitBuffer::WordType));
+    }
+
+    void Visit(
+        std::string const & name,
+        InterleavedVec2fBuffer const & buffer)
+    {
+        Visit(name, buffer.GetComponentArray(0), buffer.GetComponentArrayLength());
+    }
+
+    void Visit(
+        std::string const & name,
+        SplitVec2fBuffer const & buffer)
+    {
+        Visit(name + ".X", buffer.GetComponentArray(0), buffer.GetComponentArrayLength());
+        Visit(name + ".Y", buffer.GetComponentArray(1), buffer.GetComponentArrayLength());
+    }
+
+    template<typename T>
+    void Visit(
+        std::string const & name,
+        CsrAdjacencyList<T> const & list)
+    {
+        Visit(name + ".Elements", list.mElements.data(), list.mElements.size());
+        Visit(name + ".RowOffsets", list.mRowOffsets.data(), list.mRowOffsets.size());
+        Visit(name + ".RowSizes", list.mRowSizes.data(), list.mRowSizes.size());
+        Visit(name + ".RowOwnedSizes", list.mRowOwnedSizes.data(), list.mRowOwnedSizes.size());
+    }
+
+    template<typename T>
+    void Visit(
+        std::string const & name,
+        std::vector<T> const & vector)
+    {
+        static_assert(std::is_trivially_copyable<T>::value);
+
+        AddBlock(name, vector.data(), sizeof(T), vector.size());
+    }
+
+    void Visit(
+        std::string const & name,
+        std::string const & value)
+    {
+        AddBlock(name, value.data(), 1, value.size());
+    }
+
+    /*
+     * The total size of the blocks, in bytes.
+     */
+    size_t GetByteSize() const
+    {
+        return mByteSize;
+    }
+
+    /*
+     * Completes the image by appending the schema; no more blocks may be visited afterwards.
+     */
+    void Finish();
+
+    /*
+     * Completes the image and writes it; throws GameException if the file cannot be written.
+     */
+    void Save(std::filesystem::path const & filePath);
+
+private:
+
+    void AddBlock(
+        std::string const & name,
+        void const * data,
+        size_t elementSize,
+        size_t elementCount);
+
+    void AppendPadding(size_t size);
+
+private:
+
+    struct SchemaEntry
+    {
+        size_t Offset;
+        size_t ElementCount;
+        size_t ElementSize;
+        size_t NameOffset; // In the schema names
+        size_t NameLength;
+    };
+
+    std::vector<std::uint8_t> mOwnImage;
+    std::vector<std::uint8_t> & mImage;
+
+    std::string mScope;
+
+    // The schema, written once all blocks have been written
+    std::vector<SchemaEntry> mSchema;
+    std::string mSchemaNames;
+
+    size_t mByteSize;
+    bool mIsFinished;
+};
+
+class CheckpointReader
+{
+public:
+
+    /*
+     * Maps the checkpoint; throws GameException if the file cannot be opened or is not
+     * a valid checkpoint.
+     */
+    explicit CheckpointReader(std::filesystem::path const & filePath);
+
+    /*
+     * Reads a checkpoint image in memory, which must outlive the reader; throws
+     * GameException if the image is not a valid checkpoint.
+     */
+    CheckpointReader(
+        std::uint8_t const * data,
+        size_t size);
+
+    /*
+     * Sets the prefix of the names of the blocks visited from now on.
+     */
+    void SetScope(std::string const & scope)
+    {
+        mScope = scope;
+    }
+
+    bool HasBlock(std::string const & name) const
+    {
+        return mBlocks.count(mScope + name) != 0;
+    }
+
+    //
+    // All of the following throw GameException when the block does not exist, or
+    // when it does not match the destination
+    //
+
+    template<typename T>
+    void Visit(
+        std::string const & name,
+        T & value) const
+    {
+        static_assert(std::is_trivially_copyable<T>::value);
+
+        CopyBlock(name, &value, sizeof(T), 1);
+    }
+
+    template<typename T>
+    void Visit(
+        std::string const & name,
+        T * data,
+        size_t count) const
+    {
+        static_assert(std::is_trivially_copyable<T>::value);
+
+        CopyBlock(name, data, sizeof(T), count);
+    }
+
+    template<typename T>
+    void Visit(
+        std::string const & name,
+        std::optional<T> & value) const
+    {
+        static_assert(std::is_trivially_copyable<T>::value);
+
+        bool hasValue;
+        Visit(name + ".HasValue", hasValue);
+        if (hasValue)
+        {
+            // The value might not be assignable, hence we copy-construct it
+            alignas(T) std::uint8_t storage[sizeof(T)];
+            CopyBlock(name, storage, sizeof(T), 1);
+            value.emplace(*reinterpret_cast<T const *>(storage));
+        }
+        else
+        {
+            value.reset();
+        }
+    }
+
+    template<typename T>
+    void Visit(
+        std::string const & name,
+        Buffer<T> & buffer) const
+    {
+        Visit(name, buffer.data(), buffer.GetByteSize() / sizeof(T));
+    }
+
+    template<typename T>
+    void Visit(
+        std::string const & name,
+        std::unique_ptr<Buffer<T>> & buffer) const
+    {
+        if (HasBlock(name))
+        {
+            if (!buffer)
+            {
+                buffer = std::make_unique<Buffer<T>>(GetBlockHeader(name).ElementCount);
+            }
+
+            Visit(name, *buffer);
+        }
+        else
+        {
+            buffer.reset();
+        }
+    }
+
+    void Visit(
+        std::string const & name,
+        BitBuffer & buffer) const
+    {
+        Visit(name, buffer.data(), buffer.GetByteSize() / sizeof(BitBuffer::WordType));
+    }
+
+    void Visit(
+        std::string const & name,
+        InterleavedVec2fBuffer & buffer) const
+    {
+        Visit(name, buffer.GetComponentArray(0), buffer.GetComponentArrayLength());
+    }
+
+    void Visit(
+        std::string const & name,
+        SplitVec2fBuffer & buffer) const
+    {
+        Visit(name + ".X", buffer.GetComponentArray(0), buffer.GetComponentArrayLength());
+        Visit(name + ".Y", buffer.GetComponentArray(1), buffer.GetComponentArrayLength());
+    }
+
+    template<typename T>
+    void Visit(
+        std::string const & name,
+        CsrAdjacencyList<T> & list) const
+    {
+        // The shape of the list is fixed at build time, hence it must match
+        Visit(name + ".Elements", list.mElements.data(), list.mElements.size());
+        Visit(name + ".RowOffsets", list.mRowOffsets.data(), list.mRowOffsets.size());
+        Visit(name + ".RowSizes", list.mRowSizes.data(), list.mRowSizes.size());
+        Visit(name + ".RowOwnedSizes", list.mRowOwnedSizes.data(), list.mRowOwnedSizes.size());
+    }
+
+    template<typename T>
+    void Visit(
+        std::string const & name,
+        std::vector<T> & vector) const
+    {
+        static_assert(std::is_trivially_copyable<T>::value);
+
+        vector.resize(GetBlockHeader(name).ElementCount);
+        CopyBlock(name, vector.data(), sizeof(T), vector.size());
+    }
+
+    void Visit(
+        std::string const & name,
+        std::string & value) const
+    {
+        value.resize(GetBlockHeader(name).ElementCount);
+        CopyBlock(name, value.data(), 1, value.size());
+    }
+
+public:
+
+    static constexpr std::uint32_t Magic = 0x4b435346; // "FSCK"
+    static constexpr std::uint32_t Version = 2;
+
+    // Blocks start at multiples of this, from the beginning of the file
+    static constexpr size_t BlockAlignment = 64;
+
+#pragma pack(push, 4)
+
+    struct FileHeader
+    {
+        std::uint32_t Magic;
+        std::uint32_t Version;
+        std::uint32_t BlockCount;
+        std::uint32_t Reserved;
+        std::uint64_t SchemaOffset; // From beginning of file
+    };
+
+    // Followed by the name, padded to 8 bytes
+    struct BlockHeader
+    {
+        std::uint64_t Offset; // From beginning of file
+        std::uint64_t ElementCount;
+        std::uint32_t ElementSize;
+        std::uint32_t NameLength;
+    };
+
+#pragma pack(pop)
+
+private:
+
+    void IndexBlocks();
+
+    BlockHeader const & GetBlockHeader(std::string const & name) const;
+
+    void CopyBlock(
+        std::string const & name,
+        void * data,
+        size_t elementSize,
+        size_t elementCount) const;
+
+private:
+
+    std::string const mSourceName; // For errors
+    std::unique_ptr<MemoryMappedFile> mFile; // Null for images in memory
+    std::uint8_t const * mData;
+    size_t mSize;
+    std::unordered_map<std::string, BlockHeader const *> mBlocks;
+
+    std::string mScope;
+};
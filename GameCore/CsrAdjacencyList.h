@@ -0,0 +1,333 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2019-12-29
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/*
+ * This class is an adjacency list in compressed sparse row (CSR) layout: the elements of
+ * all rows are stored back-to-back in a single array, and each row occupies a slice of it.
+ *
+ * The capacity of each row is fixed when the list is built, and is the number of elements
+ * the row was built with; elements may then be disconnected from - and re-connected to - a
+ * row, as long as the row does not exceed its capacity. Disconnecting compacts the row in
+ * place, hence visiting a row only ever touches its current elements.
+ *
+ * Within each row, the elements "owned" by the row come first.
+ */
+template <typename TElement>
+class CsrAdjacencyList
+{
+private:
+
+    using SizeType = std::uint32_t;
+
+public:
+
+    /*
+     * A view of the current elements of a row. The view is live: it reflects
+     * modifications made to the row after the view has been obtained.
+     */
+    class Row
+    {
+    public:
+
+        using const_iterator = TElement const *;
+
+        inline const_iterator begin() const noexcept
+        {
+            return mElements;
+        }
+
+        inline const_iterator end() const noexcept
+        {
+            return mElements + *mSize;
+        }
+
+        inline TElement const & operator[](size_t index) const noexcept
+        {
+            assert(index < *mSize);
+            return mElements[index];
+        }
+
+        inline TElement const & back() const noexcept
+        {
+            assert(*mSize > 0);
+            return mElements[*mSize - 1];
+        }
+
+        inline size_t size() const noexcept
+        {
+            return *mSize;
+        }
+
+        inline bool empty() const noexcept
+        {
+            return *mSize == 0;
+        }
+
+        template<typename UnaryPredicate>
+        inline bool contains(UnaryPredicate p) const noexcept
+        {
+            for (SizeType i = 0; i < *mSize; ++i)
+            {
+                if (p(mElements[i]))
+                    return true;
+            }
+
+            return false;
+        }
+
+    private:
+
+        friend class CsrAdjacencyList<TElement>;
+
+        Row(
+            TElement const * elements,
+            SizeType const * size) noexcept
+            : mElements(elements)
+            , mSize(size)
+        {}
+
+        TElement const * mElements;
+        SizeType const * mSize;
+    };
+
+    /*
+     * Collects the elements of all rows, in any order, and then lays them out.
+     */
+    class Builder
+    {
+    public:
+
+        explicit Builder(size_t rowCount)
+            : mRowCount(rowCount)
+            , mEntries()
+        {}
+
+        void Add(
+            size_t row,
+            TElement const & element,
+            bool isAtOwner)
+        {
+            assert(row < mRowCount);
+            mEntries.emplace_back(row, element, isAtOwner);
+        }
+
+        CsrAdjacencyList<TElement> Build() const
+        {
+            CsrAdjacencyList<TElement> list(mRowCount);
+
+            //
+            // Calculate row offsets
+            //
+
+            for (auto const & entry : mEntries)
+            {
+                ++list.mRowOffsets[entry.Row + 1];
+            }
+
+            for (size_t r = 0; r < mRowCount; ++r)
+            {
+                list.mRowOffsets[r + 1] += list.mRowOffsets[r];
+            }
+
+            //
+            // Place elements - owned elements first
+            //
+
+            list.mElements.resize(list.mRowOffsets[mRowCount]);
+
+            for (auto const & entry : mEntries)
+            {
+                if (entry.IsAtOwner)
+                {
+                    list.mElements[list.mRowOffsets[entry.Row] + list.mRowSizes[entry.Row]] = entry.Element;
+                    ++list.mRowSizes[entry.Row];
+                    ++list.mRowOwnedSizes[entry.Row];
+                }
+            }
+
+            for (auto const & entry : mEntries)
+            {
+                if (!entry.IsAtOwner)
+                {
+                    list.mElements[list.mRowOffsets[entry.Row] + list.mRowSizes[entry.Row]] = entry.Element;
+                    ++list.mRowSizes[entry.Row];
+                }
+            }
+
+            return list;
+        }
+
+    private:
+
+        struct Entry
+        {
+            size_t Row;
+            TElement Element;
+            bool IsAtOwner;
+
+            Entry(
+                size_t row,
+                TElement const & element,
+                bool isAtOwner)
+                : Row(row)
+                , Element(element)
+                , IsAtOwner(isAtOwner)
+            {}
+        };
+
+        size_t const mRowCount;
+        std::vector<Entry> mEntries;
+    };
+
+public:
+
+    /*
+     * Creates a list with the specified number of rows, all empty and with no capacity.
+     */
+    explicit CsrAdjacencyList(size_t rowCount)
+        : mElements()
+        , mRowOffsets(rowCount + 1, 0)
+        , mRowSizes(rowCount, 0)
+        , mRowOwnedSizes(rowCount, 0)
+    {}
+
+    CsrAdjacencyList(CsrAdjacencyList const & other) = default;
+    CsrAdjacencyList(CsrAdjacencyList && other) = default;
+    CsrAdjacencyList & operator=(CsrAdjacencyList const & other) = default;
+    CsrAdjacencyList & operator=(CsrAdjacencyList && other) = default;
+
+    size_t GetRowCount() const
+    {
+        return mRowSizes.size();
+    }
+
+    inline Row GetRow(size_t row) const noexcept
+    {
+        assert(row < GetRowCount());
+        return Row(mElements.data() + mRowOffsets[row], &(mRowSizes[row]));
+    }
+
+    inline size_t GetRowCapacity(size_t row) const noexcept
+    {
+        assert(row < GetRowCount());
+        return mRowOffsets[row + 1] - mRowOffsets[row];
+    }
+
+    inline size_t GetRowOwnedSize(size_t row) const noexcept
+    {
+        assert(row < GetRowCount());
+        return mRowOwnedSizes[row];
+    }
+
+    /*
+     * Gets the number of bytes occupied by the list.
+     */
+    size_t GetByteSize() const
+    {
+        return mElements.size() * sizeof(TElement)
+            + mRowOffsets.size() * sizeof(SizeType)
+            + mRowSizes.size() * sizeof(SizeType)
+            + mRowOwnedSizes.size() * sizeof(SizeType);
+    }
+
+    /*
+     * Adds an element to a row; owned elements are added at the front of the row,
+     * while the others are added at its back.
+     */
+    void Connect(
+        size_t row,
+        TElement const & element,
+        bool isAtOwner)
+    {
+        assert(row < GetRowCount());
+
+        if (mRowSizes[row] == GetRowCapacity(row))
+        {
+            throw std::runtime_error("The row is already full");
+        }
+
+        TElement * const rowElements = mElements.data() + mRowOffsets[row];
+
+        if (isAtOwner)
+        {
+            // Shift elements (to the right) first
+            for (SizeType j = mRowSizes[row]; j > 0; --j)
+            {
+                rowElements[j] = std::move(rowElements[j - 1]);
+            }
+
+            rowElements[0] = element;
+
+            ++mRowOwnedSizes[row];
+        }
+        else
+        {
+            rowElements[mRowSizes[row]] = element;
+        }
+
+        ++mRowSizes[row];
+    }
+
+    /*
+     * Removes the first element of a row that satisfies the predicate, compacting
+     * the remaining elements of the row.
+     */
+    template<typename UnaryPredicate>
+    void Disconnect(
+        size_t row,
+        UnaryPredicate p,
+        bool isAtOwner)
+    {
+        assert(row < GetRowCount());
+
+        TElement * const rowElements = mElements.data() + mRowOffsets[row];
+
+        // Owned elements are at the front
+        SizeType const start = isAtOwner ? 0 : mRowOwnedSizes[row];
+        SizeType const end = isAtOwner ? mRowOwnedSizes[row] : mRowSizes[row];
+
+        for (SizeType i = start; i < end; ++i)
+        {
+            if (p(rowElements[i]))
+            {
+                // Shift remaining elements
+                for (SizeType j = i; j < mRowSizes[row] - 1; ++j)
+                {
+                    rowElements[j] = std::move(rowElements[j + 1]);
+                }
+
+                --mRowSizes[row];
+
+                if (isAtOwner)
+                {
+                    assert(mRowOwnedSizes[row] > 0);
+                    --mRowOwnedSizes[row];
+                }
+
+                return;
+            }
+        }
+
+        assert(false); // Element not found
+    }
+
+private:
+
+    friend class CheckpointWriter;
+    friend class CheckpointReader;
+
+    std::vector<TElement> mElements;
+    std::vector<SizeType> mRowOffsets; // One more than the number of rows
+    std::vector<SizeType> mRowSizes;
+    std::vector<SizeType> mRowOwnedSizes;
+};
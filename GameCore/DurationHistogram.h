@@ -0,0 +1,131 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2020-01-08
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+
+/*
+ * Percentiles of a set of durations, in milliseconds.
+ */
+struct DurationPercentiles
+{
+    float P50;
+    float P95;
+    float P99;
+    float Max;
+
+    DurationPercentiles()
+        : P50(0.0f)
+        , P95(0.0f)
+        , P99(0.0f)
+        , Max(0.0f)
+    {}
+};
+
+/*
+ * A fixed-size histogram of durations, with buckets of equal width up to a limit;
+ * longer durations are counted in a single overflow bucket.
+ *
+ * Percentiles are reported as the upper bound of the bucket they fall into, hence
+ * with the resolution of a bucket; the maximum is exact.
+ */
+class DurationHistogram
+{
+public:
+
+    static std::chrono::microseconds constexpr BucketWidth = std::chrono::microseconds(50);
+    static size_t constexpr BucketCount = 2000; // Up to 100ms
+
+    DurationHistogram()
+    {
+        Reset();
+    }
+
+    void Record(std::chrono::steady_clock::duration duration)
+    {
+        auto const durationUs = std::chrono::duration_cast<std::chrono::microseconds>(duration);
+
+        size_t const bucketIndex = std::min(
+            static_cast<size_t>(std::max(durationUs.count(), std::chrono::microseconds::rep(0)) / BucketWidth.count()),
+            BucketCount);
+
+        ++mBuckets[bucketIndex];
+        ++mSampleCount;
+        mMax = std::max(mMax, duration);
+    }
+
+    size_t GetSampleCount() const
+    {
+        return mSampleCount;
+    }
+
+    /*
+     * Returns the duration, in milliseconds, below which the specified fraction of the
+     * samples falls.
+     */
+    float GetPercentile(float fraction) const
+    {
+        assert(fraction >= 0.0f && fraction <= 1.0f);
+
+        if (mSampleCount == 0)
+            return 0.0f;
+
+        // The rank of the sample at the percentile, one-based
+        size_t const rank = std::max(
+            static_cast<size_t>(std::ceil(fraction * static_cast<float>(mSampleCount))),
+            size_t(1));
+
+        size_t cumulativeCount = 0;
+        for (size_t b = 0; b < BucketCount; ++b)
+        {
+            cumulativeCount += mBuckets[b];
+            if (cumulativeCount >= rank)
+            {
+                // Upper bound of the bucket, but never above the actual maximum
+                return std::min(
+                    static_cast<float>((b + 1) * BucketWidth.count()) / 1000.0f,
+                    GetMaxMilliseconds());
+            }
+        }
+
+        // In the overflow bucket
+        return GetMaxMilliseconds();
+    }
+
+    DurationPercentiles GetPercentiles() const
+    {
+        DurationPercentiles percentiles;
+        percentiles.P50 = GetPercentile(0.50f);
+        percentiles.P95 = GetPercentile(0.95f);
+        percentiles.P99 = GetPercentile(0.99f);
+        percentiles.Max = GetMaxMilliseconds();
+
+        return percentiles;
+    }
+
+    void Reset()
+    {
+        mBuckets.fill(0);
+        mSampleCount = 0;
+        mMax = std::chrono::steady_clock::duration::zero();
+    }
+
+private:
+
+    float GetMaxMilliseconds() const
+    {
+        return std::chrono::duration<float, std::milli>(mMax).count();
+    }
+
+    std::array<std::uint32_t, BucketCount + 1> mBuckets; // Last one is overflow
+    size_t mSampleCount;
+    std::chrono::steady_clock::duration mMax;
+};
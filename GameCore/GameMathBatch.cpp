@@ -0,0 +1,217 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2020-01-05
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "GameMathBatch.h"
+
+#include "GameMath.h"
+#include "LibSimdPp.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace /* anonymous */ {
+
+    // As wide as the target instruction set natively allows
+    static size_t constexpr Width = SIMDPP_FAST_FLOAT32_SIZE;
+
+    using floatv = simdpp::float32<Width>;
+    using intv = simdpp::int32<Width>;
+    using uintv = simdpp::uint32<Width>;
+
+    inline floatv Splat(float value)
+    {
+        return simdpp::make_float(value);
+    }
+
+    inline uintv Splat(std::uint32_t value)
+    {
+        return simdpp::make_uint(value);
+    }
+
+    /*
+     * Vector FastLog2(); see GameMath.h.
+     */
+    inline floatv FastLog2_V(floatv const & x)
+    {
+        uintv const vxi = simdpp::bit_cast<uintv>(x);
+
+        floatv const mxf = simdpp::bit_cast<floatv>(
+            uintv(simdpp::bit_or(
+                simdpp::bit_and(vxi, Splat(std::uint32_t(0x007FFFFF))),
+                Splat(std::uint32_t(0x3f000000)))));
+
+        // The bit pattern of a non-negative float fits an int32
+        floatv const y =
+            floatv(simdpp::to_float32(simdpp::bit_cast<intv>(vxi)))
+            * Splat(1.1920928955078125e-7f);
+
+        return y - Splat(124.22551499f)
+            - Splat(1.498030302f) * mxf
+            - floatv(simdpp::div(Splat(1.72587999f), Splat(0.3520887068f) + mxf));
+    }
+
+    /*
+     * Vector FastPow2(); see GameMath.h.
+     */
+    inline floatv FastPow2_V(floatv const & p)
+    {
+        floatv const zero = simdpp::make_zero();
+
+        floatv const offset = simdpp::blend(Splat(1.0f), zero, simdpp::cmp_lt(p, zero));
+        floatv const clipp = simdpp::max(p, Splat(-126.0f));
+        floatv const w = simdpp::to_float32(simdpp::to_int32(clipp)); // Truncation
+        floatv const z = clipp - w + offset;
+
+        floatv const v =
+            Splat(static_cast<float>(1 << 23))
+            * (clipp
+                + Splat(121.2740575f)
+                + floatv(simdpp::div(Splat(27.7280233f), Splat(4.84252568f) - z))
+                - Splat(1.49012907f) * z);
+
+        return simdpp::bit_cast<floatv>(simdpp::to_int32(v));
+    }
+}
+
+void FastLog2Batch(
+    float const * x,
+    float * result,
+    size_t count)
+{
+
+    size_t i = 0;
+    for (; i + Width <= count; i += Width)
+    {
+        floatv const vx = simdpp::load_u(x + i);
+        simdpp::store_u(result + i, FastLog2_V(vx));
+    }
+
+    for (; i < count; ++i)
+    {
+        result[i] = FastLog2(x[i]);
+    }
+}
+
+void FastPow2Batch(
+    float const * p,
+    float * result,
+    size_t count)
+{
+
+    size_t i = 0;
+    for (; i + Width <= count; i += Width)
+    {
+        floatv const vp = simdpp::load_u(p + i);
+        simdpp::store_u(result + i, FastPow2_V(vp));
+    }
+
+    for (; i < count; ++i)
+    {
+        result[i] = FastPow2(p[i]);
+    }
+}
+
+void FastExpBatch(
+    float const * p,
+    float * result,
+    size_t count)
+{
+
+    floatv const log2e = Splat(1.442695040f);
+
+    size_t i = 0;
+    for (; i + Width <= count; i += Width)
+    {
+        floatv const vp = simdpp::load_u(p + i);
+        simdpp::store_u(result + i, FastPow2_V(log2e * vp));
+    }
+
+    for (; i < count; ++i)
+    {
+        result[i] = FastExp(p[i]);
+    }
+}
+
+void FastPowBatch(
+    float const * x,
+    float p,
+    float * result,
+    size_t count)
+{
+
+    floatv const vp = Splat(p);
+
+    size_t i = 0;
+    for (; i + Width <= count; i += Width)
+    {
+        floatv const vx = simdpp::load_u(x + i);
+        simdpp::store_u(result + i, FastPow2_V(vp * FastLog2_V(vx)));
+    }
+
+    for (; i < count; ++i)
+    {
+        result[i] = FastPow(x[i], p);
+    }
+}
+
+void FastPowBatch(
+    float const * x,
+    float const * p,
+    float * result,
+    size_t count)
+{
+
+    size_t i = 0;
+    for (; i + Width <= count; i += Width)
+    {
+        floatv const vx = simdpp::load_u(x + i);
+        floatv const vp = simdpp::load_u(p + i);
+        simdpp::store_u(result + i, FastPow2_V(vp * FastLog2_V(vx)));
+    }
+
+    for (; i < count; ++i)
+    {
+        result[i] = FastPow(x[i], p[i]);
+    }
+}
+
+void CalculatePeriodicSampleIndicesBatch(
+    float const * x,
+    std::int32_t samplesCount,
+    std::int32_t * sampleIndices,
+    float * sampleFractions,
+    size_t count)
+{
+
+    floatv const vSamplesCount = Splat(static_cast<float>(samplesCount));
+    intv const vLastSampleIndex = simdpp::make_int(samplesCount - 1);
+
+    size_t i = 0;
+    for (; i + Width <= count; i += Width)
+    {
+        floatv const vx = simdpp::load_u(x + i);
+
+        // Reduce to [0.0, 1.0) first, so that the index fits an int32 however large x is
+        floatv const vxPeriod = vx - floatv(simdpp::floor(vx));
+        floatv const vSampleIndexF = vxPeriod * vSamplesCount;
+
+        // Rounding might bring us to the last (extra) sample
+        intv const vSampleIndex = simdpp::min(intv(simdpp::to_int32(vSampleIndexF)), vLastSampleIndex);
+
+        simdpp::store_u(sampleIndices + i, vSampleIndex);
+        simdpp::store_u(sampleFractions + i, floatv(vSampleIndexF - simdpp::to_float32(vSampleIndex)));
+    }
+
+    for (; i < count; ++i)
+    {
+        float const xPeriod = x[i] - std::floor(x[i]);
+        float const sampleIndexF = xPeriod * static_cast<float>(samplesCount);
+        std::int32_t const sampleIndex = std::min(static_cast<std::int32_t>(sampleIndexF), samplesCount - 1);
+
+        sampleIndices[i] = sampleIndex;
+        sampleFractions[i] = sampleIndexF - static_cast<float>(sampleIndex);
+    }
+}
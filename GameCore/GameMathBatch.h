@@ -0,0 +1,58 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2020-01-05
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/*
+ * Batch versions of the fast math functions in GameMath.h, computing the same
+ * approximations on four - or, on AVX2 targets, eight - values at a time.
+ *
+ * Spans need not be aligned - so that callers may start anywhere within a buffer -
+ * and any count is fine, with the values past the last whole vector computed by the
+ * scalar functions. The result span may be the same as - but may not otherwise overlap
+ * with - an input span.
+ */
+
+void FastLog2Batch(
+    float const * x,
+    float * result,
+    size_t count);
+
+void FastPow2Batch(
+    float const * p,
+    float * result,
+    size_t count);
+
+void FastExpBatch(
+    float const * p,
+    float * result,
+    size_t count);
+
+void FastPowBatch(
+    float const * x,
+    float p,
+    float * result,
+    size_t count);
+
+void FastPowBatch(
+    float const * x,
+    float const * p,
+    float * result,
+    size_t count);
+
+/*
+ * For each value, assumed to be periodic around one, calculates the index of the sample
+ * at its left in a periodic table of samplesCount samples, and its fractional distance
+ * from that sample, in [0.0, 1.0].
+ */
+void CalculatePeriodicSampleIndicesBatch(
+    float const * x,
+    std::int32_t samplesCount,
+    std::int32_t * sampleIndices,
+    float * sampleFractions,
+    size_t count);
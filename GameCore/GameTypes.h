@@ -23,6 +23,27 @@ using ElementCount = std::uint32_t;
 using ElementIndex = std::uint32_t;
 static constexpr ElementIndex NoneElementIndex = std::numeric_limits<ElementIndex>::max();
 
+/*
+ * A range of element indices, from Start (included) to End (excluded).
+ */
+struct ElementIndexRange
+{
+    ElementIndex Start;
+    ElementIndex End;
+
+    ElementIndexRange(
+        ElementIndex start,
+        ElementIndex end)
+        : Start(start)
+        , End(end)
+    {}
+
+    inline ElementCount GetSize() const
+    {
+        return End - Start;
+    }
+};
+
 /*
  * Ship identifiers.
  *
@@ -144,12 +165,7 @@ public:
         : mValue(0)
     {}
 
-    inline SequenceNumber & operator=(SequenceNumber const & other)
-    {
-        mValue = other.mValue;
-
-        return *this;
-    }
+    inline SequenceNumber & operator=(SequenceNumber const & other) = default;
 
     SequenceNumber & operator++()
     {
@@ -215,6 +231,16 @@ DurationShortLongType StrToDurationShortLongType(std::string const & str);
 using RepairSessionId = std::uint32_t;
 using RepairSessionStepId = std::uint64_t;
 
+/*
+ * The outcomes of rewinding the simulation.
+ */
+enum class RewindResultType
+{
+    Rewound,
+    NothingRecorded,
+    NotRecording
+};
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 // Rendering
 ////////////////////////////////////////////////////////////////////////////////////////////////
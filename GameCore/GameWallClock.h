@@ -5,6 +5,7 @@
 ***************************************************************************************/
 #pragma once
 
+#include <cassert>
 #include <chrono>
 #include <optional>
 
@@ -13,6 +14,10 @@
  *
  * Note: it's not really a wall clock - its values do not measure time.
  *
+ * In deterministic mode the clock does not follow real time at all: it only moves
+ * when advanced explicitly - once per simulation step - so that everything timed
+ * with it is driven by simulation time and is reproducible from run to run.
+ *
  * Singleton.
  */
 class GameWallClock
@@ -33,7 +38,11 @@ public:
 
     inline time_point Now() const
     {
-        if (!!mLastResumeTime)
+        if (mIsDeterministic)
+        {
+            return mDeterministicNow;
+        }
+        else if (!!mLastResumeTime)
         {
             // We're running
             return mLastPauseTime + (std::chrono::steady_clock::now() - *mLastResumeTime);
@@ -53,7 +62,7 @@ public:
      */
     inline float NowAsFloat() const
     {
-        return ElapsedAsFloat(mClockStartTime);
+        return ElapsedAsFloat(mIsDeterministic ? time_point() : mClockStartTime);
     }
 
     inline duration Elapsed(time_point previousTimePoint) const
@@ -116,6 +125,12 @@ public:
 
     void SetPaused(bool isPaused)
     {
+        if (mIsDeterministic)
+        {
+            // Only advanced explicitly
+            return;
+        }
+
         if (isPaused)
         {
             if (!!mLastResumeTime)
@@ -133,12 +148,52 @@ public:
         }
     }
 
+    bool IsDeterministic() const
+    {
+        return mIsDeterministic;
+    }
+
+    /*
+     * Enters deterministic mode, restarting the clock from the zero time point, so that
+     * time points are the same in every run - and may be saved in checkpoints.
+     *
+     * Meant to be invoked once, at startup, before any time point is taken.
+     */
+    void SetDeterministic()
+    {
+        mIsDeterministic = true;
+        mDeterministicNow = time_point();
+    }
+
+    /*
+     * Moves the clock to the specified time point, as taken earlier with Now(); only
+     * valid in deterministic mode, for resuming from a checkpoint.
+     */
+    void SetDeterministicNow(time_point now)
+    {
+        assert(mIsDeterministic);
+
+        mDeterministicNow = now;
+    }
+
+    /*
+     * Moves the clock forward; only valid in deterministic mode.
+     */
+    void Advance(duration interval)
+    {
+        assert(mIsDeterministic);
+
+        mDeterministicNow += interval;
+    }
+
 private:
 
     GameWallClock()
         : mClockStartTime(std::chrono::steady_clock::now())
         , mLastPauseTime(std::chrono::steady_clock::now())
         , mLastResumeTime(mLastPauseTime)
+        , mIsDeterministic(false)
+        , mDeterministicNow()
     {
 
     }
@@ -146,4 +201,7 @@ private:
     time_point const mClockStartTime;
     time_point mLastPauseTime;
     std::optional<time_point> mLastResumeTime;
+
+    bool mIsDeterministic;
+    time_point mDeterministicNow;
 };
@@ -0,0 +1,209 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2020-01-09
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "HardwareCounters.h"
+
+#include "Log.h"
+
+#include <atomic>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace /* anonymous */ {
+
+#ifdef __linux__
+
+    int OpenCounter(
+        std::uint32_t type,
+        std::uint64_t config,
+        int groupLeaderFileDescriptor,
+        char const * name)
+    {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 0;
+        attr.exclude_kernel = 1; // Allowed with perf_event_paranoid up to 2
+        attr.exclude_hv = 1;
+        attr.read_format =
+            PERF_FORMAT_GROUP
+            | PERF_FORMAT_TOTAL_TIME_ENABLED
+            | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        // Calling thread, any CPU
+        int const fd = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, groupLeaderFileDescriptor, 0));
+        if (fd < 0)
+        {
+            // Only tell once, as the reason is usually the same for all instances
+            static std::atomic<bool> hasLogged(false);
+            if (!hasLogged.exchange(true))
+            {
+                LogMessage("HardwareCounters: counter \"", name, "\" is not available (", std::strerror(errno), "); check perf_event_paranoid");
+            }
+        }
+
+        return fd;
+    }
+
+#endif
+}
+
+HardwareCounters::HardwareCounters()
+    : mGroupLeaderFileDescriptor(-1)
+    , mGroupSize(0)
+{
+#ifdef __linux__
+    struct CounterDefinition
+    {
+        std::uint32_t Type;
+        std::uint64_t Config;
+        char const * Name;
+    };
+
+    // In the order of CounterType
+    CounterDefinition const counterDefinitions[_Count] = {
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, "cycles" },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, "instructions" },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, "LLC misses" },
+        { PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16), "dTLB misses" }
+    };
+
+    for (int c = 0; c < _Count; ++c)
+    {
+        mFileDescriptors[c] = OpenCounter(
+            counterDefinitions[c].Type,
+            counterDefinitions[c].Config,
+            mGroupLeaderFileDescriptor,
+            counterDefinitions[c].Name);
+
+        if (mFileDescriptors[c] >= 0)
+        {
+            if (mGroupLeaderFileDescriptor < 0)
+                mGroupLeaderFileDescriptor = mFileDescriptors[c];
+
+            mGroupCounters[mGroupSize++] = static_cast<CounterType>(c);
+        }
+    }
+#else
+    for (int c = 0; c < _Count; ++c)
+    {
+        mFileDescriptors[c] = -1;
+    }
+
+    // Only tell once, as there may be many instances
+    static std::atomic<bool> hasLogged(false);
+    if (!hasLogged.exchange(true))
+    {
+        LogMessage("HardwareCounters: not supported on this platform");
+    }
+#endif
+}
+
+HardwareCounters::~HardwareCounters()
+{
+#ifdef __linux__
+    // Group members first, then the leader
+    for (int c = _Count - 1; c >= 0; --c)
+    {
+        if (mFileDescriptors[c] >= 0 && mFileDescriptors[c] != mGroupLeaderFileDescriptor)
+            ::close(mFileDescriptors[c]);
+    }
+
+    if (mGroupLeaderFileDescriptor >= 0)
+        ::close(mGroupLeaderFileDescriptor);
+#endif
+}
+
+bool HardwareCounters::IsAvailable() const
+{
+    return mGroupSize > 0;
+}
+
+HardwareCounterValues HardwareCounters::Read() const
+{
+    HardwareCounterValues values;
+
+#ifdef __linux__
+    if (mGroupLeaderFileDescriptor >= 0)
+    {
+        // The layout of a PERF_FORMAT_GROUP read, with total times
+        struct
+        {
+            std::uint64_t Count;
+            std::uint64_t TimeEnabled;
+            std::uint64_t TimeRunning;
+            std::uint64_t Values[_Count];
+        } groupData;
+
+        ssize_t const expectedSize = static_cast<ssize_t>((3 + mGroupSize) * sizeof(std::uint64_t));
+
+        if (::read(mGroupLeaderFileDescriptor, &groupData, sizeof(groupData)) == expectedSize
+            && groupData.Count == mGroupSize)
+        {
+            for (size_t i = 0; i < mGroupSize; ++i)
+            {
+                std::uint64_t const value = ScaleCount(
+                    groupData.Values[i],
+                    groupData.TimeEnabled,
+                    groupData.TimeRunning);
+
+                switch (mGroupCounters[i])
+                {
+                    case Cycles:
+                        values.Cycles = value;
+                        break;
+
+                    case Instructions:
+                        values.Instructions = value;
+                        break;
+
+                    case LLCMisses:
+                        values.LLCMisses = value;
+                        break;
+
+                    case DTLBMisses:
+                        values.DTLBMisses = value;
+                        break;
+
+                    case _Count:
+                        break;
+                }
+            }
+        }
+    }
+#endif
+
+    return values;
+}
+
+std::uint64_t HardwareCounters::ScaleCount(
+    std::uint64_t count,
+    std::uint64_t timeEnabled,
+    std::uint64_t timeRunning)
+{
+    if (timeRunning == 0)
+    {
+        // Never got onto the PMU
+        return 0;
+    }
+
+    if (timeRunning >= timeEnabled)
+    {
+        // Never multiplexed
+        return count;
+    }
+
+    return static_cast<std::uint64_t>(
+        static_cast<double>(count) * static_cast<double>(timeEnabled) / static_cast<double>(timeRunning));
+}
@@ -0,0 +1,117 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2020-01-09
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/*
+ * A snapshot - or a difference of snapshots - of the hardware performance counters.
+ */
+struct HardwareCounterValues
+{
+    std::uint64_t Cycles;
+    std::uint64_t Instructions;
+    std::uint64_t LLCMisses;
+    std::uint64_t DTLBMisses;
+
+    HardwareCounterValues()
+        : Cycles(0)
+        , Instructions(0)
+        , LLCMisses(0)
+        , DTLBMisses(0)
+    {}
+
+    HardwareCounterValues & operator+=(HardwareCounterValues const & other)
+    {
+        Cycles += other.Cycles;
+        Instructions += other.Instructions;
+        LLCMisses += other.LLCMisses;
+        DTLBMisses += other.DTLBMisses;
+
+        return *this;
+    }
+
+    HardwareCounterValues operator-(HardwareCounterValues const & other) const
+    {
+        HardwareCounterValues result;
+        result.Cycles = Cycles - other.Cycles;
+        result.Instructions = Instructions - other.Instructions;
+        result.LLCMisses = LLCMisses - other.LLCMisses;
+        result.DTLBMisses = DTLBMisses - other.DTLBMisses;
+
+        return result;
+    }
+
+    float GetInstructionsPerCycle() const
+    {
+        return Cycles != 0
+            ? static_cast<float>(Instructions) / static_cast<float>(Cycles)
+            : 0.0f;
+    }
+};
+
+/*
+ * The hardware performance counters of the calling thread - cycles, instructions,
+ * last-level cache misses, and data TLB misses - counted in user space only.
+ *
+ * Only supported on Linux, via perf_event_open; counters that cannot be opened -
+ * on other platforms, without a PMU, or when perf_event_paranoid forbids them -
+ * simply read as zero.
+ *
+ * The counters are opened as one group, so that they are scheduled onto the PMU
+ * together and read with a single system call; when the kernel multiplexes the
+ * group with other events, the counts are scaled up by the fraction of time
+ * during which the group was actually counting.
+ *
+ * Counts the thread that creates the instance, regardless of the thread reading it.
+ */
+class HardwareCounters
+{
+public:
+
+    HardwareCounters();
+
+    ~HardwareCounters();
+
+    HardwareCounters(HardwareCounters const &) = delete;
+    HardwareCounters & operator=(HardwareCounters const &) = delete;
+
+    /*
+     * Whether at least one of the counters is available.
+     */
+    bool IsAvailable() const;
+
+    HardwareCounterValues Read() const;
+
+    /*
+     * Estimates the count of an event that was only counting for part of the time
+     * in which it was enabled.
+     */
+    static std::uint64_t ScaleCount(
+        std::uint64_t count,
+        std::uint64_t timeEnabled,
+        std::uint64_t timeRunning);
+
+private:
+
+    enum CounterType
+    {
+        Cycles = 0,
+        Instructions,
+        LLCMisses,
+        DTLBMisses,
+
+        _Count
+    };
+
+    int mFileDescriptors[_Count]; // -1 when not available; the first available is the group leader
+    int mGroupLeaderFileDescriptor; // -1 when no counter is available
+
+    // The available counters, in the order in which they joined the group - and are read
+    CounterType mGroupCounters[_Count];
+    size_t mGroupSize;
+};
@@ -5,6 +5,11 @@
 ***************************************************************************************/
 #include "ImageTools.h"
 
+#include "GameMath.h"
+#include "LibSimdPp.h"
+
+#include <vector>
+
 void ImageTools::BlendWithColor(
     RgbaImageData & imageData,
     rgbColor const & color,
@@ -15,4 +20,223 @@ void ImageTools::BlendWithColor(
     {
         imageData.Data[i] = imageData.Data[i].mix(color, alpha);
     }
-}
\ No newline at end of file
+}
+
+std::vector<RgbaImageData> ImageTools::MakeMipmaps(RgbaImageData const & baseImage)
+{
+    std::vector<RgbaImageData> mipmaps;
+
+    ImageSize readImageSize(baseImage.Size);
+    rgbaColor const * rp = baseImage.Data.get();
+
+    while (readImageSize.Width > 1 || readImageSize.Height > 1)
+    {
+        // Calculate dimensions of new level
+        int width = std::max(1, readImageSize.Width / 2);
+        int height = std::max(1, readImageSize.Height / 2);
+
+        // Create new level
+        auto writeBuffer = std::make_unique<rgbaColor[]>(width * height);
+        rgbaColor * wp = writeBuffer.get();
+        for (int h = 0; h < height; ++h)
+        {
+            for (int w = 0; w < width; ++w)
+            {
+                //
+                // Apply box filter
+                //
+
+                int wIndex = ((h * width) + w);
+
+                int rIndex = (((h * 2) * readImageSize.Width) + (w * 2));
+                int rIndexNextLine = ((((h * 2) + 1) * readImageSize.Width) + (w * 2));
+
+                rgbaColorAccumulation sum(rp[rIndex]);
+
+                if (readImageSize.Width > 1)
+                    sum += rp[rIndex + 1];
+
+                if (readImageSize.Height > 1)
+                {
+                    sum += rp[rIndexNextLine];
+
+                    if (readImageSize.Width > 1)
+                        sum += rp[rIndexNextLine + 1];
+                }
+
+                wp[wIndex] = sum.toRgbaColor();
+            }
+        }
+
+        mipmaps.emplace_back(
+            ImageSize(width, height),
+            std::move(writeBuffer));
+
+        // Next level reads from this one
+        readImageSize = ImageSize(width, height);
+        rp = mipmaps.back().Data.get();
+    }
+
+    return mipmaps;
+}
+
+std::vector<RgbaImageData> ImageTools::MakePowerOfTwoMipmaps(
+    RgbaImageData const & baseImage,
+    int maxDimension)
+{
+    assert(baseImage.Size.Width == CeilPowerOfTwo(baseImage.Size.Width));
+    assert(baseImage.Size.Height == CeilPowerOfTwo(baseImage.Size.Height));
+
+    std::vector<RgbaImageData> mipmaps;
+
+    rgbaColor const * rp = baseImage.Data.get();
+
+    for (int divisor = 2; maxDimension / divisor >= 1; divisor *= 2)
+    {
+        // Calculate dimensions of new level
+        int newWidth = std::max(1, baseImage.Size.Width / divisor);
+        int newHeight = std::max(1, baseImage.Size.Height / divisor);
+
+        // Create new level
+        auto writeBuffer = std::make_unique<rgbaColor[]>(newWidth * newHeight);
+        rgbaColor * wp = writeBuffer.get();
+        for (int h = 0; h < newHeight; ++h)
+        {
+            size_t frameIndexInReadBuffer = (h * 2) * (newWidth * 2);
+            size_t frameIndexInWriteBuffer = (h) * (newWidth);
+
+            for (int w = 0; w < newWidth; ++w)
+            {
+                //
+                // Calculate and store average of the four neighboring pixels whose bottom-left corner is at (w*2, h*2)
+                //
+
+                rgbaColorAccumulation sum;
+
+                sum += rp[frameIndexInReadBuffer + w * 2];
+                sum += rp[frameIndexInReadBuffer + w * 2 + 1];
+                sum += rp[frameIndexInReadBuffer + newWidth * 2 + w * 2];
+                sum += rp[frameIndexInReadBuffer + newWidth * 2 + w * 2 + 1];
+
+                wp[frameIndexInWriteBuffer + w] = sum.toRgbaColor();
+            }
+        }
+
+        mipmaps.emplace_back(
+            ImageSize(newWidth, newHeight),
+            std::move(writeBuffer));
+
+        // Next level reads from this one
+        rp = mipmaps.back().Data.get();
+    }
+
+    return mipmaps;
+}
+
+RgbaImageData ImageTools::BoxFilterResize(
+    rgbaColor const * sourceData,
+    ImageSize const & sourceSize,
+    ImageSize const & targetSize,
+    bool doFlipVertically)
+{
+    assert(sourceSize.Width > 0 && sourceSize.Height > 0);
+    assert(targetSize.Width > 0 && targetSize.Height > 0);
+
+    auto targetData = std::make_unique<rgbaColor[]>(targetSize.Width * targetSize.Height);
+
+    //
+    // Calculate the range of source columns covered by each target column;
+    // each target column covers at least one source column
+    //
+
+    std::vector<int> sourceColumnStarts(targetSize.Width);
+    std::vector<int> sourceColumnEnds(targetSize.Width);
+    for (int tx = 0; tx < targetSize.Width; ++tx)
+    {
+        sourceColumnStarts[tx] = std::min(
+            static_cast<int>(static_cast<int64_t>(tx) * sourceSize.Width / targetSize.Width),
+            sourceSize.Width - 1);
+
+        sourceColumnEnds[tx] = std::max(
+            static_cast<int>(static_cast<int64_t>(tx + 1) * sourceSize.Width / targetSize.Width),
+            sourceColumnStarts[tx] + 1);
+    }
+
+    //
+    // Visit all target rows; for each target row, we accumulate the source rows
+    // it covers into a row of per-column RGBA sums, and then we reduce the
+    // per-column sums into target pixels
+    //
+
+    std::vector<simdpp::float32<4>> columnSums(sourceSize.Width);
+
+    for (int ty = 0; ty < targetSize.Height; ++ty)
+    {
+        int const sourceRowStart = std::min(
+            static_cast<int>(static_cast<int64_t>(ty) * sourceSize.Height / targetSize.Height),
+            sourceSize.Height - 1);
+
+        int const sourceRowEnd = std::max(
+            static_cast<int>(static_cast<int64_t>(ty + 1) * sourceSize.Height / targetSize.Height),
+            sourceRowStart + 1);
+
+        //
+        // Accumulate source rows
+        //
+
+        std::fill(columnSums.begin(), columnSums.end(), simdpp::float32<4>(simdpp::make_zero()));
+
+        for (int sy = sourceRowStart; sy < sourceRowEnd; ++sy)
+        {
+            rgbaColor const * const sourceRow = sourceData + static_cast<size_t>(sy) * sourceSize.Width;
+
+            for (int sx = 0; sx < sourceSize.Width; ++sx)
+            {
+                rgbaColor const & c = sourceRow[sx];
+
+                columnSums[sx] = columnSums[sx] + simdpp::float32<4>(
+                    simdpp::make_float(c.r, c.g, c.b, c.a));
+            }
+        }
+
+        //
+        // Reduce columns into target pixels
+        //
+
+        int const targetRow = doFlipVertically
+            ? targetSize.Height - 1 - ty
+            : ty;
+
+        rgbaColor * const targetRowData = targetData.get() + static_cast<size_t>(targetRow) * targetSize.Width;
+
+        float const rowCount = static_cast<float>(sourceRowEnd - sourceRowStart);
+
+        for (int tx = 0; tx < targetSize.Width; ++tx)
+        {
+            simdpp::float32<4> pixelSum(simdpp::make_zero());
+            for (int sx = sourceColumnStarts[tx]; sx < sourceColumnEnds[tx]; ++sx)
+            {
+                pixelSum = pixelSum + columnSums[sx];
+            }
+
+            float const normalizationFactor = 1.0f / (rowCount * static_cast<float>(sourceColumnEnds[tx] - sourceColumnStarts[tx]));
+
+            simdpp::float32<4> const pixel =
+                pixelSum * simdpp::float32<4>(simdpp::make_float(normalizationFactor))
+                + simdpp::float32<4>(simdpp::make_float(0.5f));
+
+            alignas(16) float pixelComponents[4];
+            simdpp::store(pixelComponents, pixel);
+
+            targetRowData[tx] = rgbaColor(
+                static_cast<uint8_t>(std::min(pixelComponents[0], 255.0f)),
+                static_cast<uint8_t>(std::min(pixelComponents[1], 255.0f)),
+                static_cast<uint8_t>(std::min(pixelComponents[2], 255.0f)),
+                static_cast<uint8_t>(std::min(pixelComponents[3], 255.0f)));
+        }
+    }
+
+    return RgbaImageData(
+        targetSize,
+        std::move(targetData));
+}
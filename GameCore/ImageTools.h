@@ -12,6 +12,7 @@
 #include <algorithm>
 #include <cassert>
 #include <functional>
+#include <vector>
 
 class ImageTools
 {
@@ -22,6 +23,32 @@ public:
         rgbColor const & color,
         float alpha);
 
+    /*
+     * Resizes an image with a box filter, streaming through the source image one row at a time;
+     * meant for reducing images, each target pixel being the average of the source pixels it covers.
+     *
+     * When requested, the image is also flipped vertically while being resized.
+     */
+    static RgbaImageData BoxFilterResize(
+        rgbaColor const * sourceData,
+        ImageSize const & sourceSize,
+        ImageSize const & targetSize,
+        bool doFlipVertically);
+
+    /*
+     * Builds the mipmaps of an image, from level 1 down to the 1x1 level,
+     * each level being a box-filtered version of the previous one.
+     */
+    static std::vector<RgbaImageData> MakeMipmaps(RgbaImageData const & baseImage);
+
+    /*
+     * Builds the mipmaps of an image whose dimensions are powers of two, from level 1
+     * down to the level at which the specified max dimension would reach 1.
+     */
+    static std::vector<RgbaImageData> MakePowerOfTwoMipmaps(
+        RgbaImageData const & baseImage,
+        int maxDimension);
+
     static inline vec4f SamplePixel(
         RgbaImageData const & imageData,
         float x,
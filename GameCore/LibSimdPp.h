@@ -0,0 +1,29 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2019-12-15
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+/*
+ * Single point of inclusion for libsimdpp, so that all of its users
+ * agree on the target instruction set.
+ *
+ * SSE2 is the baseline of all x86 targets; AVX2 is used when the compiler
+ * itself targets it (e.g. -mavx2, or /arch:AVX2), in which case the fast
+ * vector width - SIMDPP_FAST_FLOAT32_SIZE - doubles to eight floats.
+ */
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#if defined(__AVX2__)
+#ifndef SIMDPP_ARCH_X86_AVX2
+#define SIMDPP_ARCH_X86_AVX2
+#endif
+#else
+#ifndef SIMDPP_ARCH_X86_SSE2
+#define SIMDPP_ARCH_X86_SSE2
+#endif
+#endif
+#endif
+
+#include <simdpp/simd.h>
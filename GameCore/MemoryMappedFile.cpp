@@ -0,0 +1,138 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2019-12-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "MemoryMappedFile.h"
+
+#include "GameException.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+std::unique_ptr<MemoryMappedFile> MemoryMappedFile::Open(std::filesystem::path const & filepath)
+{
+    HANDLE fileHandle = ::CreateFileW(
+        filepath.wstring().c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr);
+
+    if (fileHandle == INVALID_HANDLE_VALUE)
+    {
+        throw GameException("Could not open file \"" + filepath.string() + "\"");
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!::GetFileSizeEx(fileHandle, &fileSize))
+    {
+        ::CloseHandle(fileHandle);
+        throw GameException("Could not get size of file \"" + filepath.string() + "\"");
+    }
+
+    if (fileSize.QuadPart == 0)
+    {
+        // Empty files cannot be mapped
+        return std::unique_ptr<MemoryMappedFile>(
+            new MemoryMappedFile(nullptr, 0, fileHandle, nullptr));
+    }
+
+    HANDLE mappingHandle = ::CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mappingHandle == nullptr)
+    {
+        ::CloseHandle(fileHandle);
+        throw GameException("Could not map file \"" + filepath.string() + "\"");
+    }
+
+    void const * data = ::MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+    if (data == nullptr)
+    {
+        ::CloseHandle(mappingHandle);
+        ::CloseHandle(fileHandle);
+        throw GameException("Could not map view of file \"" + filepath.string() + "\"");
+    }
+
+    return std::unique_ptr<MemoryMappedFile>(
+        new MemoryMappedFile(
+            static_cast<std::uint8_t const *>(data),
+            static_cast<size_t>(fileSize.QuadPart),
+            fileHandle,
+            mappingHandle));
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+    if (mData != nullptr)
+        ::UnmapViewOfFile(mData);
+
+    if (mMappingHandle != nullptr)
+        ::CloseHandle(static_cast<HANDLE>(mMappingHandle));
+
+    ::CloseHandle(static_cast<HANDLE>(mFileHandle));
+}
+
+#else
+
+std::unique_ptr<MemoryMappedFile> MemoryMappedFile::Open(std::filesystem::path const & filepath)
+{
+    int const fd = ::open(filepath.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw GameException("Could not open file \"" + filepath.string() + "\"");
+    }
+
+    struct stat fileStat;
+    if (::fstat(fd, &fileStat) != 0)
+    {
+        ::close(fd);
+        throw GameException("Could not get size of file \"" + filepath.string() + "\"");
+    }
+
+    size_t const fileSize = static_cast<size_t>(fileStat.st_size);
+
+    if (fileSize == 0)
+    {
+        // Empty files cannot be mapped
+        ::close(fd);
+        return std::unique_ptr<MemoryMappedFile>(
+            new MemoryMappedFile(nullptr, 0, nullptr, nullptr));
+    }
+
+    void * data = ::mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    // The mapping keeps its own reference to the file
+    ::close(fd);
+
+    if (data == MAP_FAILED)
+    {
+        throw GameException("Could not map file \"" + filepath.string() + "\"");
+    }
+
+    return std::unique_ptr<MemoryMappedFile>(
+        new MemoryMappedFile(
+            static_cast<std::uint8_t const *>(data),
+            fileSize,
+            nullptr,
+            nullptr));
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+    if (mData != nullptr)
+        ::munmap(const_cast<std::uint8_t *>(mData), mSize);
+}
+
+#endif
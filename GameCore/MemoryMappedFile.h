@@ -0,0 +1,62 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2019-12-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+
+/*
+ * A read-only view of a whole file mapped into memory.
+ *
+ * The mapping stays valid for the lifetime of this object; the file may not
+ * be overwritten while it is mapped (notably on Windows).
+ */
+class MemoryMappedFile
+{
+public:
+
+    /*
+     * Maps the specified file; throws GameException if the file cannot be opened or mapped.
+     */
+    static std::unique_ptr<MemoryMappedFile> Open(std::filesystem::path const & filepath);
+
+    ~MemoryMappedFile();
+
+    MemoryMappedFile(MemoryMappedFile const &) = delete;
+    MemoryMappedFile & operator=(MemoryMappedFile const &) = delete;
+
+    std::uint8_t const * GetData() const
+    {
+        return mData;
+    }
+
+    size_t GetSize() const
+    {
+        return mSize;
+    }
+
+private:
+
+    MemoryMappedFile(
+        std::uint8_t const * data,
+        size_t size,
+        void * fileHandle,
+        void * mappingHandle)
+        : mData(data)
+        , mSize(size)
+        , mFileHandle(fileHandle)
+        , mMappingHandle(mappingHandle)
+    {}
+
+    std::uint8_t const * const mData;
+    size_t const mSize;
+
+    // Platform-specific handles
+    void * const mFileHandle;
+    void * const mMappingHandle;
+};
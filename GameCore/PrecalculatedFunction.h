@@ -6,7 +6,9 @@
 #pragma once
 
 #include "GameMath.h"
+#include "GameMathBatch.h"
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <cstdint>
@@ -139,6 +141,41 @@ public:
             + mSamples[sampleIndexI].SampleValuePlusOneMinusSampleValue * sampleIndexDx;
     }
 
+    /*
+     * Batch version of GetLinearlyInterpolatedPeriodic().
+     */
+    void GetLinearlyInterpolatedPeriodicBatch(
+        float const * x,
+        float * result,
+        size_t count) const
+    {
+        // First the sample indices - vectorized - and then the lookups, in blocks
+        static size_t constexpr BlockSize = 256;
+        alignas(16) std::int32_t sampleIndices[BlockSize];
+        alignas(16) float sampleFractions[BlockSize];
+
+        for (size_t blockStart = 0; blockStart < count; blockStart += BlockSize)
+        {
+            size_t const blockCount = std::min(BlockSize, count - blockStart);
+
+            CalculatePeriodicSampleIndicesBatch(
+                x + blockStart,
+                static_cast<std::int32_t>(SamplesCount),
+                sampleIndices,
+                sampleFractions,
+                blockCount);
+
+            for (size_t i = 0; i < blockCount; ++i)
+            {
+                Sample const & sample = mSamples[sampleIndices[i]];
+
+                result[blockStart + i] =
+                    sample.SampleValue
+                    + sample.SampleValuePlusOneMinusSampleValue * sampleFractions[i];
+            }
+        }
+    }
+
 private:
 
     void PopulateSamples(std::function<float(float)> calculator)
@@ -0,0 +1,366 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2020-01-04
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "GameMath.h"
+#include "SysSpecifics.h"
+#include "Vectors.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+/*
+ * A fast random engine, running four xoshiro128+ generators side by side so that
+ * each step produces four numbers with a few lane-wise integer operations.
+ *
+ * Two engines constructed with the same seed and stream produce the same sequence;
+ * engines with the same seed and different streams produce independent sequences,
+ * hence loops running in parallel get reproducible numbers by giving each of their
+ * chunks - or each of their threads - its own stream.
+ *
+ * The batch methods produce exactly the same values as the equivalent sequence of
+ * scalar invocations.
+ *
+ * Not thread-safe: each thread must use its own instance.
+ */
+class RandomEngine
+{
+public:
+
+    static size_t constexpr LaneCount = 4;
+
+    explicit RandomEngine(
+        std::uint64_t seed,
+        std::uint64_t stream = 0)
+        : mNextOutput(LaneCount)
+    {
+        Seed(seed, stream);
+    }
+
+    void Seed(
+        std::uint64_t seed,
+        std::uint64_t stream = 0)
+    {
+        // Expand the seed with splitmix64, as recommended by the xoshiro authors
+        std::uint64_t splitMixState = seed ^ (stream * 0xd1b54a32d192ed03ull);
+
+        for (size_t l = 0; l < LaneCount; ++l)
+        {
+            std::uint64_t const a = SplitMix64(splitMixState);
+            std::uint64_t const b = SplitMix64(splitMixState);
+
+            mS0[l] = static_cast<std::uint32_t>(a);
+            mS1[l] = static_cast<std::uint32_t>(a >> 32);
+            mS2[l] = static_cast<std::uint32_t>(b);
+            mS3[l] = static_cast<std::uint32_t>(b >> 32);
+
+            // The all-zero state is the only one xoshiro cannot escape from
+            if ((mS0[l] | mS1[l] | mS2[l] | mS3[l]) == 0)
+                mS0[l] = 1;
+        }
+
+        mNextOutput = LaneCount;
+    }
+
+    //
+    // Scalar
+    //
+
+    inline std::uint32_t GenerateUInt32()
+    {
+        if (mNextOutput == LaneCount)
+        {
+            StepLanes(mOutputs);
+            mNextOutput = 0;
+        }
+
+        return mOutputs[mNextOutput++];
+    }
+
+    /*
+     * Returns a value between 0 and count - 1, included.
+     */
+    template <typename T>
+    inline T Choose(T count)
+    {
+        return GenerateRandomInteger<T>(0, count - 1);
+    }
+
+    /*
+     * Returns a value between 0 and count - 1, included, with the exclusion of
+     * previous.
+     */
+    template <typename T>
+    inline T ChooseNew(
+        T count,
+        T previous)
+    {
+        // Choose randomly, but avoid choosing the last-chosen again
+        T chosen = GenerateRandomInteger<T>(0, count - 2);
+        if (chosen >= previous)
+        {
+            ++chosen;
+        }
+
+        return chosen;
+    }
+
+    /*
+     * Returns a value between first and last, included, with the exclusion of
+     * previous, if the latter is in the first-last range.
+     */
+    template <typename T>
+    inline T ChooseNew(
+        T first,
+        T last,
+        T previous)
+    {
+        // Choose randomly, but avoid choosing the last-chosen again
+        if (previous >= first && previous <= last)
+        {
+            T chosen = GenerateRandomInteger<T>(first, last - 1);
+            if (chosen >= previous)
+            {
+                ++chosen;
+            }
+
+            return chosen;
+        }
+        else
+        {
+            return GenerateRandomInteger<T>(first, last);
+        }
+    }
+
+    /*
+     * Returns a value between minValue and maxValue, both included, without bias.
+     */
+    template <typename T>
+    inline T GenerateRandomInteger(
+        T minValue,
+        T maxValue)
+    {
+        assert(minValue <= maxValue);
+
+        // Two's complement makes this correct for signed types as well
+        std::uint64_t const range = static_cast<std::uint64_t>(maxValue) - static_cast<std::uint64_t>(minValue) + 1;
+
+        std::uint64_t offset;
+        if (range == 0)
+        {
+            // Full 64-bit range
+            offset = GenerateUInt64();
+        }
+        else if (range <= 0xffffffffull)
+        {
+            // Lemire's multiply-and-reject
+            std::uint32_t const range32 = static_cast<std::uint32_t>(range);
+            std::uint64_t m = static_cast<std::uint64_t>(GenerateUInt32()) * range32;
+            if (static_cast<std::uint32_t>(m) < range32)
+            {
+                std::uint32_t const threshold = static_cast<std::uint32_t>(-range32) % range32;
+                while (static_cast<std::uint32_t>(m) < threshold)
+                {
+                    m = static_cast<std::uint64_t>(GenerateUInt32()) * range32;
+                }
+            }
+
+            offset = m >> 32;
+        }
+        else
+        {
+            // Reject the top, incomplete interval
+            std::uint64_t const limit = std::numeric_limits<std::uint64_t>::max() - (std::numeric_limits<std::uint64_t>::max() % range);
+            std::uint64_t x;
+            do
+            {
+                x = GenerateUInt64();
+            } while (x >= limit);
+
+            offset = x % range;
+        }
+
+        return static_cast<T>(static_cast<std::uint64_t>(minValue) + offset);
+    }
+
+    /*
+     * Returns a value in [0.0, 1.0).
+     */
+    inline float GenerateRandomNormalizedReal()
+    {
+        return ToNormalizedReal(GenerateUInt32());
+    }
+
+    /*
+     * Returns a value in [minValue, maxValue).
+     */
+    inline float GenerateRandomReal(
+        float minValue,
+        float maxValue)
+    {
+        return minValue + GenerateRandomNormalizedReal() * (maxValue - minValue);
+    }
+
+    inline vec2f GenerateRandomRadialVector(
+        float minMagnitude,
+        float maxMagnitude)
+    {
+        //
+        // Choose a vector: point on a circle with random radius and random angle
+        //
+
+        float const magnitude = GenerateRandomReal(
+            minMagnitude, maxMagnitude);
+
+        float const angle = GenerateRandomReal(0.0f, 2.0f * Pi<float>);
+
+        return vec2f::fromPolar(magnitude, angle);
+    }
+
+    inline bool GenerateRandomBoolean(float trueProbability)
+    {
+        return GenerateRandomNormalizedReal() < trueProbability;
+    }
+
+    inline float GenerateExponentialReal(float lambda)
+    {
+        // Inversion; 1 - u is in (0.0, 1.0]
+        return -std::log(1.0f - GenerateRandomNormalizedReal()) / lambda;
+    }
+
+    //
+    // Batch
+    //
+
+    /*
+     * Fills the buffer with values in [minValue, maxValue); the same values as count
+     * invocations of GenerateRandomReal(minValue, maxValue).
+     */
+    void FillUniform(
+        float * restrict outBuffer,
+        size_t count,
+        float minValue,
+        float maxValue)
+    {
+        float const width = maxValue - minValue;
+
+        size_t i = 0;
+
+        // Use up outputs left over from previous invocations
+        for (; i < count && mNextOutput < LaneCount; ++i)
+        {
+            outBuffer[i] = minValue + ToNormalizedReal(mOutputs[mNextOutput++]) * width;
+        }
+
+        // Whole steps straight into the buffer
+        alignas(16) std::uint32_t outputs[LaneCount];
+        for (; i + LaneCount <= count; i += LaneCount)
+        {
+            StepLanes(outputs);
+
+            for (size_t l = 0; l < LaneCount; ++l)
+            {
+                outBuffer[i + l] = minValue + ToNormalizedReal(outputs[l]) * width;
+            }
+        }
+
+        // Tail
+        for (; i < count; ++i)
+        {
+            outBuffer[i] = GenerateRandomReal(minValue, maxValue);
+        }
+    }
+
+    /*
+     * Fills the buffer with random radial vectors; the same values as count invocations
+     * of GenerateRandomRadialVector(minMagnitude, maxMagnitude).
+     */
+    void FillRadialVectors(
+        vec2f * restrict outBuffer,
+        size_t count,
+        float minMagnitude,
+        float maxMagnitude)
+    {
+        // Magnitudes and angles are drawn alternately, as in the scalar version
+        static size_t constexpr BatchSize = 64;
+        alignas(16) float normalizedReals[2 * BatchSize];
+
+        for (size_t start = 0; start < count; start += BatchSize)
+        {
+            size_t const batchCount = std::min(BatchSize, count - start);
+
+            FillUniform(normalizedReals, 2 * batchCount, 0.0f, 1.0f);
+
+            for (size_t i = 0; i < batchCount; ++i)
+            {
+                float const magnitude = minMagnitude + normalizedReals[2 * i] * (maxMagnitude - minMagnitude);
+                float const angle = normalizedReals[2 * i + 1] * (2.0f * Pi<float>);
+
+                outBuffer[start + i] = vec2f::fromPolar(magnitude, angle);
+            }
+        }
+    }
+
+private:
+
+    static inline std::uint64_t SplitMix64(std::uint64_t & state)
+    {
+        std::uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    static inline float ToNormalizedReal(std::uint32_t value)
+    {
+        // The top 24 bits - the lowest bits of xoshiro+ are the weakest
+        return static_cast<float>(value >> 8) * (1.0f / 16777216.0f);
+    }
+
+    inline std::uint64_t GenerateUInt64()
+    {
+        std::uint64_t const high = GenerateUInt32();
+        return (high << 32) | GenerateUInt32();
+    }
+
+    /*
+     * Advances all lanes by one step, writing one output per lane; written lane-wise
+     * so that it compiles to vector instructions.
+     */
+    inline void StepLanes(std::uint32_t * restrict outputs)
+    {
+        for (size_t l = 0; l < LaneCount; ++l)
+        {
+            outputs[l] = mS0[l] + mS3[l];
+
+            std::uint32_t const t = mS1[l] << 9;
+
+            mS2[l] ^= mS0[l];
+            mS3[l] ^= mS1[l];
+            mS1[l] ^= mS2[l];
+            mS0[l] ^= mS3[l];
+
+            mS2[l] ^= t;
+
+            mS3[l] = (mS3[l] << 11) | (mS3[l] >> 21);
+        }
+    }
+
+private:
+
+    // Generator state, one column per lane
+    alignas(16) std::uint32_t mS0[LaneCount];
+    alignas(16) std::uint32_t mS1[LaneCount];
+    alignas(16) std::uint32_t mS2[LaneCount];
+    alignas(16) std::uint32_t mS3[LaneCount];
+
+    // Outputs of the last step, handed out one by one to scalar invocations
+    alignas(16) std::uint32_t mOutputs[LaneCount];
+    size_t mNextOutput;
+};
@@ -0,0 +1,416 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2020-01-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "RewindBuffer.h"
+
+#include "TraceRecorder.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace /* anonymous */ {
+
+    // The maximum number of images waiting for the encoding thread
+    static constexpr size_t MaxPendingImages = 2;
+
+    // Each run is a header word - the number of zero words in its high half, and
+    // the number of literal words in its low half - followed by the literal words
+    static constexpr size_t MaxRunLength = 0xffffffff;
+
+    inline std::uint64_t LoadWord(
+        std::uint8_t const * image,
+        size_t w)
+    {
+        std::uint64_t word;
+        std::memcpy(&word, image + w * sizeof(std::uint64_t), sizeof(std::uint64_t));
+        return word;
+    }
+
+    inline void StoreWord(
+        std::uint8_t * image,
+        size_t w,
+        std::uint64_t word)
+    {
+        std::memcpy(image + w * sizeof(std::uint64_t), &word, sizeof(std::uint64_t));
+    }
+
+    /*
+     * Encodes the XOR of the image with the previous one - or the image itself, when
+     * there is no previous image.
+     */
+    void Encode(
+        std::uint8_t const * image,
+        std::uint8_t const * previousImage,
+        size_t wordCount,
+        std::vector<std::uint64_t> & encodedImage)
+    {
+        auto const getWord = [image, previousImage](size_t w)
+        {
+            return previousImage != nullptr
+                ? LoadWord(image, w) ^ LoadWord(previousImage, w)
+                : LoadWord(image, w);
+        };
+
+        encodedImage.clear();
+
+        size_t w = 0;
+        while (w < wordCount)
+        {
+            size_t const zeroStart = w;
+            while (w < wordCount && w - zeroStart < MaxRunLength && getWord(w) == 0)
+                ++w;
+
+            size_t const literalStart = w;
+            while (w < wordCount && w - literalStart < MaxRunLength)
+            {
+                // A single zero word costs as much as a new header, hence we only
+                // stop at two
+                if (getWord(w) == 0 && (w + 1 == wordCount || getWord(w + 1) == 0))
+                    break;
+
+                ++w;
+            }
+
+            encodedImage.push_back(
+                (static_cast<std::uint64_t>(literalStart - zeroStart) << 32)
+                | static_cast<std::uint64_t>(w - literalStart));
+
+            for (size_t l = literalStart; l < w; ++l)
+                encodedImage.push_back(getWord(l));
+        }
+
+        encodedImage.shrink_to_fit();
+    }
+
+    /*
+     * XORs the encoded image into the image; when the image starts zeroed, this
+     * decodes a keyframe.
+     */
+    void Decode(
+        std::vector<std::uint64_t> const & encodedImage,
+        std::uint8_t * image)
+    {
+        size_t w = 0;
+        for (size_t e = 0; e < encodedImage.size(); )
+        {
+            std::uint64_t const header = encodedImage[e++];
+
+            w += static_cast<size_t>(header >> 32);
+
+            size_t const literalCount = static_cast<size_t>(header & 0xffffffff);
+            for (size_t l = 0; l < literalCount; ++l, ++w)
+                StoreWord(image, w, LoadWord(image, w) ^ encodedImage[e++]);
+        }
+    }
+}
+
+RewindBuffer::RewindBuffer(Settings const & settings)
+    : mSettings(settings)
+    , mFrames()
+    , mKeyframeCount(0)
+    , mFramesSinceKeyframe(0)
+    , mIsKeyframeForced(false)
+    , mEncodedByteSize(0)
+    , mDroppedFrameCount(0)
+    , mEncodingThread()
+    , mPendingImages()
+    , mFreeImages()
+    , mPreviousImage()
+    , mIsEncoding(false)
+    , mIsStopping(false)
+    , mMutex()
+    , mPendingImageEvent()
+    , mIdleEvent()
+{
+    assert(mSettings.KeyframeInterval > 0);
+
+    mEncodingThread = std::thread(&RewindBuffer::RunEncodingThread, this);
+}
+
+RewindBuffer::~RewindBuffer()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        mIsStopping = true;
+        mPendingImageEvent.notify_one();
+    }
+
+    mEncodingThread.join();
+}
+
+bool RewindBuffer::TryAcquireImage(std::vector<std::uint8_t> & image)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    if (mPendingImages.size() >= MaxPendingImages)
+    {
+        ++mDroppedFrameCount;
+        return false;
+    }
+
+    if (!mFreeImages.empty())
+    {
+        image = std::move(mFreeImages.back());
+        mFreeImages.pop_back();
+    }
+
+    return true;
+}
+
+void RewindBuffer::DropImage(std::vector<std::uint8_t> && image)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    ++mDroppedFrameCount;
+
+    // An image acquired from an empty pool has no memory worth keeping
+    if (image.capacity() > 0)
+    {
+        mFreeImages.emplace_back(std::move(image));
+    }
+}
+
+void RewindBuffer::Push(
+    float time,
+    std::vector<std::uint8_t> && image)
+{
+    assert(image.size() % sizeof(std::uint64_t) == 0);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    mPendingImages.push_back({ time, std::move(image) });
+    mPendingImageEvent.notify_one();
+}
+
+std::optional<float> RewindBuffer::Restore(
+    float time,
+    std::vector<std::uint8_t> & image)
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+
+    WaitForIdle(lock);
+
+    if (mFrames.empty())
+        return std::nullopt;
+
+    //
+    // Find the frame, and the keyframe it depends on
+    //
+
+    size_t f = 0;
+    while (f + 1 < mFrames.size() && mFrames[f + 1].Time <= time)
+        ++f;
+
+    size_t k = f;
+    while (!mFrames[k].IsKeyframe)
+    {
+        assert(k > 0);
+        --k;
+    }
+
+    //
+    // Decode
+    //
+
+    image.assign(mFrames[k].ImageSize, 0);
+
+    for (size_t d = k; d <= f; ++d)
+    {
+        assert(mFrames[d].ImageSize == image.size());
+        Decode(mFrames[d].EncodedImage, image.data());
+    }
+
+    //
+    // Resume from this frame
+    //
+
+    while (mFrames.size() > f + 1)
+    {
+        mEncodedByteSize -= mFrames.back().EncodedImage.size() * sizeof(std::uint64_t);
+        if (mFrames.back().IsKeyframe)
+            --mKeyframeCount;
+
+        mFrames.pop_back();
+    }
+
+    mFramesSinceKeyframe = f - k + 1;
+
+    mPreviousImage = image;
+
+    return mFrames[f].Time;
+}
+
+void RewindBuffer::Clear()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+
+    WaitForIdle(lock);
+
+    mFrames.clear();
+    mKeyframeCount = 0;
+    mFramesSinceKeyframe = 0;
+    mIsKeyframeForced = false;
+    mEncodedByteSize = 0;
+
+    // Next image is a keyframe
+    mPreviousImage.clear();
+}
+
+RewindBuffer::Statistics RewindBuffer::GetStatistics() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    Statistics statistics;
+    statistics.FrameCount = mFrames.size();
+    statistics.KeyframeCount = mKeyframeCount;
+    statistics.Duration = mFrames.empty() ? 0.0f : mFrames.back().Time - mFrames.front().Time;
+    statistics.ByteSize = CalculateByteSize();
+    statistics.UncompressedByteSize = 0;
+    for (auto const & frame : mFrames)
+        statistics.UncompressedByteSize += frame.ImageSize;
+    statistics.DroppedFrameCount = mDroppedFrameCount;
+
+    return statistics;
+}
+
+void RewindBuffer::RunEncodingThread()
+{
+    TraceRecorder::GetInstance().SetCurrentThreadName("Rewind Encoder");
+
+    std::unique_lock<std::mutex> lock(mMutex);
+
+    while (true)
+    {
+        mPendingImageEvent.wait(
+            lock,
+            [this]()
+            {
+                return mIsStopping || !mPendingImages.empty();
+            });
+
+        if (mIsStopping)
+            break;
+
+        PendingImage pendingImage = std::move(mPendingImages.front());
+        mPendingImages.pop_front();
+
+        Frame frame;
+        frame.Time = pendingImage.Time;
+        frame.IsKeyframe =
+            mIsKeyframeForced
+            || mFramesSinceKeyframe >= mSettings.KeyframeInterval
+            || mPreviousImage.size() != pendingImage.Image.size();
+        frame.ImageSize = pendingImage.Image.size();
+
+        mIsEncoding = true;
+
+        lock.unlock();
+
+        {
+            TRACE_SCOPE("RewindBuffer::Encode");
+
+            Encode(
+                pendingImage.Image.data(),
+                frame.IsKeyframe ? nullptr : mPreviousImage.data(),
+                pendingImage.Image.size() / sizeof(std::uint64_t),
+                frame.EncodedImage);
+        }
+
+        lock.lock();
+
+        // This image is the base of the next delta, and the previous one may be recycled
+        std::swap(mPreviousImage, pendingImage.Image);
+        mFreeImages.emplace_back(std::move(pendingImage.Image));
+
+        if (frame.IsKeyframe)
+        {
+            ++mKeyframeCount;
+            mFramesSinceKeyframe = 0;
+            mIsKeyframeForced = false;
+        }
+
+        ++mFramesSinceKeyframe;
+        mEncodedByteSize += frame.EncodedImage.size() * sizeof(std::uint64_t);
+        mFrames.emplace_back(std::move(frame));
+
+        Trim();
+
+        mIsEncoding = false;
+        mIdleEvent.notify_all();
+    }
+}
+
+void RewindBuffer::WaitForIdle(std::unique_lock<std::mutex> & lock)
+{
+    mIdleEvent.wait(
+        lock,
+        [this]()
+        {
+            return mPendingImages.empty() && !mIsEncoding;
+        });
+}
+
+void RewindBuffer::Trim()
+{
+    assert(!mFrames.empty());
+
+    float const oldestTime = mFrames.back().Time - mSettings.Duration;
+
+    //
+    // Evict whole keyframe groups, as long as the frame at the oldest time remains
+    // decodable and the newest group remains
+    //
+
+    while (mKeyframeCount > 1)
+    {
+        assert(mFrames.front().IsKeyframe);
+
+        auto const nextKeyframeIt = std::find_if(
+            mFrames.cbegin() + 1,
+            mFrames.cend(),
+            [](Frame const & frame)
+            {
+                return frame.IsKeyframe;
+            });
+
+        assert(nextKeyframeIt != mFrames.cend());
+
+        if (CalculateByteSize() <= mSettings.MaxByteSize
+            && nextKeyframeIt->Time > oldestTime)
+        {
+            break;
+        }
+
+        do
+        {
+            mEncodedByteSize -= mFrames.front().EncodedImage.size() * sizeof(std::uint64_t);
+            mFrames.pop_front();
+        } while (!mFrames.front().IsKeyframe);
+
+        --mKeyframeCount;
+    }
+
+    // The newest group alone may exceed the cap: start a new group, so that this one
+    // may be evicted
+    if (CalculateByteSize() > mSettings.MaxByteSize)
+    {
+        mIsKeyframeForced = true;
+    }
+}
+
+size_t RewindBuffer::CalculateByteSize() const
+{
+    size_t byteSize = mEncodedByteSize + mPreviousImage.capacity();
+
+    for (auto const & pendingImage : mPendingImages)
+        byteSize += pendingImage.Image.capacity();
+
+    for (auto const & freeImage : mFreeImages)
+        byteSize += freeImage.capacity();
+
+    return byteSize;
+}
@@ -0,0 +1,170 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2020-01-14
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+/*
+ * Keeps the most recent images of the state of the simulation - e.g. checkpoint
+ * images - within a maximum span of simulation time and a maximum memory size.
+ *
+ * Images are stored as periodic keyframes, each followed by the deltas of the
+ * images that come after it: a delta is the XOR of an image with the previous one,
+ * which is mostly zeroes as most of the state does not change between two steps,
+ * and both keyframes and deltas have their runs of zero words squeezed out.
+ *
+ * The encoding runs on a thread of its own, hence pushing an image only costs its
+ * capture; when the thread falls behind, new images are refused - and counted as
+ * dropped - rather than queued.
+ *
+ * The memory cap covers the encoded images together with the few raw images in
+ * flight; when exceeded, the oldest keyframe is evicted together with its deltas.
+ */
+class RewindBuffer
+{
+public:
+
+    struct Settings
+    {
+        float Duration; // Simulation time, seconds
+        size_t MaxByteSize;
+        size_t KeyframeInterval; // Images
+
+        Settings(
+            float duration,
+            size_t maxByteSize,
+            size_t keyframeInterval = 64)
+            : Duration(duration)
+            , MaxByteSize(maxByteSize)
+            , KeyframeInterval(keyframeInterval)
+        {}
+    };
+
+    struct Statistics
+    {
+        size_t FrameCount;
+        size_t KeyframeCount;
+        float Duration; // Between the oldest and the newest frame
+        size_t ByteSize; // What counts towards the cap
+        size_t UncompressedByteSize; // Of the frames, had they been kept raw
+        size_t DroppedFrameCount;
+    };
+
+public:
+
+    explicit RewindBuffer(Settings const & settings);
+
+    ~RewindBuffer();
+
+    Settings const & GetSettings() const
+    {
+        return mSettings;
+    }
+
+    /*
+     * Gets a buffer to capture the next image into, recycling the memory of an earlier
+     * image; returns false - and counts a dropped frame - when the encoding thread is
+     * still busy with earlier images.
+     */
+    bool TryAcquireImage(std::vector<std::uint8_t> & image);
+
+    /*
+     * Gives back an acquired image that could not be captured, so that its memory
+     * may be recycled; counts a dropped frame.
+     */
+    void DropImage(std::vector<std::uint8_t> && image);
+
+    /*
+     * Queues the image for encoding; images must be pushed in order of time, and their
+     * sizes must be multiples of 8 bytes.
+     */
+    void Push(
+        float time,
+        std::vector<std::uint8_t> && image);
+
+    /*
+     * Decodes into the specified image the newest frame at or before the specified
+     * time - or the oldest frame, if all are newer - and returns its time; the frames
+     * after it are discarded, as the simulation resumes from it.
+     *
+     * Waits for the encoding of the queued images to complete; returns none if the
+     * buffer is empty.
+     */
+    std::optional<float> Restore(
+        float time,
+        std::vector<std::uint8_t> & image);
+
+    /*
+     * Discards all frames, e.g. when the simulation changes in ways that make
+     * earlier images incompatible.
+     */
+    void Clear();
+
+    Statistics GetStatistics() const;
+
+private:
+
+    struct Frame
+    {
+        float Time;
+        bool IsKeyframe;
+        size_t ImageSize;
+        std::vector<std::uint64_t> EncodedImage;
+    };
+
+    struct PendingImage
+    {
+        float Time;
+        std::vector<std::uint8_t> Image;
+    };
+
+    void RunEncodingThread();
+
+    void WaitForIdle(std::unique_lock<std::mutex> & lock);
+
+    // Assumes the lock is held
+    void Trim();
+
+    // Assumes the lock is held
+    size_t CalculateByteSize() const;
+
+private:
+
+    Settings const mSettings;
+
+    std::deque<Frame> mFrames;
+    size_t mKeyframeCount;
+    size_t mFramesSinceKeyframe;
+    bool mIsKeyframeForced;
+    size_t mEncodedByteSize;
+    size_t mDroppedFrameCount;
+
+    //
+    // Encoding thread
+    //
+
+    std::thread mEncodingThread;
+
+    std::deque<PendingImage> mPendingImages;
+    std::vector<std::vector<std::uint8_t>> mFreeImages;
+
+    // The image that deltas are calculated against; only touched by the encoding
+    // thread, except while the thread is idle
+    std::vector<std::uint8_t> mPreviousImage;
+
+    bool mIsEncoding;
+    bool mIsStopping;
+
+    mutable std::mutex mMutex;
+    std::condition_variable mPendingImageEvent;
+    std::condition_variable mIdleEvent;
+};
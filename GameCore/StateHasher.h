@@ -0,0 +1,68 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2020-01-12
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "Vectors.h"
+
+#include <cstdint>
+#include <cstring>
+
+/*
+ * Digests a sequence of values into a 64-bit hash (FNV-1a), for comparing the state
+ * of two simulations.
+ *
+ * Floats are hashed by their bit patterns, hence two states hash the same only when
+ * they are bit-for-bit identical.
+ */
+class StateHasher
+{
+public:
+
+    StateHasher()
+        : mHash(OffsetBasis)
+    {}
+
+    inline void Add(std::uint64_t value)
+    {
+        for (int b = 0; b < 8; ++b)
+        {
+            mHash ^= (value & 0xffu);
+            mHash *= Prime;
+            value >>= 8;
+        }
+    }
+
+    inline void Add(float value)
+    {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+
+        Add(static_cast<std::uint64_t>(bits));
+    }
+
+    inline void Add(vec2f const & value)
+    {
+        Add(value.x);
+        Add(value.y);
+    }
+
+    inline void Add(bool value)
+    {
+        Add(static_cast<std::uint64_t>(value ? 1 : 0));
+    }
+
+    std::uint64_t GetHash() const
+    {
+        return mHash;
+    }
+
+private:
+
+    static std::uint64_t constexpr OffsetBasis = 0xcbf29ce484222325ull;
+    static std::uint64_t constexpr Prime = 0x100000001b3ull;
+
+    std::uint64_t mHash;
+};
@@ -31,7 +31,13 @@ inline void * aligned_alloc(
     size_t alignment,
     size_t size)
 {
-    return std::aligned_alloc(alignment, size);
+    // Note: with glibc, std::aligned_alloc is this very function, hence we
+    // go via posix_memalign - which wants at least pointer alignment
+    void * ptr = nullptr;
+    if (0 != posix_memalign(&ptr, alignment < sizeof(void *) ? sizeof(void *) : alignment, size))
+        return nullptr;
+
+    return ptr;
 }
 
 inline void aligned_free(void * ptr)
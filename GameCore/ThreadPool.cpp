@@ -0,0 +1,319 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2019-12-31
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "ThreadPool.h"
+
+#include "Log.h"
+#include "TraceRecorder.h"
+
+#include <algorithm>
+#include <cassert>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace /* anonymous */ {
+
+    inline std::uint64_t PackChunks(
+        std::uint32_t begin,
+        std::uint32_t end)
+    {
+        return (static_cast<std::uint64_t>(begin) << 32) | static_cast<std::uint64_t>(end);
+    }
+
+    inline std::uint32_t GetChunksBegin(std::uint64_t chunks)
+    {
+        return static_cast<std::uint32_t>(chunks >> 32);
+    }
+
+    inline std::uint32_t GetChunksEnd(std::uint64_t chunks)
+    {
+        return static_cast<std::uint32_t>(chunks);
+    }
+
+    void PinCurrentThreadToCore(size_t core)
+    {
+#ifdef _WIN32
+        if (0 == ::SetThreadAffinityMask(::GetCurrentThread(), static_cast<DWORD_PTR>(1) << (core % (sizeof(DWORD_PTR) * 8))))
+        {
+            LogMessage("ThreadPool: cannot pin worker to core ", core);
+        }
+#elif defined(__linux__)
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        CPU_SET(static_cast<int>(core % CPU_SETSIZE), &cpuSet);
+        if (0 != pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet))
+        {
+            LogMessage("ThreadPool: cannot pin worker to core ", core);
+        }
+#else
+        LogMessage("ThreadPool: pinning is not supported on this platform (core ", core, ")");
+#endif
+    }
+}
+
+ThreadPool::ThreadPool(
+    size_t workerCount,
+    bool isPinningEnabled)
+    : mParticipants(new ParticipantState[workerCount + 1])
+    , mWorkers()
+    , mJobInvoker(nullptr)
+    , mJobFunction(nullptr)
+    , mJobRange(0, 0)
+    , mJobChunkSize(0)
+    , mJobMutex()
+    , mJobStartedCondition()
+    , mJobCompletedCondition()
+    , mJobSequenceNumber(0)
+    , mRunningWorkerCount(0)
+    , mIsStopping(false)
+    , mLastUtilizationStatisticsTimestamp(std::chrono::steady_clock::now())
+{
+    size_t const coreCount = std::max(std::thread::hardware_concurrency(), 1u);
+
+    for (size_t w = 0; w < workerCount; ++w)
+    {
+        size_t const participantIndex = w + 1;
+
+        mWorkers.emplace_back(
+            [this, participantIndex, isPinningEnabled, coreCount]()
+            {
+                if (isPinningEnabled)
+                {
+                    PinCurrentThreadToCore(participantIndex % coreCount);
+                }
+
+                WorkerThreadLoop(participantIndex);
+            });
+    }
+
+    LogMessage("ThreadPool: started ", workerCount, " workers", isPinningEnabled ? " (pinned)" : "");
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mJobMutex);
+
+        mIsStopping = true;
+    }
+
+    mJobStartedCondition.notify_all();
+
+    for (auto & worker : mWorkers)
+    {
+        worker.join();
+    }
+}
+
+size_t ThreadPool::GetDefaultWorkerCount()
+{
+    unsigned int const coreCount = std::thread::hardware_concurrency();
+
+    return coreCount > 1 ? static_cast<size_t>(coreCount - 1) : 0;
+}
+
+std::vector<float> ThreadPool::GetUtilizationStatistics()
+{
+    auto const now = std::chrono::steady_clock::now();
+    auto const elapsedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(now - mLastUtilizationStatisticsTimestamp).count();
+    mLastUtilizationStatisticsTimestamp = now;
+
+    std::vector<float> utilizations;
+    for (size_t p = 0; p < GetParallelism(); ++p)
+    {
+        auto const busyNs = mParticipants[p].BusyNanoseconds.exchange(0, std::memory_order_relaxed);
+
+        utilizations.push_back(
+            elapsedNs > 0
+            ? std::min(static_cast<float>(busyNs) / static_cast<float>(elapsedNs), 1.0f)
+            : 0.0f);
+    }
+
+    return utilizations;
+}
+
+void ThreadPool::RunJob(
+    ElementIndexRange const & range,
+    ElementCount chunkSize,
+    Invoker invoker,
+    void const * function)
+{
+    //
+    // Deal out chunks in contiguous runs, one run per participant
+    //
+
+    std::uint32_t const chunkCount = (range.GetSize() + chunkSize - 1) / chunkSize;
+    size_t const participantCount = GetParallelism();
+
+    for (size_t p = 0; p < participantCount; ++p)
+    {
+        mParticipants[p].Chunks.store(
+            PackChunks(
+                static_cast<std::uint32_t>(static_cast<size_t>(chunkCount) * p / participantCount),
+                static_cast<std::uint32_t>(static_cast<size_t>(chunkCount) * (p + 1) / participantCount)),
+            std::memory_order_relaxed);
+    }
+
+    //
+    // Start workers
+    //
+
+    {
+        std::lock_guard<std::mutex> lock(mJobMutex);
+
+        mJobInvoker = invoker;
+        mJobFunction = function;
+        mJobRange = range;
+        mJobChunkSize = chunkSize;
+
+        ++mJobSequenceNumber;
+        mRunningWorkerCount = mWorkers.size();
+    }
+
+    mJobStartedCondition.notify_all();
+
+    //
+    // Participate
+    //
+
+    RunChunks(0);
+
+    //
+    // Wait for workers to complete
+    //
+
+    std::unique_lock<std::mutex> lock(mJobMutex);
+
+    mJobCompletedCondition.wait(
+        lock,
+        [this]()
+        {
+            return mRunningWorkerCount == 0;
+        });
+}
+
+void ThreadPool::WorkerThreadLoop(size_t participantIndex)
+{
+    TraceRecorder::GetInstance().SetCurrentThreadName("Worker " + std::to_string(participantIndex));
+
+    std::uint64_t lastJobSequenceNumber = 0;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mJobMutex);
+
+            mJobStartedCondition.wait(
+                lock,
+                [this, lastJobSequenceNumber]()
+                {
+                    return mIsStopping || mJobSequenceNumber != lastJobSequenceNumber;
+                });
+
+            if (mIsStopping)
+                return;
+
+            lastJobSequenceNumber = mJobSequenceNumber;
+        }
+
+        RunChunks(participantIndex);
+
+        bool isLastWorker;
+
+        {
+            std::lock_guard<std::mutex> lock(mJobMutex);
+
+            assert(mRunningWorkerCount > 0);
+            --mRunningWorkerCount;
+            isLastWorker = (mRunningWorkerCount == 0);
+        }
+
+        if (isLastWorker)
+        {
+            mJobCompletedCondition.notify_one();
+        }
+    }
+}
+
+void ThreadPool::RunChunks(size_t participantIndex)
+{
+    auto const startTime = std::chrono::steady_clock::now();
+
+    std::uint32_t chunkIndex;
+    while (TryPopOwnChunk(participantIndex, chunkIndex)
+        || TryStealChunk(participantIndex, chunkIndex))
+    {
+        ElementIndex const start = mJobRange.Start + chunkIndex * mJobChunkSize;
+        ElementIndex const end = std::min(start + mJobChunkSize, mJobRange.End);
+
+        mJobInvoker(mJobFunction, start, end);
+    }
+
+    auto const endTime = std::chrono::steady_clock::now();
+
+    mParticipants[participantIndex].BusyNanoseconds.fetch_add(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime).count(),
+        std::memory_order_relaxed);
+
+    TraceRecorder::GetInstance().RecordEvent("ParallelFor", startTime, endTime);
+}
+
+bool ThreadPool::TryPopOwnChunk(
+    size_t participantIndex,
+    std::uint32_t & chunkIndex)
+{
+    auto & chunks = mParticipants[participantIndex].Chunks;
+
+    std::uint64_t current = chunks.load(std::memory_order_relaxed);
+    while (GetChunksBegin(current) < GetChunksEnd(current))
+    {
+        // Owner takes from the front
+        if (chunks.compare_exchange_weak(
+            current,
+            PackChunks(GetChunksBegin(current) + 1, GetChunksEnd(current)),
+            std::memory_order_acq_rel))
+        {
+            chunkIndex = GetChunksBegin(current);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool ThreadPool::TryStealChunk(
+    size_t participantIndex,
+    std::uint32_t & chunkIndex)
+{
+    size_t const participantCount = GetParallelism();
+
+    for (size_t i = 1; i < participantCount; ++i)
+    {
+        auto & chunks = mParticipants[(participantIndex + i) % participantCount].Chunks;
+
+        std::uint64_t current = chunks.load(std::memory_order_relaxed);
+        while (GetChunksBegin(current) < GetChunksEnd(current))
+        {
+            // Thieves take from the back
+            if (chunks.compare_exchange_weak(
+                current,
+                PackChunks(GetChunksBegin(current), GetChunksEnd(current) - 1),
+                std::memory_order_acq_rel))
+            {
+                chunkIndex = GetChunksEnd(current) - 1;
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,220 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2019-12-31
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "GameTypes.h"
+#include "SysSpecifics.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/*
+ * A pool of worker threads for running per-element loops in parallel.
+ *
+ * A ParallelFor splits its range into chunks, and deals the chunks out, in contiguous
+ * runs, to the calling thread and to each worker; a thread that runs out of chunks
+ * steals them from the end of the runs of the others. Chunk boundaries are multiples
+ * of the vectorization word size, so that vectorized loops never straddle threads.
+ *
+ * Ranges that fit into a single chunk - and all ranges, when there are no workers - are
+ * run inline on the calling thread, without any synchronization.
+ *
+ * A ParallelReduce reduces each chunk separately and then combines the partial results
+ * in chunk order; since chunks depend on the range and on the grain only, its result is
+ * the same - bit for bit, even for floating-point sums - regardless of the number of
+ * workers and of which thread ran which chunk.
+ *
+ * Not re-entrant: a ParallelFor may only be invoked by one thread at a time, and not
+ * from within another ParallelFor.
+ */
+class ThreadPool
+{
+public:
+
+    /*
+     * Creates a pool with the specified number of workers, in addition to the calling
+     * thread; when pinning is enabled, each worker is pinned to its own core, with the
+     * calling thread left unpinned.
+     */
+    ThreadPool(
+        size_t workerCount,
+        bool isPinningEnabled);
+
+    ~ThreadPool();
+
+    /*
+     * The number of workers that leaves one core for the calling thread.
+     */
+    static size_t GetDefaultWorkerCount();
+
+    /*
+     * The number of threads taking part in each ParallelFor, including the calling thread.
+     */
+    size_t GetParallelism() const
+    {
+        return mWorkers.size() + 1;
+    }
+
+    /*
+     * Invokes function(start, end) on disjoint sub-ranges covering the whole range, returning
+     * when all of them have completed.
+     *
+     * The grain is the minimum size of each sub-range, and is rounded up to a multiple of the
+     * vectorization word size.
+     */
+    template<typename TFunction>
+    void ParallelFor(
+        ElementIndexRange const & range,
+        ElementCount grain,
+        TFunction && function)
+    {
+        ElementCount const chunkSize = static_cast<ElementCount>(make_aligned_element_count(grain > 0 ? grain : 1));
+
+        if (mWorkers.empty() || range.GetSize() <= chunkSize)
+        {
+            // Run inline
+            function(range.Start, range.End);
+            return;
+        }
+
+        RunJob(
+            range,
+            chunkSize,
+            &InvokeFunction<std::remove_reference_t<TFunction>>,
+            static_cast<void const *>(&function));
+    }
+
+    /*
+     * Returns combine(...combine(combine(identity, r0), r1)..., rN), where ri is the result
+     * of chunkFunction(start, end) on the i-th chunk of the range.
+     *
+     * The grain is the size of each chunk, and is rounded up to a multiple of the
+     * vectorization word size.
+     */
+    template<typename T, typename TChunkFunction, typename TCombineFunction>
+    T ParallelReduce(
+        ElementIndexRange const & range,
+        ElementCount grain,
+        T identity,
+        TChunkFunction && chunkFunction,
+        TCombineFunction && combineFunction)
+    {
+        ElementCount const chunkSize = static_cast<ElementCount>(make_aligned_element_count(grain > 0 ? grain : 1));
+        size_t const chunkCount = (range.GetSize() + chunkSize - 1) / chunkSize;
+
+        std::vector<T> partials(chunkCount, identity);
+
+        ParallelFor(
+            range,
+            grain,
+            [&](ElementIndex start, ElementIndex end)
+            {
+                // We might be given more than one chunk at a time, e.g. when running inline
+                for (ElementIndex chunkStart = start; chunkStart < end; chunkStart += chunkSize)
+                {
+                    partials[(chunkStart - range.Start) / chunkSize] = chunkFunction(
+                        chunkStart,
+                        std::min(chunkStart + chunkSize, end));
+                }
+            });
+
+        T result = identity;
+        for (auto const & partial : partials)
+        {
+            result = combineFunction(result, partial);
+        }
+
+        return result;
+    }
+
+    /*
+     * Returns, for the calling thread (first) and for each worker, the fraction of wall-clock
+     * time spent running chunks since the previous invocation of this method.
+     */
+    std::vector<float> GetUtilizationStatistics();
+
+private:
+
+    using Invoker = void(*)(void const * function, ElementIndex start, ElementIndex end);
+
+    template<typename TFunction>
+    static void InvokeFunction(
+        void const * function,
+        ElementIndex start,
+        ElementIndex end)
+    {
+        (*static_cast<TFunction *>(const_cast<void *>(function)))(start, end);
+    }
+
+    void RunJob(
+        ElementIndexRange const & range,
+        ElementCount chunkSize,
+        Invoker invoker,
+        void const * function);
+
+    void WorkerThreadLoop(size_t participantIndex);
+
+    void RunChunks(size_t participantIndex);
+
+    bool TryPopOwnChunk(
+        size_t participantIndex,
+        std::uint32_t & chunkIndex);
+
+    bool TryStealChunk(
+        size_t participantIndex,
+        std::uint32_t & chunkIndex);
+
+private:
+
+    //
+    // The chunks of each participant, packed as [begin (high 32 bits), end (low 32 bits)),
+    // so that owner and thieves may race on them with a single compare-and-swap
+    //
+
+    struct alignas(64) ParticipantState
+    {
+        std::atomic<std::uint64_t> Chunks;
+        std::atomic<std::int64_t> BusyNanoseconds;
+
+        ParticipantState()
+            : Chunks(0)
+            , BusyNanoseconds(0)
+        {}
+    };
+
+    std::unique_ptr<ParticipantState[]> mParticipants; // Calling thread first
+    std::vector<std::thread> mWorkers;
+
+    //
+    // Current job
+    //
+
+    Invoker mJobInvoker;
+    void const * mJobFunction;
+    ElementIndexRange mJobRange;
+    ElementCount mJobChunkSize;
+
+    std::mutex mJobMutex;
+    std::condition_variable mJobStartedCondition;
+    std::condition_variable mJobCompletedCondition;
+    std::uint64_t mJobSequenceNumber;
+    size_t mRunningWorkerCount;
+    bool mIsStopping;
+
+    //
+    // Statistics
+    //
+
+    std::chrono::steady_clock::time_point mLastUtilizationStatisticsTimestamp;
+};
@@ -0,0 +1,120 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2020-01-07
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "TraceRecorder.h"
+
+#include "GameException.h"
+
+#include <fstream>
+#include <iomanip>
+
+namespace /* anonymous */ {
+
+    void WriteJsonString(
+        std::ostream & os,
+        std::string const & str)
+    {
+        os << '"';
+
+        for (char c : str)
+        {
+            if (c == '"' || c == '\\')
+                os << '\\' << c;
+            else if (static_cast<unsigned char>(c) < 0x20)
+                os << ' ';
+            else
+                os << c;
+        }
+
+        os << '"';
+    }
+}
+
+TraceRecorder::TraceRecorder()
+    : mIsEnabled(false)
+    , mEvents(new TraceEvent[Capacity])
+    , mNextEventIndex(0)
+    , mNextThreadIndex(1)
+    , mThreadNames()
+    , mThreadNamesMutex()
+    , mOriginTimestamp(std::chrono::steady_clock::now())
+{
+}
+
+void TraceRecorder::SetCurrentThreadName(std::string const & name)
+{
+    std::uint32_t const threadIndex = GetCurrentThreadIndex();
+
+    std::lock_guard<std::mutex> lock(mThreadNamesMutex);
+
+    mThreadNames[threadIndex] = name;
+}
+
+void TraceRecorder::WriteChromeTrace(std::filesystem::path const & filePath) const
+{
+    std::ofstream file(filePath, std::ios_base::out | std::ios_base::trunc);
+    if (!file.is_open())
+    {
+        throw GameException("Cannot open file \"" + filePath.string() + "\" for writing");
+    }
+
+    file << std::fixed << std::setprecision(3);
+
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    bool isFirst = true;
+
+    // Thread names
+    {
+        std::lock_guard<std::mutex> lock(mThreadNamesMutex);
+
+        for (auto const & threadName : mThreadNames)
+        {
+            file << (isFirst ? "\n" : ",\n")
+                << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << threadName.first
+                << ",\"args\":{\"name\":";
+            WriteJsonString(file, threadName.second);
+            file << "}}";
+
+            isFirst = false;
+        }
+    }
+
+    // Events, oldest first
+    size_t const nextEventIndex = mNextEventIndex.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < Capacity; ++i)
+    {
+        TraceEvent const & traceEvent = mEvents[(nextEventIndex + i) & (Capacity - 1)];
+        if (nullptr == traceEvent.Name)
+            continue;
+
+        file << (isFirst ? "\n" : ",\n")
+            << "{\"name\":";
+        WriteJsonString(file, traceEvent.Name);
+        file << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << traceEvent.ThreadIndex
+            << ",\"ts\":" << std::chrono::duration<double, std::micro>(traceEvent.StartTimestamp - mOriginTimestamp).count()
+            << ",\"dur\":" << std::chrono::duration<double, std::micro>(traceEvent.EndTimestamp - traceEvent.StartTimestamp).count()
+            << "}";
+
+        isFirst = false;
+    }
+
+    file << "\n]}\n";
+
+    if (!file)
+    {
+        throw GameException("Cannot write to file \"" + filePath.string() + "\"");
+    }
+}
+
+void TraceRecorder::Clear()
+{
+    for (size_t i = 0; i < Capacity; ++i)
+    {
+        mEvents[i].Name = nullptr;
+    }
+
+    mNextEventIndex.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,166 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2020-01-07
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+/*
+ * Records the begin and end of the phases of the frames, on any thread, into a
+ * bounded ring buffer; the most recent events may be written at any moment as a
+ * Chrome Trace Event file, to be viewed with chrome://tracing or Perfetto.
+ *
+ * Recording an event takes a single atomic increment; once the buffer is full,
+ * new events overwrite the oldest ones. Recording is disabled until enabled.
+ *
+ * Singleton.
+ */
+class TraceRecorder
+{
+public:
+
+    static size_t constexpr Capacity = 1 << 16; // Power of two
+
+    static TraceRecorder & GetInstance()
+    {
+        static TraceRecorder * instance = new TraceRecorder();
+
+        return *instance;
+    }
+
+    bool IsEnabled() const
+    {
+        return mIsEnabled.load(std::memory_order_relaxed);
+    }
+
+    void SetEnabled(bool isEnabled)
+    {
+        mIsEnabled.store(isEnabled, std::memory_order_relaxed);
+    }
+
+    /*
+     * Records an event that began and ended at the specified times on the calling thread.
+     *
+     * The name must outlive the recorder, i.e. it should be a string literal.
+     */
+    inline void RecordEvent(
+        char const * name,
+        std::chrono::steady_clock::time_point startTimestamp,
+        std::chrono::steady_clock::time_point endTimestamp)
+    {
+        if (!IsEnabled())
+            return;
+
+        size_t const eventIndex = mNextEventIndex.fetch_add(1, std::memory_order_relaxed) & (Capacity - 1);
+
+        TraceEvent & traceEvent = mEvents[eventIndex];
+        traceEvent.Name = name;
+        traceEvent.StartTimestamp = startTimestamp;
+        traceEvent.EndTimestamp = endTimestamp;
+        traceEvent.ThreadIndex = GetCurrentThreadIndex();
+    }
+
+    /*
+     * Names the calling thread in the traces.
+     */
+    void SetCurrentThreadName(std::string const & name);
+
+    /*
+     * Writes the recorded events, oldest first, as a Chrome Trace Event file.
+     *
+     * Events are not synchronized with their recording: to be invoked while no other
+     * thread is recording, e.g. between frames.
+     */
+    void WriteChromeTrace(std::filesystem::path const & filePath) const;
+
+    /*
+     * Forgets all the events recorded so far.
+     */
+    void Clear();
+
+private:
+
+    TraceRecorder();
+
+    struct TraceEvent
+    {
+        char const * Name; // Null for unused slots
+        std::chrono::steady_clock::time_point StartTimestamp;
+        std::chrono::steady_clock::time_point EndTimestamp;
+        std::uint32_t ThreadIndex;
+
+        TraceEvent()
+            : Name(nullptr)
+            , StartTimestamp()
+            , EndTimestamp()
+            , ThreadIndex(0)
+        {}
+    };
+
+    std::uint32_t GetCurrentThreadIndex()
+    {
+        thread_local std::uint32_t threadIndex = mNextThreadIndex.fetch_add(1, std::memory_order_relaxed);
+
+        return threadIndex;
+    }
+
+private:
+
+    std::atomic<bool> mIsEnabled;
+
+    std::unique_ptr<TraceEvent[]> mEvents;
+    std::atomic<size_t> mNextEventIndex;
+
+    std::atomic<std::uint32_t> mNextThreadIndex;
+    std::map<std::uint32_t, std::string> mThreadNames;
+    mutable std::mutex mThreadNamesMutex;
+
+    std::chrono::steady_clock::time_point const mOriginTimestamp;
+};
+
+/*
+ * Records an event spanning its own lifetime.
+ */
+class ScopedTraceEvent
+{
+public:
+
+    explicit ScopedTraceEvent(char const * name)
+        : mName(name)
+        , mStartTimestamp(std::chrono::steady_clock::now())
+    {}
+
+    ~ScopedTraceEvent()
+    {
+        TraceRecorder::GetInstance().RecordEvent(
+            mName,
+            mStartTimestamp,
+            std::chrono::steady_clock::now());
+    }
+
+    ScopedTraceEvent(ScopedTraceEvent const &) = delete;
+    ScopedTraceEvent & operator=(ScopedTraceEvent const &) = delete;
+
+private:
+
+    char const * const mName;
+    std::chrono::steady_clock::time_point const mStartTimestamp;
+};
+
+#define TRACE_SCOPE_CONCAT_INNER(a, b) a##b
+#define TRACE_SCOPE_CONCAT(a, b) TRACE_SCOPE_CONCAT_INNER(a, b)
+
+/*
+ * Traces the rest of the enclosing scope.
+ */
+#define TRACE_SCOPE(name) \
+    ScopedTraceEvent const TRACE_SCOPE_CONCAT(_traceScopeEvent, __LINE__)(name)
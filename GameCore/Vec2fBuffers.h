@@ -0,0 +1,225 @@
+/***************************************************************************************
+* Original Author:      Gabriele Giuseppini
+* Created:              2019-12-30
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "Buffer.h"
+#include "SysSpecifics.h"
+#include "Vectors.h"
+
+#include <cassert>
+#include <cstring>
+
+/*
+ * Two interchangeable layouts for fixed-size buffers of vec2f's.
+ *
+ * Both expose the same interface, so that kernels written against it compile
+ * with either layout:
+ *  - Element access via get(), set(), add(), x(), and y();
+ *  - Raw access via "component arrays": float arrays that together hold all the
+ *    components of all the elements, in an order that is only meaningful for
+ *    kernels that treat x and y the same way (e.g. integration). There is one
+ *    component array in the interleaved layout and two in the split layout.
+ */
+
+/*
+ * x and y are interleaved in a single array: x0 y0 x1 y1 ...
+ */
+class InterleavedVec2fBuffer
+{
+public:
+
+    static constexpr size_t ComponentArrayCount = 1;
+
+    InterleavedVec2fBuffer(
+        size_t size,
+        size_t fillStart,
+        vec2f const & fillValue)
+        : mBuffer(size, fillStart, fillValue)
+        , mSize(size)
+    {}
+
+    InterleavedVec2fBuffer(InterleavedVec2fBuffer && other) = default;
+
+    size_t GetByteSize() const
+    {
+        return mBuffer.GetByteSize();
+    }
+
+    void emplace_back(vec2f const & value)
+    {
+        mBuffer.emplace_back(value);
+    }
+
+    inline vec2f get(size_t index) const noexcept
+    {
+        return mBuffer[index];
+    }
+
+    inline void set(
+        size_t index,
+        vec2f const & value) noexcept
+    {
+        mBuffer[index] = value;
+    }
+
+    inline void add(
+        size_t index,
+        vec2f const & value) noexcept
+    {
+        mBuffer[index] += value;
+    }
+
+    inline float & x(size_t index) noexcept
+    {
+        return mBuffer[index].x;
+    }
+
+    inline float & y(size_t index) noexcept
+    {
+        return mBuffer[index].y;
+    }
+
+    inline float * GetComponentArray(size_t componentArrayIndex) noexcept
+    {
+        assert(componentArrayIndex < ComponentArrayCount);
+        (void)componentArrayIndex;
+
+        return reinterpret_cast<float *>(mBuffer.data());
+    }
+
+    inline float const * GetComponentArray(size_t componentArrayIndex) const noexcept
+    {
+        assert(componentArrayIndex < ComponentArrayCount);
+        (void)componentArrayIndex;
+
+        return reinterpret_cast<float const *>(mBuffer.data());
+    }
+
+    inline size_t GetComponentArrayLength() const noexcept
+    {
+        return mSize * 2;
+    }
+
+    /*
+     * Copies all elements, interleaved, to the specified array.
+     */
+    void copy_to(vec2f * restrict destination) const
+    {
+        std::memcpy(destination, mBuffer.data(), mSize * sizeof(vec2f));
+    }
+
+    inline vec2f const * data() const
+    {
+        return mBuffer.data();
+    }
+
+private:
+
+    Buffer<vec2f> mBuffer;
+    size_t const mSize;
+};
+
+/*
+ * x and y are in two separate, aligned arrays: x0 x1 ... and y0 y1 ...
+ */
+class SplitVec2fBuffer
+{
+public:
+
+    static constexpr size_t ComponentArrayCount = 2;
+
+    SplitVec2fBuffer(
+        size_t size,
+        size_t fillStart,
+        vec2f const & fillValue)
+        : mXBuffer(size, fillStart, fillValue.x)
+        , mYBuffer(size, fillStart, fillValue.y)
+        , mSize(size)
+    {}
+
+    SplitVec2fBuffer(SplitVec2fBuffer && other) = default;
+
+    size_t GetByteSize() const
+    {
+        return mXBuffer.GetByteSize() + mYBuffer.GetByteSize();
+    }
+
+    void emplace_back(vec2f const & value)
+    {
+        mXBuffer.emplace_back(value.x);
+        mYBuffer.emplace_back(value.y);
+    }
+
+    inline vec2f get(size_t index) const noexcept
+    {
+        return vec2f(mXBuffer[index], mYBuffer[index]);
+    }
+
+    inline void set(
+        size_t index,
+        vec2f const & value) noexcept
+    {
+        mXBuffer[index] = value.x;
+        mYBuffer[index] = value.y;
+    }
+
+    inline void add(
+        size_t index,
+        vec2f const & value) noexcept
+    {
+        mXBuffer[index] += value.x;
+        mYBuffer[index] += value.y;
+    }
+
+    inline float & x(size_t index) noexcept
+    {
+        return mXBuffer[index];
+    }
+
+    inline float & y(size_t index) noexcept
+    {
+        return mYBuffer[index];
+    }
+
+    inline float * GetComponentArray(size_t componentArrayIndex) noexcept
+    {
+        assert(componentArrayIndex < ComponentArrayCount);
+
+        return componentArrayIndex == 0 ? mXBuffer.data() : mYBuffer.data();
+    }
+
+    inline float const * GetComponentArray(size_t componentArrayIndex) const noexcept
+    {
+        assert(componentArrayIndex < ComponentArrayCount);
+
+        return componentArrayIndex == 0 ? mXBuffer.data() : mYBuffer.data();
+    }
+
+    inline size_t GetComponentArrayLength() const noexcept
+    {
+        return mSize;
+    }
+
+    /*
+     * Copies all elements, interleaved, to the specified array.
+     */
+    void copy_to(vec2f * restrict destination) const
+    {
+        float const * restrict const xBuffer = mXBuffer.data();
+        float const * restrict const yBuffer = mYBuffer.data();
+
+        for (size_t i = 0; i < mSize; ++i)
+        {
+            destination[i] = vec2f(xBuffer[i], yBuffer[i]);
+        }
+    }
+
+private:
+
+    Buffer<float> mXBuffer;
+    Buffer<float> mYBuffer;
+    size_t const mSize;
+};
@@ -6,6 +6,7 @@
 #include "GameOpenGL.h"
 
 #include <GameCore/GameMath.h>
+#include <GameCore/ImageTools.h>
 
 #include <algorithm>
 #include <memory>
@@ -176,6 +177,25 @@ void GameOpenGL::UploadTexture(RgbaImageData texture)
 }
 
 void GameOpenGL::UploadMipmappedTexture(RgbaImageData baseTexture)
+{
+    UploadMipmappedTexture(
+        baseTexture,
+        ImageTools::MakeMipmaps(baseTexture));
+}
+
+void GameOpenGL::UploadMipmappedPowerOfTwoTexture(
+    RgbaImageData baseTexture,
+    int maxDimension)
+{
+    UploadMipmappedTexture(
+        baseTexture,
+        ImageTools::MakePowerOfTwoMipmaps(baseTexture, maxDimension));
+}
+
+void GameOpenGL::UploadMipmappedTexture(
+    RgbaImageData const & baseTexture,
+    std::vector<RgbaImageData>::const_iterator mipmapsBegin,
+    std::vector<RgbaImageData>::const_iterator mipmapsEnd)
 {
     //
     // Upload base image
@@ -190,153 +210,25 @@ void GameOpenGL::UploadMipmappedTexture(RgbaImageData baseTexture)
 
 
     //
-    // Create minified textures
+    // Upload minified textures
     //
 
-    ImageSize readImageSize(baseTexture.Size);
-
-    std::unique_ptr<rgbaColor[]> readBuffer(std::move(baseTexture.Data));
-    std::unique_ptr<rgbaColor[]> writeBuffer = std::make_unique<rgbaColor[]>(
-        std::max(1, (readImageSize.Width / 2) * (readImageSize.Height / 2)));
-
-    for (GLint textureLevel = 1; ; ++textureLevel)
+    GLint textureLevel = 0;
+    for (auto mipmapIt = mipmapsBegin; mipmapIt != mipmapsEnd; ++mipmapIt)
     {
-        if (readImageSize.Width == 1 && readImageSize.Height == 1)
-        {
-            // We're done!
-            break;
-        }
-
-        // Calculate dimensions of new write buffer
-        int width = std::max(1, readImageSize.Width / 2);
-        int height = std::max(1, readImageSize.Height / 2);
+        RgbaImageData const & mipmap = *mipmapIt;
 
-        // Create new buffer
-        rgbaColor const * rp = readBuffer.get();
-        rgbaColor * wp = writeBuffer.get();
-        for (int h = 0; h < height; ++h)
-        {
-            for (int w = 0; w < width; ++w)
-            {
-                //
-                // Apply box filter
-                //
-
-                int wIndex = ((h * width) + w);
-
-                int rIndex = (((h * 2) * readImageSize.Width) + (w * 2));
-                int rIndexNextLine = ((((h * 2) + 1) * readImageSize.Width) + (w * 2));
-
-                rgbaColorAccumulation sum(rp[rIndex]);
-
-                if (readImageSize.Width > 1)
-                    sum += rp[rIndex + 1];
-
-                if (readImageSize.Height > 1)
-                {
-                    sum += rp[rIndexNextLine];
-
-                    if (readImageSize.Width > 1)
-                        sum += rp[rIndexNextLine + 1];
-                }
-
-                wp[wIndex] = sum.toRgbaColor();
-            }
-        }
-
-        // Upload write buffer
-        glTexImage2D(GL_TEXTURE_2D, textureLevel, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, writeBuffer.get());
+        ++textureLevel;
+        glTexImage2D(GL_TEXTURE_2D, textureLevel, GL_RGBA, mipmap.Size.Width, mipmap.Size.Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, mipmap.Data.get());
         glError = glGetError();
         if (GL_NO_ERROR != glError)
         {
             throw GameException("Error uploading minified texture onto GPU: " + std::to_string(glError));
         }
-
-        // Swap buffers
-        readImageSize = ImageSize(width, height);
-        readBuffer.swap(writeBuffer);
-    }
-}
-
-void GameOpenGL::UploadMipmappedPowerOfTwoTexture(
-    RgbaImageData baseTexture,
-    int maxDimension)
-{
-    assert(baseTexture.Size.Width == CeilPowerOfTwo(baseTexture.Size.Width));
-    assert(baseTexture.Size.Height == CeilPowerOfTwo(baseTexture.Size.Height));
-
-
-    //
-    // Upload base image
-    //
-
-    glTexImage2D(
-        GL_TEXTURE_2D,
-        0,
-        GL_RGBA,
-        baseTexture.Size.Width,
-        baseTexture.Size.Height,
-        0,
-        GL_RGBA,
-        GL_UNSIGNED_BYTE,
-        baseTexture.Data.get());
-
-    CheckOpenGLError();
-
-
-    //
-    // Create minified textures
-    //
-
-    std::unique_ptr<rgbaColor const[]> readBuffer(std::move(baseTexture.Data));
-    std::unique_ptr<rgbaColor[]> writeBuffer;
-
-    GLint lastUploadedTextureLevel = 0;
-    for (int divisor = 2; maxDimension / divisor >= 1; divisor *= 2)
-    {
-        // Calculate dimensions of new write buffer
-        int newWidth = std::max(1, baseTexture.Size.Width / divisor);
-        int newHeight = std::max(1, baseTexture.Size.Height / divisor);
-
-        // Allocate new write buffer
-        writeBuffer.reset(new rgbaColor[newWidth * newHeight]);
-
-        // Populate write buffer
-        rgbaColor const * rp = readBuffer.get();
-        rgbaColor * wp = writeBuffer.get();
-        for (int h = 0; h < newHeight; ++h)
-        {
-            size_t frameIndexInReadBuffer = (h * 2) * (newWidth * 2);
-            size_t frameIndexInWriteBuffer = (h) * (newWidth);
-
-            for (int w = 0; w < newWidth; ++w)
-            {
-                //
-                // Calculate and store average of the four neighboring pixels whose bottom-left corner is at (w*2, h*2)
-                //
-
-                rgbaColorAccumulation sum;
-
-                sum += rp[frameIndexInReadBuffer + w * 2];
-                sum += rp[frameIndexInReadBuffer + w * 2 + 1];
-                sum += rp[frameIndexInReadBuffer + newWidth * 2 + w * 2];
-                sum += rp[frameIndexInReadBuffer + newWidth * 2 + w * 2 + 1];
-
-                wp[frameIndexInWriteBuffer + w] = sum.toRgbaColor();
-            }
-        }
-
-        // Upload write buffer
-        ++lastUploadedTextureLevel;
-        glTexImage2D(GL_TEXTURE_2D, lastUploadedTextureLevel, GL_RGBA, newWidth, newHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, writeBuffer.get());
-        CheckOpenGLError();
-
-        // Swap buffer
-        readBuffer = std::move(writeBuffer);
     }
 
     // Set max mipmap level
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, lastUploadedTextureLevel);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, textureLevel);
     CheckOpenGLError();
 }
 
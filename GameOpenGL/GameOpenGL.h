@@ -14,6 +14,7 @@
 #include <cassert>
 #include <cstdio>
 #include <string>
+#include <vector>
 
 /////////////////////////////////////////////////////////////////////////////////////////
 // Types
@@ -212,6 +213,24 @@ public:
         RgbaImageData baseTexture,
         int maxDimension);
 
+    /*
+     * Uploads a texture together with its pre-built mipmaps (levels 1 and beyond).
+     */
+    static void UploadMipmappedTexture(
+        RgbaImageData const & baseTexture,
+        std::vector<RgbaImageData> const & mipmaps)
+    {
+        UploadMipmappedTexture(
+            baseTexture,
+            mipmaps.cbegin(),
+            mipmaps.cend());
+    }
+
+    static void UploadMipmappedTexture(
+        RgbaImageData const & baseTexture,
+        std::vector<RgbaImageData>::const_iterator mipmapsBegin,
+        std::vector<RgbaImageData>::const_iterator mipmapsEnd);
+
     static void Flush();
 };
 
@@ -0,0 +1,199 @@
+#include <BenchmarkCompare/BenchmarkComparer.h>
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace /* anonymous */ {
+
+    BenchmarkComparer::Comparison const & Find(
+        std::vector<BenchmarkComparer::Comparison> const & comparisons,
+        std::string const & name)
+    {
+        auto const it = std::find_if(
+            comparisons.cbegin(),
+            comparisons.cend(),
+            [&name](BenchmarkComparer::Comparison const & comparison)
+            {
+                return comparison.Name == name;
+            });
+
+        EXPECT_NE(it, comparisons.cend());
+        return *it;
+    }
+}
+
+TEST(BenchmarkComparerTests, Median_Odd)
+{
+    EXPECT_EQ(3.0, BenchmarkComparer::CalculateMedian({ 5.0, 1.0, 3.0 }));
+    EXPECT_EQ(7.0, BenchmarkComparer::CalculateMedian({ 7.0 }));
+}
+
+TEST(BenchmarkComparerTests, Median_Even)
+{
+    EXPECT_EQ(2.5, BenchmarkComparer::CalculateMedian({ 4.0, 1.0, 3.0, 2.0 }));
+    EXPECT_EQ(5.0, BenchmarkComparer::CalculateMedian({ 6.0, 4.0 }));
+}
+
+TEST(BenchmarkComparerTests, Median_Empty)
+{
+    EXPECT_EQ(0.0, BenchmarkComparer::CalculateMedian({}));
+}
+
+TEST(BenchmarkComparerTests, MedianAbsoluteDeviation)
+{
+    // Median 2; deviations 1, 1, 0, 0, 2, 4, 7 -> median 1
+    EXPECT_EQ(1.0, BenchmarkComparer::CalculateMedianAbsoluteDeviation({ 1.0, 1.0, 2.0, 2.0, 4.0, 6.0, 9.0 }));
+
+    // Outliers do not move it
+    EXPECT_EQ(1.0, BenchmarkComparer::CalculateMedianAbsoluteDeviation({ 1.0, 1.0, 2.0, 2.0, 4.0, 6.0, 900.0 }));
+
+    EXPECT_EQ(0.0, BenchmarkComparer::CalculateMedianAbsoluteDeviation({ 5.0, 5.0, 5.0 }));
+}
+
+TEST(BenchmarkComparerTests, Compare_Verdicts)
+{
+    BenchmarkComparer::BenchmarkSamples const baseline = {
+        { "Regressed", { 100.0, 100.0, 100.0 } },
+        { "Improved", { 100.0, 100.0, 100.0 } },
+        { "Unchanged", { 100.0, 100.0, 100.0 } } };
+
+    BenchmarkComparer::BenchmarkSamples const current = {
+        { "Regressed", { 120.0, 120.0, 120.0 } },
+        { "Improved", { 80.0, 80.0, 80.0 } },
+        { "Unchanged", { 104.0, 104.0, 104.0 } } };
+
+    auto const comparisons = BenchmarkComparer::Compare(baseline, current, 0.05, 3.0);
+
+    ASSERT_EQ(3u, comparisons.size());
+
+    auto const & regressed = Find(comparisons, "Regressed");
+    EXPECT_EQ(BenchmarkComparer::Verdict::Regressed, regressed.Result);
+    EXPECT_EQ(100.0, regressed.BaselineMedian);
+    EXPECT_EQ(120.0, regressed.CurrentMedian);
+    EXPECT_NEAR(0.2, regressed.RelativeChange, 0.0001);
+    EXPECT_EQ(0.05, regressed.Threshold);
+    EXPECT_EQ(3u, regressed.BaselineSampleCount);
+    EXPECT_EQ(3u, regressed.CurrentSampleCount);
+
+    EXPECT_EQ(BenchmarkComparer::Verdict::Improved, Find(comparisons, "Improved").Result);
+    EXPECT_EQ(BenchmarkComparer::Verdict::Unchanged, Find(comparisons, "Unchanged").Result);
+
+    EXPECT_FALSE(BenchmarkComparer::IsPass(comparisons, false));
+    EXPECT_FALSE(BenchmarkComparer::IsPass(comparisons, true));
+}
+
+TEST(BenchmarkComparerTests, Compare_NoiseRaisesThreshold)
+{
+    // MAD of 10 at a median of 100: a relative noise of ~15%
+    BenchmarkComparer::BenchmarkSamples const baseline = {
+        { "Noisy", { 90.0, 100.0, 110.0, 95.0, 105.0, 80.0, 120.0 } } };
+
+    BenchmarkComparer::BenchmarkSamples const current = {
+        { "Noisy", { 120.0, 120.0, 120.0 } } };
+
+    auto comparisons = BenchmarkComparer::Compare(baseline, current, 0.05, 3.0);
+
+    ASSERT_EQ(1u, comparisons.size());
+    EXPECT_EQ(BenchmarkComparer::Verdict::Unchanged, comparisons[0].Result);
+    EXPECT_NEAR(3.0 * 1.4826 * 10.0 / 100.0, comparisons[0].Threshold, 0.0001);
+
+    // The same change stands out with a lower noise factor
+    comparisons = BenchmarkComparer::Compare(baseline, current, 0.05, 1.0);
+
+    ASSERT_EQ(1u, comparisons.size());
+    EXPECT_EQ(BenchmarkComparer::Verdict::Regressed, comparisons[0].Result);
+}
+
+TEST(BenchmarkComparerTests, Compare_NoiseOfCurrentRun)
+{
+    BenchmarkComparer::BenchmarkSamples const baseline = {
+        { "Noisy", { 100.0, 100.0, 100.0 } } };
+
+    BenchmarkComparer::BenchmarkSamples const current = {
+        { "Noisy", { 100.0, 120.0, 140.0, 110.0, 130.0 } } };
+
+    auto const comparisons = BenchmarkComparer::Compare(baseline, current, 0.05, 3.0);
+
+    ASSERT_EQ(1u, comparisons.size());
+    EXPECT_EQ(BenchmarkComparer::Verdict::Unchanged, comparisons[0].Result);
+}
+
+TEST(BenchmarkComparerTests, Compare_SortsRegressionsFirst)
+{
+    BenchmarkComparer::BenchmarkSamples const baseline = {
+        { "A", { 100.0 } },
+        { "B", { 100.0 } },
+        { "C", { 100.0 } },
+        { "D", { 100.0 } },
+        { "E", { 100.0 } } };
+
+    BenchmarkComparer::BenchmarkSamples const current = {
+        { "A", { 90.0 } },
+        { "B", { 110.0 } },
+        { "C", { 150.0 } },
+        { "D", { 101.0 } },
+        { "F", { 100.0 } } };
+
+    auto const comparisons = BenchmarkComparer::Compare(baseline, current, 0.05, 3.0);
+
+    ASSERT_EQ(6u, comparisons.size());
+    EXPECT_EQ("C", comparisons[0].Name);
+    EXPECT_EQ("B", comparisons[1].Name);
+    EXPECT_EQ("D", comparisons[2].Name);
+    EXPECT_EQ("A", comparisons[3].Name);
+    EXPECT_EQ(BenchmarkComparer::Verdict::Missing, comparisons[4].Result);
+    EXPECT_EQ("E", comparisons[4].Name);
+    EXPECT_EQ(BenchmarkComparer::Verdict::New, comparisons[5].Result);
+    EXPECT_EQ("F", comparisons[5].Name);
+}
+
+TEST(BenchmarkComparerTests, Compare_MissingFailsUnlessAllowed)
+{
+    BenchmarkComparer::BenchmarkSamples const baseline = {
+        { "Kept", { 100.0, 100.0, 100.0 } },
+        { "Dropped", { 100.0, 100.0, 100.0 } } };
+
+    BenchmarkComparer::BenchmarkSamples const current = {
+        { "Kept", { 100.0, 100.0, 100.0 } } };
+
+    auto const comparisons = BenchmarkComparer::Compare(baseline, current, 0.05, 3.0);
+
+    ASSERT_EQ(2u, comparisons.size());
+    EXPECT_EQ(BenchmarkComparer::Verdict::Missing, Find(comparisons, "Dropped").Result);
+    EXPECT_EQ(0u, Find(comparisons, "Dropped").CurrentSampleCount);
+
+    EXPECT_FALSE(BenchmarkComparer::IsPass(comparisons, false));
+    EXPECT_TRUE(BenchmarkComparer::IsPass(comparisons, true));
+
+    std::stringstream report;
+    BenchmarkComparer::PrintReport(comparisons, false, report);
+    EXPECT_NE(std::string::npos, report.str().find("FAIL: 1 benchmark(s) missing"));
+    EXPECT_EQ(std::string::npos, report.str().find("PASS"));
+
+    std::stringstream allowedReport;
+    BenchmarkComparer::PrintReport(comparisons, true, allowedReport);
+    EXPECT_NE(std::string::npos, allowedReport.str().find("WARNING: 1 benchmark(s) missing"));
+    EXPECT_NE(std::string::npos, allowedReport.str().find("PASS"));
+}
+
+TEST(BenchmarkComparerTests, Compare_NewDoesNotFail)
+{
+    BenchmarkComparer::BenchmarkSamples const baseline = {
+        { "Old", { 100.0, 100.0, 100.0 } } };
+
+    BenchmarkComparer::BenchmarkSamples const current = {
+        { "Old", { 100.0, 100.0, 100.0 } },
+        { "New", { 500.0, 500.0, 500.0 } } };
+
+    auto const comparisons = BenchmarkComparer::Compare(baseline, current, 0.05, 3.0);
+
+    ASSERT_EQ(2u, comparisons.size());
+    EXPECT_EQ(BenchmarkComparer::Verdict::New, Find(comparisons, "New").Result);
+    EXPECT_EQ(500.0, Find(comparisons, "New").CurrentMedian);
+
+    EXPECT_TRUE(BenchmarkComparer::IsPass(comparisons, false));
+}
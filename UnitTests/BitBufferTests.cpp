@@ -0,0 +1,129 @@
+#include <GameCore/BitBuffer.h>
+
+#include "gtest/gtest.h"
+
+namespace /* anonymous */ {
+
+    // Crosses two word boundaries, and ends within the third word
+    static constexpr size_t Size = 130;
+}
+
+TEST(BitBufferTests, StartsCleared)
+{
+    BitBuffer buffer(Size);
+
+    for (size_t i = 0; i < Size; ++i)
+    {
+        EXPECT_FALSE(buffer[i]);
+    }
+}
+
+TEST(BitBufferTests, ByteSize)
+{
+    EXPECT_EQ(0u, BitBuffer(0).GetByteSize());
+    EXPECT_EQ(8u, BitBuffer(1).GetByteSize());
+    EXPECT_EQ(8u, BitBuffer(64).GetByteSize());
+    EXPECT_EQ(16u, BitBuffer(65).GetByteSize());
+    EXPECT_EQ(24u, BitBuffer(Size).GetByteSize());
+}
+
+TEST(BitBufferTests, SetAtWordBoundaries)
+{
+    for (size_t const index : { size_t(0), size_t(1), size_t(62), size_t(63), size_t(64), size_t(65), size_t(127), size_t(128), Size - 1 })
+    {
+        BitBuffer buffer(Size);
+
+        buffer.set(index, true);
+
+        for (size_t i = 0; i < Size; ++i)
+        {
+            EXPECT_EQ(i == index, buffer[i]) << "Set " << index << ", read " << i;
+        }
+
+        buffer.set(index, false);
+
+        for (size_t i = 0; i < Size; ++i)
+        {
+            EXPECT_FALSE(buffer[i]) << "Reset " << index << ", read " << i;
+        }
+    }
+}
+
+TEST(BitBufferTests, ResetLeavesNeighboursSet)
+{
+    BitBuffer buffer(Size);
+    buffer.fill(true);
+
+    buffer.set(63, false);
+    buffer.set(64, false);
+
+    for (size_t i = 0; i < Size; ++i)
+    {
+        EXPECT_EQ(i != 63 && i != 64, buffer[i]) << i;
+    }
+}
+
+TEST(BitBufferTests, FillAndClear)
+{
+    BitBuffer buffer(Size);
+
+    buffer.fill(true);
+
+    for (size_t i = 0; i < Size; ++i)
+    {
+        EXPECT_TRUE(buffer[i]) << i;
+    }
+
+    buffer.fill(false);
+
+    for (size_t i = 0; i < Size; ++i)
+    {
+        EXPECT_FALSE(buffer[i]) << i;
+    }
+}
+
+TEST(BitBufferTests, FillStart)
+{
+    BitBuffer buffer(Size, 64, true);
+
+    for (size_t i = 0; i < Size; ++i)
+    {
+        EXPECT_EQ(i >= 64, buffer[i]) << i;
+    }
+}
+
+TEST(BitBufferTests, EmplaceBack)
+{
+    BitBuffer buffer(Size);
+
+    for (size_t i = 0; i < Size; ++i)
+    {
+        buffer.emplace_back(i % 3 == 0);
+        EXPECT_EQ(i + 1, buffer.GetCurrentPopulatedSize());
+    }
+
+    for (size_t i = 0; i < Size; ++i)
+    {
+        EXPECT_EQ(i % 3 == 0, buffer[i]) << i;
+    }
+
+    EXPECT_THROW(buffer.emplace_back(true), std::runtime_error);
+}
+
+TEST(BitBufferTests, Data)
+{
+    BitBuffer buffer(Size);
+
+    buffer.set(0, true);
+    buffer.set(65, true);
+    buffer.set(129, true);
+
+    EXPECT_EQ(BitBuffer::WordType(1), buffer.data()[0]);
+    EXPECT_EQ(BitBuffer::WordType(2), buffer.data()[1]);
+    EXPECT_EQ(BitBuffer::WordType(2), buffer.data()[2]);
+
+    // Writing words is writing flags
+    buffer.data()[1] = BitBuffer::WordType(1) << 63;
+    EXPECT_FALSE(buffer[65]);
+    EXPECT_TRUE(buffer[127]);
+}
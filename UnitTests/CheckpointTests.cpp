@@ -0,0 +1,278 @@
+#include <GameCore/Checkpoint.h>
+
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace /* anonymous */ {
+
+    std::filesystem::path GetCheckpointFilePath()
+    {
+        return std::filesystem::temp_directory_path() / "CheckpointTests.fscp";
+    }
+
+    CheckpointReader::BlockHeader & GetFirstBlockHeader(std::vector<std::uint8_t> & image)
+    {
+        auto const & fileHeader = *reinterpret_cast<CheckpointReader::FileHeader const *>(image.data());
+        return *reinterpret_cast<CheckpointReader::BlockHeader *>(image.data() + fileHeader.SchemaOffset);
+    }
+}
+
+TEST(CheckpointTests, RoundTrip)
+{
+    auto const filePath = GetCheckpointFilePath();
+
+    {
+        Buffer<float> buffer(8, 0, 0.0f);
+        for (size_t i = 0; i < 8; ++i)
+            buffer[i] = static_cast<float>(i) * 1.5f;
+
+        BitBuffer bitBuffer(70);
+        bitBuffer.set(3, true);
+        bitBuffer.set(69, true);
+
+        SplitVec2fBuffer vec2fBuffer(8, 0, vec2f::zero());
+        vec2fBuffer.x(2) = 4.0f;
+        vec2fBuffer.y(2) = -4.0f;
+
+        CheckpointWriter writer;
+        writer.SetScope("A.");
+        writer.Visit("Buffer", buffer);
+        writer.Visit("BitBuffer", bitBuffer);
+        writer.Visit("Vec2f", vec2fBuffer);
+        writer.SetScope("B.");
+        writer.Visit("Value", std::uint64_t(42));
+        writer.Visit("Vector", std::vector<int>({ 7, 8, 9 }));
+        writer.Visit("String", std::string("Titanic"));
+
+        writer.Save(filePath);
+    }
+
+    {
+        Buffer<float> buffer(8, 0, 0.0f);
+        BitBuffer bitBuffer(70);
+        SplitVec2fBuffer vec2fBuffer(8, 0, vec2f::zero());
+        std::uint64_t value = 0;
+        std::vector<int> vector;
+        std::string str;
+
+        CheckpointReader reader(filePath);
+        reader.SetScope("A.");
+        reader.Visit("Buffer", buffer);
+        reader.Visit("BitBuffer", bitBuffer);
+        reader.Visit("Vec2f", vec2fBuffer);
+        reader.SetScope("B.");
+        reader.Visit("Value", value);
+        reader.Visit("Vector", vector);
+        reader.Visit("String", str);
+
+        for (size_t i = 0; i < 8; ++i)
+            EXPECT_EQ(static_cast<float>(i) * 1.5f, buffer[i]);
+
+        for (size_t i = 0; i < 70; ++i)
+            EXPECT_EQ(i == 3 || i == 69, bitBuffer[i]);
+
+        EXPECT_EQ(4.0f, vec2fBuffer.x(2));
+        EXPECT_EQ(-4.0f, vec2fBuffer.y(2));
+
+        EXPECT_EQ(42u, value);
+        EXPECT_EQ(std::vector<int>({ 7, 8, 9 }), vector);
+        EXPECT_EQ("Titanic", str);
+    }
+
+    std::filesystem::remove(filePath);
+}
+
+TEST(CheckpointTests, OptionalBuffer)
+{
+    auto const filePath = GetCheckpointFilePath();
+
+    {
+        auto present = std::make_unique<Buffer<int>>(8, 0, 6);
+        std::unique_ptr<Buffer<int>> absent;
+
+        CheckpointWriter writer;
+        writer.Visit("Present", present);
+        writer.Visit("Absent", absent);
+
+        writer.Save(filePath);
+    }
+
+    {
+        std::unique_ptr<Buffer<int>> present;
+        auto absent = std::make_unique<Buffer<int>>(8, 0, 0);
+
+        CheckpointReader reader(filePath);
+        EXPECT_TRUE(reader.HasBlock("Present"));
+        EXPECT_FALSE(reader.HasBlock("Absent"));
+
+        reader.Visit("Present", present);
+        reader.Visit("Absent", absent);
+
+        ASSERT_TRUE(!!present);
+        EXPECT_EQ(6, (*present)[0]);
+        EXPECT_EQ(6, (*present)[1]);
+        EXPECT_FALSE(!!absent);
+    }
+
+    std::filesystem::remove(filePath);
+}
+
+TEST(CheckpointTests, OptionalValue)
+{
+    auto const filePath = GetCheckpointFilePath();
+
+    {
+        std::optional<float> present(2.5f);
+        std::optional<float> absent;
+
+        CheckpointWriter writer;
+        writer.Visit("Present", present);
+        writer.Visit("Absent", absent);
+
+        writer.Save(filePath);
+    }
+
+    {
+        std::optional<float> present;
+        std::optional<float> absent(7.0f);
+
+        CheckpointReader reader(filePath);
+        reader.Visit("Present", present);
+        reader.Visit("Absent", absent);
+
+        ASSERT_TRUE(present.has_value());
+        EXPECT_EQ(2.5f, *present);
+        EXPECT_FALSE(absent.has_value());
+    }
+
+    std::filesystem::remove(filePath);
+}
+
+TEST(CheckpointTests, ThrowsOnSchemaMismatch)
+{
+    auto const filePath = GetCheckpointFilePath();
+
+    {
+        Buffer<float> buffer(16, 0, 0.0f);
+
+        CheckpointWriter writer;
+        writer.Visit("Buffer", buffer);
+
+        writer.Save(filePath);
+    }
+
+    {
+        Buffer<float> smallerBuffer(8, 0, 0.0f);
+        Buffer<double> widerBuffer(16, 0, 0.0);
+
+        CheckpointReader reader(filePath);
+        EXPECT_THROW(reader.Visit("Buffer", smallerBuffer), GameException);
+        EXPECT_THROW(reader.Visit("Buffer", widerBuffer), GameException);
+        EXPECT_THROW(reader.Visit("Missing", smallerBuffer), GameException);
+    }
+
+    std::filesystem::remove(filePath);
+}
+
+TEST(CheckpointTests, ThrowsOnBlockBeyondImage)
+{
+    std::vector<std::uint8_t> image;
+
+    {
+        Buffer<float> buffer(8, 0, 0.0f);
+
+        CheckpointWriter writer(image);
+        writer.Visit("Buffer", buffer);
+        writer.Finish();
+    }
+
+    // Sanity check
+    EXPECT_NO_THROW(CheckpointReader(image.data(), image.size()));
+
+    // Offset past the end
+    {
+        auto corruptImage = image;
+        auto & corruptBlockHeader = GetFirstBlockHeader(corruptImage);
+        corruptBlockHeader.Offset = image.size() + 1;
+        EXPECT_THROW(CheckpointReader(corruptImage.data(), corruptImage.size()), GameException);
+    }
+
+    // Size overflowing to zero
+    {
+        auto corruptImage = image;
+        auto & corruptBlockHeader = GetFirstBlockHeader(corruptImage);
+        corruptBlockHeader.ElementCount = std::uint64_t(1) << 62;
+        EXPECT_THROW(CheckpointReader(corruptImage.data(), corruptImage.size()), GameException);
+    }
+
+    // Zero-sized elements
+    {
+        auto corruptImage = image;
+        auto & corruptBlockHeader = GetFirstBlockHeader(corruptImage);
+        corruptBlockHeader.ElementSize = 0;
+        EXPECT_THROW(CheckpointReader(corruptImage.data(), corruptImage.size()), GameException);
+    }
+}
+
+TEST(CheckpointTests, ImageRoundTrip_ReusesImage)
+{
+    std::vector<std::uint8_t> image;
+    std::uint8_t const * previousData = nullptr;
+
+    for (int capture = 0; capture < 2; ++capture)
+    {
+        Buffer<float> buffer(128, 0, static_cast<float>(capture));
+
+        {
+            CheckpointWriter writer(image);
+            writer.SetScope("A.");
+            writer.Visit("Buffer", buffer);
+            writer.Visit("Value", capture);
+            writer.Finish();
+
+            EXPECT_EQ(128u * sizeof(float) + sizeof(int), writer.GetByteSize());
+        }
+
+        EXPECT_EQ(0u, image.size() % 8);
+
+        if (capture > 0)
+        {
+            // Same size, same memory
+            EXPECT_EQ(previousData, image.data());
+        }
+
+        previousData = image.data();
+
+        Buffer<float> restoredBuffer(128, 0, -1.0f);
+        int restoredValue = -1;
+
+        CheckpointReader reader(image.data(), image.size());
+        reader.SetScope("A.");
+        reader.Visit("Buffer", restoredBuffer);
+        reader.Visit("Value", restoredValue);
+
+        for (size_t i = 0; i < 128; ++i)
+            EXPECT_EQ(static_cast<float>(capture), restoredBuffer[i]);
+
+        EXPECT_EQ(capture, restoredValue);
+    }
+}
+
+TEST(CheckpointTests, ThrowsOnNonCheckpoint)
+{
+    auto const filePath = GetCheckpointFilePath();
+
+    {
+        std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+        file << "Not a checkpoint, not at all";
+    }
+
+    EXPECT_THROW(CheckpointReader reader(filePath), GameException);
+
+    std::filesystem::remove(filePath);
+}
@@ -0,0 +1,132 @@
+#include <GameCore/CsrAdjacencyList.h>
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+    std::vector<int> ToVector(CsrAdjacencyList<int>::Row const & row)
+    {
+        return std::vector<int>(row.begin(), row.end());
+    }
+}
+
+TEST(CsrAdjacencyListTests, Empty)
+{
+    CsrAdjacencyList<int> list(3);
+
+    EXPECT_EQ(3u, list.GetRowCount());
+
+    for (size_t r = 0; r < 3; ++r)
+    {
+        EXPECT_TRUE(list.GetRow(r).empty());
+        EXPECT_EQ(0u, list.GetRowCapacity(r));
+        EXPECT_EQ(0u, list.GetRowOwnedSize(r));
+    }
+}
+
+TEST(CsrAdjacencyListTests, Build_OwnedElementsFirst)
+{
+    CsrAdjacencyList<int>::Builder builder(3);
+    builder.Add(0, 10, false);
+    builder.Add(2, 20, true);
+    builder.Add(0, 11, true);
+    builder.Add(0, 12, false);
+    builder.Add(0, 13, true);
+
+    CsrAdjacencyList<int> list = builder.Build();
+
+    ASSERT_EQ(3u, list.GetRowCount());
+
+    EXPECT_EQ(std::vector<int>({ 11, 13, 10, 12 }), ToVector(list.GetRow(0)));
+    EXPECT_EQ(4u, list.GetRowCapacity(0));
+    EXPECT_EQ(2u, list.GetRowOwnedSize(0));
+
+    EXPECT_TRUE(list.GetRow(1).empty());
+    EXPECT_EQ(0u, list.GetRowCapacity(1));
+
+    EXPECT_EQ(std::vector<int>({ 20 }), ToVector(list.GetRow(2)));
+    EXPECT_EQ(1u, list.GetRowCapacity(2));
+    EXPECT_EQ(1u, list.GetRowOwnedSize(2));
+}
+
+TEST(CsrAdjacencyListTests, Disconnect_CompactsRow)
+{
+    CsrAdjacencyList<int>::Builder builder(2);
+    builder.Add(0, 1, true);
+    builder.Add(0, 2, true);
+    builder.Add(0, 3, false);
+    builder.Add(0, 4, false);
+    builder.Add(1, 5, false);
+
+    CsrAdjacencyList<int> list = builder.Build();
+
+    list.Disconnect(0, [](int e) { return e == 1; }, true);
+
+    EXPECT_EQ(std::vector<int>({ 2, 3, 4 }), ToVector(list.GetRow(0)));
+    EXPECT_EQ(1u, list.GetRowOwnedSize(0));
+
+    list.Disconnect(0, [](int e) { return e == 3; }, false);
+
+    EXPECT_EQ(std::vector<int>({ 2, 4 }), ToVector(list.GetRow(0)));
+    EXPECT_EQ(1u, list.GetRowOwnedSize(0));
+
+    // Other rows are untouched
+    EXPECT_EQ(std::vector<int>({ 5 }), ToVector(list.GetRow(1)));
+
+    // Capacity does not change
+    EXPECT_EQ(4u, list.GetRowCapacity(0));
+}
+
+TEST(CsrAdjacencyListTests, Connect_AfterDisconnect)
+{
+    CsrAdjacencyList<int>::Builder builder(1);
+    builder.Add(0, 1, true);
+    builder.Add(0, 2, false);
+    builder.Add(0, 3, false);
+
+    CsrAdjacencyList<int> list = builder.Build();
+
+    list.Disconnect(0, [](int e) { return e == 1; }, true);
+    list.Disconnect(0, [](int e) { return e == 2; }, false);
+
+    EXPECT_EQ(std::vector<int>({ 3 }), ToVector(list.GetRow(0)));
+
+    list.Connect(0, 2, false);
+    list.Connect(0, 1, true);
+
+    EXPECT_EQ(std::vector<int>({ 1, 3, 2 }), ToVector(list.GetRow(0)));
+    EXPECT_EQ(1u, list.GetRowOwnedSize(0));
+}
+
+TEST(CsrAdjacencyListTests, Connect_ThrowsWhenRowIsFull)
+{
+    CsrAdjacencyList<int>::Builder builder(1);
+    builder.Add(0, 1, false);
+
+    CsrAdjacencyList<int> list = builder.Build();
+
+    EXPECT_THROW(list.Connect(0, 2, false), std::runtime_error);
+}
+
+TEST(CsrAdjacencyListTests, Row_IsLive)
+{
+    CsrAdjacencyList<int>::Builder builder(1);
+    builder.Add(0, 1, false);
+    builder.Add(0, 2, false);
+
+    CsrAdjacencyList<int> list = builder.Build();
+
+    auto const row = list.GetRow(0);
+
+    EXPECT_EQ(2u, row.size());
+    EXPECT_EQ(2, row.back());
+    EXPECT_TRUE(row.contains([](int e) { return e == 2; }));
+
+    list.Disconnect(0, [](int e) { return e == 2; }, false);
+
+    EXPECT_EQ(1u, row.size());
+    EXPECT_EQ(1, row.back());
+    EXPECT_FALSE(row.contains([](int e) { return e == 2; }));
+}
@@ -0,0 +1,73 @@
+#include <GameCore/DurationHistogram.h>
+
+#include "gtest/gtest.h"
+
+TEST(DurationHistogramTests, Empty)
+{
+    DurationHistogram histogram;
+
+    EXPECT_EQ(0u, histogram.GetSampleCount());
+
+    auto const percentiles = histogram.GetPercentiles();
+    EXPECT_EQ(0.0f, percentiles.P50);
+    EXPECT_EQ(0.0f, percentiles.P99);
+    EXPECT_EQ(0.0f, percentiles.Max);
+}
+
+TEST(DurationHistogramTests, Percentiles)
+{
+    DurationHistogram histogram;
+
+    // 1ms, 2ms, ..., 100ms
+    for (int i = 1; i <= 100; ++i)
+    {
+        histogram.Record(std::chrono::microseconds(i * 1000 - 10));
+    }
+
+    EXPECT_EQ(100u, histogram.GetSampleCount());
+
+    auto const percentiles = histogram.GetPercentiles();
+    EXPECT_NEAR(50.0f, percentiles.P50, 0.05f);
+    EXPECT_NEAR(95.0f, percentiles.P95, 0.05f);
+    EXPECT_NEAR(99.0f, percentiles.P99, 0.05f);
+    EXPECT_FLOAT_EQ(99.99f, percentiles.Max);
+}
+
+TEST(DurationHistogramTests, PercentileNeverExceedsMax)
+{
+    DurationHistogram histogram;
+
+    histogram.Record(std::chrono::microseconds(1010));
+
+    EXPECT_FLOAT_EQ(1.01f, histogram.GetPercentile(0.5f));
+    EXPECT_FLOAT_EQ(1.01f, histogram.GetPercentile(1.0f));
+}
+
+TEST(DurationHistogramTests, Overflow)
+{
+    DurationHistogram histogram;
+
+    for (int i = 0; i < 98; ++i)
+    {
+        histogram.Record(std::chrono::milliseconds(10));
+    }
+
+    histogram.Record(std::chrono::milliseconds(250));
+    histogram.Record(std::chrono::milliseconds(500));
+
+    auto const percentiles = histogram.GetPercentiles();
+    EXPECT_FLOAT_EQ(10.05f, percentiles.P50); // Upper bound of the bucket
+    EXPECT_FLOAT_EQ(500.0f, percentiles.P99);
+    EXPECT_FLOAT_EQ(500.0f, percentiles.Max);
+}
+
+TEST(DurationHistogramTests, Reset)
+{
+    DurationHistogram histogram;
+
+    histogram.Record(std::chrono::milliseconds(10));
+    histogram.Reset();
+
+    EXPECT_EQ(0u, histogram.GetSampleCount());
+    EXPECT_EQ(0.0f, histogram.GetPercentiles().Max);
+}
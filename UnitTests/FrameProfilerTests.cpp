@@ -0,0 +1,129 @@
+#include <Game/FrameProfiler.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#ifdef FRAME_PROFILER
+
+namespace /* anonymous */ {
+
+    size_t CountTraceEvents(std::string const & name)
+    {
+        auto const filePath = std::filesystem::temp_directory_path() / "FrameProfilerTests.json";
+
+        TraceRecorder::GetInstance().WriteChromeTrace(filePath);
+
+        std::ifstream file(filePath);
+        std::stringstream ss;
+        ss << file.rdbuf();
+        file.close();
+
+        std::filesystem::remove(filePath);
+
+        std::string const trace = ss.str();
+        std::string const pattern = "{\"name\":\"" + name + "\",\"ph\":\"X\"";
+
+        size_t count = 0;
+        for (size_t pos = trace.find(pattern); pos != std::string::npos; pos = trace.find(pattern, pos + 1))
+        {
+            ++count;
+        }
+
+        return count;
+    }
+}
+
+TEST(FrameProfilerTests, SectionsAreInDepthFirstOrder)
+{
+    auto const profile = FrameProfiler::GetInstance().Sample();
+
+    ASSERT_EQ(static_cast<size_t>(ProfiledSection::_Last) + 1, profile.size());
+
+    for (size_t s = 0; s < profile.size(); ++s)
+    {
+        EXPECT_EQ(static_cast<ProfiledSection>(s), profile[s].Section);
+        EXPECT_FALSE(profile[s].Name.empty());
+
+        // Each section is at most one level deeper than its predecessor
+        if (s > 0)
+        {
+            EXPECT_LE(profile[s].Depth, profile[s - 1].Depth + 1);
+        }
+    }
+
+    EXPECT_EQ(0u, profile[static_cast<size_t>(ProfiledSection::Update)].Depth);
+    EXPECT_EQ(1u, profile[static_cast<size_t>(ProfiledSection::UpdateShip)].Depth);
+    EXPECT_EQ(3u, profile[static_cast<size_t>(ProfiledSection::ShipWaterVelocities)].Depth);
+    EXPECT_EQ(0u, profile[static_cast<size_t>(ProfiledSection::Render)].Depth);
+}
+
+TEST(FrameProfilerTests, FractionOfParent)
+{
+    auto & profiler = FrameProfiler::GetInstance();
+
+    // Start over
+    profiler.Sample();
+
+    profiler.Accumulate(ProfiledSection::UpdateShip, std::chrono::milliseconds(8), HardwareCounterValues());
+    profiler.Accumulate(ProfiledSection::ShipMechanicalDynamics, std::chrono::milliseconds(2), HardwareCounterValues());
+    profiler.Accumulate(ProfiledSection::ShipWaterDynamics, std::chrono::milliseconds(6), HardwareCounterValues());
+
+    auto const profile = profiler.Sample();
+
+    EXPECT_FLOAT_EQ(0.25f, profile[static_cast<size_t>(ProfiledSection::ShipMechanicalDynamics)].FractionOfParent);
+    EXPECT_FLOAT_EQ(0.75f, profile[static_cast<size_t>(ProfiledSection::ShipWaterDynamics)].FractionOfParent);
+    EXPECT_FLOAT_EQ(0.0f, profile[static_cast<size_t>(ProfiledSection::ShipStrains)].FractionOfParent);
+
+    // Parent of the ship update has not been timed
+    EXPECT_FLOAT_EQ(0.0f, profile[static_cast<size_t>(ProfiledSection::UpdateShip)].FractionOfParent);
+    EXPECT_GT(profile[static_cast<size_t>(ProfiledSection::UpdateShip)].MillisecondsPerSecond, 0.0f);
+}
+
+TEST(FrameProfilerTests, SampleStartsOver)
+{
+    auto & profiler = FrameProfiler::GetInstance();
+
+    {
+        ScopedProfileTimer timer(ProfiledSection::RenderWorld);
+    }
+
+    profiler.Sample();
+
+    auto const profile = profiler.Sample();
+
+    for (auto const & section : profile)
+    {
+        EXPECT_EQ(0.0f, section.MillisecondsPerSecond);
+    }
+}
+
+TEST(FrameProfilerTests, TimerTracesOnlyWhenRecorderIsEnabled)
+{
+    auto & recorder = TraceRecorder::GetInstance();
+
+    recorder.SetEnabled(false);
+    recorder.Clear();
+
+    {
+        ScopedProfileTimer timer(ProfiledSection::RenderEnd);
+    }
+
+    EXPECT_EQ(0u, CountTraceEvents("End"));
+
+    recorder.SetEnabled(true);
+
+    {
+        ScopedProfileTimer timer(ProfiledSection::RenderEnd);
+    }
+
+    EXPECT_EQ(1u, CountTraceEvents("End"));
+
+    recorder.SetEnabled(false);
+    recorder.Clear();
+}
+
+#endif
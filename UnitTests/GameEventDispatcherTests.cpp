@@ -2,6 +2,9 @@
 
 #include "gmock/gmock.h"
 
+#include <thread>
+#include <vector>
+
 class _MockHandler
     : public IStructuralGameEventHandler
     , public ILifecycleGameEventHandler
@@ -17,21 +20,17 @@ using namespace ::testing;
 
 using MockHandler = StrictMock<_MockHandler>;
 
-/////////////////////////////////////////////////////////////////
-
-TEST(GameEventDispatcherTests, Aggregates_OnStress)
+static StructuralMaterial MakeTestStructuralMaterial(std::string const & name)
 {
-    MockHandler handler;
-
-    GameEventDispatcher dispatcher;
-    dispatcher.RegisterStructuralEventHandler(&handler);
-
-    StructuralMaterial sm(
-        "Foo",
+    return StructuralMaterial(
+        name,
+        1.0f,
         1.0f,
         1.0f,
         1.0f,
         vec4f::zero(),
+        std::nullopt,
+        std::nullopt,
         false,
         1.0f,
         1.0f,
@@ -39,8 +38,23 @@ TEST(GameEventDispatcherTests, Aggregates_OnStress)
         1.0f,
         1.0f,
         1.0f,
-        std::nullopt,
-        std::nullopt);
+        1.0f,
+        1.0f,
+        1.0f,
+        StructuralMaterial::MaterialCombustionType::Combustion,
+        1.0f);
+}
+
+/////////////////////////////////////////////////////////////////
+
+TEST(GameEventDispatcherTests, Aggregates_OnStress)
+{
+    MockHandler handler;
+
+    GameEventDispatcher dispatcher;
+    dispatcher.RegisterStructuralEventHandler(&handler);
+
+    StructuralMaterial sm = MakeTestStructuralMaterial("Foo");
 
     EXPECT_CALL(handler, OnStress(_, _, _)).Times(0);
 
@@ -63,37 +77,9 @@ TEST(GameEventDispatcherTests, Aggregates_OnStress_MultipleKeys)
     GameEventDispatcher dispatcher;
     dispatcher.RegisterStructuralEventHandler(&handler);
 
-    StructuralMaterial sm1(
-        "Foo1",
-        1.0f,
-        1.0f,
-        1.0f,
-        vec4f::zero(),
-        false,
-        1.0f,
-        1.0f,
-        1.0f,
-        1.0f,
-        1.0f,
-        1.0f,
-        std::nullopt,
-        std::nullopt);
+    StructuralMaterial sm1 = MakeTestStructuralMaterial("Foo1");
 
-    StructuralMaterial sm2(
-        "Foo2",
-        1.0f,
-        1.0f,
-        1.0f,
-        vec4f::zero(),
-        false,
-        1.0f,
-        1.0f,
-        1.0f,
-        1.0f,
-        1.0f,
-        1.0f,
-        std::nullopt,
-        std::nullopt);
+    StructuralMaterial sm2 = MakeTestStructuralMaterial("Foo2");
 
     EXPECT_CALL(handler, OnStress(_, _, _)).Times(0);
 
@@ -153,21 +139,7 @@ TEST(GameEventDispatcherTests, ClearsStateAtUpdate)
     GameEventDispatcher dispatcher;
     dispatcher.RegisterStructuralEventHandler(&handler);
 
-    StructuralMaterial sm(
-        "Foo",
-        1.0f,
-        1.0f,
-        1.0f,
-        vec4f::zero(),
-        false,
-        1.0f,
-        1.0f,
-        1.0f,
-        1.0f,
-        1.0f,
-        1.0f,
-        std::nullopt,
-        std::nullopt);
+    StructuralMaterial sm = MakeTestStructuralMaterial("Foo");
 
     EXPECT_CALL(handler, OnStress(_, _, _)).Times(0);
 
@@ -187,4 +159,98 @@ TEST(GameEventDispatcherTests, ClearsStateAtUpdate)
     dispatcher.Flush();
 
     Mock::VerifyAndClear(&handler);
-}
\ No newline at end of file
+}
+TEST(GameEventDispatcherTests, Aggregates_OnBreak_AcrossThreads)
+{
+    MockHandler handler;
+
+    GameEventDispatcher dispatcher;
+    dispatcher.RegisterStructuralEventHandler(&handler);
+
+    StructuralMaterial sm = MakeTestStructuralMaterial("Foo");
+
+    EXPECT_CALL(handler, OnBreak(_, _, _)).Times(0);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back(
+            [&dispatcher, &sm]()
+            {
+                for (int i = 0; i < 1000; ++i)
+                {
+                    dispatcher.OnBreak(sm, true, 1);
+                }
+            });
+    }
+
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+
+    dispatcher.OnBreak(sm, true, 2);
+
+    Mock::VerifyAndClear(&handler);
+
+    EXPECT_CALL(handler, OnBreak(Field(&StructuralMaterial::Name, "Foo"), true, 4002)).Times(1);
+
+    dispatcher.Flush();
+
+    Mock::VerifyAndClear(&handler);
+}
+
+TEST(GameEventDispatcherTests, Aggregates_OnStress_BeyondRecordBufferCapacity)
+{
+    MockHandler handler;
+
+    GameEventDispatcher dispatcher;
+    dispatcher.RegisterStructuralEventHandler(&handler);
+
+    StructuralMaterial sm = MakeTestStructuralMaterial("Foo");
+
+    size_t const eventCount = 3 * GameEventRecordBuffer::Capacity + 5;
+    for (size_t i = 0; i < eventCount; ++i)
+    {
+        dispatcher.OnStress(sm, (i % 2) == 0, 1);
+    }
+
+    EXPECT_CALL(handler, OnStress(Field(&StructuralMaterial::Name, "Foo"), true, static_cast<unsigned int>((eventCount + 1) / 2))).Times(1);
+    EXPECT_CALL(handler, OnStress(Field(&StructuralMaterial::Name, "Foo"), false, static_cast<unsigned int>(eventCount / 2))).Times(1);
+
+    dispatcher.Flush();
+
+    Mock::VerifyAndClear(&handler);
+}
+
+TEST(GameEventDispatcherTests, Dispatchers_DoNotShareRecordedEvents)
+{
+    MockHandler handler1;
+    MockHandler handler2;
+
+    GameEventDispatcher dispatcher1;
+    dispatcher1.RegisterStructuralEventHandler(&handler1);
+
+    GameEventDispatcher dispatcher2;
+    dispatcher2.RegisterStructuralEventHandler(&handler2);
+
+    StructuralMaterial sm = MakeTestStructuralMaterial("Foo");
+
+    dispatcher1.OnStress(sm, false, 1);
+    dispatcher2.OnStress(sm, false, 2);
+    dispatcher1.OnStress(sm, false, 4);
+
+    EXPECT_CALL(handler1, OnStress(Field(&StructuralMaterial::Name, "Foo"), false, 5)).Times(1);
+    EXPECT_CALL(handler2, OnStress(_, _, _)).Times(0);
+
+    dispatcher1.Flush();
+
+    Mock::VerifyAndClear(&handler1);
+    Mock::VerifyAndClear(&handler2);
+
+    EXPECT_CALL(handler2, OnStress(Field(&StructuralMaterial::Name, "Foo"), false, 2)).Times(1);
+
+    dispatcher2.Flush();
+
+    Mock::VerifyAndClear(&handler2);
+}
@@ -1,5 +1,7 @@
 #include <GameCore/GameMath.h>
+#include <GameCore/GameMathBatch.h>
 
+#include <algorithm>
 #include <cmath>
 
 #include "gtest/gtest.h"
@@ -133,6 +135,109 @@ TEST_P(FastExpTest, FastExpTest)
     EXPECT_TRUE(ApproxEquals(result, expectedResult, std::get<1>(GetParam())));
 }
 
+// Batch versions: same as the scalar versions, over aligned spans of any length
+
+static size_t constexpr BatchTestCount = 103; // Not a multiple of the batch width
+
+TEST(FastMathBatchTest, FastLog2Batch)
+{
+    alignas(16) float x[BatchTestCount];
+    alignas(16) float result[BatchTestCount];
+
+    for (size_t i = 0; i < BatchTestCount; ++i)
+    {
+        x[i] = 0.01f + static_cast<float>(i) * 0.37f;
+    }
+
+    FastLog2Batch(x, result, BatchTestCount);
+
+    for (size_t i = 0; i < BatchTestCount; ++i)
+    {
+        EXPECT_FLOAT_EQ(FastLog2(x[i]), result[i]);
+        EXPECT_TRUE(ApproxEquals(result[i], log2(x[i]), 0.001f));
+    }
+}
+
+TEST(FastMathBatchTest, FastPow2Batch)
+{
+    alignas(16) float p[BatchTestCount];
+    alignas(16) float result[BatchTestCount];
+
+    for (size_t i = 0; i < BatchTestCount; ++i)
+    {
+        p[i] = -5.0f + static_cast<float>(i) * 0.1f;
+    }
+
+    FastPow2Batch(p, result, BatchTestCount);
+
+    for (size_t i = 0; i < BatchTestCount; ++i)
+    {
+        EXPECT_FLOAT_EQ(FastPow2(p[i]), result[i]);
+        EXPECT_TRUE(ApproxEquals(result[i], exp2(p[i]), 0.001f * exp2(p[i])));
+    }
+}
+
+TEST(FastMathBatchTest, FastExpBatch)
+{
+    alignas(16) float p[BatchTestCount];
+    alignas(16) float result[BatchTestCount];
+
+    for (size_t i = 0; i < BatchTestCount; ++i)
+    {
+        p[i] = -5.0f + static_cast<float>(i) * 0.1f;
+    }
+
+    // In place
+    std::copy(p, p + BatchTestCount, result);
+    FastExpBatch(result, result, BatchTestCount);
+
+    for (size_t i = 0; i < BatchTestCount; ++i)
+    {
+        EXPECT_FLOAT_EQ(FastExp(p[i]), result[i]);
+        EXPECT_TRUE(ApproxEquals(result[i], exp(p[i]), 0.001f * exp(p[i])));
+    }
+}
+
+TEST(FastMathBatchTest, FastPowBatch_ScalarExponent)
+{
+    alignas(16) float x[BatchTestCount];
+    alignas(16) float result[BatchTestCount];
+
+    for (size_t i = 0; i < BatchTestCount; ++i)
+    {
+        x[i] = static_cast<float>(i) * 0.1f;
+    }
+
+    FastPowBatch(x, 1.7f, result, BatchTestCount);
+
+    for (size_t i = 0; i < BatchTestCount; ++i)
+    {
+        EXPECT_FLOAT_EQ(FastPow(x[i], 1.7f), result[i]);
+        EXPECT_TRUE(ApproxEquals(result[i], pow(x[i], 1.7f), 0.001f + 0.001f * pow(x[i], 1.7f)));
+    }
+}
+
+TEST(FastMathBatchTest, FastPowBatch_ExponentSpan)
+{
+    alignas(16) float x[BatchTestCount];
+    alignas(16) float p[BatchTestCount];
+    alignas(16) float result[BatchTestCount];
+
+    for (size_t i = 0; i < BatchTestCount; ++i)
+    {
+        x[i] = 0.5f + static_cast<float>(i) * 0.05f;
+        p[i] = static_cast<float>(i % 7) * 0.3f;
+    }
+
+    FastPowBatch(x, p, result, BatchTestCount);
+
+    for (size_t i = 0; i < BatchTestCount; ++i)
+    {
+        EXPECT_FLOAT_EQ(FastPow(x[i], p[i]), result[i]);
+        EXPECT_TRUE(ApproxEquals(result[i], pow(x[i], p[i]), 0.001f + 0.001f * pow(x[i], p[i])));
+    }
+}
+
 // COMPARISON STICK
 #include <cmath>
 float FastFastLog2_1(float x)
@@ -0,0 +1,73 @@
+#include <GameCore/HardwareCounters.h>
+
+#include "gtest/gtest.h"
+
+TEST(HardwareCountersTests, ValuesArithmetic)
+{
+    HardwareCounterValues a;
+    a.Cycles = 1000;
+    a.Instructions = 2500;
+    a.LLCMisses = 10;
+    a.DTLBMisses = 3;
+
+    HardwareCounterValues b;
+    b.Cycles = 400;
+    b.Instructions = 500;
+    b.LLCMisses = 4;
+    b.DTLBMisses = 1;
+
+    HardwareCounterValues const d = a - b;
+    EXPECT_EQ(600u, d.Cycles);
+    EXPECT_EQ(2000u, d.Instructions);
+    EXPECT_EQ(6u, d.LLCMisses);
+    EXPECT_EQ(2u, d.DTLBMisses);
+
+    b += d;
+    EXPECT_EQ(a.Cycles, b.Cycles);
+    EXPECT_EQ(a.DTLBMisses, b.DTLBMisses);
+
+    EXPECT_FLOAT_EQ(2.5f, a.GetInstructionsPerCycle());
+    EXPECT_FLOAT_EQ(0.0f, HardwareCounterValues().GetInstructionsPerCycle());
+}
+
+TEST(HardwareCountersTests, ScaleCount)
+{
+    // Counted all the time
+    EXPECT_EQ(1000u, HardwareCounters::ScaleCount(1000, 500, 500));
+
+    // Counted a quarter of the time
+    EXPECT_EQ(4000u, HardwareCounters::ScaleCount(1000, 2000, 500));
+
+    // Never counted
+    EXPECT_EQ(0u, HardwareCounters::ScaleCount(0, 500, 0));
+    EXPECT_EQ(0u, HardwareCounters::ScaleCount(0, 0, 0));
+}
+
+TEST(HardwareCountersTests, ReadsMonotonicallyOrZero)
+{
+    // Counters may legitimately be unavailable, e.g. in containers
+    HardwareCounters counters;
+
+    HardwareCounterValues const first = counters.Read();
+
+    volatile float sum = 0.0f;
+    for (int i = 0; i < 100000; ++i)
+    {
+        sum = sum + static_cast<float>(i);
+    }
+
+    HardwareCounterValues const second = counters.Read();
+
+    if (counters.IsAvailable())
+    {
+        EXPECT_GE(second.Cycles, first.Cycles);
+        EXPECT_GE(second.Instructions, first.Instructions);
+    }
+    else
+    {
+        EXPECT_EQ(0u, second.Cycles);
+        EXPECT_EQ(0u, second.Instructions);
+        EXPECT_EQ(0u, second.LLCMisses);
+        EXPECT_EQ(0u, second.DTLBMisses);
+    }
+}
@@ -0,0 +1,145 @@
+#include "HeapAllocationCounter.h"
+
+#include <GameCore/SysSpecifics.h>
+
+#include <cstdlib>
+#include <new>
+
+//
+// Replacements of all the global allocation functions - plain, array, nothrow, and
+// over-aligned - for this executable only.
+//
+
+namespace /* anonymous */ {
+
+    thread_local size_t CurrentThreadAllocationCount = 0;
+
+    void * CountedAllocate(size_t size) noexcept
+    {
+        ++CurrentThreadAllocationCount;
+
+        return std::malloc(size > 0 ? size : 1);
+    }
+
+    void * CountedAllocate(
+        size_t size,
+        std::align_val_t alignment) noexcept
+    {
+        ++CurrentThreadAllocationCount;
+
+        return aligned_alloc(static_cast<size_t>(alignment), size > 0 ? size : 1);
+    }
+
+    void * ThrowIfNull(void * p)
+    {
+        if (nullptr == p)
+            throw std::bad_alloc();
+
+        return p;
+    }
+}
+
+size_t HeapAllocationCounter::GetCurrentThreadAllocationCount()
+{
+    return CurrentThreadAllocationCount;
+}
+
+void * operator new(size_t size)
+{
+    return ThrowIfNull(CountedAllocate(size));
+}
+
+void * operator new[](size_t size)
+{
+    return ThrowIfNull(CountedAllocate(size));
+}
+
+void * operator new(size_t size, std::nothrow_t const &) noexcept
+{
+    return CountedAllocate(size);
+}
+
+void * operator new[](size_t size, std::nothrow_t const &) noexcept
+{
+    return CountedAllocate(size);
+}
+
+void * operator new(size_t size, std::align_val_t alignment)
+{
+    return ThrowIfNull(CountedAllocate(size, alignment));
+}
+
+void * operator new[](size_t size, std::align_val_t alignment)
+{
+    return ThrowIfNull(CountedAllocate(size, alignment));
+}
+
+void * operator new(size_t size, std::align_val_t alignment, std::nothrow_t const &) noexcept
+{
+    return CountedAllocate(size, alignment);
+}
+
+void * operator new[](size_t size, std::align_val_t alignment, std::nothrow_t const &) noexcept
+{
+    return CountedAllocate(size, alignment);
+}
+
+void operator delete(void * p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void * p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void * p, size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void * p, size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void * p, std::nothrow_t const &) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void * p, std::nothrow_t const &) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void * p, std::align_val_t) noexcept
+{
+    aligned_free(p);
+}
+
+void operator delete[](void * p, std::align_val_t) noexcept
+{
+    aligned_free(p);
+}
+
+void operator delete(void * p, size_t, std::align_val_t) noexcept
+{
+    aligned_free(p);
+}
+
+void operator delete[](void * p, size_t, std::align_val_t) noexcept
+{
+    aligned_free(p);
+}
+
+void operator delete(void * p, std::align_val_t, std::nothrow_t const &) noexcept
+{
+    aligned_free(p);
+}
+
+void operator delete[](void * p, std::align_val_t, std::nothrow_t const &) noexcept
+{
+    aligned_free(p);
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+
+/*
+ * Counts the heap allocations made by the calling thread.
+ *
+ * The count is kept by this executable's replacements of the global allocation
+ * functions - see HeapAllocationCounter.cpp - hence the game itself, and the
+ * libraries it links, are unaffected.
+ */
+class HeapAllocationCounter
+{
+public:
+
+    static size_t GetCurrentThreadAllocationCount();
+};
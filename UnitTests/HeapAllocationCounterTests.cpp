@@ -0,0 +1,64 @@
+#include "HeapAllocationCounter.h"
+
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace /* anonymous */ {
+
+    struct alignas(64) OverAligned
+    {
+        float Values[16];
+    };
+}
+
+TEST(HeapAllocationCounterTests, CountsAllocations)
+{
+    size_t const initialCount = HeapAllocationCounter::GetCurrentThreadAllocationCount();
+
+    auto const i = std::make_unique<int>(42);
+    EXPECT_EQ(initialCount + 1, HeapAllocationCounter::GetCurrentThreadAllocationCount());
+
+    auto const a = std::make_unique<int[]>(16);
+    EXPECT_EQ(initialCount + 2, HeapAllocationCounter::GetCurrentThreadAllocationCount());
+
+    std::vector<int> v;
+    v.reserve(8);
+    EXPECT_EQ(initialCount + 3, HeapAllocationCounter::GetCurrentThreadAllocationCount());
+}
+
+TEST(HeapAllocationCounterTests, CountsOverAlignedAllocations)
+{
+    size_t const initialCount = HeapAllocationCounter::GetCurrentThreadAllocationCount();
+
+    auto const o = std::make_unique<OverAligned>();
+    EXPECT_EQ(initialCount + 1, HeapAllocationCounter::GetCurrentThreadAllocationCount());
+    EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(o.get()) % 64);
+
+    auto const oa = std::make_unique<OverAligned[]>(3);
+    EXPECT_EQ(initialCount + 2, HeapAllocationCounter::GetCurrentThreadAllocationCount());
+    EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(oa.get()) % 64);
+}
+
+TEST(HeapAllocationCounterTests, DoesNotCountOtherThreads)
+{
+    size_t const initialCount = HeapAllocationCounter::GetCurrentThreadAllocationCount();
+
+    std::unique_ptr<int> fromOtherThread;
+    std::thread thread(
+        [&fromOtherThread]()
+        {
+            fromOtherThread = std::make_unique<int>(42);
+        });
+
+    size_t const countAfterStart = HeapAllocationCounter::GetCurrentThreadAllocationCount();
+
+    thread.join();
+
+    // Starting the thread may well allocate on this thread, but nothing else does
+    EXPECT_EQ(countAfterStart, HeapAllocationCounter::GetCurrentThreadAllocationCount());
+    EXPECT_LE(initialCount, countAfterStart);
+}
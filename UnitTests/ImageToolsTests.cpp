@@ -0,0 +1,99 @@
+#include <GameCore/ImageTools.h>
+
+#include "gtest/gtest.h"
+
+TEST(ImageToolsTests, BoxFilterResize_AveragesCoveredPixels)
+{
+    rgbaColor const source[] = {
+        rgbaColor(0, 0, 0, 255),    rgbaColor(100, 0, 0, 255),  rgbaColor(10, 20, 30, 0),  rgbaColor(10, 20, 30, 0),
+        rgbaColor(0, 100, 0, 255),  rgbaColor(0, 0, 100, 255),  rgbaColor(10, 20, 30, 0),  rgbaColor(10, 20, 30, 0)
+    };
+
+    auto const result = ImageTools::BoxFilterResize(
+        source,
+        ImageSize(4, 2),
+        ImageSize(2, 1),
+        false);
+
+    ASSERT_EQ(2, result.Size.Width);
+    ASSERT_EQ(1, result.Size.Height);
+
+    EXPECT_EQ(rgbaColor(25, 25, 25, 255), result.Data[0]);
+    EXPECT_EQ(rgbaColor(10, 20, 30, 0), result.Data[1]);
+}
+
+TEST(ImageToolsTests, BoxFilterResize_RoundsToNearest)
+{
+    rgbaColor const source[] = {
+        rgbaColor(0, 0, 0, 0),  rgbaColor(1, 3, 255, 255)
+    };
+
+    auto const result = ImageTools::BoxFilterResize(
+        source,
+        ImageSize(2, 1),
+        ImageSize(1, 1),
+        false);
+
+    EXPECT_EQ(rgbaColor(1, 2, 128, 128), result.Data[0]);
+}
+
+TEST(ImageToolsTests, BoxFilterResize_FlipsVertically)
+{
+    rgbaColor const source[] = {
+        rgbaColor(1, 1, 1, 1),  rgbaColor(3, 3, 3, 3),
+        rgbaColor(1, 1, 1, 1),  rgbaColor(3, 3, 3, 3),
+        rgbaColor(5, 5, 5, 5),  rgbaColor(7, 7, 7, 7),
+        rgbaColor(5, 5, 5, 5),  rgbaColor(7, 7, 7, 7)
+    };
+
+    auto const result = ImageTools::BoxFilterResize(
+        source,
+        ImageSize(2, 4),
+        ImageSize(1, 2),
+        true);
+
+    ASSERT_EQ(1, result.Size.Width);
+    ASSERT_EQ(2, result.Size.Height);
+
+    EXPECT_EQ(rgbaColor(6, 6, 6, 6), result.Data[0]);
+    EXPECT_EQ(rgbaColor(2, 2, 2, 2), result.Data[1]);
+}
+
+TEST(ImageToolsTests, BoxFilterResize_SameSizeIsIdentity)
+{
+    rgbaColor const source[] = {
+        rgbaColor(1, 2, 3, 4),  rgbaColor(5, 6, 7, 8),
+        rgbaColor(9, 10, 11, 12),  rgbaColor(13, 14, 15, 16)
+    };
+
+    auto const result = ImageTools::BoxFilterResize(
+        source,
+        ImageSize(2, 2),
+        ImageSize(2, 2),
+        false);
+
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ(source[i], result.Data[i]);
+    }
+}
+
+TEST(ImageToolsTests, MakeMipmaps_GoesDownToOnePixel)
+{
+    auto data = std::make_unique<rgbaColor[]>(4 * 2);
+    for (int i = 0; i < 8; ++i)
+        data[i] = rgbaColor(static_cast<uint8_t>(i * 10), 0, 0, 255);
+
+    RgbaImageData const baseImage(ImageSize(4, 2), std::move(data));
+
+    auto const mipmaps = ImageTools::MakeMipmaps(baseImage);
+
+    ASSERT_EQ(2u, mipmaps.size());
+
+    ASSERT_EQ(ImageSize(2, 1), mipmaps[0].Size);
+    EXPECT_EQ(rgbaColor(25, 0, 0, 255), mipmaps[0].Data[0]);
+    EXPECT_EQ(rgbaColor(45, 0, 0, 255), mipmaps[0].Data[1]);
+
+    ASSERT_EQ(ImageSize(1, 1), mipmaps[1].Size);
+    EXPECT_EQ(rgbaColor(35, 0, 0, 255), mipmaps[1].Data[0]);
+}
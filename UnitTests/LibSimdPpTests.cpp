@@ -1,13 +1,10 @@
 #include "Utils.h"
 
 #include <GameCore/GameTypes.h>
+#include <GameCore/LibSimdPp.h>
 #include <GameCore/SysSpecifics.h>
 #include <GameCore/Vectors.h>
 
-// TODO: move to GameLib's LibSimdPp.h
-//#define SIMDPP_ARCH_X86_SSSE3
-#define SIMDPP_ARCH_X86_SSE2
-#include "simdpp/simd.h"
 #include "intrin.h"
 
 #include "gtest/gtest.h"
@@ -124,4 +124,31 @@ TEST(PrecalculatedFunctionTests, LinearlyInterpolatedPeriodic)
     EXPECT_NEAR(sin(2.0f * Pi<float> * -0.67f), pf.GetLinearlyInterpolatedPeriodic(-1.67f), 0.0001);
     EXPECT_NEAR(sin(2.0f * Pi<float> * -0.67f), pf.GetLinearlyInterpolatedPeriodic(-2.67f), 0.0001);
     EXPECT_NEAR(sin(2.0f * Pi<float> * -0.67f), pf.GetLinearlyInterpolatedPeriodic(-100.67f), 0.0001);
-}
\ No newline at end of file
+}
+TEST(PrecalculatedFunctionTests, LinearlyInterpolatedPeriodicBatch)
+{
+    PrecalculatedFunction<8192> pf(
+        [](float x)
+        {
+            return sin(2.0f * Pi<float> * x);
+        });
+
+    // Not a multiple of the batch width nor of the block size
+    size_t constexpr Count = 1003;
+
+    alignas(16) float x[Count];
+    alignas(16) float result[Count];
+
+    for (size_t i = 0; i < Count; ++i)
+    {
+        x[i] = -3.0f + static_cast<float>(i) * 0.00613f;
+    }
+
+    pf.GetLinearlyInterpolatedPeriodicBatch(x, result, Count);
+
+    for (size_t i = 0; i < Count; ++i)
+    {
+        EXPECT_NEAR(pf.GetLinearlyInterpolatedPeriodic(x[i]), result[i], 0.0001f);
+        EXPECT_NEAR(sin(2.0f * Pi<float> * x[i]), result[i], 0.001f);
+    }
+}
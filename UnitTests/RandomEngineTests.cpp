@@ -0,0 +1,140 @@
+#include <GameCore/RandomEngine.h>
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+TEST(RandomEngineTests, SameSeedAndStream_SameSequence)
+{
+    RandomEngine engine1(42, 7);
+    RandomEngine engine2(42, 7);
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        EXPECT_EQ(engine1.GenerateUInt32(), engine2.GenerateUInt32());
+    }
+}
+
+TEST(RandomEngineTests, DifferentStreams_DifferentSequences)
+{
+    RandomEngine engine1(42, 0);
+    RandomEngine engine2(42, 1);
+
+    int sameCount = 0;
+    for (int i = 0; i < 1000; ++i)
+    {
+        if (engine1.GenerateUInt32() == engine2.GenerateUInt32())
+            ++sameCount;
+    }
+
+    EXPECT_LT(sameCount, 5);
+}
+
+TEST(RandomEngineTests, Reseed_RestartsSequence)
+{
+    RandomEngine engine(42);
+
+    std::vector<std::uint32_t> first;
+    for (int i = 0; i < 10; ++i)
+        first.push_back(engine.GenerateUInt32());
+
+    engine.Seed(42);
+
+    for (int i = 0; i < 10; ++i)
+    {
+        EXPECT_EQ(first[i], engine.GenerateUInt32());
+    }
+}
+
+TEST(RandomEngineTests, GenerateRandomInteger_StaysInRangeAndCoversIt)
+{
+    RandomEngine engine(42);
+
+    std::vector<int> counts(7, 0);
+    for (int i = 0; i < 7000; ++i)
+    {
+        int const value = engine.GenerateRandomInteger(-3, 3);
+        ASSERT_GE(value, -3);
+        ASSERT_LE(value, 3);
+
+        ++counts[value + 3];
+    }
+
+    for (auto count : counts)
+    {
+        EXPECT_GT(count, 800);
+        EXPECT_LT(count, 1200);
+    }
+}
+
+TEST(RandomEngineTests, GenerateRandomInteger_SingleValue)
+{
+    RandomEngine engine(42);
+
+    for (int i = 0; i < 10; ++i)
+    {
+        EXPECT_EQ(5u, engine.GenerateRandomInteger<size_t>(5, 5));
+    }
+}
+
+TEST(RandomEngineTests, ChooseNew_NeverRepeatsPrevious)
+{
+    RandomEngine engine(42);
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        EXPECT_NE(2u, engine.ChooseNew<size_t>(4, 2));
+    }
+}
+
+TEST(RandomEngineTests, GenerateRandomReal_StaysInRange)
+{
+    RandomEngine engine(42);
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        float const value = engine.GenerateRandomReal(-2.0f, 5.0f);
+        ASSERT_GE(value, -2.0f);
+        ASSERT_LT(value, 5.0f);
+    }
+}
+
+TEST(RandomEngineTests, FillUniform_MatchesScalar)
+{
+    RandomEngine scalarEngine(42);
+    RandomEngine batchEngine(42);
+
+    // Misalign the two engines' outputs with respect to lane steps
+    scalarEngine.GenerateUInt32();
+    batchEngine.GenerateUInt32();
+
+    std::vector<float> values(37);
+    batchEngine.FillUniform(values.data(), values.size(), 1.0f, 3.0f);
+
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        EXPECT_EQ(scalarEngine.GenerateRandomReal(1.0f, 3.0f), values[i]);
+    }
+
+    // And they continue in lockstep
+    EXPECT_EQ(scalarEngine.GenerateUInt32(), batchEngine.GenerateUInt32());
+}
+
+TEST(RandomEngineTests, FillRadialVectors_MatchesScalar)
+{
+    RandomEngine scalarEngine(42);
+    RandomEngine batchEngine(42);
+
+    std::vector<vec2f> vectors(131);
+    batchEngine.FillRadialVectors(vectors.data(), vectors.size(), 2.0f, 4.0f);
+
+    for (size_t i = 0; i < vectors.size(); ++i)
+    {
+        vec2f const expected = scalarEngine.GenerateRandomRadialVector(2.0f, 4.0f);
+        EXPECT_EQ(expected, vectors[i]);
+
+        float const magnitude = vectors[i].length();
+        EXPECT_GE(magnitude, 2.0f - 0.001f);
+        EXPECT_LE(magnitude, 4.0f + 0.001f);
+    }
+}
@@ -0,0 +1,199 @@
+#include <GameCore/RewindBuffer.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace /* anonymous */ {
+
+    // An image of 1024 words whose few words depend on the frame number, as in a
+    // simulation where most state does not change between steps
+    std::vector<std::uint8_t> MakeImage(size_t frame)
+    {
+        std::vector<std::uint8_t> image(1024 * 8, 0);
+        for (size_t i = 0; i < image.size(); i += 97)
+            image[i] = static_cast<std::uint8_t>(i);
+
+        image[frame % image.size()] = 0xaa;
+        image[(frame * 13) % image.size()] ^= static_cast<std::uint8_t>(frame);
+
+        return image;
+    }
+
+    void PushImage(
+        RewindBuffer & rewindBuffer,
+        size_t frame)
+    {
+        std::vector<std::uint8_t> image;
+        ASSERT_TRUE(rewindBuffer.TryAcquireImage(image));
+
+        image = MakeImage(frame);
+        rewindBuffer.Push(static_cast<float>(frame), std::move(image));
+    }
+}
+
+TEST(RewindBufferTests, RestoresEachFrame)
+{
+    RewindBuffer rewindBuffer(RewindBuffer::Settings(1000.0f, 64 * 1024 * 1024, 8));
+
+    for (size_t f = 0; f < 40; ++f)
+    {
+        PushImage(rewindBuffer, f);
+
+        // Also waits for the encoder, which would otherwise drop frames
+        std::vector<std::uint8_t> image;
+        auto const time = rewindBuffer.Restore(static_cast<float>(f), image);
+        ASSERT_TRUE(time.has_value());
+        EXPECT_EQ(static_cast<float>(f), *time);
+        EXPECT_EQ(MakeImage(f), image);
+    }
+
+    auto const statistics = rewindBuffer.GetStatistics();
+    EXPECT_EQ(40u, statistics.FrameCount);
+    EXPECT_EQ(5u, statistics.KeyframeCount);
+    EXPECT_EQ(39.0f, statistics.Duration);
+    EXPECT_EQ(40u * 1024u * 8u, statistics.UncompressedByteSize);
+    EXPECT_EQ(0u, statistics.DroppedFrameCount);
+
+    // Deltas are much smaller than the images
+    EXPECT_LT(statistics.ByteSize, statistics.UncompressedByteSize / 2);
+}
+
+TEST(RewindBufferTests, RestoreDiscardsNewerFrames)
+{
+    RewindBuffer rewindBuffer(RewindBuffer::Settings(1000.0f, 64 * 1024 * 1024, 8));
+
+    for (size_t f = 0; f < 20; ++f)
+    {
+        PushImage(rewindBuffer, f);
+
+        std::vector<std::uint8_t> image;
+        rewindBuffer.Restore(static_cast<float>(f), image);
+    }
+
+    std::vector<std::uint8_t> image;
+
+    // Between frames: the older frame
+    auto time = rewindBuffer.Restore(11.5f, image);
+    ASSERT_TRUE(time.has_value());
+    EXPECT_EQ(11.0f, *time);
+    EXPECT_EQ(MakeImage(11), image);
+    EXPECT_EQ(12u, rewindBuffer.GetStatistics().FrameCount);
+
+    // Resume with a different history
+    PushImage(rewindBuffer, 30);
+    time = rewindBuffer.Restore(30.0f, image);
+    ASSERT_TRUE(time.has_value());
+    EXPECT_EQ(30.0f, *time);
+    EXPECT_EQ(MakeImage(30), image);
+
+    // Before all frames: the oldest frame
+    time = rewindBuffer.Restore(-5.0f, image);
+    ASSERT_TRUE(time.has_value());
+    EXPECT_EQ(0.0f, *time);
+    EXPECT_EQ(MakeImage(0), image);
+    EXPECT_EQ(1u, rewindBuffer.GetStatistics().FrameCount);
+}
+
+TEST(RewindBufferTests, EvictsFramesOlderThanDuration)
+{
+    RewindBuffer rewindBuffer(RewindBuffer::Settings(10.0f, 64 * 1024 * 1024, 4));
+
+    for (size_t f = 0; f < 100; ++f)
+    {
+        PushImage(rewindBuffer, f);
+
+        std::vector<std::uint8_t> image;
+        rewindBuffer.Restore(static_cast<float>(f), image);
+    }
+
+    // The frame 10 seconds ago must remain decodable
+    std::vector<std::uint8_t> image;
+    auto const time = rewindBuffer.Restore(89.0f, image);
+    ASSERT_TRUE(time.has_value());
+    EXPECT_EQ(89.0f, *time);
+    EXPECT_EQ(MakeImage(89), image);
+
+    // Whole keyframe groups are evicted, hence a bit more than 10 seconds remain
+    auto const statistics = rewindBuffer.GetStatistics();
+    EXPECT_LE(statistics.FrameCount, 11u + 4u);
+}
+
+TEST(RewindBufferTests, EvictsFramesOverMemoryCap)
+{
+    size_t const maxByteSize = 64 * 1024;
+
+    // Keyframes only, so that each frame is a group of its own
+    RewindBuffer rewindBuffer(RewindBuffer::Settings(1000.0f, maxByteSize, 1));
+
+    for (size_t f = 0; f < 200; ++f)
+    {
+        PushImage(rewindBuffer, f);
+
+        std::vector<std::uint8_t> image;
+        rewindBuffer.Restore(static_cast<float>(f), image);
+    }
+
+    auto const statistics = rewindBuffer.GetStatistics();
+    EXPECT_LT(statistics.FrameCount, 200u);
+    EXPECT_GE(statistics.KeyframeCount, 1u);
+
+    EXPECT_EQ(statistics.FrameCount, statistics.KeyframeCount);
+    EXPECT_LE(statistics.ByteSize, maxByteSize);
+
+    // The newest frame is always there
+    std::vector<std::uint8_t> image;
+    auto const time = rewindBuffer.Restore(199.0f, image);
+    ASSERT_TRUE(time.has_value());
+    EXPECT_EQ(199.0f, *time);
+    EXPECT_EQ(MakeImage(199), image);
+}
+
+TEST(RewindBufferTests, DropImageRecyclesImage)
+{
+    RewindBuffer rewindBuffer(RewindBuffer::Settings(1000.0f, 64 * 1024 * 1024));
+
+    for (size_t f = 0; f < 2; ++f)
+    {
+        PushImage(rewindBuffer, f);
+
+        std::vector<std::uint8_t> image;
+        rewindBuffer.Restore(static_cast<float>(f), image);
+    }
+
+    std::vector<std::uint8_t> image;
+    ASSERT_TRUE(rewindBuffer.TryAcquireImage(image));
+    ASSERT_GT(image.capacity(), 0u);
+
+    // As when the state cannot be captured
+    rewindBuffer.DropImage(std::move(image));
+
+    auto const statistics = rewindBuffer.GetStatistics();
+    EXPECT_EQ(2u, statistics.FrameCount);
+    EXPECT_EQ(1u, statistics.DroppedFrameCount);
+
+    std::vector<std::uint8_t> recycledImage;
+    ASSERT_TRUE(rewindBuffer.TryAcquireImage(recycledImage));
+    EXPECT_GT(recycledImage.capacity(), 0u);
+}
+
+TEST(RewindBufferTests, Clear)
+{
+    RewindBuffer rewindBuffer(RewindBuffer::Settings(1000.0f, 64 * 1024 * 1024));
+
+    PushImage(rewindBuffer, 0);
+    PushImage(rewindBuffer, 1);
+
+    rewindBuffer.Clear();
+
+    std::vector<std::uint8_t> image;
+    EXPECT_FALSE(rewindBuffer.Restore(1.0f, image).has_value());
+    EXPECT_EQ(0u, rewindBuffer.GetStatistics().FrameCount);
+
+    // Starts over with a keyframe
+    PushImage(rewindBuffer, 5);
+    auto const time = rewindBuffer.Restore(5.0f, image);
+    ASSERT_TRUE(time.has_value());
+    EXPECT_EQ(MakeImage(5), image);
+}
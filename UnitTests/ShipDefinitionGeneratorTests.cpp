@@ -0,0 +1,126 @@
+#include <Game/ShipDefinitionGenerator.h>
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+
+#include "gtest/gtest.h"
+
+namespace /* anonymous */ {
+
+    ShipDefinitionGenerator::Palette MakePalette()
+    {
+        ShipDefinitionGenerator::Palette palette;
+        palette.StructuralMaterials = { { 0x10, 0x20, 0x30 }, { 0x40, 0x50, 0x60 }, { 0x70, 0x80, 0x90 } };
+        palette.HullMaterials = { { 0x10, 0x20, 0x30 }, { 0x40, 0x50, 0x60 } };
+        palette.LampMaterials = { { 0xff, 0xe0, 0x10 } };
+        return palette;
+    }
+
+    size_t CountNonBackground(RgbImageData const & image)
+    {
+        return std::count_if(
+            image.Data.get(),
+            image.Data.get() + image.Size.Width * image.Size.Height,
+            [](rgbColor const & c)
+            {
+                return c != rgbColor(0xff, 0xff, 0xff);
+            });
+    }
+
+    bool AreEqual(RgbImageData const & a, RgbImageData const & b)
+    {
+        return a.Size == b.Size
+            && 0 == std::memcmp(a.Data.get(), b.Data.get(), a.Size.Width * a.Size.Height * sizeof(rgbColor));
+    }
+}
+
+TEST(ShipDefinitionGeneratorTests, SameSeedProducesSameDefinition)
+{
+    auto const palette = MakePalette();
+
+    auto const def1 = ShipDefinitionGenerator::Generate(ShipDefinitionGenerator::HullType::RopeRig, 20000, 42, palette);
+    auto const def2 = ShipDefinitionGenerator::Generate(ShipDefinitionGenerator::HullType::RopeRig, 20000, 42, palette);
+
+    EXPECT_TRUE(AreEqual(def1.StructuralLayerImage, def2.StructuralLayerImage));
+    ASSERT_TRUE(!!def1.RopesLayerImage);
+    ASSERT_TRUE(!!def2.RopesLayerImage);
+    EXPECT_TRUE(AreEqual(*def1.RopesLayerImage, *def2.RopesLayerImage));
+}
+
+TEST(ShipDefinitionGeneratorTests, DifferentSeedsProduceDifferentDefinitions)
+{
+    auto const palette = MakePalette();
+
+    auto const def1 = ShipDefinitionGenerator::Generate(ShipDefinitionGenerator::HullType::MixedMaterials, 10000, 1, palette);
+    auto const def2 = ShipDefinitionGenerator::Generate(ShipDefinitionGenerator::HullType::MixedMaterials, 10000, 2, palette);
+
+    EXPECT_FALSE(AreEqual(def1.StructuralLayerImage, def2.StructuralLayerImage));
+}
+
+TEST(ShipDefinitionGeneratorTests, SolidRectangleHasRequestedPointCount)
+{
+    auto const def = ShipDefinitionGenerator::Generate(ShipDefinitionGenerator::HullType::SolidRectangle, 100000, 0, MakePalette());
+
+    size_t const pointCount = CountNonBackground(def.StructuralLayerImage);
+    EXPECT_GE(pointCount, 100000u);
+    EXPECT_LE(pointCount, 101000u);
+
+    EXPECT_GT(def.StructuralLayerImage.Size.Width, def.StructuralLayerImage.Size.Height);
+}
+
+TEST(ShipDefinitionGeneratorTests, LatticeHasHoles)
+{
+    auto const def = ShipDefinitionGenerator::Generate(ShipDefinitionGenerator::HullType::Lattice, 100000, 0, MakePalette());
+
+    size_t const pointCount = CountNonBackground(def.StructuralLayerImage);
+    EXPECT_LT(pointCount, static_cast<size_t>(def.StructuralLayerImage.Size.Width * def.StructuralLayerImage.Size.Height));
+    EXPECT_GE(pointCount, 90000u);
+    EXPECT_LE(pointCount, 110000u);
+}
+
+TEST(ShipDefinitionGeneratorTests, RopeRigHasRopesWithTwoEndpointsOnStructure)
+{
+    auto const def = ShipDefinitionGenerator::Generate(ShipDefinitionGenerator::HullType::RopeRig, 50000, 7, MakePalette());
+
+    ASSERT_TRUE(!!def.RopesLayerImage);
+    ASSERT_EQ(def.StructuralLayerImage.Size, def.RopesLayerImage->Size);
+
+    std::map<rgbColor, size_t> endpointCounts;
+    for (int i = 0; i < def.RopesLayerImage->Size.Width * def.RopesLayerImage->Size.Height; ++i)
+    {
+        rgbColor const & c = def.RopesLayerImage->Data[i];
+        if (c != rgbColor(0xff, 0xff, 0xff))
+        {
+            ++endpointCounts[c];
+            EXPECT_NE(rgbColor(0xff, 0xff, 0xff), def.StructuralLayerImage.Data[i]);
+        }
+    }
+
+    EXPECT_GT(endpointCounts.size(), 1000u);
+    for (auto const & entry : endpointCounts)
+    {
+        EXPECT_EQ(2u, entry.second);
+    }
+}
+
+TEST(ShipDefinitionGeneratorTests, LampGridHasLampsOnStructure)
+{
+    auto const def = ShipDefinitionGenerator::Generate(ShipDefinitionGenerator::HullType::LampGrid, 10000, 0, MakePalette());
+
+    ASSERT_TRUE(!!def.ElectricalLayerImage);
+    ASSERT_EQ(def.StructuralLayerImage.Size, def.ElectricalLayerImage->Size);
+
+    size_t const lampCount = CountNonBackground(*def.ElectricalLayerImage);
+    EXPECT_GE(lampCount, 10000u / 64u - 20u);
+    EXPECT_LE(lampCount, 10000u / 64u + 20u);
+
+    for (int i = 0; i < def.ElectricalLayerImage->Size.Width * def.ElectricalLayerImage->Size.Height; ++i)
+    {
+        if (def.ElectricalLayerImage->Data[i] != rgbColor(0xff, 0xff, 0xff))
+        {
+            EXPECT_EQ(rgbColor(0xff, 0xe0, 0x10), def.ElectricalLayerImage->Data[i]);
+            EXPECT_NE(rgbColor(0xff, 0xff, 0xff), def.StructuralLayerImage.Data[i]);
+        }
+    }
+}
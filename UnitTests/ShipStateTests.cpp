@@ -0,0 +1,216 @@
+#include "HeapAllocationCounter.h"
+
+#include <Game/GameEventDispatcher.h>
+#include <Game/MaterialDatabase.h>
+#include <Game/ResourceLoader.h>
+#include <Game/ShipBuilder.h>
+#include <Game/ShipDefinitionGenerator.h>
+#include <Game/World.h>
+
+#include <GameCore/Checkpoint.h>
+#include <GameCore/ThreadPool.h>
+
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace Physics
+{
+
+/*
+ * Builds ships out of a synthetic definition; expects the Data folder in the
+ * current directory, and skips the tests otherwise.
+ */
+class ShipStateTests : public ::testing::Test
+{
+protected:
+
+    void SetUp() override
+    {
+        if (!std::filesystem::exists("Data"))
+        {
+            GTEST_SKIP() << "No Data folder in the current directory";
+        }
+
+        mResourceLoader = std::make_unique<ResourceLoader>();
+        mMaterialDatabase = std::make_unique<MaterialDatabase>(MaterialDatabase::Load(*mResourceLoader));
+        mGameEventDispatcher = std::make_shared<GameEventDispatcher>();
+        mWorld = std::make_unique<World>(
+            mGameEventDispatcher,
+            std::make_shared<ThreadPool>(1, false),
+            mGameParameters,
+            *mResourceLoader);
+    }
+
+    std::unique_ptr<Ship> MakeShip()
+    {
+        return ShipBuilder::Create(
+            0,
+            *mWorld,
+            mGameEventDispatcher,
+            ShipDefinitionGenerator::Generate(
+                ShipDefinitionGenerator::HullType::SolidRectangle,
+                1000,
+                1,
+                ShipDefinitionGenerator::Palette::FromMaterialDatabase(*mMaterialDatabase)),
+            *mMaterialDatabase,
+            mGameParameters);
+    }
+
+    /*
+     * Does what Ship::Render does with the structure, minus the render context; returns
+     * the number of triangles that would be uploaded, or none if they would not be.
+     */
+    static std::optional<size_t> RenderTriangles(Ship & ship)
+    {
+        std::optional<size_t> triangleCount;
+
+        if (ship.mIsStructureDirty)
+        {
+            ship.RunConnectivityVisit();
+            triangleCount = ship.mPlaneTriangleIndicesToRender.back();
+        }
+
+        ship.mIsStructureDirty = false;
+
+        return triangleCount;
+    }
+
+    static void DestroyConnectedTriangles(
+        Ship & ship,
+        size_t triangleCount)
+    {
+        for (ElementIndex p = 0; p < ship.GetPointCount() && triangleCount > 0; ++p)
+        {
+            if (!ship.mPoints.GetConnectedTriangles(p).empty())
+            {
+                ship.DestroyConnectedTriangles(p);
+                --triangleCount;
+            }
+        }
+    }
+
+    /*
+     * Runs one simulation step of the ship, returning the number of heap allocations
+     * made by the update itself.
+     */
+    size_t UpdateShip(
+        Ship & ship,
+        float & currentSimulationTime)
+    {
+        currentSimulationTime += GameParameters::SimulationStepTimeDuration<float>;
+
+        size_t const initialAllocationCount = HeapAllocationCounter::GetCurrentThreadAllocationCount();
+
+        ship.Update(
+            currentSimulationTime,
+            mGameParameters,
+            VectorFieldRenderMode::None);
+
+        size_t const allocationCount = HeapAllocationCounter::GetCurrentThreadAllocationCount() - initialAllocationCount;
+
+        // As the game controller does at the end of each step
+        mGameEventDispatcher->Flush();
+
+        return allocationCount;
+    }
+
+    static std::vector<std::uint8_t> SaveState(Ship const & ship)
+    {
+        std::vector<std::uint8_t> image;
+
+        CheckpointWriter checkpoint(image);
+        ship.SaveState(checkpoint);
+        checkpoint.Finish();
+
+        return image;
+    }
+
+    static void LoadState(
+        Ship & ship,
+        std::vector<std::uint8_t> const & image)
+    {
+        CheckpointReader checkpoint(image.data(), image.size());
+        ship.LoadState(checkpoint);
+    }
+
+    GameParameters const mGameParameters;
+
+    std::unique_ptr<ResourceLoader> mResourceLoader;
+    std::unique_ptr<MaterialDatabase> mMaterialDatabase;
+    std::shared_ptr<GameEventDispatcher> mGameEventDispatcher;
+    std::unique_ptr<World> mWorld;
+};
+
+}
+
+using Physics::ShipStateTests;
+
+TEST_F(ShipStateTests, LoadedShipUploadsTriangles)
+{
+    auto savedShip = MakeShip();
+    auto const triangleCount = RenderTriangles(*savedShip);
+    ASSERT_TRUE(triangleCount.has_value());
+    ASSERT_GT(*triangleCount, 0u);
+
+    // Nothing changed, nothing to upload
+    EXPECT_FALSE(RenderTriangles(*savedShip).has_value());
+
+    auto const image = SaveState(*savedShip);
+
+    auto loadedShip = MakeShip();
+    EXPECT_TRUE(RenderTriangles(*loadedShip).has_value());
+
+    LoadState(*loadedShip, image);
+
+    auto const loadedTriangleCount = RenderTriangles(*loadedShip);
+    ASSERT_TRUE(loadedTriangleCount.has_value());
+    EXPECT_EQ(*triangleCount, *loadedTriangleCount);
+}
+
+TEST_F(ShipStateTests, RestoredShipUploadsRestoredTriangles)
+{
+    auto ship = MakeShip();
+    auto const triangleCount = RenderTriangles(*ship);
+    ASSERT_TRUE(triangleCount.has_value());
+
+    auto const image = SaveState(*ship);
+
+    // As when rewinding after the ship broke
+    DestroyConnectedTriangles(*ship, 10);
+    auto const brokenTriangleCount = RenderTriangles(*ship);
+    ASSERT_TRUE(brokenTriangleCount.has_value());
+    ASSERT_LT(*brokenTriangleCount, *triangleCount);
+
+    LoadState(*ship, image);
+
+    auto const restoredTriangleCount = RenderTriangles(*ship);
+    ASSERT_TRUE(restoredTriangleCount.has_value());
+    EXPECT_EQ(*triangleCount, *restoredTriangleCount);
+}
+
+TEST_F(ShipStateTests, UpdateDoesNotAllocateInSteadyState)
+{
+    auto ship = MakeShip();
+
+    float currentSimulationTime = 0.0f;
+
+    // Let all buffers - also this thread's event buffers - reach their working size,
+    // over a few periods of the low-frequency updates
+    for (int i = 0; i < 200; ++i)
+    {
+        UpdateShip(*ship, currentSimulationTime);
+    }
+
+    // Then count over as many steps
+    size_t allocationCount = 0;
+    for (int i = 0; i < 200; ++i)
+    {
+        allocationCount += UpdateShip(*ship, currentSimulationTime);
+    }
+
+    EXPECT_EQ(0u, allocationCount);
+}
@@ -0,0 +1,49 @@
+#include <GameCore/StateHasher.h>
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+
+TEST(StateHasherTests, SameSequenceSameHash)
+{
+    StateHasher hasher1;
+    hasher1.Add(vec2f(1.0f, -2.5f));
+    hasher1.Add(0.25f);
+    hasher1.Add(true);
+
+    StateHasher hasher2;
+    hasher2.Add(vec2f(1.0f, -2.5f));
+    hasher2.Add(0.25f);
+    hasher2.Add(true);
+
+    EXPECT_EQ(hasher1.GetHash(), hasher2.GetHash());
+    EXPECT_NE(StateHasher().GetHash(), hasher1.GetHash());
+}
+
+TEST(StateHasherTests, OrderMatters)
+{
+    StateHasher hasher1;
+    hasher1.Add(1.0f);
+    hasher1.Add(2.0f);
+
+    StateHasher hasher2;
+    hasher2.Add(2.0f);
+    hasher2.Add(1.0f);
+
+    EXPECT_NE(hasher1.GetHash(), hasher2.GetHash());
+}
+
+TEST(StateHasherTests, DistinguishesBitPatterns)
+{
+    StateHasher hasher1;
+    hasher1.Add(0.0f);
+
+    StateHasher hasher2;
+    hasher2.Add(-0.0f);
+
+    StateHasher hasher3;
+    hasher3.Add(std::nextafter(0.0f, 1.0f));
+
+    EXPECT_NE(hasher1.GetHash(), hasher2.GetHash());
+    EXPECT_NE(hasher1.GetHash(), hasher3.GetHash());
+}
@@ -0,0 +1,144 @@
+#include <Game/StructuralCommandBuffer.h>
+
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace Physics;
+
+TEST(StructuralCommandBufferTests, Empty)
+{
+    StructuralCommandBuffer buffer;
+
+    EXPECT_TRUE(buffer.IsEmpty());
+    EXPECT_TRUE(buffer.Seal().empty());
+}
+
+TEST(StructuralCommandBufferTests, SealOrdersByTypeAndElement)
+{
+    StructuralCommandBuffer buffer;
+
+    buffer.RecordSpringBreak(7);
+    buffer.RecordPointDetach(12, vec2f(1.0f, 2.0f), true);
+    buffer.RecordSpringBreak(3);
+    buffer.RecordPointDetach(4, vec2f(3.0f, 4.0f), false);
+
+    EXPECT_FALSE(buffer.IsEmpty());
+
+    auto const & commands = buffer.Seal();
+
+    ASSERT_EQ(4u, commands.size());
+
+    EXPECT_EQ(StructuralCommandBuffer::CommandType::DetachPoint, commands[0].Type);
+    EXPECT_EQ(4u, commands[0].Element);
+    EXPECT_EQ(vec2f(3.0f, 4.0f), commands[0].Velocity);
+    EXPECT_FALSE(commands[0].GenerateDebris);
+
+    EXPECT_EQ(StructuralCommandBuffer::CommandType::DetachPoint, commands[1].Type);
+    EXPECT_EQ(12u, commands[1].Element);
+    EXPECT_EQ(vec2f(1.0f, 2.0f), commands[1].Velocity);
+    EXPECT_TRUE(commands[1].GenerateDebris);
+
+    EXPECT_EQ(StructuralCommandBuffer::CommandType::BreakSpring, commands[2].Type);
+    EXPECT_EQ(3u, commands[2].Element);
+
+    EXPECT_EQ(StructuralCommandBuffer::CommandType::BreakSpring, commands[3].Type);
+    EXPECT_EQ(7u, commands[3].Element);
+}
+
+TEST(StructuralCommandBufferTests, SealKeepsStrongestCommandForEachElement)
+{
+    StructuralCommandBuffer buffer;
+
+    buffer.RecordPointDetach(5, vec2f(1.0f, 1.0f), false);
+    buffer.RecordSpringBreak(5);
+    buffer.RecordPointDetach(5, vec2f(3.0f, 3.0f), false);
+    buffer.RecordPointDetach(5, vec2f(2.0f, 2.0f), true);
+    buffer.RecordSpringBreak(5);
+
+    auto const & commands = buffer.Seal();
+
+    ASSERT_EQ(2u, commands.size());
+
+    EXPECT_EQ(StructuralCommandBuffer::CommandType::DetachPoint, commands[0].Type);
+    EXPECT_EQ(vec2f(2.0f, 2.0f), commands[0].Velocity);
+    EXPECT_TRUE(commands[0].GenerateDebris);
+
+    EXPECT_EQ(StructuralCommandBuffer::CommandType::BreakSpring, commands[1].Type);
+}
+
+TEST(StructuralCommandBufferTests, SealDoesNotDependOnRecordingOrder)
+{
+    std::vector<std::pair<vec2f, bool>> const detaches = {
+        { vec2f(1.0f, 0.0f), false },
+        { vec2f(0.0f, 1.0f), false },
+        { vec2f(0.0f, -1.0f), false } };
+
+    for (size_t first = 0; first < detaches.size(); ++first)
+    {
+        StructuralCommandBuffer buffer;
+
+        for (size_t d = 0; d < detaches.size(); ++d)
+        {
+            auto const & detach = detaches[(first + d) % detaches.size()];
+            buffer.RecordPointDetach(5, detach.first, detach.second);
+        }
+
+        auto const & commands = buffer.Seal();
+
+        ASSERT_EQ(1u, commands.size());
+        EXPECT_EQ(vec2f(1.0f, 0.0f), commands[0].Velocity) << first;
+    }
+}
+
+TEST(StructuralCommandBufferTests, RecordFromMultipleThreads)
+{
+    StructuralCommandBuffer buffer;
+
+    buffer.RecordSpringBreak(0);
+
+    std::vector<std::thread> threads;
+    for (ElementIndex t = 1; t <= 4; ++t)
+    {
+        threads.emplace_back(
+            [&buffer, t]()
+            {
+                for (ElementIndex s = 0; s < 100; ++s)
+                {
+                    buffer.RecordSpringBreak(t * 100 + s);
+                }
+
+                // Also recorded by every other thread
+                buffer.RecordSpringBreak(0);
+            });
+    }
+
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_FALSE(buffer.IsEmpty());
+
+    auto const & commands = buffer.Seal();
+
+    ASSERT_EQ(401u, commands.size());
+    EXPECT_EQ(0u, commands[0].Element);
+    EXPECT_EQ(100u, commands[1].Element);
+    EXPECT_EQ(499u, commands[400].Element);
+
+    // Sealing consumes the commands of all threads
+    EXPECT_TRUE(buffer.IsEmpty());
+}
+
+TEST(StructuralCommandBufferTests, ClearEmpties)
+{
+    StructuralCommandBuffer buffer;
+
+    buffer.RecordSpringBreak(1);
+    buffer.Clear();
+
+    EXPECT_TRUE(buffer.IsEmpty());
+}
@@ -0,0 +1,206 @@
+#include <Game/TextureCache.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace Render;
+
+namespace /* anonymous */ {
+
+    std::filesystem::path GetRootPath()
+    {
+        return std::filesystem::temp_directory_path() / "TextureCacheTests";
+    }
+
+    std::filesystem::path GetTexturesPath()
+    {
+        return GetRootPath() / "Textures";
+    }
+
+    std::filesystem::path GetCacheFilePath()
+    {
+        // In a folder that does not exist yet
+        return GetRootPath() / "Cache" / "TextureCache.bin";
+    }
+
+    void WriteFile(
+        std::filesystem::path const & filePath,
+        size_t size)
+    {
+        std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+        file << std::string(size, 'x');
+    }
+
+    RgbaImageData MakeImage(
+        int width,
+        int height,
+        std::uint8_t seed)
+    {
+        auto data = std::make_unique<rgbaColor[]>(width * height);
+        for (int i = 0; i < width * height; ++i)
+            data[i] = rgbaColor(seed, static_cast<std::uint8_t>(i), 0x10, 0xff);
+
+        return RgbaImageData(ImageSize(width, height), std::move(data));
+    }
+
+    bool AreEqual(RgbaImageData const & a, RgbaImageData const & b)
+    {
+        return a.Size == b.Size
+            && std::equal(a.Data.get(), a.Data.get() + a.Size.Width * a.Size.Height, b.Data.get());
+    }
+
+    /*
+     * Starts from a textures folder with two files and a cache file holding an image
+     * size and an entry.
+     */
+    void MakeCache()
+    {
+        std::filesystem::remove_all(GetRootPath());
+        std::filesystem::create_directories(GetTexturesPath());
+
+        WriteFile(GetTexturesPath() / "a.png", 10);
+        WriteFile(GetTexturesPath() / "b.png", 20);
+
+        auto textureCache = TextureCache::Load(GetCacheFilePath(), GetTexturesPath());
+
+        textureCache->PutImageSize(GetTexturesPath() / "a.png", ImageSize(4, 8));
+
+        std::vector<RgbaImageData> levels;
+        levels.emplace_back(MakeImage(2, 2, 1));
+        levels.emplace_back(MakeImage(1, 1, 2));
+
+        textureCache->PutEntry(
+            "Atlas",
+            TextureCache::Entry(
+                ImageSize(16, 32),
+                { TextureCache::FramePosition(TextureFrameId(TextureGroupType::Cloud, 3), 4, 8) },
+                std::move(levels)));
+
+        EXPECT_TRUE(textureCache->IsDirty());
+
+        textureCache->Save();
+
+        EXPECT_FALSE(textureCache->IsDirty());
+    }
+
+    void ExpectEmpty(TextureCache const & textureCache)
+    {
+        EXPECT_FALSE(textureCache.GetImageSize(GetTexturesPath() / "a.png").has_value());
+        EXPECT_EQ(nullptr, textureCache.GetEntry("Atlas"));
+        EXPECT_FALSE(textureCache.IsDirty());
+    }
+}
+
+TEST(TextureCacheTests, MissingFile)
+{
+    std::filesystem::remove_all(GetRootPath());
+    std::filesystem::create_directories(GetTexturesPath());
+
+    auto const textureCache = TextureCache::Load(GetCacheFilePath(), GetTexturesPath());
+
+    ExpectEmpty(*textureCache);
+}
+
+TEST(TextureCacheTests, RoundTrip)
+{
+    MakeCache();
+
+    auto const textureCache = TextureCache::Load(GetCacheFilePath(), GetTexturesPath());
+
+    EXPECT_FALSE(textureCache->IsDirty());
+
+    auto const imageSize = textureCache->GetImageSize(GetTexturesPath() / "a.png");
+    ASSERT_TRUE(imageSize.has_value());
+    EXPECT_EQ(ImageSize(4, 8), *imageSize);
+
+    EXPECT_FALSE(textureCache->GetImageSize(GetTexturesPath() / "b.png").has_value());
+
+    auto const * const entry = textureCache->GetEntry("Atlas");
+    ASSERT_NE(nullptr, entry);
+
+    EXPECT_EQ(ImageSize(16, 32), entry->AtlasSize);
+
+    ASSERT_EQ(1u, entry->FramePositions.size());
+    EXPECT_EQ(TextureFrameId(TextureGroupType::Cloud, 3), entry->FramePositions[0].FrameId);
+    EXPECT_EQ(4, entry->FramePositions[0].FrameLeftX);
+    EXPECT_EQ(8, entry->FramePositions[0].FrameBottomY);
+
+    ASSERT_EQ(2u, entry->Levels.size());
+    EXPECT_TRUE(AreEqual(MakeImage(2, 2, 1), entry->Levels[0]));
+    EXPECT_TRUE(AreEqual(MakeImage(1, 1, 2), entry->Levels[1]));
+
+    EXPECT_EQ(nullptr, textureCache->GetEntry("Other"));
+}
+
+TEST(TextureCacheTests, IgnoresTruncatedFile)
+{
+    MakeCache();
+
+    auto const fileSize = std::filesystem::file_size(GetCacheFilePath());
+
+    // Within the pixels of the last level, and within the header
+    for (std::uintmax_t const truncatedFileSize : { fileSize - 1, std::uintmax_t(6) })
+    {
+        std::filesystem::resize_file(GetCacheFilePath(), truncatedFileSize);
+
+        auto const textureCache = TextureCache::Load(GetCacheFilePath(), GetTexturesPath());
+
+        ExpectEmpty(*textureCache);
+    }
+}
+
+TEST(TextureCacheTests, IgnoresFileWithTrailingData)
+{
+    MakeCache();
+
+    {
+        std::ofstream file(GetCacheFilePath(), std::ios::binary | std::ios::app);
+        file << "x";
+    }
+
+    auto const textureCache = TextureCache::Load(GetCacheFilePath(), GetTexturesPath());
+
+    ExpectEmpty(*textureCache);
+}
+
+TEST(TextureCacheTests, IgnoresStaleFile_ChangedSize)
+{
+    MakeCache();
+
+    WriteFile(GetTexturesPath() / "b.png", 21);
+
+    auto const textureCache = TextureCache::Load(GetCacheFilePath(), GetTexturesPath());
+
+    ExpectEmpty(*textureCache);
+}
+
+TEST(TextureCacheTests, IgnoresStaleFile_ChangedModificationTime)
+{
+    MakeCache();
+
+    auto const texturePath = GetTexturesPath() / "b.png";
+    std::filesystem::last_write_time(
+        texturePath,
+        std::filesystem::last_write_time(texturePath) + std::chrono::hours(1));
+
+    auto const textureCache = TextureCache::Load(GetCacheFilePath(), GetTexturesPath());
+
+    ExpectEmpty(*textureCache);
+}
+
+TEST(TextureCacheTests, IgnoresStaleFile_AddedFile)
+{
+    MakeCache();
+
+    WriteFile(GetTexturesPath() / "c.png", 10);
+
+    auto const textureCache = TextureCache::Load(GetCacheFilePath(), GetTexturesPath());
+
+    ExpectEmpty(*textureCache);
+}
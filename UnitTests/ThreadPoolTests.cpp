@@ -0,0 +1,222 @@
+#include <GameCore/ThreadPool.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+TEST(ThreadPoolTests, ParallelFor_CoversRangeExactlyOnce)
+{
+    ThreadPool threadPool(3, false);
+
+    ElementCount const count = 100000;
+    std::unique_ptr<std::atomic<int>[]> visits(new std::atomic<int>[count]);
+    for (ElementCount i = 0; i < count; ++i)
+        visits[i] = 0;
+
+    threadPool.ParallelFor(
+        ElementIndexRange(0, count),
+        64,
+        [&visits](ElementIndex start, ElementIndex end)
+        {
+            for (ElementIndex i = start; i < end; ++i)
+                ++visits[i];
+        });
+
+    for (ElementCount i = 0; i < count; ++i)
+    {
+        EXPECT_EQ(1, visits[i]);
+    }
+}
+
+TEST(ThreadPoolTests, ParallelFor_SubRangesAreAlignedToVectorizationWordSize)
+{
+    ThreadPool threadPool(2, false);
+
+    std::atomic<bool> isMisaligned(false);
+    std::atomic<ElementCount> totalSize(0);
+
+    threadPool.ParallelFor(
+        ElementIndexRange(0, 1003),
+        5, // Rounded up to the vectorization word size
+        [&](ElementIndex start, ElementIndex end)
+        {
+            if ((start % VectorizationWordSize) != 0
+                || (end != 1003 && (end % VectorizationWordSize) != 0)
+                || (end - start < VectorizationWordSize && end != 1003))
+            {
+                isMisaligned = true;
+            }
+
+            totalSize += end - start;
+        });
+
+    EXPECT_FALSE(isMisaligned);
+    EXPECT_EQ(1003u, totalSize);
+}
+
+TEST(ThreadPoolTests, ParallelFor_RunsSmallRangesInline)
+{
+    ThreadPool threadPool(3, false);
+
+    auto const callingThreadId = std::this_thread::get_id();
+
+    int invocationCount = 0;
+    bool isOnCallingThread = false;
+
+    threadPool.ParallelFor(
+        ElementIndexRange(10, 74),
+        64,
+        [&](ElementIndex start, ElementIndex end)
+        {
+            ++invocationCount;
+            isOnCallingThread = (std::this_thread::get_id() == callingThreadId);
+
+            EXPECT_EQ(10u, start);
+            EXPECT_EQ(74u, end);
+        });
+
+    EXPECT_EQ(1, invocationCount);
+    EXPECT_TRUE(isOnCallingThread);
+}
+
+TEST(ThreadPoolTests, ParallelFor_RunsInlineWithoutWorkers)
+{
+    ThreadPool threadPool(0, false);
+
+    EXPECT_EQ(1u, threadPool.GetParallelism());
+
+    int invocationCount = 0;
+
+    threadPool.ParallelFor(
+        ElementIndexRange(0, 100000),
+        8,
+        [&](ElementIndex start, ElementIndex end)
+        {
+            ++invocationCount;
+
+            EXPECT_EQ(0u, start);
+            EXPECT_EQ(100000u, end);
+        });
+
+    EXPECT_EQ(1, invocationCount);
+}
+
+TEST(ThreadPoolTests, ParallelFor_RepeatedJobs)
+{
+    ThreadPool threadPool(4, false);
+
+    std::vector<float> values(4096, 0.0f);
+
+    for (int j = 0; j < 200; ++j)
+    {
+        threadPool.ParallelFor(
+            ElementIndexRange(0, static_cast<ElementIndex>(values.size())),
+            16,
+            [&values](ElementIndex start, ElementIndex end)
+            {
+                for (ElementIndex i = start; i < end; ++i)
+                    values[i] += 1.0f;
+            });
+    }
+
+    for (float v : values)
+    {
+        EXPECT_EQ(200.0f, v);
+    }
+}
+
+TEST(ThreadPoolTests, ParallelReduce_CombinesChunksInOrder)
+{
+    ThreadPool threadPool(3, false);
+
+    // Record the start of each chunk, in combination order
+    auto const chunkStarts = threadPool.ParallelReduce(
+        ElementIndexRange(0, 1000),
+        100,
+        std::vector<ElementIndex>(),
+        [](ElementIndex start, ElementIndex /*end*/)
+        {
+            return std::vector<ElementIndex>(1, start);
+        },
+        [](std::vector<ElementIndex> lhs, std::vector<ElementIndex> const & rhs)
+        {
+            lhs.insert(lhs.end(), rhs.cbegin(), rhs.cend());
+            return lhs;
+        });
+
+    ElementCount const chunkSize = static_cast<ElementCount>(make_aligned_element_count(100));
+
+    ASSERT_EQ((1000 + chunkSize - 1) / chunkSize, chunkStarts.size());
+    for (size_t c = 0; c < chunkStarts.size(); ++c)
+    {
+        EXPECT_EQ(c * chunkSize, chunkStarts[c]);
+    }
+}
+
+TEST(ThreadPoolTests, ParallelReduce_IsIndependentOfWorkerCount)
+{
+    // Values of very different magnitudes, so that the sum depends on the order
+    std::vector<float> values(100003);
+    for (size_t i = 0; i < values.size(); ++i)
+        values[i] = (i % 7 == 0) ? 1.0e7f : 0.1f * static_cast<float>(i % 13);
+
+    auto const sum = [&values](ThreadPool & threadPool)
+    {
+        return threadPool.ParallelReduce(
+            ElementIndexRange(0, static_cast<ElementIndex>(values.size())),
+            256,
+            0.0f,
+            [&values](ElementIndex start, ElementIndex end)
+            {
+                float chunkSum = 0.0f;
+                for (ElementIndex i = start; i < end; ++i)
+                    chunkSum += values[i];
+
+                return chunkSum;
+            },
+            [](float lhs, float rhs)
+            {
+                return lhs + rhs;
+            });
+    };
+
+    ThreadPool inlinePool(0, false);
+    float const expectedSum = sum(inlinePool);
+
+    for (size_t workerCount : { 1, 3, 7 })
+    {
+        ThreadPool threadPool(workerCount, false);
+
+        for (int j = 0; j < 20; ++j)
+        {
+            EXPECT_EQ(expectedSum, sum(threadPool));
+        }
+    }
+}
+
+TEST(ThreadPoolTests, UtilizationStatistics)
+{
+    ThreadPool threadPool(2, false);
+
+    threadPool.ParallelFor(
+        ElementIndexRange(0, 1024),
+        8,
+        [](ElementIndex, ElementIndex)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        });
+
+    auto const utilizations = threadPool.GetUtilizationStatistics();
+
+    ASSERT_EQ(3u, utilizations.size());
+    for (float u : utilizations)
+    {
+        EXPECT_GE(u, 0.0f);
+        EXPECT_LE(u, 1.0f);
+    }
+
+    EXPECT_GT(utilizations[0], 0.0f);
+}
@@ -0,0 +1,125 @@
+#include <GameCore/TraceRecorder.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace /* anonymous */ {
+
+    std::string WriteAndReadTrace()
+    {
+        auto const filePath = std::filesystem::temp_directory_path() / "TraceRecorderTests.json";
+
+        TraceRecorder::GetInstance().WriteChromeTrace(filePath);
+
+        std::ifstream file(filePath);
+        std::stringstream ss;
+        ss << file.rdbuf();
+        file.close();
+
+        std::filesystem::remove(filePath);
+
+        return ss.str();
+    }
+
+    size_t CountOccurrences(
+        std::string const & str,
+        std::string const & pattern)
+    {
+        size_t count = 0;
+        for (size_t pos = str.find(pattern); pos != std::string::npos; pos = str.find(pattern, pos + 1))
+        {
+            ++count;
+        }
+
+        return count;
+    }
+}
+
+TEST(TraceRecorderTests, WritesCompleteEvents)
+{
+    auto & recorder = TraceRecorder::GetInstance();
+    recorder.SetEnabled(true);
+    recorder.Clear();
+
+    {
+        TRACE_SCOPE("Outer");
+
+        {
+            TRACE_SCOPE("Inner");
+        }
+    }
+
+    std::string const trace = WriteAndReadTrace();
+
+    EXPECT_EQ(0u, trace.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+    EXPECT_EQ(1u, CountOccurrences(trace, "{\"name\":\"Outer\",\"ph\":\"X\""));
+    EXPECT_EQ(1u, CountOccurrences(trace, "{\"name\":\"Inner\",\"ph\":\"X\""));
+
+    // Inner ends first, hence it is recorded first
+    EXPECT_LT(trace.find("\"Inner\""), trace.find("\"Outer\""));
+}
+
+TEST(TraceRecorderTests, NamesThreads)
+{
+    auto & recorder = TraceRecorder::GetInstance();
+    recorder.SetEnabled(true);
+    recorder.Clear();
+
+    std::thread thread(
+        [&recorder]()
+        {
+            recorder.SetCurrentThreadName("Test \"Thread\"");
+
+            TRACE_SCOPE("OnThread");
+        });
+
+    thread.join();
+
+    std::string const trace = WriteAndReadTrace();
+
+    EXPECT_EQ(1u, CountOccurrences(trace, "\"args\":{\"name\":\"Test \\\"Thread\\\"\"}"));
+    EXPECT_EQ(1u, CountOccurrences(trace, "\"OnThread\""));
+}
+
+TEST(TraceRecorderTests, KeepsMostRecentEvents)
+{
+    auto & recorder = TraceRecorder::GetInstance();
+    recorder.SetEnabled(true);
+    recorder.Clear();
+
+    auto const now = std::chrono::steady_clock::now();
+
+    recorder.RecordEvent("Oldest", now, now);
+
+    for (size_t i = 0; i < TraceRecorder::Capacity; ++i)
+    {
+        recorder.RecordEvent("Newer", now, now);
+    }
+
+    std::string const trace = WriteAndReadTrace();
+
+    EXPECT_EQ(0u, CountOccurrences(trace, "\"Oldest\""));
+    EXPECT_EQ(TraceRecorder::Capacity, CountOccurrences(trace, "\"Newer\""));
+}
+
+TEST(TraceRecorderTests, DisabledRecordsNothing)
+{
+    auto & recorder = TraceRecorder::GetInstance();
+    recorder.SetEnabled(true);
+    recorder.Clear();
+
+    recorder.SetEnabled(false);
+
+    {
+        TRACE_SCOPE("Disabled");
+    }
+
+    std::string const trace = WriteAndReadTrace();
+
+    EXPECT_EQ(0u, CountOccurrences(trace, "\"Disabled\""));
+}
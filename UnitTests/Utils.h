@@ -1,4 +1,3 @@
-#define SIMDPP_ARCH_X86_SSSE3
-#include "simdpp/simd.h"
+#include <GameCore/LibSimdPp.h>
 
 void DoSomething(simdpp::float32<4> const & v);
@@ -0,0 +1,93 @@
+#include <GameCore/Vec2fBuffers.h>
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+template<typename TBuffer>
+class Vec2fBuffersTests : public ::testing::Test
+{
+};
+
+using Vec2fBufferTypes = ::testing::Types<InterleavedVec2fBuffer, SplitVec2fBuffer>;
+TYPED_TEST_CASE(Vec2fBuffersTests, Vec2fBufferTypes);
+
+TYPED_TEST(Vec2fBuffersTests, FillsFromFillStart)
+{
+    TypeParam buffer(8, 2, vec2f(1.0f, 2.0f));
+
+    buffer.emplace_back(vec2f(3.0f, 4.0f));
+    buffer.emplace_back(vec2f(5.0f, 6.0f));
+
+    EXPECT_EQ(vec2f(3.0f, 4.0f), buffer.get(0));
+    EXPECT_EQ(vec2f(5.0f, 6.0f), buffer.get(1));
+
+    for (size_t i = 2; i < 8; ++i)
+    {
+        EXPECT_EQ(vec2f(1.0f, 2.0f), buffer.get(i));
+    }
+
+    EXPECT_EQ(8 * sizeof(vec2f), buffer.GetByteSize());
+}
+
+TYPED_TEST(Vec2fBuffersTests, SetAddAndComponents)
+{
+    TypeParam buffer(8, 0, vec2f::zero());
+
+    buffer.set(3, vec2f(1.0f, 2.0f));
+    buffer.add(3, vec2f(10.0f, 20.0f));
+
+    EXPECT_EQ(vec2f(11.0f, 22.0f), buffer.get(3));
+
+    buffer.x(3) = 5.0f;
+    buffer.y(3) -= 2.0f;
+
+    EXPECT_EQ(vec2f(5.0f, 20.0f), buffer.get(3));
+    EXPECT_EQ(vec2f::zero(), buffer.get(2));
+    EXPECT_EQ(vec2f::zero(), buffer.get(4));
+}
+
+TYPED_TEST(Vec2fBuffersTests, ComponentArraysCoverAllComponents)
+{
+    TypeParam buffer(8, 0, vec2f::zero());
+
+    for (size_t i = 0; i < 8; ++i)
+    {
+        buffer.set(i, vec2f(static_cast<float>(i), -static_cast<float>(i)));
+    }
+
+    EXPECT_EQ(8u * 2u, TypeParam::ComponentArrayCount * buffer.GetComponentArrayLength());
+
+    // Doubling all components of all arrays doubles all elements
+    for (size_t a = 0; a < TypeParam::ComponentArrayCount; ++a)
+    {
+        float * const data = buffer.GetComponentArray(a);
+        for (size_t i = 0; i < buffer.GetComponentArrayLength(); ++i)
+        {
+            data[i] *= 2.0f;
+        }
+    }
+
+    for (size_t i = 0; i < 8; ++i)
+    {
+        EXPECT_EQ(vec2f(2.0f * static_cast<float>(i), -2.0f * static_cast<float>(i)), buffer.get(i));
+    }
+}
+
+TYPED_TEST(Vec2fBuffersTests, CopyToInterleaves)
+{
+    TypeParam buffer(8, 0, vec2f::zero());
+
+    for (size_t i = 0; i < 8; ++i)
+    {
+        buffer.set(i, vec2f(static_cast<float>(i), static_cast<float>(i) + 0.5f));
+    }
+
+    std::vector<vec2f> interleaved(8);
+    buffer.copy_to(interleaved.data());
+
+    for (size_t i = 0; i < 8; ++i)
+    {
+        EXPECT_EQ(vec2f(static_cast<float>(i), static_cast<float>(i) + 0.5f), interleaved[i]);
+    }
+}